@@ -5,6 +5,7 @@
  */
 
 #include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
 #include <LibGC/NanBoxedValue.h>
 
 namespace GC {
@@ -15,4 +16,9 @@ void GC::Cell::Visitor::visit(NanBoxedValue const& value)
         visit_impl(value.as_cell());
 }
 
+void Cell::remember_for_young_generation_collection()
+{
+    heap().remember_cell({}, *this);
+}
+
 }
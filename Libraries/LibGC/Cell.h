@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
@@ -28,6 +29,13 @@ namespace GC {
 #    define IGNORE_GC
 #endif
 
+// Declares that every store of a cell pointer into instances of this class is followed by a call to
+// Cell::write_barrier(). Such cells don't have to be re-scanned by young generation collections.
+// NOTE: This is deliberately not inherited, as subclasses usually have edges of their own.
+#define GC_DECLARE_WRITE_BARRIER(class_) \
+public:                                  \
+    using WriteBarrierCellType = class_;
+
 #define GC_CELL(class_, base_class)                \
 public:                                            \
     using Base = base_class;                       \
@@ -47,14 +55,48 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
-    enum class State : bool {
+    // Sets the mark bit and returns true if this call was the one that set it.
+    // This is what lets the parallel marker guarantee that every cell is traced by exactly one thread.
+    bool try_set_marked() { return !m_mark.exchange(true, AK::MemoryOrder::memory_order_acq_rel); }
+
+    enum class State : u8 {
         Live,
+        // Unreachable and finalized, but not destroyed yet. The cell will be destroyed when its block is swept.
+        PendingSweep,
         Dead,
     };
 
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Young cells have been allocated since the last collection. Only used when generational collection is enabled.
+    bool is_young() const { return m_young; }
+    void set_young(Badge<Heap>, bool b) { m_young = b; }
+
+    bool has_write_barrier() const { return m_has_write_barrier; }
+    void set_has_write_barrier(Badge<Heap>, bool b) { m_has_write_barrier = b; }
+
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(Badge<Heap>, bool b) { m_remembered = b; }
+
+    // Must be called after storing a pointer to another cell in a cell whose class uses GC_DECLARE_WRITE_BARRIER.
+    // NOTE: With generational collection, cells that survived a collection keep their mark bit until the next
+    //       full collection, so a marked cell pointing to an unmarked one is an old-to-young edge.
+    ALWAYS_INLINE void write_barrier(Cell const* target)
+    {
+        if (target && !m_remembered && is_marked() && !target->is_marked()) [[unlikely]]
+            remember_for_young_generation_collection();
+    }
+
+    ALWAYS_INLINE void write_barrier(NanBoxedValue const&);
+
+    // For stores that can't be inspected, e.g. when handing out mutable access to internal storage.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if (!m_remembered && is_marked()) [[unlikely]]
+            remember_for_young_generation_collection();
+    }
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -171,6 +213,10 @@ public:
     // This will be called on unmarked objects by the garbage collector in a separate pass before destruction.
     virtual void finalize() { }
 
+    // Called on unmarked cells right after finalize(). A dead cell is only destroyed once its HeapBlock gets swept, which
+    // can be long after the collection, so cells that hand out AK::WeakPtrs to themselves must revoke them here.
+    virtual void revoke_weak_ptrs_before_sweep() { }
+
     // This allows cells to survive GC by choice, even if nothing points to them.
     // It's used to implement special rules in the web platform.
     // NOTE: Cells must call set_overrides_must_survive_garbage_collection() for this to be honored.
@@ -188,9 +234,14 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
-    bool m_mark { false };
+    void remember_for_young_generation_collection();
+
+    Atomic<bool, AK::MemoryOrder::memory_order_relaxed> m_mark { false };
     bool m_overrides_must_survive_garbage_collection { false };
     State m_state { State::Live };
+    bool m_young { false };
+    bool m_has_write_barrier { false };
+    bool m_remembered { false };
 } SWIFT_UNSAFE_REFERENCE;
 
 }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <LibGC/BlockAllocator.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Heap.h>
@@ -23,13 +24,13 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    // Destroy whatever the last collection left behind before growing the heap.
+    while (m_usable_blocks.is_empty() && !m_blocks_pending_sweep.is_empty())
+        sweep_block(*m_blocks_pending_sweep.take_last());
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
-        auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
-        if (m_min_block_address > block_ptr)
-            m_min_block_address = block_ptr;
-        if (m_max_block_address < block_ptr)
-            m_max_block_address = block_ptr;
+        heap.did_create_heap_block({}, *block);
         m_usable_blocks.append(*block.leak_ptr());
     }
 
@@ -41,15 +42,62 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     return cell;
 }
 
-void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+void CellAllocator::block_needs_sweep(Badge<Heap>, HeapBlock& block)
+{
+    VERIFY(!block.is_pending_sweep());
+    block.set_pending_sweep(true);
+    m_blocks_pending_sweep.append(&block);
+}
+
+size_t CellAllocator::sweep_pending_blocks(Badge<Heap>)
+{
+    size_t released_blocks = 0;
+    while (!m_blocks_pending_sweep.is_empty()) {
+        if (sweep_block(*m_blocks_pending_sweep.take_last()))
+            ++released_blocks;
+    }
+    return released_blocks;
+}
+
+bool CellAllocator::sweep_block(HeapBlock& block)
+{
+    VERIFY(block.is_pending_sweep());
+    block.set_pending_sweep(false);
+
+    bool block_has_live_cells = false;
+    bool block_was_full = block.is_full();
+    block.for_each_cell([&](Cell* cell) {
+        if (cell->state() == Cell::State::PendingSweep) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            block.deallocate(cell);
+        } else if (cell->state() == Cell::State::Live) {
+            block_has_live_cells = true;
+        }
+    });
+
+    if (!block_has_live_cells) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
+        block_did_become_empty(block);
+        return true;
+    }
+
+    if (block_was_full != block.is_full()) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", &block, block.cell_size());
+        block_did_become_usable(block);
+    }
+    return false;
+}
+
+void CellAllocator::block_did_become_empty(HeapBlock& block)
 {
     block.m_list_node.remove();
+    block.heap().will_destroy_heap_block({}, block);
     // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
     block.~HeapBlock();
     m_block_allocator.deallocate_block(&block);
 }
 
-void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
+void CellAllocator::block_did_become_usable(HeapBlock& block)
 {
     VERIFY(!block.is_full());
     m_usable_blocks.append(block);
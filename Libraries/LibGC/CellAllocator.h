@@ -44,17 +44,23 @@ public:
         return IterationDecision::Continue;
     }
 
-    void block_did_become_empty(Badge<Heap>, HeapBlock&);
-    void block_did_become_usable(Badge<Heap>, HeapBlock&);
+    void block_needs_sweep(Badge<Heap>, HeapBlock&);
+
+    // Sweeps every block that still has cells waiting to be destroyed, and returns how many blocks were released.
+    size_t sweep_pending_blocks(Badge<Heap>);
 
     IntrusiveListNode<CellAllocator> m_list_node;
     using List = IntrusiveList<&CellAllocator::m_list_node>;
 
     BlockAllocator& block_allocator() { return m_block_allocator; }
-    FlatPtr min_block_address() const { return m_min_block_address; }
-    FlatPtr max_block_address() const { return m_max_block_address; }
 
 private:
+    // Returns true if the block had no live cells left and was released.
+    bool sweep_block(HeapBlock&);
+
+    void block_did_become_empty(HeapBlock&);
+    void block_did_become_usable(HeapBlock&);
+
     char const* const m_class_name { nullptr };
     size_t const m_cell_size;
 
@@ -63,8 +69,7 @@ private:
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
-    FlatPtr m_min_block_address { explode_byte(0xff) };
-    FlatPtr m_max_block_address { 0 };
+    Vector<HeapBlock*> m_blocks_pending_sweep;
 };
 
 template<typename T>
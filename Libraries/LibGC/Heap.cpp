@@ -15,6 +15,7 @@
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Heap.h>
 #include <LibGC/HeapBlock.h>
@@ -26,20 +27,20 @@
 #    include <sanitizer/asan_interface.h>
 #endif
 
+#if !defined(AK_OS_WINDOWS)
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
 namespace GC {
 
 Heap::Heap(void* private_data, AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> gather_embedder_roots)
     : HeapBase(private_data)
     , m_gather_embedder_roots(move(gather_embedder_roots))
 {
-    static_assert(HeapBlock::min_possible_cell_size <= 32, "Heap Cell tracking uses too much data!");
-    m_size_based_cell_allocators.append(make<CellAllocator>(64));
-    m_size_based_cell_allocators.append(make<CellAllocator>(96));
-    m_size_based_cell_allocators.append(make<CellAllocator>(128));
-    m_size_based_cell_allocators.append(make<CellAllocator>(256));
-    m_size_based_cell_allocators.append(make<CellAllocator>(512));
-    m_size_based_cell_allocators.append(make<CellAllocator>(1024));
-    m_size_based_cell_allocators.append(make<CellAllocator>(3072));
+    static_assert(HeapBlock::min_possible_cell_size <= size_classes.first(), "Heap Cell tracking uses too much data!");
+    for (auto cell_size : size_classes)
+        m_size_based_cell_allocators.append(make<CellAllocator>(cell_size));
 }
 
 Heap::~Heap()
@@ -47,66 +48,219 @@ Heap::~Heap()
     collect_garbage(CollectionType::CollectEverything);
 }
 
+void Heap::set_marking_thread_count(size_t count)
+{
+#if defined(AK_OS_WINDOWS)
+    // FIXME: Support parallel marking on Windows.
+    count = 1;
+#endif
+    if (count == 0)
+        count = max(1u, Core::System::hardware_concurrency());
+    m_marking_thread_count = count;
+}
+
+void Heap::set_generational_collection_enabled(bool enabled)
+{
+    VERIFY(!m_collecting_garbage);
+    if (m_generational_collection_enabled == enabled)
+        return;
+    m_generational_collection_enabled = enabled;
+
+    if (enabled) {
+        // Everything that exists right now becomes part of the old generation.
+        for_each_block([&](auto& block) {
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                cell->set_marked(true);
+                if (!cell->has_write_barrier())
+                    m_old_cells_without_write_barrier.append(cell);
+            });
+            return IterationDecision::Continue;
+        });
+        m_promoted_bytes_since_last_full_gc = 0;
+        return;
+    }
+
+    clear_all_marks();
+    for (auto* cell : m_young_cells)
+        cell->set_young({}, false);
+    m_young_cells.clear();
+    m_old_cells_without_write_barrier.clear();
+    forget_remembered_cells();
+}
+
+void Heap::did_allocate_young_cell(Cell& cell, bool has_write_barrier)
+{
+    cell.set_young({}, true);
+    cell.set_has_write_barrier({}, has_write_barrier);
+    m_young_cells.append(&cell);
+}
+
+void Heap::remember_cell(Badge<Cell>, Cell& cell)
+{
+    if (!m_generational_collection_enabled)
+        return;
+    VERIFY(!cell.is_remembered());
+    cell.set_remembered({}, true);
+    m_remembered_cells.append(&cell);
+}
+
+void Heap::forget_remembered_cells()
+{
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered({}, false);
+    m_remembered_cells.clear();
+}
+
+void Heap::clear_all_marks()
+{
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+Heap::CollectionType Heap::collection_type_for_exhausted_budget() const
+{
+    // Once as much has been promoted as was alive after the last full collection, the old generation has
+    // likely accumulated enough garbage to be worth a full collection.
+    if (m_generational_collection_enabled && m_promoted_bytes_since_last_full_gc < m_gc_bytes_threshold)
+        return CollectionType::CollectYoungGeneration;
+    return CollectionType::CollectGarbage;
+}
+
 void Heap::will_allocate(size_t size)
 {
+    auto bytes_threshold = m_generational_collection_enabled ? GC_YOUNG_GENERATION_BYTES_THRESHOLD : m_gc_bytes_threshold;
+
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
-    } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
+    } else if (m_allocated_bytes_since_last_gc + size > bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(collection_type_for_exhausted_budget());
     }
 
     m_allocated_bytes_since_last_gc += size;
+    m_total_allocated_bytes += size;
 }
 
-static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+bool Heap::collect_garbage_if_idle(AK::Duration time_remaining)
 {
-    if constexpr (sizeof(FlatPtr*) == sizeof(NanBoxedValue)) {
-        // Because NanBoxedValue stores pointers in non-canonical form we have to check if the top bytes
-        // match any pointer-backed tag, in that case we have to extract the pointer to its
-        // canonical form and add that as a possible pointer.
-        FlatPtr possible_pointer;
-        if ((data & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN)
-            possible_pointer = NanBoxedValue::extract_pointer_bits(data);
-        else
-            possible_pointer = data;
-        if (possible_pointer < min_block_address || possible_pointer > max_block_address)
-            return;
-        possible_pointers.set(possible_pointer, move(origin));
-    } else {
-        static_assert((sizeof(NanBoxedValue) % sizeof(FlatPtr*)) == 0);
-        if (data < min_block_address || data > max_block_address)
-            return;
-        // In the 32-bit case we will look at the top and bottom part of NanBoxedValue separately we just
-        // add both the upper and lower bytes as possible pointers.
-        possible_pointers.set(data, move(origin));
-    }
+    if (m_collecting_garbage || m_gc_deferrals)
+        return false;
+
+    auto bytes_threshold = m_generational_collection_enabled ? GC_YOUNG_GENERATION_BYTES_THRESHOLD : m_gc_bytes_threshold;
+    if (m_allocated_bytes_since_last_gc < bytes_threshold * m_pacing_configuration.idle_collection_threshold_ratio)
+        return false;
+
+    auto collection_type = collection_type_for_exhausted_budget();
+    auto expected_duration = collection_type == CollectionType::CollectYoungGeneration
+        ? m_last_young_generation_collection_duration
+        : m_last_full_collection_duration;
+    if (expected_duration > time_remaining)
+        return false;
+
+    dbgln_if(HEAP_DEBUG, "collect_garbage_if_idle: {} bytes allocated, {} ms left", m_allocated_bytes_since_last_gc, time_remaining.to_milliseconds());
+
+    m_allocated_bytes_since_last_gc = 0;
+    ++m_idle_collection_count;
+    collect_garbage(collection_type);
+    return true;
 }
 
-void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address)
+void Heap::set_pacing_configuration(PacingConfiguration const& configuration)
 {
-    min_address = explode_byte(0xff);
-    max_address = 0;
-    for (auto& allocator : m_all_cell_allocators) {
-        min_address = min(min_address, allocator.min_block_address());
-        max_address = max(max_address, allocator.max_block_address() + HeapBlockBase::block_size);
-    }
+    VERIFY(configuration.min_bytes_threshold > 0);
+    VERIFY(configuration.min_bytes_threshold <= configuration.max_bytes_threshold);
+    m_pacing_configuration = configuration;
+    m_gc_bytes_threshold = clamp(m_gc_bytes_threshold, configuration.min_bytes_threshold, configuration.max_bytes_threshold);
 }
 
-template<typename Callback>
-static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& all_live_heap_blocks, HashMap<FlatPtr, HeapRoot>& possible_pointers, Callback callback)
+void Heap::update_gc_bytes_threshold(size_t live_cell_bytes, size_t collected_cell_bytes)
 {
-    for (auto possible_pointer : possible_pointers.keys()) {
-        if (!possible_pointer)
-            continue;
-        auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
-        if (!all_live_heap_blocks.contains(possible_heap_block))
+    auto now = MonotonicTime::now();
+    auto interval = now - m_last_full_gc_time;
+    auto allocated_bytes = m_total_allocated_bytes - m_total_allocated_bytes_at_last_full_gc;
+    m_last_full_gc_time = now;
+    m_total_allocated_bytes_at_last_full_gc = m_total_allocated_bytes;
+
+    if (auto interval_in_microseconds = interval.to_microseconds(); interval_in_microseconds > 0)
+        m_allocation_rate = static_cast<double>(allocated_bytes) * 1'000'000 / interval_in_microseconds;
+
+    auto examined_bytes = live_cell_bytes + collected_cell_bytes;
+    m_survival_ratio_of_last_full_gc = examined_bytes ? static_cast<double>(live_cell_bytes) / examined_bytes : 0;
+    m_live_bytes_after_last_full_gc = live_cell_bytes;
+    m_gc_bytes_threshold = bytes_threshold_after_full_collection(m_pacing_configuration, live_cell_bytes, collected_cell_bytes, interval);
+}
+
+size_t Heap::bytes_threshold_after_full_collection(PacingConfiguration const& configuration, size_t live_cell_bytes, size_t collected_cell_bytes, AK::Duration interval)
+{
+    auto examined_bytes = live_cell_bytes + collected_cell_bytes;
+    auto survival_ratio = examined_bytes ? static_cast<double>(live_cell_bytes) / examined_bytes : 0;
+
+    // When most of the heap survives, a collection doesn't free up much, so give the program more room before
+    // the next one. When almost everything dies, this degrades to allowing as much allocation as is live.
+    double growth_factor = 1.0 + survival_ratio;
+
+    // Collections that come too quickly mean the program allocates faster than the threshold anticipated.
+    // Stretch the threshold towards the target interval, but never more than double it at once.
+    auto target_interval = configuration.target_collection_interval;
+    if (interval < target_interval && interval.to_microseconds() > 0)
+        growth_factor *= min(2.0, static_cast<double>(target_interval.to_microseconds()) / interval.to_microseconds());
+
+    auto threshold = static_cast<double>(live_cell_bytes) * growth_factor;
+    if (threshold >= static_cast<double>(configuration.max_bytes_threshold))
+        return configuration.max_bytes_threshold;
+    return max(static_cast<size_t>(threshold), configuration.min_bytes_threshold);
+}
+
+void Heap::dump_allocation_statistics() const
+{
+    dbgln("Allocation statistics");
+    dbgln("=============================================");
+    if constexpr (!HEAP_DEBUG) {
+        dbgln("  Not available, allocations are only counted when HEAP_DEBUG is enabled.");
+        dbgln("=============================================");
+        return;
+    }
+    for (size_t i = 0; i < size_classes.size(); ++i) {
+        auto const& statistics = m_size_class_statistics[i];
+        if (!statistics.allocated_cells)
             continue;
-        if (auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer)) {
-            callback(cell, possible_pointer);
-        }
+        auto allocated_bytes = statistics.allocated_cells * size_classes[i];
+        size_t live_blocks = 0;
+        const_cast<CellAllocator&>(*m_size_based_cell_allocators[i]).for_each_block([&](auto&) {
+            ++live_blocks;
+            return IterationDecision::Continue;
+        });
+        dbgln("  {:>4} bytes: {} cells, {} bytes requested, {:.1}% wasted, {} live blocks",
+            size_classes[i], statistics.allocated_cells, statistics.requested_bytes,
+            100.0 * (allocated_bytes - statistics.requested_bytes) / allocated_bytes, live_blocks);
     }
+    dbgln("Requested cell sizes:");
+    for (size_t i = 0; i < m_allocation_size_histogram.size(); ++i) {
+        if (m_allocation_size_histogram[i])
+            dbgln("  {:>4} bytes: {} cells", i * size_class_granularity, m_allocation_size_histogram[i]);
+    }
+    dbgln("=============================================");
+}
+
+Heap::Statistics Heap::statistics() const
+{
+    return Statistics {
+        .full_collections = m_full_collection_count,
+        .young_generation_collections = m_young_generation_collection_count,
+        .idle_collections = m_idle_collection_count,
+        .bytes_threshold = m_gc_bytes_threshold,
+        .allocated_bytes_since_last_collection = m_allocated_bytes_since_last_gc,
+        .live_bytes_after_last_full_collection = m_live_bytes_after_last_full_gc,
+        .survival_ratio_of_last_full_collection = m_survival_ratio_of_last_full_gc,
+        .allocation_rate_in_bytes_per_second = m_allocation_rate,
+        .last_collection_duration = m_last_collection_duration,
+        .total_collection_duration = m_total_collection_duration,
+    };
 }
 
 class GraphConstructorVisitor final : public Cell::Visitor {
@@ -114,11 +268,6 @@ public:
     explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
         : m_heap(heap)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
         m_work_queue.ensure_capacity(roots.size());
 
         for (auto& [root, root_origin] : roots) {
@@ -143,13 +292,7 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
-
-        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
-        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
-
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        m_heap.m_block_map.for_each_cell_among_possible_values(bytes, [&](Cell* cell) {
             if (m_node_being_visited)
                 m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(cell));
 
@@ -223,9 +366,6 @@ private:
     HashMap<FlatPtr, GraphNode> m_graph;
 
     Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
 };
 
 AK::JsonObject Heap::dump_graph()
@@ -244,21 +384,51 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     {
         TemporaryChange change(m_collecting_garbage, true);
 
-        Core::ElapsedTimer collection_measurement_timer;
-        if (print_report)
-            collection_measurement_timer.start();
+        auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+        m_last_marking_statistics.clear();
 
-        if (collection_type == CollectionType::CollectGarbage) {
+        if (collection_type == CollectionType::CollectYoungGeneration && !m_generational_collection_enabled)
+            collection_type = CollectionType::CollectGarbage;
+
+        if (collection_type != CollectionType::CollectEverything) {
             if (m_gc_deferrals) {
                 m_should_gc_when_deferral_ends = true;
                 return;
             }
+
+            // Destroy whatever the previous collection left unswept, so that cells it doomed can't keep
+            // anything alive through roots they own.
+            sweep_pending_blocks();
+
+            // Old cells keep their mark bit between collections, so a full collection has to start from scratch.
+            if (collection_type == CollectionType::CollectGarbage && m_generational_collection_enabled)
+                clear_all_marks();
+
+            dbgln_if(HEAP_DEBUG, "collect_garbage: {}", collection_type == CollectionType::CollectYoungGeneration ? "young generation"sv : "full"sv);
+
             HashMap<Cell*, HeapRoot> roots;
             gather_roots(roots);
-            mark_live_cells(roots);
+            mark_live_cells(collection_type, roots);
+        } else if (m_generational_collection_enabled) {
+            clear_all_marks();
         }
-        finalize_unmarked_cells();
-        sweep_dead_cells(print_report, collection_measurement_timer);
+
+        if (collection_type == CollectionType::CollectYoungGeneration)
+            ++m_young_generation_collection_count;
+        else
+            ++m_full_collection_count;
+
+        forget_remembered_cells();
+        finalize_unmarked_cells(collection_type);
+        sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+
+        m_last_collection_duration = collection_measurement_timer.elapsed_time();
+        m_total_collection_duration += m_last_collection_duration;
+        if (collection_type == CollectionType::CollectYoungGeneration)
+            m_last_young_generation_collection_duration = m_last_collection_duration;
+        else
+            m_last_full_collection_duration = m_last_collection_duration;
     }
 
     auto tasks = move(m_post_gc_tasks);
@@ -292,8 +462,21 @@ void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
     }
 }
 
+ALWAYS_INLINE void Heap::add_possible_root(HashMap<Cell*, HeapRoot>& roots, FlatPtr data, HeapRoot::Type type)
+{
+    auto* cell = m_block_map.cell_from_possible_value(data);
+    if (!cell)
+        return;
+    if (cell->state() == Cell::State::Live) {
+        dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
+        roots.set(cell, HeapRoot { .type = type });
+    } else {
+        dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
+    }
+}
+
 #ifdef HAS_ADDRESS_SANITIZER
-NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr addr, FlatPtr min_block_address, FlatPtr max_block_address)
+NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<Cell*, HeapRoot>& roots, FlatPtr addr)
 {
     void* begin = nullptr;
     void* end = nullptr;
@@ -304,12 +487,12 @@ NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, Hea
             void const* real_address = *real_stack_addr;
             if (real_address == nullptr)
                 continue;
-            add_possible_value(possible_pointers, reinterpret_cast<FlatPtr>(real_address), HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
+            add_possible_root(roots, reinterpret_cast<FlatPtr>(real_address), HeapRoot::Type::StackPointer);
         }
     }
 }
 #else
-void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr, FlatPtr)
+void Heap::gather_asan_fake_stack_roots(HashMap<Cell*, HeapRoot>&, FlatPtr)
 {
 }
 #endif
@@ -323,44 +506,23 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     jmp_buf buf;
     setjmp(buf);
 
-    HashMap<FlatPtr, HeapRoot> possible_pointers;
-
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
-    FlatPtr min_block_address, max_block_address;
-    find_min_and_max_block_addresses(min_block_address, max_block_address);
-
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
-        add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, min_block_address, max_block_address);
+        add_possible_root(roots, raw_jmp_buf[i], HeapRoot::Type::RegisterPointer);
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
 
     for (FlatPtr stack_address = stack_reference; stack_address < m_stack_info.top(); stack_address += sizeof(FlatPtr)) {
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
-        gather_asan_fake_stack_roots(possible_pointers, data, min_block_address, max_block_address);
+        add_possible_root(roots, data, HeapRoot::Type::StackPointer);
+        gather_asan_fake_stack_roots(roots, data);
     }
 
     for (auto& vector : m_conservative_vectors) {
-        for (auto possible_value : vector.possible_values()) {
-            add_possible_value(possible_pointers, possible_value, HeapRoot { .type = HeapRoot::Type::ConservativeVector }, min_block_address, max_block_address);
-        }
+        for (auto possible_value : vector.possible_values())
+            add_possible_root(roots, possible_value, HeapRoot::Type::ConservativeVector);
     }
-
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
-        if (cell->state() == Cell::State::Live) {
-            dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
-            roots.set(cell, *possible_pointers.get(possible_pointer));
-        } else {
-            dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
-        }
-    });
 }
 
 class MarkingVisitor final : public Cell::Visitor {
@@ -368,11 +530,6 @@ public:
     explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
         : m_heap(heap)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
 
         for (auto* root : roots.keys()) {
             visit(root);
@@ -391,13 +548,7 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
-
-        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
-        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
-
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        m_heap.m_block_map.for_each_cell_among_possible_values(bytes, [&](Cell* cell) {
             if (cell->is_marked())
                 return;
             if (cell->state() != Cell::State::Live)
@@ -414,21 +565,280 @@ public:
         }
     }
 
+    Vector<Ref<Cell>> take_work_queue() { return move(m_work_queue); }
+
 private:
     Heap& m_heap;
     Vector<Ref<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+#if !defined(AK_OS_WINDOWS)
+
+class ParallelMarkingVisitor;
+
+// Traces the object graph on several threads at once. Every thread has a private mark stack, and publishes
+// part of it to its shared work queue whenever that queue has been drained. Threads that run out of work
+// steal half of another thread's shared queue. Marking is complete once every thread is idle.
+class ParallelMarker {
+    AK_MAKE_NONCOPYABLE(ParallelMarker);
+    AK_MAKE_NONMOVABLE(ParallelMarker);
+
+public:
+    ParallelMarker(size_t thread_count, HeapBlockMap const&);
+    ~ParallelMarker();
+
+    Vector<Heap::MarkingThreadStatistics> mark_all_live_cells(Vector<Ref<Cell>> initial_work);
+
+private:
+    friend class ParallelMarkingVisitor;
+
+    struct SharedWorkQueue {
+        void lock()
+        {
+            while (is_locked.exchange(true, AK::MemoryOrder::memory_order_acquire)) {
+                while (is_locked.load(AK::MemoryOrder::memory_order_relaxed))
+                    ;
+            }
+        }
+
+        void unlock() { is_locked.store(false, AK::MemoryOrder::memory_order_release); }
+
+        Atomic<bool> is_locked { false };
+        Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> size { 0 };
+        Vector<Ref<Cell>> cells;
+    };
+
+    bool has_shared_work() const
+    {
+        for (auto const& queue : m_shared_queues) {
+            if (queue->size != 0)
+                return true;
+        }
+        return false;
+    }
+
+    HeapBlockMap const& m_block_map;
+
+    Vector<NonnullOwnPtr<SharedWorkQueue>> m_shared_queues;
+    Vector<NonnullOwnPtr<ParallelMarkingVisitor>> m_visitors;
+    Atomic<size_t> m_active_threads { 0 };
+};
+
+class ParallelMarkingVisitor final : public Cell::Visitor {
+public:
+    ParallelMarkingVisitor(ParallelMarker& marker, size_t index)
+        : m_marker(marker)
+        , m_index(index)
+    {
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (!cell.try_set_marked())
+            return;
+        dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
+
+        m_work_stack.append(cell);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        m_marker.m_block_map.for_each_cell_among_possible_values(bytes, [&](Cell* cell) {
+            if (cell->state() != Cell::State::Live)
+                return;
+            if (!cell->try_set_marked())
+                return;
+            m_work_stack.append(*cell);
+        });
+    }
+
+    void run()
+    {
+        for (;;) {
+            while (!m_work_stack.is_empty()) {
+                auto cell = m_work_stack.take_last();
+                ++m_statistics.marked_cells;
+                cell->visit_edges(*this);
+                share_work_if_needed();
+            }
+
+            if (take_work())
+                continue;
+
+            // We're out of work. Stay idle until someone publishes more, or until every thread is idle,
+            // at which point no more work can appear and marking is complete.
+            m_marker.m_active_threads.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel);
+            for (;;) {
+                if (m_marker.has_shared_work()) {
+                    m_marker.m_active_threads.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel);
+                    if (take_work())
+                        break;
+                    m_marker.m_active_threads.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel);
+                }
+                if (m_marker.m_active_threads.load(AK::MemoryOrder::memory_order_acquire) == 0)
+                    return;
+                sched_yield();
+            }
+        }
+    }
+
+    Heap::MarkingThreadStatistics const& statistics() const { return m_statistics; }
+
+private:
+    static constexpr size_t min_cells_to_share = 64;
+
+    void share_work_if_needed()
+    {
+        if (m_work_stack.size() < min_cells_to_share)
+            return;
+
+        // Only publish more work once the previous batch has been picked up by someone.
+        auto& queue = *m_marker.m_shared_queues[m_index];
+        if (queue.size != 0)
+            return;
+
+        // Hand out the oldest half of our stack; those cells tend to lead to the largest unexplored subgraphs.
+        auto count = m_work_stack.size() / 2;
+        queue.lock();
+        queue.cells.append(m_work_stack.data(), count);
+        queue.size = queue.cells.size();
+        queue.unlock();
+        m_work_stack.remove(0, count);
+
+        ++m_statistics.shared_batches;
+    }
+
+    bool take_work()
+    {
+        auto& queues = m_marker.m_shared_queues;
+        for (size_t i = 0; i < queues.size(); ++i) {
+            auto queue_index = (m_index + i) % queues.size();
+            auto& queue = *queues[queue_index];
+            if (queue.size == 0)
+                continue;
+
+            bool is_steal = queue_index != m_index;
+            if (is_steal)
+                ++m_statistics.steal_attempts;
+
+            queue.lock();
+            auto available = queue.cells.size();
+            if (available == 0) {
+                // Someone else got here first.
+                queue.unlock();
+                continue;
+            }
+            // We take everything from our own queue, but leave half of someone else's queue to the others.
+            auto count = is_steal ? max<size_t>(1, available / 2) : available;
+            for (size_t j = 0; j < count; ++j)
+                m_work_stack.append(queue.cells.take_last());
+            queue.size = queue.cells.size();
+            queue.unlock();
+
+            if (is_steal) {
+                ++m_statistics.successful_steals;
+                m_statistics.stolen_cells += count;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    ParallelMarker& m_marker;
+    size_t m_index { 0 };
+    Vector<Ref<Cell>> m_work_stack;
+    Heap::MarkingThreadStatistics m_statistics;
+};
+
+ParallelMarker::ParallelMarker(size_t thread_count, HeapBlockMap const& block_map)
+    : m_block_map(block_map)
+{
+    VERIFY(thread_count > 0);
+    for (size_t i = 0; i < thread_count; ++i) {
+        m_shared_queues.append(make<SharedWorkQueue>());
+        m_visitors.append(make<ParallelMarkingVisitor>(*this, i));
+    }
+}
+
+ParallelMarker::~ParallelMarker() = default;
+
+Vector<Heap::MarkingThreadStatistics> ParallelMarker::mark_all_live_cells(Vector<Ref<Cell>> initial_work)
+{
+    // Deal the roots out round-robin so that every thread has something to trace right away.
+    for (size_t i = 0; i < initial_work.size(); ++i)
+        m_shared_queues[i % m_shared_queues.size()]->cells.append(initial_work[i]);
+    for (auto& queue : m_shared_queues)
+        queue->size = queue->cells.size();
+
+    m_active_threads = m_visitors.size();
+
+    Vector<pthread_t> helper_threads;
+    for (size_t i = 1; i < m_visitors.size(); ++i) {
+        pthread_t thread;
+        auto rc = pthread_create(
+            &thread, nullptr, [](void* visitor) -> void* {
+                static_cast<ParallelMarkingVisitor*>(visitor)->run();
+                return nullptr;
+            },
+            m_visitors[i].ptr());
+        if (rc != 0) {
+            // The remaining threads will steal this thread's share of the roots.
+            dbgln("Failed to create GC marking thread: {}", strerror(rc));
+            m_active_threads.fetch_sub(1);
+            continue;
+        }
+        helper_threads.append(thread);
+    }
+
+    // The collecting thread takes part in marking as well.
+    m_visitors[0]->run();
+
+    for (auto thread : helper_threads)
+        pthread_join(thread, nullptr);
+
+    Vector<Heap::MarkingThreadStatistics> statistics;
+    for (auto& visitor : m_visitors)
+        statistics.append(visitor->statistics());
+    return statistics;
+}
+
+#endif
+
+void Heap::mark_live_cells(CollectionType collection_type, HashMap<Cell*, HeapRoot> const& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
     MarkingVisitor visitor(*this, roots);
 
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        // Old cells are already marked, so tracing stops at them. Anything young they point to has to be reached
+        // through them directly: via the remembered set for cells with a write barrier, and by re-scanning every
+        // old cell without one. All other old cells are skipped.
+        for (auto* cell : m_remembered_cells)
+            cell->visit_edges(visitor);
+        for (auto* cell : m_old_cells_without_write_barrier)
+            cell->visit_edges(visitor);
+    }
+
+#if !defined(AK_OS_WINDOWS)
+    if (m_marking_thread_count > 1) {
+        ParallelMarker marker(m_marking_thread_count, m_block_map);
+        m_last_marking_statistics = marker.mark_all_live_cells(visitor.take_work_queue());
+    } else {
+        visitor.mark_all_live_cells();
+    }
+#else
     visitor.mark_all_live_cells();
+#endif
+
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        // NOTE: Uprooted cells are left for the next full collection, as only that one can collect old cells.
+        for (auto* cell : m_young_cells) {
+            if (!cell->is_marked() && cell_must_survive_garbage_collection(*cell))
+                cell->visit_edges(visitor);
+        }
+        return;
+    }
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
@@ -451,8 +861,22 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
     return cell.must_survive_garbage_collection();
 }
 
-void Heap::finalize_unmarked_cells()
+void Heap::finalize_unmarked_cells(CollectionType collection_type)
 {
+    // NOTE: Dead cells stay in place until their blocks get swept, so AK::WeakPtrs to them would keep pointing at them
+    //       well past the collection. We revoke those once every cell has been finalized, as finalizers may still use them.
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        for (auto* cell : m_young_cells) {
+            if (!cell->is_marked())
+                cell->finalize();
+        }
+        for (auto* cell : m_young_cells) {
+            if (!cell->is_marked())
+                cell->revoke_weak_ptrs_before_sweep();
+        }
+        return;
+    }
+
     for_each_block([&](auto& block) {
         block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
             if (!cell->is_marked())
@@ -460,53 +884,95 @@ void Heap::finalize_unmarked_cells()
         });
         return IterationDecision::Continue;
     });
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            if (!cell->is_marked())
+                cell->revoke_weak_ptrs_before_sweep();
+        });
+        return IterationDecision::Continue;
+    });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
 
     size_t collected_cells = 0;
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t blocks_pending_sweep = 0;
 
-    for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+    // NOTE: With generational collection, survivors keep their mark bit. That's what makes them old.
+    auto did_survive = [&](Cell& cell) {
+        if (!m_generational_collection_enabled) {
+            cell.set_marked(false);
+            return;
+        }
+        cell.set_young({}, false);
+        if (!cell.has_write_barrier())
+            m_old_cells_without_write_barrier.append(&cell);
+    };
+    // A full collection finds every surviving cell again, including the old ones.
+    if (collection_type != CollectionType::CollectYoungGeneration)
+        m_old_cells_without_write_barrier.clear_with_capacity();
+
+    // NOTE: We don't destroy dead cells here. They are only flagged, and their blocks are queued up with their
+    //       allocator, which sweeps them on demand when it runs out of free cells. This keeps the cost of running
+    //       destructors out of the collection pause.
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        for (auto* cell : m_young_cells) {
+            auto& block = *HeapBlock::from_cell(cell);
             if (!cell->is_marked()) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
+                cell->set_state(Cell::State::PendingSweep);
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
+                if (!block.is_pending_sweep()) {
+                    block.cell_allocator().block_needs_sweep({}, block);
+                    ++blocks_pending_sweep;
+                }
             } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
+                did_survive(*cell);
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
+        }
+        m_promoted_bytes_since_last_full_gc += live_cell_bytes;
+    } else {
+        for_each_block([&](auto& block) {
+            bool block_has_live_cells = false;
+            bool block_has_dead_cells = false;
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                if (!cell->is_marked()) {
+                    cell->set_state(Cell::State::PendingSweep);
+                    block_has_dead_cells = true;
+                    ++collected_cells;
+                    collected_cell_bytes += block.cell_size();
+                } else {
+                    did_survive(*cell);
+                    block_has_live_cells = true;
+                    ++live_cells;
+                    live_cell_bytes += block.cell_size();
+                }
+            });
+            if ((block_has_dead_cells || !block_has_live_cells) && !block.is_pending_sweep()) {
+                block.cell_allocator().block_needs_sweep({}, block);
+                ++blocks_pending_sweep;
+            }
+            return IterationDecision::Continue;
         });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
+        m_promoted_bytes_since_last_full_gc = 0;
+    }
+    m_young_cells.clear();
 
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_empty({}, *block);
-    }
-
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_usable({}, *block);
+    // When tearing down the heap, everything has to be destroyed right away.
+    size_t freed_blocks = 0;
+    if (collection_type == CollectionType::CollectEverything) {
+        freed_blocks = sweep_pending_blocks();
+        blocks_pending_sweep = 0;
     }
 
     if constexpr (HEAP_DEBUG) {
@@ -516,7 +982,8 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    if (collection_type != CollectionType::CollectYoungGeneration)
+        update_gc_bytes_threshold(live_cell_bytes, collected_cell_bytes);
 
     if (print_report) {
         AK::Duration const time_spent = measurement_timer.elapsed_time();
@@ -528,15 +995,41 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
         dbgln("Garbage collection report");
         dbgln("=============================================");
+        if (m_generational_collection_enabled) {
+            dbgln("     Collection: {} ({} young generation, {} full so far)",
+                collection_type == CollectionType::CollectYoungGeneration ? "young generation"sv : "full"sv,
+                m_young_generation_collection_count, m_full_collection_count);
+        }
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
+        if (collection_type == CollectionType::CollectYoungGeneration)
+            dbgln(" Promoted cells: {} ({} bytes)", live_cells, live_cell_bytes);
+        else
+            dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("   Freed blocks: {} ({} bytes)", freed_blocks, freed_blocks * HeapBlock::block_size);
+        dbgln(" Pending sweeps: {} blocks", blocks_pending_sweep);
+        dbgln("  Next GC after: {} bytes allocated (survival {:.2}, {} bytes/s)", m_gc_bytes_threshold, m_survival_ratio_of_last_full_gc, static_cast<u64>(m_allocation_rate));
+        if (!m_last_marking_statistics.is_empty()) {
+            dbgln("Marking threads: {}", m_last_marking_statistics.size());
+            for (size_t i = 0; i < m_last_marking_statistics.size(); ++i) {
+                auto const& statistics = m_last_marking_statistics[i];
+                dbgln("      Thread #{}: {} cells marked, {} batches shared, {}/{} steals ({} cells stolen)",
+                    i, statistics.marked_cells, statistics.shared_batches, statistics.successful_steals, statistics.steal_attempts, statistics.stolen_cells);
+            }
+        }
         dbgln("=============================================");
     }
 }
 
+size_t Heap::sweep_pending_blocks()
+{
+    size_t freed_blocks = 0;
+    for (auto& allocator : m_all_cell_allocators)
+        freed_blocks += allocator.sweep_pending_blocks({});
+    return freed_blocks;
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
@@ -14,6 +16,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -21,6 +24,7 @@
 #include <LibGC/CellAllocator.h>
 #include <LibGC/ConservativeVector.h>
 #include <LibGC/Forward.h>
+#include <LibGC/HeapBlockMap.h>
 #include <LibGC/HeapRoot.h>
 #include <LibGC/Internals.h>
 #include <LibGC/Root.h>
@@ -43,22 +47,115 @@ public:
     {
         auto* memory = allocate_cell<T>();
         defer_gc();
-        new (memory) T(forward<Args>(args)...);
+        auto* cell = new (memory) T(forward<Args>(args)...);
+        if (m_generational_collection_enabled)
+            did_allocate_young_cell(*cell, cell_type_has_write_barrier<T>());
         undefer_gc();
-        return *static_cast<T*>(memory);
+        return *cell;
     }
 
     enum class CollectionType {
         CollectGarbage,
+        CollectYoungGeneration,
         CollectEverything,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     AK::JsonObject dump_graph();
 
+    // Streams the object graph to the given stream in the Chrome DevTools .heapsnapshot format. Unlike dump_graph(),
+    // this doesn't build the graph in memory first, so it's suitable for very large heaps.
+    ErrorOr<void> write_heap_snapshot(Stream&);
+
+    struct TypeStatistics {
+        StringView class_name;
+        size_t live_cells { 0 };
+        size_t live_bytes { 0 };
+    };
+
+    // Returns the number of live cells and the bytes they occupy per cell type, largest first.
+    Vector<TypeStatistics> live_cell_statistics_by_type();
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // Number of threads that trace the object graph during marking. With 1 (the default), marking happens
+    // serially on the collecting thread. Pass 0 to use one thread per available CPU core.
+    // NOTE: With more than one thread, Cell::visit_edges() runs concurrently for different cells. It must only read
+    //       the cell and whatever it owns, and pass what it finds to the visitor. It must not allocate, take or drop
+    //       references to ref-counted objects (which aren't thread-safe), or fill in caches lazily. The mutator is
+    //       paused during marking, so nothing else changes the object graph meanwhile.
+    size_t marking_thread_count() const { return m_marking_thread_count; }
+    void set_marking_thread_count(size_t);
+
+    // With generational collection, the heap is split into cells allocated since the last collection (the young
+    // generation) and cells that survived one (the old generation). Most collections then only trace young cells,
+    // starting from the roots and from old cells that may point to young ones.
+    bool generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool);
+
+    void remember_cell(Badge<Cell>, Cell&);
+
+    // After every full collection, the number of bytes that may be allocated before the next one is derived from
+    // the amount of live memory, the fraction of the heap that survived, and how quickly collections have been
+    // happening. The result is clamped to [min_bytes_threshold, max_bytes_threshold].
+    struct PacingConfiguration {
+        size_t min_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
+        size_t max_bytes_threshold { GC_MAX_BYTES_THRESHOLD };
+        // Full collections that come closer together than this let the threshold grow faster.
+        AK::Duration target_collection_interval { AK::Duration::from_milliseconds(100) };
+        // Idle time is only used for collection once this fraction of the threshold has been allocated.
+        double idle_collection_threshold_ratio { 0.5 };
+    };
+
+    PacingConfiguration const& pacing_configuration() const { return m_pacing_configuration; }
+    void set_pacing_configuration(PacingConfiguration const&);
+
+    // Returns the number of bytes that may be allocated after a full collection, before the next one is due.
+    // The interval is the time since the previous full collection.
+    static size_t bytes_threshold_after_full_collection(PacingConfiguration const&, size_t live_cell_bytes, size_t collected_cell_bytes, AK::Duration interval);
+
+    // Lets the embedder hand over idle time. Collects garbage if enough has been allocated to make it worthwhile,
+    // and the last collection of the same kind took less than time_remaining. Returns true if it collected.
+    bool collect_garbage_if_idle(AK::Duration time_remaining);
+
+    struct Statistics {
+        size_t full_collections { 0 };
+        size_t young_generation_collections { 0 };
+        size_t idle_collections { 0 };
+        size_t bytes_threshold { 0 };
+        size_t allocated_bytes_since_last_collection { 0 };
+        size_t live_bytes_after_last_full_collection { 0 };
+        double survival_ratio_of_last_full_collection { 0 };
+        double allocation_rate_in_bytes_per_second { 0 };
+        AK::Duration last_collection_duration;
+        AK::Duration total_collection_duration;
+    };
+
+    Statistics statistics() const;
+
+    // Returns the size of the cells that cells of the given size are allocated in, unless their type has an allocator
+    // of its own.
+    static constexpr size_t size_class_for_cell_size(size_t cell_size)
+    {
+        VERIFY(cell_size <= size_classes.last());
+        return size_classes[size_class_lookup_table[size_class_lookup_index(cell_size)]];
+    }
+
+    static constexpr size_t largest_size_class() { return size_classes.last(); }
+
+    // Prints, for every size class, how many cells were allocated from it and how much of them went unused,
+    // followed by a histogram of the requested cell sizes. Allocations are only counted when HEAP_DEBUG is enabled.
+    void dump_allocation_statistics() const;
+
+    struct MarkingThreadStatistics {
+        size_t marked_cells { 0 };
+        size_t shared_batches { 0 };
+        size_t steal_attempts { 0 };
+        size_t successful_steals { 0 };
+        size_t stolen_cells { 0 };
+    };
+
     void did_create_root(Badge<RootImpl>, RootImpl&);
     void did_destroy_root(Badge<RootImpl>, RootImpl&);
 
@@ -76,6 +173,9 @@ public:
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
 
+    void did_create_heap_block(Badge<CellAllocator>, HeapBlock& block) { m_block_map.add(block); }
+    void will_destroy_heap_block(Badge<CellAllocator>, HeapBlock& block) { m_block_map.remove(block); }
+
     void uproot_cell(Cell* cell);
 
     bool is_gc_deferred() const { return m_gc_deferrals > 0; }
@@ -84,7 +184,9 @@ public:
 
 private:
     friend class MarkingVisitor;
+    friend class ParallelMarker;
     friend class GraphConstructorVisitor;
+    friend class HeapSnapshotWriter;
     friend class DeferGC;
     friend class ForeignCell;
 
@@ -97,33 +199,68 @@ private:
     Cell* allocate_cell()
     {
         will_allocate(sizeof(T));
-        if constexpr (requires { T::cell_allocator.allocator.get().allocate_cell(*this); }) {
-            if constexpr (IsSame<T, typename decltype(T::cell_allocator)::CellType>) {
-                return T::cell_allocator.allocator.get().allocate_cell(*this);
-            }
+        if constexpr (cell_type_has_isolated_allocator<T>()) {
+            return T::cell_allocator.allocator.get().allocate_cell(*this);
+        } else {
+            static_assert(sizeof(T) <= size_classes.last(), "Cell type is too large for any size class");
+            constexpr auto size_class = size_class_lookup_table[size_class_lookup_index(sizeof(T))];
+            record_allocation(size_class, sizeof(T));
+            return m_size_based_cell_allocators[size_class]->allocate_cell(*this);
         }
-        return allocator_for_size(sizeof(T)).allocate_cell(*this);
+    }
+
+    template<typename T>
+    static constexpr bool cell_type_has_isolated_allocator()
+    {
+        if constexpr (requires(Heap& heap) { T::cell_allocator.allocator.get().allocate_cell(heap); })
+            return IsSame<T, typename decltype(T::cell_allocator)::CellType>;
+        return false;
     }
 
     void will_allocate(size_t);
+    CollectionType collection_type_for_exhausted_budget() const;
+    void update_gc_bytes_threshold(size_t live_cell_bytes, size_t collected_cell_bytes);
+
+    template<typename T>
+    static constexpr bool cell_type_has_write_barrier()
+    {
+        if constexpr (requires { typename T::WriteBarrierCellType; })
+            return IsSame<T, typename T::WriteBarrierCellType>;
+        return false;
+    }
+
+    void did_allocate_young_cell(Cell&, bool has_write_barrier);
+    void clear_all_marks();
+    void forget_remembered_cells();
 
-    void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
-    void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void gather_asan_fake_stack_roots(HashMap<Cell*, HeapRoot>&, FlatPtr);
+    void add_possible_root(HashMap<Cell*, HeapRoot>&, FlatPtr data, HeapRoot::Type);
+    void mark_live_cells(CollectionType, HashMap<Cell*, HeapRoot> const& live_cells);
+    void finalize_unmarked_cells(CollectionType);
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
+    size_t sweep_pending_blocks();
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
-        // FIXME: Use binary search?
-        for (auto& allocator : m_size_based_cell_allocators) {
-            if (allocator->cell_size() >= cell_size)
-                return *allocator;
+        if (cell_size > size_classes.last()) {
+            dbgln("Cannot get CellAllocator for cell size {}, largest available is {}!", cell_size, size_classes.last());
+            VERIFY_NOT_REACHED();
         }
-        dbgln("Cannot get CellAllocator for cell size {}, largest available is {}!", cell_size, m_size_based_cell_allocators.last()->cell_size());
-        VERIFY_NOT_REACHED();
+        auto size_class = size_class_lookup_table[size_class_lookup_index(cell_size)];
+        record_allocation(size_class, cell_size);
+        return *m_size_based_cell_allocators[size_class];
+    }
+
+    ALWAYS_INLINE void record_allocation(size_t size_class, size_t cell_size)
+    {
+        // NOTE: This is on the path of every allocation, so only keep count in debug builds.
+        if constexpr (!HEAP_DEBUG)
+            return;
+        ++m_size_class_statistics[size_class].allocated_cells;
+        m_size_class_statistics[size_class].requested_bytes += cell_size;
+        ++m_allocation_size_histogram[size_class_lookup_index(cell_size)];
     }
 
     template<typename Callback>
@@ -135,15 +272,74 @@ private:
         }
     }
 
+    // Cell sizes served by the size-based allocators. They are all multiples of 16, so that every cell stays
+    // aligned to __BIGGEST_ALIGNMENT__. From 128 to 1536 bytes, they are spaced so that no more than ~20% of a
+    // cell is wasted on padding.
+    static constexpr Array size_classes {
+        32uz, 48uz, 64uz, 80uz, 96uz, 112uz, 128uz, 160uz, 192uz, 224uz, 256uz, 320uz,
+        384uz, 448uz, 512uz, 640uz, 768uz, 896uz, 1024uz, 1280uz, 1536uz, 2048uz, 3072uz
+    };
+    static constexpr size_t size_class_granularity = 16;
+
+    static constexpr size_t size_class_lookup_index(size_t cell_size) { return (cell_size + size_class_granularity - 1) / size_class_granularity; }
+
+    // Maps size_class_lookup_index(size) to the index of the smallest size class that fits the size.
+    static constexpr auto size_class_lookup_table = [] {
+        Array<u8, size_classes.last() / size_class_granularity + 1> table {};
+        size_t size_class = 0;
+        for (size_t i = 0; i < table.size(); ++i) {
+            while (size_classes[size_class] < i * size_class_granularity)
+                ++size_class;
+            table[i] = size_class;
+        }
+        return table;
+    }();
+
+    struct SizeClassStatistics {
+        u64 allocated_cells { 0 };
+        u64 requested_bytes { 0 };
+    };
+    Array<SizeClassStatistics, size_classes.size()> m_size_class_statistics {};
+    Array<u64, size_class_lookup_table.size()> m_allocation_size_histogram {};
+
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    static constexpr size_t GC_MAX_BYTES_THRESHOLD { 1024 * 1024 * 1024 };
+    PacingConfiguration m_pacing_configuration;
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
+    u64 m_total_allocated_bytes { 0 };
+    u64 m_total_allocated_bytes_at_last_full_gc { 0 };
+    MonotonicTime m_last_full_gc_time { MonotonicTime::now() };
+    size_t m_live_bytes_after_last_full_gc { 0 };
+    double m_survival_ratio_of_last_full_gc { 0 };
+    double m_allocation_rate { 0 };
+    size_t m_idle_collection_count { 0 };
+    AK::Duration m_last_full_collection_duration;
+    AK::Duration m_last_young_generation_collection_duration;
+    AK::Duration m_last_collection_duration;
+    AK::Duration m_total_collection_duration;
+
+    static constexpr size_t GC_YOUNG_GENERATION_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    bool m_generational_collection_enabled { false };
+    size_t m_promoted_bytes_since_last_full_gc { 0 };
+    size_t m_young_generation_collection_count { 0 };
+    size_t m_full_collection_count { 0 };
+    Vector<Cell*> m_young_cells;
+    Vector<Cell*> m_remembered_cells;
+    // Old cells whose class has no write barrier. Stores into them can't be seen, so young collections trace them all.
+    Vector<Cell*> m_old_cells_without_write_barrier;
 
     bool m_should_collect_on_every_allocation { false };
 
+    size_t m_marking_thread_count { 1 };
+    Vector<MarkingThreadStatistics> m_last_marking_statistics;
+
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
 
+    // Every HeapBlock currently owned by this heap, used to validate possible pointers during conservative scanning.
+    HeapBlockMap m_block_map;
+
     RootImpl::List m_roots;
     RootVectorBase::List m_root_vectors;
     RootHashMapBase::List m_root_hash_maps;
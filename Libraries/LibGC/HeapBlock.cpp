@@ -41,7 +41,7 @@ void HeapBlock::deallocate(Cell* cell)
 {
     VERIFY(is_valid_cell_pointer(cell));
     VERIFY(!m_freelist || is_valid_cell_pointer(m_freelist));
-    VERIFY(cell->state() == Cell::State::Live);
+    VERIFY(cell->state() == Cell::State::PendingSweep);
     VERIFY(!cell->is_marked());
 
     cell->~Cell();
@@ -83,11 +83,19 @@ public:
         return cell(cell_index);
     }
 
+    size_t cell_index(Cell const* cell) const
+    {
+        return (reinterpret_cast<FlatPtr>(cell) - reinterpret_cast<FlatPtr>(m_storage)) / m_cell_size;
+    }
+
     bool is_valid_cell_pointer(Cell const* cell)
     {
         return cell_from_possible_pointer((FlatPtr)cell);
     }
 
+    bool is_pending_sweep() const { return m_pending_sweep; }
+    void set_pending_sweep(bool b) { m_pending_sweep = b; }
+
     IntrusiveListNode<HeapBlock> m_list_node;
 
     CellAllocator& cell_allocator() { return m_cell_allocator; }
@@ -111,6 +119,7 @@ private:
     CellAllocator& m_cell_allocator;
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
+    bool m_pending_sweep { false };
     Ptr<FreelistEntry> m_freelist;
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <LibGC/HeapBlock.h>
+#include <LibGC/HeapBlockMap.h>
+
+namespace GC {
+
+HeapBlockMap::HeapBlockMap()
+    : m_block_shift(count_trailing_zeroes(HeapBlock::block_size))
+{
+    VERIFY(is_power_of_two(HeapBlock::block_size));
+}
+
+HeapBlockMap::~HeapBlockMap() = default;
+
+u64 HeapBlockMap::block_number(HeapBlock const& block) const
+{
+    u64 block_number = static_cast<u64>(reinterpret_cast<FlatPtr>(&block)) >> m_block_shift;
+    VERIFY(!(block_number >> (bits_per_level * 3)));
+    return block_number;
+}
+
+void HeapBlockMap::add(HeapBlock const& block)
+{
+    auto number = block_number(block);
+
+    auto& middle = m_root[(number >> (bits_per_level * 2)) & level_mask];
+    if (!middle)
+        middle = make<Middle>();
+
+    auto& leaf = middle->leaves[(number >> bits_per_level) & level_mask];
+    if (!leaf) {
+        leaf = make<Leaf>();
+        ++middle->leaf_count;
+    }
+
+    auto leaf_index = number & level_mask;
+    auto& word = leaf->bits[leaf_index / 64];
+    auto bit = 1ull << (leaf_index % 64);
+    VERIFY(!(word & bit));
+    word |= bit;
+    ++leaf->block_count;
+    ++m_block_count;
+
+    auto address = reinterpret_cast<FlatPtr>(&block);
+    m_min_block_address = min(m_min_block_address, address);
+    m_max_block_end = max(m_max_block_end, address + HeapBlock::block_size);
+}
+
+void HeapBlockMap::remove(HeapBlock const& block)
+{
+    auto number = block_number(block);
+
+    auto& middle = m_root[(number >> (bits_per_level * 2)) & level_mask];
+    VERIFY(middle);
+    auto& leaf = middle->leaves[(number >> bits_per_level) & level_mask];
+    VERIFY(leaf);
+
+    auto leaf_index = number & level_mask;
+    auto& word = leaf->bits[leaf_index / 64];
+    auto bit = 1ull << (leaf_index % 64);
+    VERIFY(word & bit);
+    word &= ~bit;
+    --m_block_count;
+
+    if (--leaf->block_count == 0) {
+        leaf = nullptr;
+        if (--middle->leaf_count == 0)
+            middle = nullptr;
+    }
+}
+
+}
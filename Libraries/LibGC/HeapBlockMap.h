@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <LibGC/Forward.h>
+#include <LibGC/HeapBlock.h>
+#include <LibGC/NanBoxedValue.h>
+
+namespace GC {
+
+// Keeps track of the address ranges covered by a heap's HeapBlocks, so that conservative scanning can tell whether
+// an arbitrary word points into the heap without building any lookup tables during a collection.
+// Blocks are identified by their block number (address / HeapBlock::block_size), which is split into three
+// 12-bit indices into a sparse radix tree. The leaves are bitmaps with one bit per block.
+class HeapBlockMap {
+    AK_MAKE_NONCOPYABLE(HeapBlockMap);
+    AK_MAKE_NONMOVABLE(HeapBlockMap);
+
+public:
+    HeapBlockMap();
+    ~HeapBlockMap();
+
+    void add(HeapBlock const&);
+    void remove(HeapBlock const&);
+
+    size_t block_count() const { return m_block_count; }
+
+    // Returns true if the address lies inside one of the blocks in this map.
+    ALWAYS_INLINE bool contains(FlatPtr address) const
+    {
+        if (address < m_min_block_address || address >= m_max_block_end)
+            return false;
+
+        u64 block_number = static_cast<u64>(address) >> m_block_shift;
+        if (block_number >> (bits_per_level * 3))
+            return false;
+
+        auto const& middle = m_root[(block_number >> (bits_per_level * 2)) & level_mask];
+        if (!middle)
+            return false;
+        auto const& leaf = middle->leaves[(block_number >> bits_per_level) & level_mask];
+        if (!leaf)
+            return false;
+        auto leaf_index = block_number & level_mask;
+        return leaf->bits[leaf_index / 64] & (1ull << (leaf_index % 64));
+    }
+
+    // Returns the cell that a word found during conservative scanning may be pointing to, if any.
+    ALWAYS_INLINE Cell* cell_from_possible_value(FlatPtr data) const
+    {
+        FlatPtr possible_pointer = data;
+        if constexpr (sizeof(FlatPtr*) == sizeof(NanBoxedValue)) {
+            // Because NanBoxedValue stores pointers in non-canonical form we have to check if the top bytes
+            // match any pointer-backed tag, in that case we have to extract the pointer to its
+            // canonical form and add that as a possible pointer.
+            if ((data & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN)
+                possible_pointer = NanBoxedValue::extract_pointer_bits(data);
+        } else {
+            // In the 32-bit case we will look at the top and bottom part of NanBoxedValue separately we just
+            // add both the upper and lower bytes as possible pointers.
+            static_assert((sizeof(NanBoxedValue) % sizeof(FlatPtr*)) == 0);
+        }
+        if (!possible_pointer || !contains(possible_pointer))
+            return nullptr;
+        auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
+        return possible_heap_block->cell_from_possible_pointer(possible_pointer);
+    }
+
+    template<typename Callback>
+    void for_each_cell_among_possible_values(ReadonlyBytes bytes, Callback callback) const
+    {
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i) {
+            if (auto* cell = cell_from_possible_value(raw_pointer_sized_values[i]))
+                callback(cell);
+        }
+    }
+
+private:
+    static constexpr size_t bits_per_level = 12;
+    static constexpr size_t entries_per_level = 1 << bits_per_level;
+    static constexpr u64 level_mask = entries_per_level - 1;
+
+    struct Leaf {
+        Array<u64, entries_per_level / 64> bits {};
+        size_t block_count { 0 };
+    };
+
+    struct Middle {
+        Array<OwnPtr<Leaf>, entries_per_level> leaves;
+        size_t leaf_count { 0 };
+    };
+
+    u64 block_number(HeapBlock const&) const;
+
+    Array<OwnPtr<Middle>, entries_per_level> m_root;
+    size_t m_block_count { 0 };
+    size_t m_block_shift { 0 };
+
+    // NOTE: These only ever grow, as they're just a cheap filter in front of the tree.
+    FlatPtr m_min_block_address { explode_byte(0xff) };
+    FlatPtr m_max_block_end { 0 };
+};
+
+}
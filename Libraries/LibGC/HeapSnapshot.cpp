@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/QuickSort.h>
+#include <AK/Stream.h>
+#include <AK/StringBuilder.h>
+#include <LibGC/DeferGC.h>
+#include <LibGC/Heap.h>
+#include <LibGC/HeapBlock.h>
+
+namespace GC {
+
+// Writes a heap snapshot in the format understood by the Chrome DevTools memory panel:
+// https://learn.microsoft.com/en-us/microsoft-edge/devtools-guide-chromium/memory-problems/heap-snapshot-schema
+//
+// Node 0 is a synthetic root with an edge to every GC root, followed by one node per live cell. To avoid
+// keeping the graph in memory, the edges of every cell are visited twice: once to count them up front, and
+// once more to write out the edge array. A cell's node index is derived from its block and its rank among
+// the live cells in that block, so only one bit and one edge count per cell are kept around.
+class HeapSnapshotWriter {
+    AK_MAKE_NONCOPYABLE(HeapSnapshotWriter);
+    AK_MAKE_NONMOVABLE(HeapSnapshotWriter);
+
+public:
+    HeapSnapshotWriter(Heap& heap, Stream& stream)
+        : m_heap(heap)
+        , m_stream(stream)
+    {
+    }
+
+    ErrorOr<void> write();
+
+private:
+    static constexpr size_t node_field_count = 7;
+    static constexpr size_t flush_threshold = 64 * KiB;
+
+    // Indices into the node_types and edge_types arrays in the snapshot metadata.
+    static constexpr size_t node_type_object = 3;
+    static constexpr size_t node_type_synthetic = 9;
+    static constexpr size_t edge_type_element = 1;
+    static constexpr size_t edge_type_internal = 3;
+
+    struct BlockInfo {
+        u32 first_node_index { 0 };
+        Vector<u64> live_cells;
+    };
+
+    void index_live_cells();
+    void count_edges();
+    Optional<u32> node_index_of(Cell const&) const;
+    u32 string_index(StringView);
+
+    template<typename Callback>
+    void for_each_edge(Cell&, Callback);
+
+    ErrorOr<void> write_nodes();
+    ErrorOr<void> write_edges();
+    ErrorOr<void> write_strings();
+
+    template<typename... Parameters>
+    ErrorOr<void> append(CheckedFormatString<Parameters...>&& format, Parameters const&... parameters)
+    {
+        m_buffer.appendff(move(format), parameters...);
+        if (m_buffer.length() >= flush_threshold)
+            return flush();
+        return {};
+    }
+
+    ErrorOr<void> flush()
+    {
+        TRY(m_stream.write_until_depleted(m_buffer.string_view().bytes()));
+        m_buffer.clear();
+        return {};
+    }
+
+    Heap& m_heap;
+    Stream& m_stream;
+    StringBuilder m_buffer;
+
+    HashMap<Cell*, HeapRoot> m_roots;
+    HashMap<HeapBlock const*, BlockInfo> m_blocks;
+    u32 m_node_count { 1 };
+    size_t m_edge_count { 0 };
+    Vector<u32> m_edge_counts;
+
+    HashMap<StringView, u32> m_string_indices;
+    Vector<StringView> m_strings;
+};
+
+class HeapSnapshotEdgeVisitor final : public Cell::Visitor {
+public:
+    HeapSnapshotEdgeVisitor(HeapBlockMap const& block_map, AK::Function<void(Cell&)> callback)
+        : m_block_map(block_map)
+        , m_callback(move(callback))
+    {
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        m_callback(cell);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        m_block_map.for_each_cell_among_possible_values(bytes, [&](Cell* cell) {
+            m_callback(*cell);
+        });
+    }
+
+private:
+    HeapBlockMap const& m_block_map;
+    AK::Function<void(Cell&)> m_callback;
+};
+
+void HeapSnapshotWriter::index_live_cells()
+{
+    m_heap.for_each_block([&](auto& block) {
+        BlockInfo info;
+        info.first_node_index = m_node_count;
+        info.live_cells.resize(ceil_div(block.cell_count(), 64uz));
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            auto index = block.cell_index(cell);
+            info.live_cells[index / 64] |= 1ull << (index % 64);
+            ++m_node_count;
+        });
+        m_blocks.set(&block, move(info));
+        return IterationDecision::Continue;
+    });
+}
+
+void HeapSnapshotWriter::count_edges()
+{
+    m_edge_counts.ensure_capacity(m_node_count);
+
+    u32 root_edge_count = 0;
+    for (auto& it : m_roots) {
+        if (node_index_of(*it.key).has_value())
+            ++root_edge_count;
+    }
+    m_edge_counts.unchecked_append(root_edge_count);
+
+    m_heap.for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            u32 edge_count = 0;
+            for_each_edge(*cell, [&](u32) { ++edge_count; });
+            m_edge_counts.unchecked_append(edge_count);
+        });
+        return IterationDecision::Continue;
+    });
+
+    VERIFY(m_edge_counts.size() == m_node_count);
+    for (auto edge_count : m_edge_counts)
+        m_edge_count += edge_count;
+}
+
+Optional<u32> HeapSnapshotWriter::node_index_of(Cell const& cell) const
+{
+    auto* block = HeapBlock::from_cell(&cell);
+    auto it = m_blocks.find(block);
+    if (it == m_blocks.end())
+        return {};
+
+    auto const& info = it->value;
+    auto index = block->cell_index(&cell);
+    auto word = index / 64;
+    auto bit = 1ull << (index % 64);
+    if (!(info.live_cells[word] & bit))
+        return {};
+
+    u32 rank = 0;
+    for (size_t i = 0; i < word; ++i)
+        rank += popcount(info.live_cells[i]);
+    rank += popcount(info.live_cells[word] & (bit - 1));
+    return info.first_node_index + rank;
+}
+
+u32 HeapSnapshotWriter::string_index(StringView string)
+{
+    return m_string_indices.ensure(string, [&] {
+        m_strings.append(string);
+        return static_cast<u32>(m_strings.size() - 1);
+    });
+}
+
+template<typename Callback>
+void HeapSnapshotWriter::for_each_edge(Cell& cell, Callback callback)
+{
+    HeapSnapshotEdgeVisitor visitor(m_heap.m_block_map, [&](Cell& target) {
+        if (auto target_index = node_index_of(target); target_index.has_value())
+            callback(*target_index);
+    });
+    cell.visit_edges(visitor);
+}
+
+static StringView root_type_name(HeapRoot::Type type)
+{
+    switch (type) {
+    case HeapRoot::Type::HeapFunctionCapturedPointer:
+        return "HeapFunctionCapturedPointer"sv;
+    case HeapRoot::Type::Root:
+        return "Root"sv;
+    case HeapRoot::Type::RootVector:
+        return "RootVector"sv;
+    case HeapRoot::Type::RootHashMap:
+        return "RootHashMap"sv;
+    case HeapRoot::Type::ConservativeVector:
+        return "ConservativeVector"sv;
+    case HeapRoot::Type::RegisterPointer:
+        return "RegisterPointer"sv;
+    case HeapRoot::Type::StackPointer:
+        return "StackPointer"sv;
+    case HeapRoot::Type::VM:
+        return "VM"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> HeapSnapshotWriter::write_nodes()
+{
+    TRY(append("\"nodes\":["));
+    TRY(append("{},{},{},{},{},0,0", node_type_synthetic, string_index("(GC roots)"sv), 0, 0, m_edge_counts[0]));
+
+    u32 node_index = 1;
+    ErrorOr<void> result;
+    m_heap.for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (!result.is_error())
+                result = append("\n,{},{},{},{},{},0,0", node_type_object, string_index(cell->class_name()), reinterpret_cast<FlatPtr>(cell), block.cell_size(), m_edge_counts[node_index]);
+            ++node_index;
+        });
+        return result.is_error() ? IterationDecision::Break : IterationDecision::Continue;
+    });
+    TRY(result);
+
+    return append("],\n");
+}
+
+ErrorOr<void> HeapSnapshotWriter::write_edges()
+{
+    TRY(append("\"edges\":["));
+
+    bool first = true;
+    auto append_edge = [&](size_t type, u32 name_or_index, u32 to_node) -> ErrorOr<void> {
+        TRY(append("{}{},{},{}", first ? "" : "\n,", type, name_or_index, to_node * node_field_count));
+        first = false;
+        return {};
+    };
+
+    for (auto& it : m_roots) {
+        if (auto index = node_index_of(*it.key); index.has_value())
+            TRY(append_edge(edge_type_internal, string_index(root_type_name(it.value.type)), *index));
+    }
+
+    ErrorOr<void> result;
+    m_heap.for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            u32 element_index = 0;
+            for_each_edge(*cell, [&](u32 target_index) {
+                if (!result.is_error())
+                    result = append_edge(edge_type_element, element_index++, target_index);
+            });
+        });
+        return result.is_error() ? IterationDecision::Break : IterationDecision::Continue;
+    });
+    TRY(result);
+
+    return append("],\n");
+}
+
+ErrorOr<void> HeapSnapshotWriter::write_strings()
+{
+    TRY(append("\"strings\":["));
+    for (size_t i = 0; i < m_strings.size(); ++i) {
+        if (i != 0)
+            TRY(append("\n,"));
+        m_buffer.append('"');
+        m_buffer.append_escaped_for_json(m_strings[i]);
+        TRY(append("\""));
+    }
+    return append("]}}\n");
+}
+
+ErrorOr<void> HeapSnapshotWriter::write()
+{
+    m_heap.gather_roots(m_roots);
+    index_live_cells();
+    count_edges();
+
+    TRY(append("{{\"snapshot\":{{\"meta\":{{"
+               "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\",\"trace_node_id\",\"detachedness\"],"
+               "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\",\"closure\",\"regexp\",\"number\",\"native\",\"synthetic\",\"concatenated string\",\"sliced string\",\"symbol\",\"bigint\"],\"string\",\"number\",\"number\",\"number\",\"number\",\"number\"],"
+               "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+               "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\",\"hidden\",\"shortcut\",\"weak\"],\"string_or_number\",\"node\"]"
+               "}},\"node_count\":{},\"edge_count\":{}}},\n",
+        m_node_count, m_edge_count));
+
+    TRY(write_nodes());
+    TRY(write_edges());
+    TRY(write_strings());
+    return flush();
+}
+
+ErrorOr<void> Heap::write_heap_snapshot(Stream& stream)
+{
+    VERIFY(!m_collecting_garbage);
+
+    // The writer relies on the set of live cells staying the same between its passes over the heap.
+    DeferGC defer_gc(*this);
+    HeapSnapshotWriter writer(*this, stream);
+    return writer.write();
+}
+
+Vector<Heap::TypeStatistics> Heap::live_cell_statistics_by_type()
+{
+    HashMap<StringView, TypeStatistics> statistics_by_type;
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            auto class_name = cell->class_name();
+            auto& statistics = statistics_by_type.ensure(class_name, [&] { return TypeStatistics { .class_name = class_name }; });
+            ++statistics.live_cells;
+            statistics.live_bytes += block.cell_size();
+        });
+        return IterationDecision::Continue;
+    });
+
+    Vector<TypeStatistics> result;
+    result.ensure_capacity(statistics_by_type.size());
+    for (auto& it : statistics_by_type)
+        result.unchecked_append(it.value);
+    quick_sort(result, [](auto const& a, auto const& b) { return a.live_bytes > b.live_bytes; });
+    return result;
+}
+
+}
@@ -117,4 +117,10 @@ protected:
 
 static_assert(sizeof(NanBoxedValue) == sizeof(double));
 
+ALWAYS_INLINE void Cell::write_barrier(NanBoxedValue const& value)
+{
+    if (value.is_cell())
+        write_barrier(&value.as_cell());
+}
+
 }
@@ -777,6 +777,31 @@ struct FunctionParsingInsights {
     bool might_need_arguments_object { false };
 };
 
+// Everything needed to parse a function whose body was skipped by a lazy parse, which happens the
+// first time the function is called. See Parser::enable_lazy_function_parsing().
+struct LazyFunctionBody : public RefCounted<LazyFunctionBody> {
+    LazyFunctionBody(ByteString source, NonnullRefPtr<SourceCode const> source_code, Position start, u16 parse_options, bool is_module, bool strict_mode)
+        : source(move(source))
+        , source_code(move(source_code))
+        , start(start)
+        , parse_options(parse_options)
+        , is_module(is_module)
+        , strict_mode(strict_mode)
+    {
+    }
+
+    ByteString source;
+    NonnullRefPtr<SourceCode const> source_code;
+    Position start;
+    u16 parse_options { 0 };
+    bool is_module { false };
+    bool strict_mode { false };
+
+    // One identifier for each name the skipped body may refer to. These are annotated by the scopes
+    // around the function like any other reference, which tells us which names resolve to globals.
+    Vector<NonnullRefPtr<Identifier const>> free_identifiers;
+};
+
 class FunctionNode {
 public:
     FlyString name() const { return m_name ? m_name->string() : ""_fly_string; }
@@ -801,6 +826,10 @@ public:
     RefPtr<SharedFunctionInstanceData> shared_data() const;
     void set_shared_data(RefPtr<SharedFunctionInstanceData>) const;
 
+    // If set, body() is an empty placeholder and the real body has yet to be parsed.
+    RefPtr<LazyFunctionBody const> const& lazy_body() const { return m_lazy_body; }
+    void set_lazy_body(NonnullRefPtr<LazyFunctionBody const> lazy_body) { m_lazy_body = move(lazy_body); }
+
     virtual ~FunctionNode();
 
 protected:
@@ -821,6 +850,7 @@ private:
 
     Vector<LocalVariable> m_local_variables_names;
 
+    RefPtr<LazyFunctionBody const> m_lazy_body;
     mutable RefPtr<SharedFunctionInstanceData> m_shared_data;
 };
 
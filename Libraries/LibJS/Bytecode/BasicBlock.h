@@ -30,6 +30,7 @@ public:
     ~BasicBlock();
 
     u32 index() const { return m_index; }
+    void set_index(Badge<Optimizer>, u32 index) { m_index = index; }
 
     ReadonlyBytes instruction_stream() const { return m_buffer.span(); }
     u8* data() { return m_buffer.data(); }
@@ -44,6 +45,15 @@ public:
 
     void grow(size_t additional_size);
 
+    // Replaces the instructions of this block with a rewritten stream.
+    // NOTE: Instructions that were not carried over to the new stream must already have been destroyed.
+    void replace_instruction_stream(Badge<Optimizer>, Vector<u8> buffer, HashMap<size_t, SourceRecord> source_map, size_t last_instruction_start_offset)
+    {
+        m_buffer = move(buffer);
+        m_source_map = move(source_map);
+        m_last_instruction_start_offset = last_instruction_start_offset;
+    }
+
     void terminate(Badge<Generator>) { m_terminated = true; }
     bool is_terminated() const { return m_terminated; }
 
@@ -11,6 +11,10 @@
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/SourceCode.h>
 
+#if JS_HAS_BASELINE_JIT
+#    include <LibJS/JIT/NativeExecutable.h>
+#endif
+
 namespace JS::Bytecode {
 
 GC_DEFINE_ALLOCATOR(Executable);
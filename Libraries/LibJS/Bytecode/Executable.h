@@ -33,6 +33,11 @@ struct PropertyLookupCache {
         WeakPtr<PrototypeChainValidity> prototype_chain_validity;
     };
     AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+
+    // Set once the site has seen more shapes than it can remember. Misses then go through the interpreter's
+    // MegamorphicCache instead of evicting entries here.
+    bool is_megamorphic { false };
+    Optional<u32> megamorphic_statistics_index;
 };
 
 struct GlobalVariableCache : public PropertyLookupCache {
@@ -45,6 +50,8 @@ struct GlobalVariableCache : public PropertyLookupCache {
 struct SourceRecord {
     u32 source_start_offset {};
     u32 source_end_offset {};
+
+    bool operator==(SourceRecord const&) const = default;
 };
 
 class Executable final : public Cell {
@@ -97,6 +104,13 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+#if JS_HAS_BASELINE_JIT
+    // Native code generated by the baseline JIT, see JIT::Compiler.
+    OwnPtr<JIT::NativeExecutable> native_executable;
+    u32 number_of_runs_before_jit_compilation { 0 };
+    bool did_try_jit_compilation { false };
+#endif
+
     String const& get_string(StringTableIndex index) const { return string_table->get(index); }
     FlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
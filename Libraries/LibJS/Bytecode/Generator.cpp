@@ -10,7 +10,9 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Optimizer.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/VM.h>
@@ -260,6 +262,12 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
         }
     }
 
+    if (g_optimize_bytecode) {
+        auto statistics = Optimizer::optimize(generator, node.source_code());
+        if (g_dump_bytecode_passes)
+            statistics.dump();
+    }
+
     bool is_strict_mode = false;
     if (is<Program>(node))
         is_strict_mode = static_cast<Program const&>(node).is_strict_mode();
@@ -24,6 +24,8 @@
 namespace JS::Bytecode {
 
 class Generator {
+    friend class Optimizer;
+
 public:
     VM& vm() { return m_vm; }
 
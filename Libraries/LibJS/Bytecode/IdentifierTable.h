@@ -29,6 +29,7 @@ public:
     FlyString const& get(IdentifierTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_identifiers.is_empty(); }
+    size_t size() const { return m_identifiers.size(); }
 
 private:
     Vector<FlyString> m_identifiers;
@@ -42,6 +42,11 @@
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibJS/SourceTextModule.h>
 
+#if JS_HAS_BASELINE_JIT
+#    include <LibJS/JIT/Compiler.h>
+#    include <LibJS/JIT/NativeExecutable.h>
+#endif
+
 namespace JS {
 
 struct PropertyKeyAndEnumerableFlag {
@@ -71,6 +76,8 @@ struct Traits<JS::PropertyKeyAndEnumerableFlag> : public DefaultTraits<JS::Prope
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_dump_bytecode_passes = false;
+bool g_optimize_bytecode = true;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -183,6 +190,8 @@ ALWAYS_INLINE static ThrowCompletionOr<bool> strict_equals(VM&, Value src1, Valu
 
 Interpreter::Interpreter(VM& vm)
     : m_vm(vm)
+    , m_megamorphic_get_cache(make<MegamorphicCache>())
+    , m_megamorphic_put_cache(make<MegamorphicCache>())
 {
 }
 
@@ -396,6 +405,8 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             program_counter += instruction.length();                                                \
         else                                                                                        \
             program_counter += sizeof(Op::name);                                                    \
+        if constexpr (JS_BYTECODE_INSTRUCTION_COUNT_DEBUG)                                          \
+            ++m_executed_instruction_count;                                                         \
         auto& next_instruction = *reinterpret_cast<Instruction const*>(&bytecode[program_counter]); \
         goto* bytecode_dispatch_table[static_cast<size_t>(next_instruction.type())];                \
     } while (0)
@@ -403,6 +414,8 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
     for (;;) {
     start:
         for (;;) {
+            if constexpr (JS_BYTECODE_INSTRUCTION_COUNT_DEBUG)
+                ++m_executed_instruction_count;
             goto* bytecode_dispatch_table[static_cast<size_t>((*reinterpret_cast<Instruction const*>(&bytecode[program_counter])).type())];
 
         handle_Mov: {
@@ -609,6 +622,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(EnterObjectEnvironment);
             HANDLE_INSTRUCTION(Exp);
             HANDLE_INSTRUCTION(GetById);
+            HANDLE_INSTRUCTION(GetByIdAndCall);
             HANDLE_INSTRUCTION(GetByIdWithThis);
             HANDLE_INSTRUCTION(GetByValue);
             HANDLE_INSTRUCTION(GetByValueWithThis);
@@ -750,7 +764,13 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
         registers_and_constants_and_locals_and_arguments[executable.number_of_registers + i] = executable.constants[i];
     }
 
+#if JS_HAS_BASELINE_JIT
+    auto* native_executable = JIT::Compiler::native_executable_for(executable);
+    if (!native_executable || !native_executable->run(*this, registers_and_constants_and_locals_and_arguments, entry_point.value_or(0)))
+        run_bytecode(entry_point.value_or(0));
+#else
     run_bytecode(entry_point.value_or(0));
+#endif
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
@@ -973,6 +993,21 @@ enum class GetByIdMode {
     Length,
 };
 
+static void mark_megamorphic(PropertyLookupCache& cache, Executable const& executable)
+{
+    cache.is_megamorphic = true;
+    if (g_collect_megamorphic_cache_statistics)
+        cache.megamorphic_statistics_index = g_megamorphic_cache_statistics.add_site(executable, cache);
+}
+
+ALWAYS_INLINE void count_megamorphic_lookup(PropertyLookupCache const& cache, bool hit)
+{
+    if (!cache.megamorphic_statistics_index.has_value()) [[likely]]
+        return;
+    auto& site = g_megamorphic_cache_statistics.sites[*cache.megamorphic_statistics_index];
+    ++(hit ? site.hits : site.misses);
+}
+
 template<GetByIdMode mode = GetByIdMode::Normal>
 inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex> base_identifier, IdentifierTableIndex property, Value base_value, Value this_value, PropertyLookupCache& cache, Executable const& executable)
 {
@@ -1020,14 +1055,34 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
         }
     }
 
+    auto const& property_name = executable.get_identifier(property);
+
+    // OPTIMIZATION: Sites that have seen too many shapes fall back to the interpreter-wide megamorphic cache.
+    if (cache.is_megamorphic) {
+        auto const* entry = vm.bytecode_interpreter().megamorphic_get_cache().lookup(shape, property_name);
+        count_megamorphic_lookup(cache, entry);
+        if (entry) {
+            auto value = entry->prototype ? entry->prototype->get_direct(entry->property_offset) : base_obj->get_direct(entry->property_offset);
+            if (value.is_accessor())
+                return TRY(call(vm, value.as_accessor().getter(), this_value));
+            return value;
+        }
+    }
+
     CacheablePropertyMetadata cacheable_metadata;
-    auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
+    auto value = TRY(base_obj->internal_get(property_name, this_value, &cacheable_metadata));
 
     // If internal_get() caused object's shape change, we can no longer be sure
     // that collected metadata is valid, e.g. if getter in prototype chain added
     // property with the same name into the object itself.
     if (&shape == &base_obj->shape()) {
+        if (cache.is_megamorphic) {
+            vm.bytecode_interpreter().megamorphic_get_cache().insert(shape, property_name, cacheable_metadata);
+            return value;
+        }
         auto get_cache_slot = [&] -> PropertyLookupCache::Entry& {
+            if (cache.entries.last().shape)
+                mark_megamorphic(cache, executable);
             for (size_t i = cache.entries.size() - 1; i >= 1; --i) {
                 cache.entries[i] = cache.entries[i - 1];
             }
@@ -1062,6 +1117,15 @@ inline ThrowCompletionOr<Value> get_by_value(VM& vm, Optional<IdentifierTableInd
         // For "non-typed arrays":
         if (!object.may_interfere_with_indexed_property_access()
             && object_storage) {
+            // Numeric packed elements are never holes or accessors, so they can be returned as-is.
+            if (object_storage->is_simple_storage()) {
+                auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*object_storage);
+                auto element_kind = simple_storage.element_kind();
+                if ((element_kind == ElementKind::PackedInt32 || element_kind == ElementKind::PackedDouble)
+                    && index < simple_storage.array_like_size())
+                    return simple_storage.packed_elements().data()[index];
+            }
+
             auto maybe_value = [&] {
                 if (object_storage->is_simple_storage())
                     return static_cast<SimpleIndexedPropertyStorage const*>(object_storage)->inline_get(index);
@@ -1266,14 +1330,39 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
             }
         }
 
+        // OPTIMIZATION: Sites that have seen too many shapes fall back to the interpreter-wide megamorphic cache.
+        if (caches && caches->is_megamorphic && name.is_string()) {
+            auto const* entry = vm.bytecode_interpreter().megamorphic_put_cache().lookup(shape, name.as_string());
+            count_megamorphic_lookup(*caches, entry);
+            if (entry && entry->prototype) {
+                auto value_in_prototype = entry->prototype->get_direct(entry->property_offset);
+                if (value_in_prototype.is_accessor()) {
+                    TRY(call(vm, value_in_prototype.as_accessor().setter(), this_value, value));
+                    return {};
+                }
+            } else if (entry) {
+                auto value_in_object = object->get_direct(entry->property_offset);
+                if (value_in_object.is_accessor()) {
+                    TRY(call(vm, value_in_object.as_accessor().setter(), this_value, value));
+                } else {
+                    object->put_direct(entry->property_offset, value);
+                }
+                return {};
+            }
+        }
+
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         // If internal_set() caused object's shape change, we can no longer be sure
         // that collected metadata is valid, e.g. if setter in prototype chain added
         // property with the same name into the object itself.
-        if (succeeded && caches && &shape == &object->shape()) {
+        if (succeeded && caches && caches->is_megamorphic && name.is_string() && &shape == &object->shape()) {
+            vm.bytecode_interpreter().megamorphic_put_cache().insert(shape, name.as_string(), cacheable_metadata);
+        } else if (succeeded && caches && &shape == &object->shape()) {
             auto get_cache_slot = [&] -> PropertyLookupCache::Entry& {
+                if (caches->entries.last().shape)
+                    mark_megamorphic(*caches, vm.bytecode_interpreter().current_executable());
                 for (size_t i = caches->entries.size() - 1; i >= 1; --i) {
                     caches->entries[i] = caches->entries[i - 1];
                 }
@@ -1381,7 +1470,7 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<FlyStri
     if ((kind == Op::PropertyKind::KeyValue || kind == Op::PropertyKind::DirectKeyValue)
         && base.is_object() && property_key_value.is_int32() && property_key_value.as_i32() >= 0) {
         auto& object = base.as_object();
-        auto* storage = object.indexed_properties().storage();
+        auto const* storage = object.indexed_properties().storage();
         auto index = static_cast<u32>(property_key_value.as_i32());
 
         // For "non-typed arrays":
@@ -1392,12 +1481,21 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<FlyStri
             if (maybe_value.has_value()) {
                 auto existing_value = maybe_value->value;
                 if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
+                    object.mutable_indexed_properties().storage()->put(index, value);
                     return {};
                 }
             }
         }
 
+        // OPTIMIZATION: Appending to an array (e.g. `a[a.length] = x`) can write to the storage directly,
+        //               as long as nothing on the prototype chain could observe the new index.
+        if (is<Array>(object)
+            && index == object.indexed_properties().array_like_size()
+            && static_cast<Array const&>(object).has_fast_elements()) {
+            object.mutable_indexed_properties().append(value);
+            return {};
+        }
+
         // For typed arrays:
         if (object.is_typed_array()) {
             auto& typed_array = static_cast<TypedArrayBase&>(object);
@@ -1746,12 +1844,12 @@ inline ThrowCompletionOr<void> append(VM& vm, Value lhs, Value rhs, bool is_spre
         // ...rhs
         size_t i = lhs_size;
         TRY(get_iterator_values(vm, rhs, [&i, &lhs_array](Value iterator_value) -> Optional<Completion> {
-            lhs_array.indexed_properties().put(i, iterator_value, default_attributes);
+            lhs_array.mutable_indexed_properties().put(i, iterator_value, default_attributes);
             ++i;
             return {};
         }));
     } else {
-        lhs_array.indexed_properties().put(lhs_size, rhs, default_attributes);
+        lhs_array.mutable_indexed_properties().put(lhs_size, rhs, default_attributes);
     }
 
     return {};
@@ -2213,7 +2311,7 @@ void NewArray::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto array = MUST(Array::create(interpreter.realm(), 0));
     for (size_t i = 0; i < m_element_count; i++) {
-        array->indexed_properties().put(i, interpreter.get(m_elements[i]), default_attributes);
+        array->mutable_indexed_properties().put(i, interpreter.get(m_elements[i]), default_attributes);
     }
     interpreter.set(dst(), array);
 }
@@ -2222,7 +2320,7 @@ void NewPrimitiveArray::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto array = MUST(Array::create(interpreter.realm(), 0));
     for (size_t i = 0; i < m_element_count; i++)
-        array->indexed_properties().put(i, m_elements[i], default_attributes);
+        array->mutable_indexed_properties().put(i, m_elements[i], default_attributes);
     interpreter.set(dst(), array);
 }
 
@@ -2539,7 +2637,7 @@ void CreateRestParams::execute_impl(Bytecode::Interpreter& interpreter) const
     auto arguments_count = interpreter.running_execution_context().passed_argument_count;
     auto array = MUST(Array::create(interpreter.realm(), 0));
     for (size_t rest_index = m_rest_index; rest_index < arguments_count; ++rest_index)
-        array->indexed_properties().append(arguments[rest_index]);
+        array->mutable_indexed_properties().append(arguments[rest_index]);
     interpreter.set(m_dst, array);
 }
 
@@ -2837,37 +2935,49 @@ static ThrowCompletionOr<Value> dispatch_builtin_call(Bytecode::Interpreter& int
     VERIFY_NOT_REACHED();
 }
 
-ThrowCompletionOr<void> Call::execute_impl(Bytecode::Interpreter& interpreter) const
+ALWAYS_INLINE static ThrowCompletionOr<void> call_function(Bytecode::Interpreter& interpreter, Operand dst, Value callee, Value this_value, ReadonlySpan<Operand> arguments, Optional<StringTableIndex> const& expression_string)
 {
-    auto callee = interpreter.get(m_callee);
-
     if (!callee.is_function()) [[unlikely]] {
-        return throw_type_error_for_callee(interpreter, callee, "function"sv, m_expression_string);
+        return throw_type_error_for_callee(interpreter, callee, "function"sv, expression_string);
     }
 
     auto& function = callee.as_function();
 
     ExecutionContext* callee_context = nullptr;
     size_t registers_and_constants_and_locals_count = 0;
-    size_t argument_count = m_argument_count;
+    size_t argument_count = arguments.size();
     TRY(function.get_stack_frame_size(registers_and_constants_and_locals_count, argument_count));
-    ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK_WITHOUT_CLEARING_ARGS(callee_context, registers_and_constants_and_locals_count, max(m_argument_count, argument_count));
+    ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK_WITHOUT_CLEARING_ARGS(callee_context, registers_and_constants_and_locals_count, max(arguments.size(), argument_count));
 
     auto* callee_context_argument_values = callee_context->arguments.data();
     auto const callee_context_argument_count = callee_context->arguments.size();
-    auto const insn_argument_count = m_argument_count;
+    auto const insn_argument_count = arguments.size();
 
     for (size_t i = 0; i < insn_argument_count; ++i)
-        callee_context_argument_values[i] = interpreter.get(m_arguments[i]);
+        callee_context_argument_values[i] = interpreter.get(arguments[i]);
     for (size_t i = insn_argument_count; i < callee_context_argument_count; ++i)
         callee_context_argument_values[i] = js_undefined();
     callee_context->passed_argument_count = insn_argument_count;
 
-    auto retval = TRY(function.internal_call(*callee_context, interpreter.get(m_this_value)));
-    interpreter.set(m_dst, retval);
+    auto retval = TRY(function.internal_call(*callee_context, this_value));
+    interpreter.set(dst, retval);
     return {};
 }
 
+ThrowCompletionOr<void> Call::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    return call_function(interpreter, m_dst, interpreter.get(m_callee), interpreter.get(m_this_value), { m_arguments, m_argument_count }, m_expression_string);
+}
+
+ThrowCompletionOr<void> GetByIdAndCall::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto base_value = interpreter.get(m_base);
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    auto callee = TRY(get_by_id(interpreter.vm(), m_base_identifier, m_property, base_value, base_value, cache, interpreter.current_executable()));
+    interpreter.set(m_callee, callee);
+    return call_function(interpreter, m_dst, callee, base_value, { m_arguments, m_argument_count }, m_expression_string);
+}
+
 ThrowCompletionOr<void> CallConstruct::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto callee = interpreter.get(m_callee);
@@ -3684,6 +3794,24 @@ ByteString Call::to_byte_string_impl(Bytecode::Executable const& executable) con
     return builder.to_byte_string();
 }
 
+ByteString GetByIdAndCall::to_byte_string_impl(Bytecode::Executable const& executable) const
+{
+    StringBuilder builder;
+    builder.appendff("GetByIdAndCall {}, {}, {}, {}, ",
+        format_operand("dst"sv, m_dst, executable),
+        format_operand("callee"sv, m_callee, executable),
+        format_operand("base"sv, m_base, executable),
+        executable.identifier_table->get(m_property));
+
+    builder.append(format_operand_list("args"sv, { m_arguments, m_argument_count }, executable));
+
+    if (m_expression_string.has_value()) {
+        builder.appendff(", `{}`", executable.get_string(m_expression_string.value()));
+    }
+
+    return builder.to_byte_string();
+}
+
 ByteString CallConstruct::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
     StringBuilder builder;
@@ -8,6 +8,7 @@
 
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/MegamorphicCache.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
@@ -20,6 +21,8 @@ namespace JS::Bytecode {
 class InstructionStreamIterator;
 
 class Interpreter {
+    friend class JIT::Compiler;
+
 public:
     explicit Interpreter(VM&);
     ~Interpreter();
@@ -84,6 +87,12 @@ public:
 
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
+    // NOTE: Only counted when building with JS_BYTECODE_INSTRUCTION_COUNT_DEBUG.
+    u64 executed_instruction_count() const { return m_executed_instruction_count; }
+
+    MegamorphicCache& megamorphic_get_cache() { return *m_megamorphic_get_cache; }
+    MegamorphicCache& megamorphic_put_cache() { return *m_megamorphic_put_cache; }
+
 private:
     void run_bytecode(size_t entry_point);
 
@@ -102,9 +111,16 @@ private:
     Span<Value> m_registers_and_constants_and_locals_arguments;
     Vector<Value> m_argument_values_buffer;
     ExecutionContext* m_running_execution_context { nullptr };
+    u64 m_executed_instruction_count { 0 };
+
+    // Gets and sets are cached separately, since a property that can be read directly may not be writable.
+    NonnullOwnPtr<MegamorphicCache> m_megamorphic_get_cache;
+    NonnullOwnPtr<MegamorphicCache> m_megamorphic_put_cache;
 };
 
 JS_API extern bool g_dump_bytecode;
+JS_API extern bool g_dump_bytecode_passes;
+JS_API extern bool g_optimize_bytecode;
 
 ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, FlyString const& name);
 ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
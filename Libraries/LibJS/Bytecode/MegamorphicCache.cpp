@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/MegamorphicCache.h>
+
+namespace JS::Bytecode {
+
+bool g_collect_megamorphic_cache_statistics = false;
+MegamorphicCacheStatistics g_megamorphic_cache_statistics;
+
+u32 MegamorphicCacheStatistics::add_site(Executable const& executable, PropertyLookupCache const& cache)
+{
+    size_t cache_index = &cache - executable.property_lookup_caches.data();
+    sites.append({ .executable_name = executable.name, .cache_index = cache_index });
+    return sites.size() - 1;
+}
+
+void MegamorphicCacheStatistics::dump() const
+{
+    u64 total_hits = 0;
+    u64 total_misses = 0;
+    for (auto const& site : sites) {
+        total_hits += site.hits;
+        total_misses += site.misses;
+    }
+
+    auto hit_rate = [](u64 hits, u64 misses) {
+        auto lookups = hits + misses;
+        return lookups ? 100.0 * hits / lookups : 0.0;
+    };
+
+    warnln("\033[37;1mMegamorphic property cache\033[0m");
+    warnln("  megamorphic sites:        {}", sites.size());
+    warnln("  lookups:                  {} ({:.1}% hits)", total_hits + total_misses, hit_rate(total_hits, total_misses));
+
+    Vector<Site const*> sorted_sites;
+    sorted_sites.ensure_capacity(sites.size());
+    for (auto const& site : sites)
+        sorted_sites.unchecked_append(&site);
+    quick_sort(sorted_sites, [](auto* a, auto* b) { return a->hits + a->misses > b->hits + b->misses; });
+
+    constexpr size_t max_sites_to_dump = 20;
+    for (size_t i = 0; i < min(sorted_sites.size(), max_sites_to_dump); ++i) {
+        auto const& site = *sorted_sites[i];
+        warnln("  {}#{}: {} lookups ({:.1}% hits)", site.executable_name.is_empty() ? "(anonymous)"sv : site.executable_name.bytes_as_string_view(), site.cache_index, site.hits + site.misses, hit_rate(site.hits, site.misses));
+    }
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/FlyString.h>
+#include <AK/Vector.h>
+#include <AK/WeakPtr.h>
+#include <LibJS/Export.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
+
+namespace JS::Bytecode {
+
+// A direct-mapped (shape, property name) cache shared by all property lookup sites of an interpreter.
+//
+// Sites that have seen more shapes than their own PropertyLookupCache can remember are megamorphic, and
+// would otherwise go through the slow [[Get]] and [[Set]] paths on every miss. Entries are validated the
+// same way as inline cache entries: by shape identity, and for properties found on the prototype chain,
+// through the prototype's PrototypeChainValidity.
+class MegamorphicCache {
+public:
+    static constexpr size_t number_of_entries = 1024;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        FlyString name;
+        u32 property_offset { 0 };
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    // Returns the entry for this shape and name, or nullptr if there is no valid one.
+    Entry const* lookup(Shape const& shape, FlyString const& name) const
+    {
+        auto const& entry = m_entries[index_for(shape, name)];
+        if (entry.shape != &shape || entry.name != name)
+            return nullptr;
+        if (entry.prototype && (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid()))
+            return nullptr;
+        return &entry;
+    }
+
+    void insert(Shape& shape, FlyString const& name, CacheablePropertyMetadata const& metadata)
+    {
+        if (metadata.type == CacheablePropertyMetadata::Type::NotCacheable)
+            return;
+        auto& entry = m_entries[index_for(shape, name)];
+        entry = {};
+        entry.shape = shape;
+        entry.name = name;
+        entry.property_offset = metadata.property_offset.value();
+        if (metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
+            entry.prototype = *metadata.prototype;
+            entry.prototype_chain_validity = *metadata.prototype->shape().prototype_chain_validity();
+        }
+    }
+
+private:
+    static size_t index_for(Shape const& shape, FlyString const& name)
+    {
+        return pair_int_hash(ptr_hash(&shape), name.hash()) & (number_of_entries - 1);
+    }
+
+    AK::Array<Entry, number_of_entries> m_entries;
+};
+
+// Per-site hit rates of the megamorphic cache, collected while g_collect_megamorphic_cache_statistics is set.
+struct JS_API MegamorphicCacheStatistics {
+    struct Site {
+        FlyString executable_name;
+        size_t cache_index { 0 };
+        u64 hits { 0 };
+        u64 misses { 0 };
+    };
+
+    // Registers a site that just went megamorphic, and returns its index in sites.
+    u32 add_site(Executable const&, PropertyLookupCache const&);
+
+    Vector<Site> sites;
+
+    void dump() const;
+};
+
+JS_API extern bool g_collect_megamorphic_cache_statistics;
+JS_API extern MegamorphicCacheStatistics g_megamorphic_cache_statistics;
+
+}
@@ -965,6 +965,7 @@ public:
     Operand dst() const { return m_dst; }
     Operand base() const { return m_base; }
     IdentifierTableIndex property() const { return m_property; }
+    Optional<IdentifierTableIndex> const& base_identifier() const { return m_base_identifier; }
     u32 cache_index() const { return m_cache_index; }
 
 private:
@@ -1837,6 +1838,7 @@ public:
     Optional<StringTableIndex> const& expression_string() const { return m_expression_string; }
 
     u32 argument_count() const { return m_argument_count; }
+    ReadonlySpan<Operand> arguments() const { return { m_arguments, m_argument_count }; }
 
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     ByteString to_byte_string_impl(Bytecode::Executable const&) const;
@@ -1858,6 +1860,65 @@ private:
     Operand m_arguments[];
 };
 
+// Superinstruction for the `GetById callee, base, property` + `Call dst, callee, base, ...` pair that
+// method calls compile to. Fused by the bytecode optimizer.
+class GetByIdAndCall final : public Instruction {
+public:
+    static constexpr bool IsVariableLength = true;
+
+    GetByIdAndCall(Operand dst, Operand callee, Operand base, IdentifierTableIndex property, Optional<IdentifierTableIndex> base_identifier, u32 cache_index, ReadonlySpan<Operand> arguments, Optional<StringTableIndex> expression_string)
+        : Instruction(Type::GetByIdAndCall)
+        , m_dst(dst)
+        , m_callee(callee)
+        , m_base(base)
+        , m_property(property)
+        , m_base_identifier(move(base_identifier))
+        , m_cache_index(cache_index)
+        , m_argument_count(arguments.size())
+        , m_expression_string(expression_string)
+    {
+        for (size_t i = 0; i < arguments.size(); ++i)
+            m_arguments[i] = arguments[i];
+    }
+
+    size_t length() const { return length_impl(); }
+    size_t length_impl() const
+    {
+        return round_up_to_power_of_two(alignof(void*), sizeof(*this) + sizeof(Operand) * m_argument_count);
+    }
+
+    Operand dst() const { return m_dst; }
+    Operand callee() const { return m_callee; }
+    Operand base() const { return m_base; }
+    IdentifierTableIndex property() const { return m_property; }
+    u32 cache_index() const { return m_cache_index; }
+    Optional<StringTableIndex> const& expression_string() const { return m_expression_string; }
+
+    u32 argument_count() const { return m_argument_count; }
+
+    ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
+    ByteString to_byte_string_impl(Bytecode::Executable const&) const;
+    void visit_operands_impl(Function<void(Operand&)> visitor)
+    {
+        visitor(m_dst);
+        visitor(m_callee);
+        visitor(m_base);
+        for (size_t i = 0; i < m_argument_count; i++)
+            visitor(m_arguments[i]);
+    }
+
+private:
+    Operand m_dst;
+    Operand m_callee;
+    Operand m_base;
+    IdentifierTableIndex m_property;
+    Optional<IdentifierTableIndex> m_base_identifier;
+    u32 m_cache_index { 0 };
+    u32 m_argument_count { 0 };
+    Optional<StringTableIndex> m_expression_string;
+    Operand m_arguments[];
+};
+
 class CallBuiltin final : public Instruction {
 public:
     static constexpr bool IsVariableLength = true;
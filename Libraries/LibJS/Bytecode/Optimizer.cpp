@@ -0,0 +1,721 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/HashMap.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/IdentifierTable.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Optimizer.h>
+#include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Bytecode/StringTable.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS::Bytecode {
+
+enum class OperandLayout {
+    // The first operand is the destination, and is written after all other operands have been read.
+    WritesFirstOperand,
+    ReadsAllOperands,
+    Unknown,
+};
+
+static OperandLayout operand_layout_of(Instruction::Type type)
+{
+    switch (type) {
+    case Instruction::Type::Mov:
+    case Instruction::Type::GetById:
+    case Instruction::Type::Call:
+#define __BYTECODE_OP(OpTitleCase, ...) case Instruction::Type::OpTitleCase:
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        return OperandLayout::WritesFirstOperand;
+    case Instruction::Type::JumpIf:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined:
+    case Instruction::Type::End:
+    case Instruction::Type::Return:
+    case Instruction::Type::ThrowIfTDZ:
+    case Instruction::Type::ThrowIfNullish:
+    case Instruction::Type::ThrowIfNotObject:
+#define __BYTECODE_OP(OpTitleCase, ...) case Instruction::Type::Jump##OpTitleCase:
+        JS_ENUMERATE_COMPARISON_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        return OperandLayout::ReadsAllOperands;
+    default:
+        return OperandLayout::Unknown;
+    }
+}
+
+enum class OperandAccess {
+    Read,
+    Write,
+    Unknown,
+};
+
+static void visit_operands_with_access(Instruction& instruction, Function<void(Operand&, OperandAccess)> const& visitor)
+{
+    auto layout = operand_layout_of(instruction.type());
+    bool is_first_operand = true;
+    instruction.visit_operands([&](Operand& operand) {
+        if (layout == OperandLayout::Unknown)
+            visitor(operand, OperandAccess::Unknown);
+        else if (layout == OperandLayout::WritesFirstOperand && is_first_operand)
+            visitor(operand, OperandAccess::Write);
+        else
+            visitor(operand, OperandAccess::Read);
+        is_first_operand = false;
+    });
+}
+
+static Operand& first_operand(Instruction& instruction)
+{
+    Operand* first = nullptr;
+    instruction.visit_operands([&](Operand& operand) {
+        if (!first)
+            first = &operand;
+    });
+    VERIFY(first);
+    return *first;
+}
+
+static bool is_reserved_register(Operand const& operand)
+{
+    return operand.is_register() && operand.index() < Register::reserved_register_count;
+}
+
+// Temporaries are the registers handed out by Generator::allocate_register().
+static bool is_temporary(Operand const& operand)
+{
+    return operand.is_register() && !is_reserved_register(operand);
+}
+
+// Values in temporaries and locals can only change through instructions that name them as an operand.
+static bool is_tracked(Operand const& operand)
+{
+    return is_temporary(operand) || operand.is_local();
+}
+
+static u64 key_for(Operand const& operand)
+{
+    return (static_cast<u64>(operand.type()) << 32) | operand.index();
+}
+
+// Builds a new instruction stream for a basic block from its existing instructions.
+// Instructions are trivially relocatable, so kept instructions are simply copied over.
+class Optimizer::BlockRewriter {
+public:
+    explicit BlockRewriter(BasicBlock& block)
+        : m_block(block)
+    {
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+            m_offsets.append(it.offset());
+        m_buffer.ensure_capacity(block.size());
+    }
+
+    size_t instruction_count() const { return m_offsets.size(); }
+    Instruction& instruction(size_t index) { return *reinterpret_cast<Instruction*>(m_block.data() + m_offsets[index]); }
+    Optional<SourceRecord> source_record(size_t index) const { return m_block.source_map().get(m_offsets[index]); }
+
+    void keep(size_t index)
+    {
+        auto& instruction = this->instruction(index);
+        begin_instruction(index);
+        m_buffer.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+    }
+
+    void remove(size_t index)
+    {
+        Instruction::destroy(instruction(index));
+        m_changed = true;
+    }
+
+    // NOTE: The new instruction takes over the source range of the instruction it replaces.
+    template<typename OpType, typename... Args>
+    void replace(size_t index, size_t extra_operand_slots, Args&&... args)
+    {
+        auto offset = begin_instruction(index);
+        m_buffer.resize(offset + round_up_to_power_of_two(sizeof(OpType) + extra_operand_slots * sizeof(Operand), alignof(void*)));
+        new (m_buffer.data() + offset) OpType(forward<Args>(args)...);
+        Instruction::destroy(instruction(index));
+        m_changed = true;
+    }
+
+    void finish()
+    {
+        // NOTE: Operands may have been rewritten in place, which needs no new stream.
+        if (!m_changed)
+            return;
+        m_block.replace_instruction_stream({}, move(m_buffer), move(m_source_map), m_last_instruction_start_offset);
+    }
+
+private:
+    size_t begin_instruction(size_t index)
+    {
+        auto offset = m_buffer.size();
+        if (auto source_record = this->source_record(index); source_record.has_value())
+            m_source_map.set(offset, *source_record);
+        m_last_instruction_start_offset = offset;
+        return offset;
+    }
+
+    BasicBlock& m_block;
+    Vector<size_t> m_offsets;
+    Vector<u8> m_buffer;
+    HashMap<size_t, SourceRecord> m_source_map;
+    size_t m_last_instruction_start_offset { 0 };
+    bool m_changed { false };
+};
+
+Optimizer::Statistics Optimizer::optimize(Generator& generator, SourceCode const& source_code)
+{
+    Optimizer optimizer(generator, source_code);
+    optimizer.m_statistics.registers_before = generator.m_next_register;
+
+    if (g_dump_bytecode_passes)
+        optimizer.dump_basic_blocks("Before optimization"sv);
+
+    optimizer.run_pass("constant propagation"sv, [&] { optimizer.propagate_and_fold_constants(); });
+    optimizer.run_pass("unreachable block removal"sv, [&] { optimizer.remove_unreachable_blocks(); });
+    for (;;) {
+        bool changed = false;
+        optimizer.run_pass("move coalescing"sv, [&] { changed |= optimizer.coalesce_moves(); });
+        optimizer.run_pass("dead store removal"sv, [&] { changed |= optimizer.remove_dead_stores(); });
+        if (!changed)
+            break;
+    }
+    optimizer.run_pass("superinstruction fusion"sv, [&] { optimizer.fuse_superinstructions(); });
+    optimizer.run_pass("register compaction"sv, [&] { optimizer.compact_registers(); });
+
+    optimizer.m_statistics.registers_after = generator.m_next_register;
+    return optimizer.m_statistics;
+}
+
+template<typename Callback>
+void Optimizer::run_pass(StringView name, Callback callback)
+{
+    if (!g_dump_bytecode_passes) {
+        callback();
+        return;
+    }
+
+    auto statistics_before = m_statistics;
+    auto registers_before = m_generator.m_next_register;
+    callback();
+
+    if (statistics_before != m_statistics || registers_before != m_generator.m_next_register)
+        dump_basic_blocks(ByteString::formatted("After {}", name));
+}
+
+// Dumps the basic blocks as they are right now, in the middle of the single compilation.
+// NOTE: Nothing is linked yet, so labels are printed as block indices, and operands as the generator numbers them.
+void Optimizer::dump_basic_blocks(StringView title) const
+{
+    Vector<u8> bytecode;
+    Vector<size_t> basic_block_start_offsets;
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        basic_block_start_offsets.append(bytecode.size());
+        bytecode.append(block->instruction_stream().data(), block->size());
+    }
+
+    auto identifier_table = make<IdentifierTable>();
+    for (size_t i = 0; i < m_generator.m_identifier_table->size(); ++i)
+        identifier_table->insert(m_generator.m_identifier_table->get({ static_cast<u32>(i) }));
+    auto string_table = make<StringTable>();
+    for (size_t i = 0; i < m_generator.m_string_table->size(); ++i)
+        string_table->insert(m_generator.m_string_table->get({ static_cast<u32>(i) }));
+
+    // NOTE: The instructions in this executable are copies that still belong to the generator, so it must never run.
+    //       It has no registers, so that unlinked constant operands index straight into the constants table.
+    auto executable = m_generator.vm().heap().allocate<Executable>(
+        move(bytecode),
+        move(identifier_table),
+        move(string_table),
+        make<RegexTable>(),
+        Vector<Value> { m_generator.m_constants },
+        NonnullRefPtr<SourceCode const> { m_source_code },
+        m_generator.m_next_property_lookup_cache,
+        m_generator.m_next_global_variable_cache,
+        0,
+        false);
+    executable->basic_block_start_offsets = move(basic_block_start_offsets);
+    executable->local_variable_names = m_generator.m_local_variables;
+
+    warnln("\033[37;1m{}:\033[0m", title);
+    executable->dump();
+}
+
+void Optimizer::Statistics::dump() const
+{
+    warnln("\033[37;1mBytecode optimizer\033[0m");
+    warnln("  propagated constants:  {}", propagated_constants);
+    warnln("  folded instructions:   {}", folded_instructions);
+    warnln("  coalesced moves:       {}", coalesced_moves);
+    warnln("  removed dead stores:   {}", removed_dead_stores);
+    warnln("  fused instructions:    {}", fused_instructions);
+    warnln("  removed blocks:        {}", removed_blocks);
+    warnln("  registers:             {} -> {}", registers_before, registers_after);
+}
+
+// NOTE: We only fold operations on numbers, where none of these can throw or have observable side effects.
+static Optional<Value> fold_binary_operation(VM& vm, Instruction::Type type, Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+
+    switch (type) {
+    case Instruction::Type::Add:
+        return MUST(add(vm, lhs, rhs));
+    case Instruction::Type::Sub:
+        return MUST(sub(vm, lhs, rhs));
+    case Instruction::Type::Mul:
+        return MUST(mul(vm, lhs, rhs));
+    case Instruction::Type::Div:
+        return MUST(div(vm, lhs, rhs));
+    case Instruction::Type::Mod:
+        return MUST(mod(vm, lhs, rhs));
+    case Instruction::Type::Exp:
+        return MUST(exp(vm, lhs, rhs));
+    case Instruction::Type::BitwiseAnd:
+        return MUST(bitwise_and(vm, lhs, rhs));
+    case Instruction::Type::BitwiseOr:
+        return MUST(bitwise_or(vm, lhs, rhs));
+    case Instruction::Type::BitwiseXor:
+        return MUST(bitwise_xor(vm, lhs, rhs));
+    case Instruction::Type::LeftShift:
+        return MUST(left_shift(vm, lhs, rhs));
+    case Instruction::Type::RightShift:
+        return MUST(right_shift(vm, lhs, rhs));
+    case Instruction::Type::UnsignedRightShift:
+        return MUST(unsigned_right_shift(vm, lhs, rhs));
+    case Instruction::Type::LessThan:
+        return Value(MUST(less_than(vm, lhs, rhs)));
+    case Instruction::Type::LessThanEquals:
+        return Value(MUST(less_than_equals(vm, lhs, rhs)));
+    case Instruction::Type::GreaterThan:
+        return Value(MUST(greater_than(vm, lhs, rhs)));
+    case Instruction::Type::GreaterThanEquals:
+        return Value(MUST(greater_than_equals(vm, lhs, rhs)));
+    case Instruction::Type::LooselyEquals:
+    case Instruction::Type::StrictlyEquals:
+        return Value(is_strictly_equal(lhs, rhs));
+    case Instruction::Type::LooselyInequals:
+    case Instruction::Type::StrictlyInequals:
+        return Value(!is_strictly_equal(lhs, rhs));
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_unary_operation(VM& vm, Instruction::Type type, Value value)
+{
+    switch (type) {
+    case Instruction::Type::Not:
+        if (value.is_object())
+            return {};
+        return Value(!value.to_boolean());
+    case Instruction::Type::UnaryMinus:
+        if (!value.is_number())
+            return {};
+        return MUST(unary_minus(vm, value));
+    case Instruction::Type::UnaryPlus:
+        if (!value.is_number())
+            return {};
+        return MUST(unary_plus(vm, value));
+    case Instruction::Type::BitwiseNot:
+        if (!value.is_number())
+            return {};
+        return MUST(bitwise_not(vm, value));
+    default:
+        return {};
+    }
+}
+
+void Optimizer::propagate_and_fold_constants()
+{
+    auto& vm = m_generator.vm();
+
+    auto constant_value = [&](Operand const& operand) -> Optional<Value> {
+        if (!operand.is_constant())
+            return {};
+        auto value = m_generator.m_constants[operand.index()];
+        if (value.is_special_empty_value())
+            return {};
+        return value;
+    };
+
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        // Values of tracked operands that are known to be constant at the current instruction.
+        HashMap<u64, Operand> known_constants;
+        BlockRewriter rewriter(*block);
+
+        for (size_t i = 0; i < rewriter.instruction_count(); ++i) {
+            auto& instruction = rewriter.instruction(i);
+
+            visit_operands_with_access(instruction, [&](Operand& operand, OperandAccess access) {
+                if (access != OperandAccess::Read || !is_tracked(operand))
+                    return;
+                if (auto constant = known_constants.get(key_for(operand)); constant.has_value()) {
+                    operand = *constant;
+                    ++m_statistics.propagated_constants;
+                }
+            });
+
+            Optional<Value> folded_value;
+            Optional<bool> folded_condition;
+            Optional<Label> true_target;
+            Optional<Label> false_target;
+
+            switch (instruction.type()) {
+#define __BYTECODE_OP(OpTitleCase, ...)                                                                              \
+    case Instruction::Type::OpTitleCase: {                                                                           \
+        auto& op = static_cast<Op::OpTitleCase const&>(instruction);                                                 \
+        auto lhs = constant_value(op.lhs());                                                                         \
+        auto rhs = constant_value(op.rhs());                                                                         \
+        if (lhs.has_value() && rhs.has_value())                                                                      \
+            folded_value = fold_binary_operation(vm, Instruction::Type::OpTitleCase, *lhs, *rhs);                    \
+        break;                                                                                                       \
+    }
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BYTECODE_OP)
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(OpTitleCase, ...)                                                              \
+    case Instruction::Type::OpTitleCase: {                                                           \
+        auto& op = static_cast<Op::OpTitleCase const&>(instruction);                                 \
+        if (auto src = constant_value(op.src()); src.has_value())                                    \
+            folded_value = fold_unary_operation(vm, Instruction::Type::OpTitleCase, *src);           \
+        break;                                                                                       \
+    }
+                JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(OpTitleCase, ...)                                                                      \
+    case Instruction::Type::Jump##OpTitleCase: {                                                             \
+        auto& op = static_cast<Op::Jump##OpTitleCase const&>(instruction);                                   \
+        auto lhs = constant_value(op.lhs());                                                                 \
+        auto rhs = constant_value(op.rhs());                                                                 \
+        if (lhs.has_value() && rhs.has_value()) {                                                            \
+            auto result = fold_binary_operation(vm, Instruction::Type::OpTitleCase, *lhs, *rhs);             \
+            if (result.has_value())                                                                          \
+                folded_condition = result->as_bool();                                                        \
+        }                                                                                                    \
+        true_target = op.true_target();                                                                      \
+        false_target = op.false_target();                                                                    \
+        break;                                                                                               \
+    }
+                JS_ENUMERATE_COMPARISON_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+            case Instruction::Type::JumpIf: {
+                auto& op = static_cast<Op::JumpIf const&>(instruction);
+                if (auto condition = constant_value(op.condition()); condition.has_value() && !condition->is_object())
+                    folded_condition = condition->to_boolean();
+                true_target = op.true_target();
+                false_target = op.false_target();
+                break;
+            }
+            case Instruction::Type::JumpNullish: {
+                auto& op = static_cast<Op::JumpNullish const&>(instruction);
+                if (auto condition = constant_value(op.condition()); condition.has_value())
+                    folded_condition = condition->is_nullish();
+                true_target = op.true_target();
+                false_target = op.false_target();
+                break;
+            }
+            case Instruction::Type::JumpUndefined: {
+                auto& op = static_cast<Op::JumpUndefined const&>(instruction);
+                if (auto condition = constant_value(op.condition()); condition.has_value())
+                    folded_condition = condition->is_undefined();
+                true_target = op.true_target();
+                false_target = op.false_target();
+                break;
+            }
+            default:
+                break;
+            }
+
+            if (folded_value.has_value()) {
+                auto dst = first_operand(instruction);
+                auto constant = m_generator.add_constant(*folded_value).operand();
+                rewriter.replace<Op::Mov>(i, 0, dst, constant);
+                if (is_tracked(dst))
+                    known_constants.set(key_for(dst), constant);
+                ++m_statistics.folded_instructions;
+                continue;
+            }
+
+            if (folded_condition.has_value()) {
+                rewriter.replace<Op::Jump>(i, 0, *folded_condition ? *true_target : *false_target);
+                ++m_statistics.folded_instructions;
+                continue;
+            }
+
+            visit_operands_with_access(instruction, [&](Operand& operand, OperandAccess access) {
+                if (access != OperandAccess::Read)
+                    known_constants.remove(key_for(operand));
+            });
+            if (instruction.type() == Instruction::Type::Mov) {
+                auto& mov = static_cast<Op::Mov const&>(instruction);
+                if (is_tracked(mov.dst()) && mov.src().is_constant())
+                    known_constants.set(key_for(mov.dst()), mov.src());
+            }
+
+            rewriter.keep(i);
+        }
+
+        rewriter.finish();
+    }
+}
+
+void Optimizer::remove_unreachable_blocks()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+
+    Vector<bool> is_reachable;
+    is_reachable.resize(blocks.size());
+    Vector<size_t> work_list;
+    auto mark_reachable = [&](size_t index) {
+        if (is_reachable[index])
+            return;
+        is_reachable[index] = true;
+        work_list.append(index);
+    };
+
+    mark_reachable(0);
+    while (!work_list.is_empty()) {
+        auto& block = *blocks[work_list.take_last()];
+        if (block.handler())
+            mark_reachable(block.handler()->index());
+        if (block.finalizer())
+            mark_reachable(block.finalizer()->index());
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                mark_reachable(label.basic_block_index());
+            });
+        }
+    }
+
+    if (!is_reachable.contains_slow(false))
+        return;
+
+    Vector<u32> new_indices;
+    new_indices.resize(blocks.size());
+    Vector<NonnullOwnPtr<BasicBlock>> reachable_blocks;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!is_reachable[i]) {
+            ++m_statistics.removed_blocks;
+            continue;
+        }
+        new_indices[i] = reachable_blocks.size();
+        reachable_blocks.append(move(blocks[i]));
+    }
+
+    for (auto& block : reachable_blocks) {
+        block->set_index({}, new_indices[block->index()]);
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                label = Label { new_indices[label.basic_block_index()] };
+            });
+        }
+    }
+    blocks = move(reachable_blocks);
+}
+
+static void for_each_operand(Vector<NonnullOwnPtr<BasicBlock>>& blocks, Function<void(Operand&, OperandAccess)> const& callback)
+{
+    for (auto& block : blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it)
+            visit_operands_with_access(const_cast<Instruction&>(*it), callback);
+    }
+}
+
+// Merges a temporary into the instruction next to it:
+//
+//     Add tmp, a, b                          Add x, a, b
+//     Mov x, tmp                     =>
+//
+//     Mov tmp, a                             Call dst, f, this, a
+//     Call dst, f, this, tmp         =>
+//
+// This is only done when those two instructions are the only appearances of the temporary,
+// and relies on instructions reading all their inputs before writing their destination.
+bool Optimizer::coalesce_moves()
+{
+    HashMap<u32, size_t> appearances;
+    for_each_operand(m_generator.m_root_basic_blocks, [&](Operand& operand, OperandAccess) {
+        if (is_temporary(operand))
+            appearances.ensure(operand.index(), [] { return 0; })++;
+    });
+    auto is_only_used_in_pair = [&](Operand const& operand) {
+        return is_temporary(operand) && appearances.get(operand.index()).value_or(0) == 2;
+    };
+
+    bool changed = false;
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        BlockRewriter rewriter(*block);
+        for (size_t i = 0; i < rewriter.instruction_count(); ++i) {
+            auto& instruction = rewriter.instruction(i);
+            if (i + 1 == rewriter.instruction_count()) {
+                rewriter.keep(i);
+                continue;
+            }
+            auto& next = rewriter.instruction(i + 1);
+
+            if (next.type() == Instruction::Type::Mov && operand_layout_of(instruction.type()) == OperandLayout::WritesFirstOperand) {
+                auto& dst = first_operand(instruction);
+                auto& mov = static_cast<Op::Mov const&>(next);
+                if (mov.src() == dst && is_only_used_in_pair(dst) && is_tracked(mov.dst())) {
+                    appearances.remove(dst.index());
+                    dst = mov.dst();
+                    rewriter.keep(i);
+                    rewriter.remove(i + 1);
+                    ++i;
+                    ++m_statistics.coalesced_moves;
+                    changed = true;
+                    continue;
+                }
+            }
+
+            if (instruction.type() == Instruction::Type::Mov && operand_layout_of(next.type()) != OperandLayout::Unknown) {
+                auto& mov = static_cast<Op::Mov const&>(instruction);
+                auto temporary = mov.dst();
+                auto source = mov.src();
+                if (is_only_used_in_pair(temporary)) {
+                    bool did_substitute = false;
+                    visit_operands_with_access(next, [&](Operand& operand, OperandAccess access) {
+                        if (access == OperandAccess::Read && operand == temporary) {
+                            operand = source;
+                            did_substitute = true;
+                        }
+                    });
+                    if (did_substitute) {
+                        appearances.remove(temporary.index());
+                        rewriter.remove(i);
+                        ++m_statistics.coalesced_moves;
+                        changed = true;
+                        continue;
+                    }
+                }
+            }
+
+            rewriter.keep(i);
+        }
+        rewriter.finish();
+    }
+    return changed;
+}
+
+// Removes moves to themselves, and moves into temporaries that are never read.
+bool Optimizer::remove_dead_stores()
+{
+    HashTable<u32> read_temporaries;
+    for_each_operand(m_generator.m_root_basic_blocks, [&](Operand& operand, OperandAccess access) {
+        if (is_temporary(operand) && access != OperandAccess::Write)
+            read_temporaries.set(operand.index());
+    });
+
+    bool changed = false;
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        BlockRewriter rewriter(*block);
+        for (size_t i = 0; i < rewriter.instruction_count(); ++i) {
+            auto& instruction = rewriter.instruction(i);
+            if (instruction.type() == Instruction::Type::Mov) {
+                auto& mov = static_cast<Op::Mov const&>(instruction);
+                if (mov.dst() == mov.src() || (is_temporary(mov.dst()) && !read_temporaries.contains(mov.dst().index()))) {
+                    rewriter.remove(i);
+                    ++m_statistics.removed_dead_stores;
+                    changed = true;
+                    continue;
+                }
+            }
+            rewriter.keep(i);
+        }
+        rewriter.finish();
+    }
+    return changed;
+}
+
+// Fuses the `GetById callee, base, property` + `Call dst, callee, base, ...` pair of method calls into GetByIdAndCall.
+void Optimizer::fuse_superinstructions()
+{
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        BlockRewriter rewriter(*block);
+        for (size_t i = 0; i < rewriter.instruction_count(); ++i) {
+            auto& instruction = rewriter.instruction(i);
+            if (instruction.type() != Instruction::Type::GetById || i + 1 == rewriter.instruction_count()
+                || rewriter.instruction(i + 1).type() != Instruction::Type::Call) {
+                rewriter.keep(i);
+                continue;
+            }
+
+            auto& get_by_id = static_cast<Op::GetById const&>(instruction);
+            auto& call = static_cast<Op::Call const&>(rewriter.instruction(i + 1));
+            if (call.callee() != get_by_id.dst() || call.this_value() != get_by_id.base() || get_by_id.dst() == get_by_id.base()) {
+                rewriter.keep(i);
+                continue;
+            }
+
+            // NOTE: The fused instruction carries the source range of the call, so errors thrown by either half are
+            //       reported there. Only fuse when the property lookup was emitted for that same range, which is the
+            //       case for `base.property(...)`, so that no error location changes.
+            if (rewriter.source_record(i) != rewriter.source_record(i + 1)) {
+                rewriter.keep(i);
+                continue;
+            }
+
+            auto callee = get_by_id.dst();
+            auto base = get_by_id.base();
+            auto property = get_by_id.property();
+            auto base_identifier = get_by_id.base_identifier();
+            auto cache_index = get_by_id.cache_index();
+            rewriter.remove(i);
+
+            Vector<Operand> arguments;
+            arguments.append(call.arguments().data(), call.arguments().size());
+            rewriter.replace<Op::GetByIdAndCall>(i + 1, arguments.size(), call.dst(), callee, base, property, move(base_identifier), cache_index, arguments.span(), call.expression_string());
+            ++i;
+            ++m_statistics.fused_instructions;
+        }
+        rewriter.finish();
+    }
+}
+
+// Renumbers the temporaries that are still in use densely, to shrink the register file of the executable.
+void Optimizer::compact_registers()
+{
+    Vector<bool> is_used;
+    is_used.resize(m_generator.m_next_register);
+    for_each_operand(m_generator.m_root_basic_blocks, [&](Operand& operand, OperandAccess) {
+        if (operand.is_register())
+            is_used[operand.index()] = true;
+    });
+
+    Vector<u32> new_indices;
+    new_indices.resize(m_generator.m_next_register);
+    u32 next_register = Register::reserved_register_count;
+    for (u32 i = 0; i < m_generator.m_next_register; ++i) {
+        if (i < Register::reserved_register_count)
+            new_indices[i] = i;
+        else if (is_used[i])
+            new_indices[i] = next_register++;
+    }
+
+    if (next_register == m_generator.m_next_register)
+        return;
+
+    for_each_operand(m_generator.m_root_basic_blocks, [&](Operand& operand, OperandAccess) {
+        if (operand.is_register())
+            operand = Operand { Register { new_indices[operand.index()] } };
+    });
+    m_generator.m_next_register = next_register;
+}
+
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// Rewrites the basic blocks of a Generator in place, after code generation and before linking.
+//
+// Operands carry no def/use information, so the passes are deliberately local: values are only
+// propagated within a basic block, and temporary registers are only coalesced when all of their
+// appearances in the whole function are accounted for. Locals and arguments are never removed.
+//
+// With g_dump_bytecode_passes, the basic blocks are dumped before the first pass and after every pass that changed them.
+class Optimizer {
+public:
+    struct Statistics {
+        size_t propagated_constants { 0 };
+        size_t folded_instructions { 0 };
+        size_t coalesced_moves { 0 };
+        size_t removed_dead_stores { 0 };
+        size_t fused_instructions { 0 };
+        size_t removed_blocks { 0 };
+        u32 registers_before { 0 };
+        u32 registers_after { 0 };
+
+        void dump() const;
+        bool operator==(Statistics const&) const = default;
+    };
+
+    static Statistics optimize(Generator&, SourceCode const&);
+
+private:
+    class BlockRewriter;
+
+    Optimizer(Generator& generator, SourceCode const& source_code)
+        : m_generator(generator)
+        , m_source_code(source_code)
+    {
+    }
+
+    template<typename Callback>
+    void run_pass(StringView name, Callback);
+    void dump_basic_blocks(StringView title) const;
+
+    void propagate_and_fold_constants();
+    void remove_unreachable_blocks();
+    bool coalesce_moves();
+    bool remove_dead_stores();
+    void fuse_superinstructions();
+    void compact_registers();
+
+    Generator& m_generator;
+    SourceCode const& m_source_code;
+    Statistics m_statistics;
+};
+
+}
@@ -8,8 +8,16 @@
 #pragma once
 
 #include <AK/Concepts.h>
+#include <AK/Platform.h>
 #include <AK/Types.h>
 
+// The baseline JIT emits x86-64 code for the System V calling convention, see LibJS/CMakeLists.txt.
+#if ARCH(X86_64) && !defined(AK_OS_WINDOWS)
+#    define JS_HAS_BASELINE_JIT 1
+#else
+#    define JS_HAS_BASELINE_JIT 0
+#endif
+
 #define JS_DECLARE_NATIVE_FUNCTION(name) \
     static JS::ThrowCompletionOr<JS::Value> name(JS::VM&)
 
@@ -328,9 +336,17 @@ class Generator;
 class Instruction;
 class Interpreter;
 class Operand;
+class Optimizer;
 class RegexTable;
 class Register;
 
 }
 
+namespace JIT {
+
+class Compiler;
+class NativeExecutable;
+
+}
+
 }
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace JS::JIT {
+
+// A tiny x86-64 assembler with just the instructions the baseline JIT needs.
+// All memory operands are of the form [base + disp32].
+class Assembler {
+public:
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+        SignedLessThan = 0xc,
+        SignedGreaterThanOrEqual = 0xd,
+        SignedLessThanOrEqual = 0xe,
+        SignedGreaterThan = 0xf,
+    };
+
+    struct Label {
+        Optional<size_t> offset;
+        Vector<size_t> jump_fixups;
+    };
+
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    size_t size() const { return m_output.size(); }
+
+    void bind(Label& label)
+    {
+        VERIFY(!label.offset.has_value());
+        label.offset = m_output.size();
+        for (auto fixup : label.jump_fixups)
+            patch_rel32(fixup, m_output.size());
+        label.jump_fixups.clear();
+    }
+
+    // Patches the rel32 displacement ending at `end_of_displacement` to point at `target`.
+    void patch_rel32(size_t end_of_displacement, size_t target)
+    {
+        i32 displacement = static_cast<i32>(static_cast<i64>(target) - static_cast<i64>(end_of_displacement));
+        for (size_t i = 0; i < 4; ++i)
+            m_output[end_of_displacement - 4 + i] = static_cast<u8>(displacement >> (i * 8));
+    }
+
+    void mov_imm64(Reg dst, u64 imm)
+    {
+        emit_rex(true, 0, to_underlying(dst));
+        emit8(0xb8 | (to_underlying(dst) & 7));
+        emit64(imm);
+    }
+
+    void mov_imm32(Reg dst, u32 imm)
+    {
+        emit_rex_if_needed(false, 0, to_underlying(dst));
+        emit8(0xb8 | (to_underlying(dst) & 7));
+        emit32(imm);
+    }
+
+    // mov dst, [base + offset]
+    void load64(Reg dst, Reg base, i32 offset)
+    {
+        emit_rex(true, to_underlying(dst), to_underlying(base));
+        emit8(0x8b);
+        emit_memory_operand(to_underlying(dst), base, offset);
+    }
+
+    // mov [base + offset], src
+    void store64(Reg base, i32 offset, Reg src)
+    {
+        emit_rex(true, to_underlying(src), to_underlying(base));
+        emit8(0x89);
+        emit_memory_operand(to_underlying(src), base, offset);
+    }
+
+    void mov64(Reg dst, Reg src) { emit_register_operation(true, 0x89, src, dst); }
+
+    // NOTE: Like all 32-bit operations on x86-64, this clears the upper half of dst.
+    void mov32(Reg dst, Reg src) { emit_register_operation(false, 0x89, src, dst); }
+
+    void add32(Reg dst, Reg src) { emit_register_operation(false, 0x01, src, dst); }
+    void sub32(Reg dst, Reg src) { emit_register_operation(false, 0x29, src, dst); }
+    void and32(Reg dst, Reg src) { emit_register_operation(false, 0x21, src, dst); }
+    void or32(Reg dst, Reg src) { emit_register_operation(false, 0x09, src, dst); }
+    void xor32(Reg dst, Reg src) { emit_register_operation(false, 0x31, src, dst); }
+    void cmp32(Reg lhs, Reg rhs) { emit_register_operation(false, 0x39, rhs, lhs); }
+    void test32(Reg lhs, Reg rhs) { emit_register_operation(false, 0x85, rhs, lhs); }
+
+    void or64(Reg dst, Reg src) { emit_register_operation(true, 0x09, src, dst); }
+    void cmp64(Reg lhs, Reg rhs) { emit_register_operation(true, 0x39, rhs, lhs); }
+    void test64(Reg lhs, Reg rhs) { emit_register_operation(true, 0x85, rhs, lhs); }
+
+    void add32_imm(Reg dst, i32 imm) { emit_immediate_operation(false, 0, dst, imm); }
+    void and32_imm(Reg dst, i32 imm) { emit_immediate_operation(false, 4, dst, imm); }
+    void cmp32_imm(Reg lhs, i32 imm) { emit_immediate_operation(false, 7, lhs, imm); }
+    void add64_imm(Reg dst, i32 imm) { emit_immediate_operation(true, 0, dst, imm); }
+    void sub64_imm(Reg dst, i32 imm) { emit_immediate_operation(true, 5, dst, imm); }
+    void cmp64_imm(Reg lhs, i32 imm) { emit_immediate_operation(true, 7, lhs, imm); }
+
+    void shr64_imm(Reg dst, u8 imm)
+    {
+        emit_rex(true, 0, to_underlying(dst));
+        emit8(0xc1);
+        emit_modrm(0b11, 5, to_underlying(dst));
+        emit8(imm);
+    }
+
+    // setcc dst8; movzx dst, dst8
+    void set_if(Condition condition, Reg dst)
+    {
+        // NOTE: A REX prefix is needed to address SIL/DIL/SPL/BPL instead of AH/CH/DH/BH.
+        if (to_underlying(dst) >= 4)
+            emit8(0x40 | ((to_underlying(dst) >> 3) & 1));
+        emit8(0x0f);
+        emit8(0x90 | to_underlying(condition));
+        emit_modrm(0b11, 0, to_underlying(dst));
+
+        emit_rex_if_needed(false, to_underlying(dst), to_underlying(dst), to_underlying(dst) >= 4);
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm(0b11, to_underlying(dst), to_underlying(dst));
+    }
+
+    void push(Reg reg)
+    {
+        emit_rex_if_needed(false, 0, to_underlying(reg));
+        emit8(0x50 | (to_underlying(reg) & 7));
+    }
+
+    void pop(Reg reg)
+    {
+        emit_rex_if_needed(false, 0, to_underlying(reg));
+        emit8(0x58 | (to_underlying(reg) & 7));
+    }
+
+    void call(Reg target)
+    {
+        emit_rex_if_needed(false, 0, to_underlying(target));
+        emit8(0xff);
+        emit_modrm(0b11, 2, to_underlying(target));
+    }
+
+    void jump(Reg target)
+    {
+        emit_rex_if_needed(false, 0, to_underlying(target));
+        emit8(0xff);
+        emit_modrm(0b11, 4, to_underlying(target));
+    }
+
+    void jump(Label& label)
+    {
+        emit8(0xe9);
+        emit_rel32_to(label);
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        emit_rel32_to(label);
+    }
+
+    // Emits a jump whose target is filled in later with patch_rel32(). Returns the fixup offset.
+    size_t jump_to_be_patched()
+    {
+        emit8(0xe9);
+        emit32(0);
+        return m_output.size();
+    }
+
+    size_t jump_if_to_be_patched(Condition condition)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        emit32(0);
+        return m_output.size();
+    }
+
+    void ret() { emit8(0xc3); }
+
+private:
+    void emit8(u8 value) { m_output.append(value); }
+
+    void emit32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    void emit64(u64 value)
+    {
+        for (size_t i = 0; i < 8; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    void emit_rel32_to(Label& label)
+    {
+        emit32(0);
+        if (label.offset.has_value())
+            patch_rel32(m_output.size(), *label.offset);
+        else
+            label.jump_fixups.append(m_output.size());
+    }
+
+    void emit_rex(bool w, u8 reg, u8 rm)
+    {
+        emit8(0x40 | (w ? 0x08 : 0) | (((reg >> 3) & 1) << 2) | ((rm >> 3) & 1));
+    }
+
+    void emit_rex_if_needed(bool w, u8 reg, u8 rm, bool force = false)
+    {
+        if (w || force || reg >= 8 || rm >= 8)
+            emit_rex(w, reg, rm);
+    }
+
+    void emit_modrm(u8 mod, u8 reg, u8 rm)
+    {
+        emit8(static_cast<u8>((mod << 6) | ((reg & 7) << 3) | (rm & 7)));
+    }
+
+    void emit_memory_operand(u8 reg, Reg base, i32 offset)
+    {
+        // NOTE: We always use a 32-bit displacement, which also sidesteps the special meaning of RBP/R13 with mod=00.
+        emit_modrm(0b10, reg, to_underlying(base));
+        // RSP/R12 as base require a SIB byte.
+        if ((to_underlying(base) & 7) == 4)
+            emit8(0x24);
+        emit32(static_cast<u32>(offset));
+    }
+
+    // <op> dst, src
+    void emit_register_operation(bool w, u8 opcode, Reg src, Reg dst)
+    {
+        emit_rex_if_needed(w, to_underlying(src), to_underlying(dst));
+        emit8(opcode);
+        emit_modrm(0b11, to_underlying(src), to_underlying(dst));
+    }
+
+    // <op> dst, imm32 (group 1: 0=add, 4=and, 5=sub, 7=cmp)
+    void emit_immediate_operation(bool w, u8 extension, Reg dst, i32 imm)
+    {
+        emit_rex_if_needed(w, 0, to_underlying(dst));
+        emit8(0x81);
+        emit_modrm(0b11, extension, to_underlying(dst));
+        emit32(static_cast<u32>(imm));
+    }
+
+    Vector<u8>& m_output;
+};
+
+}
@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/StringView.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/Value.h>
+#include <stdlib.h>
+
+#if !JS_HAS_BASELINE_JIT
+#    error "The baseline JIT only supports x86-64 with the System V calling convention"
+#endif
+
+namespace JS::JIT {
+
+using Reg = Assembler::Reg;
+using Condition = Assembler::Condition;
+
+// Registers that stay live for the whole native function. Both are callee-saved in the System V ABI.
+static constexpr auto INTERPRETER = Reg::R12;
+static constexpr auto REGISTER_FILE = Reg::R14;
+
+// Executables are only compiled after they have been run this many times.
+static constexpr u32 jit_compilation_threshold = 16;
+
+enum class JITMode {
+    Disabled,
+    WhenHot,
+    Always,
+};
+
+// The JIT is off unless LIBJS_JIT is set. LIBJS_JIT=1 (or "on") compiles executables once they're hot, and
+// LIBJS_JIT=force compiles every executable on its first run.
+static JITMode jit_mode()
+{
+    static JITMode const mode = [] {
+        auto const* value = getenv("LIBJS_JIT");
+        if (!value)
+            return JITMode::Disabled;
+        auto string = StringView { value, strlen(value) };
+        if (string == "1"sv || string == "on"sv)
+            return JITMode::WhenHot;
+        if (string == "force"sv)
+            return JITMode::Always;
+        return JITMode::Disabled;
+    }();
+    return mode;
+}
+
+NativeExecutable* Compiler::native_executable_for(Bytecode::Executable& executable)
+{
+    // NOTE: Native code doesn't count the instructions it executes, so stay in the interpreter when we're counting.
+    if constexpr (JS_BYTECODE_INSTRUCTION_COUNT_DEBUG)
+        return nullptr;
+
+    if (executable.native_executable)
+        return executable.native_executable.ptr();
+    if (executable.did_try_jit_compilation)
+        return nullptr;
+
+    switch (jit_mode()) {
+    case JITMode::Disabled:
+        return nullptr;
+    case JITMode::WhenHot:
+        if (++executable.number_of_runs_before_jit_compilation < jit_compilation_threshold)
+            return nullptr;
+        break;
+    case JITMode::Always:
+        break;
+    }
+
+    executable.did_try_jit_compilation = true;
+    executable.native_executable = compile(executable);
+    return executable.native_executable.ptr();
+}
+
+Compiler::Compiler(Bytecode::Executable& executable)
+    : m_executable(executable)
+    , m_assembler(m_output)
+{
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& executable)
+{
+    Compiler compiler { executable };
+    if (!compiler.compile_executable()) {
+        dbgln_if(JS_BYTECODE_DEBUG, "JIT: Failed to compile executable \"{}\"", executable.name);
+        return nullptr;
+    }
+
+    dbgln_if(JS_BYTECODE_DEBUG, "JIT: Compiled executable \"{}\" ({} bytes of bytecode -> {} bytes of native code)", executable.name, executable.bytecode.size(), compiler.m_output.size());
+    return NativeExecutable::create(compiler.m_output, move(compiler.m_native_offsets_for_bytecode_offsets));
+}
+
+bool Compiler::compile_executable()
+{
+    // Prologue: void entry(Interpreter*, Value* register_file, void const* native_address_to_start_at)
+    m_assembler.push(Reg::RBP);
+    m_assembler.mov64(Reg::RBP, Reg::RSP);
+    m_assembler.push(Reg::RBX);
+    m_assembler.push(Reg::R12);
+    m_assembler.push(Reg::R13);
+    m_assembler.push(Reg::R14);
+    m_assembler.push(Reg::R15);
+    // NOTE: Keep the stack 16-byte aligned for the helper calls.
+    m_assembler.sub64_imm(Reg::RSP, 8);
+    m_assembler.mov64(INTERPRETER, Reg::RDI);
+    m_assembler.mov64(REGISTER_FILE, Reg::RSI);
+    m_assembler.jump(Reg::RDX);
+
+    // Helpers that can divert control flow return either exit_from_executable or a native address.
+    m_assembler.bind(m_dispatch);
+    m_assembler.cmp64_imm(Reg::RAX, exit_from_executable);
+    m_assembler.jump_if(Condition::Equal, m_exit);
+    m_assembler.jump(Reg::RAX);
+
+    m_assembler.bind(m_exit);
+    m_assembler.add64_imm(Reg::RSP, 8);
+    m_assembler.pop(Reg::R15);
+    m_assembler.pop(Reg::R14);
+    m_assembler.pop(Reg::R13);
+    m_assembler.pop(Reg::R12);
+    m_assembler.pop(Reg::RBX);
+    m_assembler.pop(Reg::RBP);
+    m_assembler.ret();
+
+    for (Bytecode::InstructionStreamIterator it(m_executable.bytecode, &m_executable); !it.at_end(); ++it) {
+        auto offset = it.offset();
+        m_native_offsets_for_bytecode_offsets.set(offset, m_assembler.size());
+
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+#define __BYTECODE_OP(op)                                                               \
+    case Bytecode::Instruction::Type::op:                                               \
+        compile_instruction(static_cast<Bytecode::Op::op const&>(instruction), offset); \
+        break;
+            ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        }
+    }
+
+    for (auto const& jump : m_bytecode_jumps) {
+        auto native_offset = m_native_offsets_for_bytecode_offsets.get(jump.bytecode_target);
+        if (!native_offset.has_value())
+            return false;
+        m_assembler.patch_rel32(jump.end_of_displacement, *native_offset);
+    }
+    return true;
+}
+
+void Compiler::emit_load(Reg reg, Bytecode::Operand operand)
+{
+    m_assembler.load64(reg, REGISTER_FILE, static_cast<i32>(operand.index() * sizeof(Value)));
+}
+
+void Compiler::emit_store(Bytecode::Operand operand, Reg reg)
+{
+    m_assembler.store64(REGISTER_FILE, static_cast<i32>(operand.index() * sizeof(Value)), reg);
+}
+
+void Compiler::emit_jump_to(size_t bytecode_offset)
+{
+    m_bytecode_jumps.append({ m_assembler.jump_to_be_patched(), bytecode_offset });
+}
+
+void Compiler::emit_jump_if_to(Condition condition, size_t bytecode_offset)
+{
+    m_bytecode_jumps.append({ m_assembler.jump_if_to_be_patched(condition), bytecode_offset });
+}
+
+// NOTE: Clobbers RDX.
+void Compiler::emit_branch_if_not_int32(Reg value, Assembler::Label& slow_case)
+{
+    m_assembler.mov64(Reg::RDX, value);
+    m_assembler.shr64_imm(Reg::RDX, GC::TAG_SHIFT);
+    m_assembler.cmp32_imm(Reg::RDX, INT32_TAG);
+    m_assembler.jump_if(Condition::NotEqual, slow_case);
+}
+
+// NOTE: Expects the upper half of `reg` to be zero, and clobbers RDX.
+void Compiler::emit_box_int32(Reg reg)
+{
+    m_assembler.mov_imm64(Reg::RDX, SHIFTED_INT32_TAG);
+    m_assembler.or64(reg, Reg::RDX);
+}
+
+// NOTE: Expects `reg` to be 0 or 1, and clobbers RDX.
+void Compiler::emit_box_boolean(Reg reg)
+{
+    m_assembler.mov_imm64(Reg::RDX, SHIFTED_BOOLEAN_TAG);
+    m_assembler.or64(reg, Reg::RDX);
+}
+
+template<typename Helper>
+void Compiler::emit_call_helper(Helper* helper, u64 first_argument, u64 second_argument)
+{
+    m_assembler.mov64(Reg::RDI, INTERPRETER);
+    m_assembler.mov_imm64(Reg::RSI, first_argument);
+    m_assembler.mov_imm64(Reg::RDX, second_argument);
+    m_assembler.mov_imm64(Reg::RAX, reinterpret_cast<FlatPtr>(helper));
+    m_assembler.call(Reg::RAX);
+}
+
+template<typename OpType>
+void Compiler::emit_call_generic_instruction(OpType const& instruction)
+{
+    emit_call_helper(&execute_instruction<OpType>, reinterpret_cast<FlatPtr>(&instruction));
+    using ReturnType = decltype(instruction.execute_impl(declval<Bytecode::Interpreter&>()));
+    if constexpr (!IsSame<ReturnType, void>) {
+        m_assembler.test64(Reg::RAX, Reg::RAX);
+        m_assembler.jump_if(Condition::NotEqual, m_dispatch);
+    }
+}
+
+void Compiler::emit_branch_on_truthiness(Bytecode::Operand condition, Optional<size_t> true_target, Optional<size_t> false_target)
+{
+    Assembler::Label have_boolean;
+    emit_load(Reg::RAX, condition);
+    m_assembler.mov64(Reg::RCX, Reg::RAX);
+    m_assembler.shr64_imm(Reg::RCX, GC::TAG_SHIFT);
+    m_assembler.cmp32_imm(Reg::RCX, BOOLEAN_TAG);
+    m_assembler.jump_if(Condition::Equal, have_boolean);
+    emit_call_helper(&to_boolean, condition.index());
+    m_assembler.bind(have_boolean);
+    m_assembler.test32(Reg::RAX, Reg::RAX);
+
+    if (true_target.has_value()) {
+        emit_jump_if_to(Condition::NotEqual, *true_target);
+        if (false_target.has_value())
+            emit_jump_to(*false_target);
+    } else {
+        VERIFY(false_target.has_value());
+        emit_jump_if_to(Condition::Equal, *false_target);
+    }
+}
+
+template<typename OpType>
+void Compiler::compile_int32_binary_arithmetic(OpType const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+    emit_load(Reg::RAX, instruction.lhs());
+    emit_load(Reg::RCX, instruction.rhs());
+    emit_branch_if_not_int32(Reg::RAX, slow_case);
+    emit_branch_if_not_int32(Reg::RCX, slow_case);
+
+    if constexpr (IsSame<OpType, Bytecode::Op::Add>) {
+        m_assembler.add32(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(Condition::Overflow, slow_case);
+    } else if constexpr (IsSame<OpType, Bytecode::Op::Sub>) {
+        m_assembler.sub32(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(Condition::Overflow, slow_case);
+    } else if constexpr (IsSame<OpType, Bytecode::Op::BitwiseAnd>) {
+        m_assembler.and32(Reg::RAX, Reg::RCX);
+    } else if constexpr (IsSame<OpType, Bytecode::Op::BitwiseOr>) {
+        m_assembler.or32(Reg::RAX, Reg::RCX);
+    } else if constexpr (IsSame<OpType, Bytecode::Op::BitwiseXor>) {
+        m_assembler.xor32(Reg::RAX, Reg::RCX);
+    } else {
+        static_assert(DependentFalse<OpType>);
+    }
+
+    emit_box_int32(Reg::RAX);
+    emit_store(instruction.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    m_assembler.bind(slow_case);
+    emit_call_generic_instruction(instruction);
+    m_assembler.bind(done);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison(OpType const& instruction, Condition condition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+    emit_load(Reg::RAX, instruction.lhs());
+    emit_load(Reg::RCX, instruction.rhs());
+    emit_branch_if_not_int32(Reg::RAX, slow_case);
+    emit_branch_if_not_int32(Reg::RCX, slow_case);
+
+    m_assembler.cmp32(Reg::RAX, Reg::RCX);
+    m_assembler.set_if(condition, Reg::RAX);
+    emit_box_boolean(Reg::RAX);
+    emit_store(instruction.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    m_assembler.bind(slow_case);
+    emit_call_generic_instruction(instruction);
+    m_assembler.bind(done);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison_and_jump(OpType const& instruction, Condition condition)
+{
+    Assembler::Label slow_case;
+    emit_load(Reg::RAX, instruction.lhs());
+    emit_load(Reg::RCX, instruction.rhs());
+    emit_branch_if_not_int32(Reg::RAX, slow_case);
+    emit_branch_if_not_int32(Reg::RCX, slow_case);
+
+    m_assembler.cmp32(Reg::RAX, Reg::RCX);
+    emit_jump_if_to(condition, instruction.true_target().address());
+    emit_jump_to(instruction.false_target().address());
+
+    m_assembler.bind(slow_case);
+    emit_call_helper(&execute_comparison_and_jump<OpType>, reinterpret_cast<FlatPtr>(&instruction));
+    m_assembler.test64(Reg::RAX, Reg::RAX);
+    emit_jump_if_to(Condition::Equal, instruction.false_target().address());
+    m_assembler.cmp64_imm(Reg::RAX, condition_is_true);
+    emit_jump_if_to(Condition::Equal, instruction.true_target().address());
+    m_assembler.jump(m_dispatch);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_increment_or_decrement(OpType const& instruction, i32 delta)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+    emit_load(Reg::RAX, instruction.dst());
+    emit_branch_if_not_int32(Reg::RAX, slow_case);
+    m_assembler.add32_imm(Reg::RAX, delta);
+    m_assembler.jump_if(Condition::Overflow, slow_case);
+    emit_box_int32(Reg::RAX);
+    emit_store(instruction.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    m_assembler.bind(slow_case);
+    emit_call_generic_instruction(instruction);
+    m_assembler.bind(done);
+}
+
+template<typename OpType>
+void Compiler::compile_instruction(OpType const& instruction, size_t offset)
+{
+    using namespace Bytecode::Op;
+
+    if constexpr (IsSame<OpType, Mov>) {
+        emit_load(Reg::RAX, instruction.src());
+        emit_store(instruction.dst(), Reg::RAX);
+    } else if constexpr (IsSame<OpType, End>) {
+        emit_load(Reg::RAX, instruction.value());
+        emit_store(Bytecode::Operand(Bytecode::Register::accumulator()), Reg::RAX);
+        m_assembler.jump(m_exit);
+    } else if constexpr (IsSame<OpType, Jump>) {
+        emit_jump_to(instruction.target().address());
+    } else if constexpr (IsSame<OpType, JumpIf>) {
+        emit_branch_on_truthiness(instruction.condition(), instruction.true_target().address(), instruction.false_target().address());
+    } else if constexpr (IsSame<OpType, JumpTrue>) {
+        emit_branch_on_truthiness(instruction.condition(), instruction.target().address(), {});
+    } else if constexpr (IsSame<OpType, JumpFalse>) {
+        emit_branch_on_truthiness(instruction.condition(), {}, instruction.target().address());
+    } else if constexpr (IsSame<OpType, JumpNullish>) {
+        emit_load(Reg::RAX, instruction.condition());
+        m_assembler.shr64_imm(Reg::RAX, GC::TAG_SHIFT);
+        m_assembler.and32_imm(Reg::RAX, IS_NULLISH_EXTRACT_PATTERN);
+        m_assembler.cmp32_imm(Reg::RAX, IS_NULLISH_PATTERN);
+        emit_jump_if_to(Condition::Equal, instruction.true_target().address());
+        emit_jump_to(instruction.false_target().address());
+    } else if constexpr (IsSame<OpType, JumpUndefined>) {
+        emit_load(Reg::RAX, instruction.condition());
+        m_assembler.mov_imm64(Reg::RCX, js_undefined().encoded());
+        m_assembler.cmp64(Reg::RAX, Reg::RCX);
+        emit_jump_if_to(Condition::Equal, instruction.true_target().address());
+        emit_jump_to(instruction.false_target().address());
+    } else if constexpr (IsSame<OpType, JumpLessThan>) {
+        compile_int32_comparison_and_jump(instruction, Condition::SignedLessThan);
+    } else if constexpr (IsSame<OpType, JumpLessThanEquals>) {
+        compile_int32_comparison_and_jump(instruction, Condition::SignedLessThanOrEqual);
+    } else if constexpr (IsSame<OpType, JumpGreaterThan>) {
+        compile_int32_comparison_and_jump(instruction, Condition::SignedGreaterThan);
+    } else if constexpr (IsSame<OpType, JumpGreaterThanEquals>) {
+        compile_int32_comparison_and_jump(instruction, Condition::SignedGreaterThanOrEqual);
+    } else if constexpr (IsOneOf<OpType, JumpLooselyEquals, JumpStrictlyEquals>) {
+        compile_int32_comparison_and_jump(instruction, Condition::Equal);
+    } else if constexpr (IsOneOf<OpType, JumpLooselyInequals, JumpStrictlyInequals>) {
+        compile_int32_comparison_and_jump(instruction, Condition::NotEqual);
+    } else if constexpr (IsOneOf<OpType, Add, Sub, BitwiseAnd, BitwiseOr, BitwiseXor>) {
+        compile_int32_binary_arithmetic(instruction);
+    } else if constexpr (IsSame<OpType, LessThan>) {
+        compile_int32_comparison(instruction, Condition::SignedLessThan);
+    } else if constexpr (IsSame<OpType, LessThanEquals>) {
+        compile_int32_comparison(instruction, Condition::SignedLessThanOrEqual);
+    } else if constexpr (IsSame<OpType, GreaterThan>) {
+        compile_int32_comparison(instruction, Condition::SignedGreaterThan);
+    } else if constexpr (IsSame<OpType, GreaterThanEquals>) {
+        compile_int32_comparison(instruction, Condition::SignedGreaterThanOrEqual);
+    } else if constexpr (IsOneOf<OpType, LooselyEquals, StrictlyEquals>) {
+        compile_int32_comparison(instruction, Condition::Equal);
+    } else if constexpr (IsOneOf<OpType, LooselyInequals, StrictlyInequals>) {
+        compile_int32_comparison(instruction, Condition::NotEqual);
+    } else if constexpr (IsSame<OpType, Increment>) {
+        compile_int32_increment_or_decrement(instruction, 1);
+    } else if constexpr (IsSame<OpType, Decrement>) {
+        compile_int32_increment_or_decrement(instruction, -1);
+    } else if constexpr (IsSame<OpType, EnterUnwindContext>) {
+        emit_call_helper(&enter_unwind_context);
+        emit_jump_to(instruction.entry_point().address());
+    } else if constexpr (IsSame<OpType, ScheduleJump>) {
+        auto finalizer = m_executable.exception_handlers_for_offset(offset).value().finalizer_offset;
+        VERIFY(finalizer.has_value());
+        emit_call_helper(&schedule_jump, instruction.target().address());
+        emit_jump_to(*finalizer);
+    } else if constexpr (IsSame<OpType, ContinuePendingUnwind>) {
+        emit_call_helper(&continue_pending_unwind, offset, instruction.resume_target().address());
+        m_assembler.jump(m_dispatch);
+    } else if constexpr (IsOneOf<OpType, Await, Return, Yield>) {
+        emit_call_generic_instruction(instruction);
+        m_assembler.jump(m_exit);
+    } else {
+        emit_call_generic_instruction(instruction);
+    }
+}
+
+template<typename OpType>
+u64 Compiler::execute_instruction(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    size_t program_counter = reinterpret_cast<u8 const*>(&instruction) - interpreter.current_executable().bytecode.data();
+    interpreter.running_execution_context().program_counter = program_counter;
+
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error()) [[unlikely]]
+            return handle_exception_at(interpreter, program_counter, result.error_value());
+    }
+    return continue_with_next_instruction;
+}
+
+static ThrowCompletionOr<bool> loosely_equals(VM& vm, Value lhs, Value rhs) { return is_loosely_equal(vm, lhs, rhs); }
+static ThrowCompletionOr<bool> loosely_inequals(VM& vm, Value lhs, Value rhs) { return !TRY(is_loosely_equal(vm, lhs, rhs)); }
+static ThrowCompletionOr<bool> strict_equals(VM&, Value lhs, Value rhs) { return is_strictly_equal(lhs, rhs); }
+static ThrowCompletionOr<bool> strict_inequals(VM&, Value lhs, Value rhs) { return !is_strictly_equal(lhs, rhs); }
+
+template<typename OpType>
+u64 Compiler::execute_comparison_and_jump(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    size_t program_counter = reinterpret_cast<u8 const*>(&instruction) - interpreter.current_executable().bytecode.data();
+    interpreter.running_execution_context().program_counter = program_counter;
+
+    auto lhs = interpreter.get(instruction.lhs());
+    auto rhs = interpreter.get(instruction.rhs());
+    ThrowCompletionOr<bool> result = false;
+#define EVALUATE_COMPARISON_OP(op_TitleCase, op_snake_case, numeric_operator) \
+    if constexpr (IsSame<OpType, Bytecode::Op::Jump##op_TitleCase>)            \
+        result = op_snake_case(interpreter.vm(), lhs, rhs);
+    JS_ENUMERATE_COMPARISON_OPS(EVALUATE_COMPARISON_OP)
+#undef EVALUATE_COMPARISON_OP
+
+    if (result.is_error()) [[unlikely]]
+        return handle_exception_at(interpreter, program_counter, result.error_value());
+    return result.value() ? condition_is_true : continue_with_next_instruction;
+}
+
+u64 Compiler::to_boolean(Bytecode::Interpreter& interpreter, size_t operand_index)
+{
+    return interpreter.m_registers_and_constants_and_locals_arguments[operand_index].to_boolean();
+}
+
+void Compiler::enter_unwind_context(Bytecode::Interpreter& interpreter)
+{
+    interpreter.enter_unwind_context();
+}
+
+void Compiler::schedule_jump(Bytecode::Interpreter& interpreter, size_t target)
+{
+    interpreter.m_scheduled_jump = target;
+}
+
+// NOTE: This mirrors the ContinuePendingUnwind handler in Interpreter::run_bytecode().
+u64 Compiler::continue_pending_unwind(Bytecode::Interpreter& interpreter, size_t program_counter, size_t resume_target)
+{
+    auto& running_execution_context = interpreter.running_execution_context();
+    running_execution_context.program_counter = program_counter;
+    auto const& native_executable = *interpreter.current_executable().native_executable;
+
+    if (auto exception = interpreter.reg(Bytecode::Register::exception()); !exception.is_special_empty_value())
+        return handle_exception_at(interpreter, program_counter, exception);
+
+    if (!interpreter.saved_return_value().is_special_empty_value()) {
+        interpreter.do_return(interpreter.saved_return_value());
+        if (auto handlers = interpreter.current_executable().exception_handlers_for_offset(program_counter); handlers.has_value()) {
+            if (auto finalizer = handlers.value().finalizer_offset; finalizer.has_value()) {
+                VERIFY(!running_execution_context.unwind_contexts.is_empty());
+                interpreter.reg(Bytecode::Register::saved_return_value()) = interpreter.reg(Bytecode::Register::return_value());
+                interpreter.reg(Bytecode::Register::return_value()) = js_special_empty_value();
+                // the unwind_context will be pop'ed when entering the finally block
+                return native_executable.native_address_for_bytecode_offset(finalizer.value());
+            }
+        }
+        return exit_from_executable;
+    }
+
+    auto const old_scheduled_jump = running_execution_context.previously_scheduled_jumps.take_last();
+    if (interpreter.m_scheduled_jump.has_value())
+        return native_executable.native_address_for_bytecode_offset(interpreter.m_scheduled_jump.release_value());
+
+    // set the scheduled jump to the old value if we continue where we left it
+    interpreter.m_scheduled_jump = old_scheduled_jump;
+    return native_executable.native_address_for_bytecode_offset(resume_target);
+}
+
+u64 Compiler::handle_exception_at(Bytecode::Interpreter& interpreter, size_t program_counter, Value exception)
+{
+    if (interpreter.handle_exception(program_counter, exception) == Bytecode::Interpreter::HandleExceptionResponse::ExitFromExecutable)
+        return exit_from_executable;
+    interpreter.running_execution_context().program_counter = program_counter;
+    return interpreter.current_executable().native_executable->native_address_for_bytecode_offset(program_counter);
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <LibJS/JIT/Assembler.h>
+
+namespace JS::JIT {
+
+// A baseline JIT that turns bytecode executables into x86-64 machine code.
+//
+// Each bytecode instruction becomes a straight-line sequence of native code. Simple instructions
+// (moves, jumps, branches, and int32 arithmetic and comparisons) are done inline, and everything
+// else calls into the same execute_impl() the interpreter uses. This removes instruction dispatch
+// and lets control flow use real branches, while sharing all semantics (and inline caches) with
+// the interpreter.
+//
+// It's only built where JS_HAS_BASELINE_JIT is set, and stays off unless enabled with the LIBJS_JIT environment variable.
+class Compiler {
+public:
+    // Returns native code for the executable, compiling it first once it has been run often enough.
+    // Returns nullptr if the JIT is unavailable or disabled, or if compilation failed.
+    static NativeExecutable* native_executable_for(Bytecode::Executable&);
+
+    // Runtime helpers return one of these, or the native address to continue execution at.
+    static constexpr u64 continue_with_next_instruction = 0;
+    static constexpr u64 condition_is_true = 1;
+    static constexpr u64 exit_from_executable = 2;
+
+private:
+    explicit Compiler(Bytecode::Executable&);
+
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+    bool compile_executable();
+
+    template<typename OpType>
+    void compile_instruction(OpType const&, size_t offset);
+
+    void emit_load(Assembler::Reg, Bytecode::Operand);
+    void emit_store(Bytecode::Operand, Assembler::Reg);
+    void emit_jump_to(size_t bytecode_offset);
+    void emit_jump_if_to(Assembler::Condition, size_t bytecode_offset);
+    void emit_branch_if_not_int32(Assembler::Reg value, Assembler::Label& slow_case);
+    void emit_box_int32(Assembler::Reg);
+    void emit_box_boolean(Assembler::Reg);
+    void emit_branch_on_truthiness(Bytecode::Operand condition, Optional<size_t> true_target, Optional<size_t> false_target);
+
+    template<typename Helper>
+    void emit_call_helper(Helper*, u64 first_argument = 0, u64 second_argument = 0);
+
+    template<typename OpType>
+    void emit_call_generic_instruction(OpType const&);
+
+    template<typename OpType>
+    void compile_int32_binary_arithmetic(OpType const&);
+    template<typename OpType>
+    void compile_int32_comparison(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_int32_comparison_and_jump(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_int32_increment_or_decrement(OpType const&, i32 delta);
+
+    // Runtime helpers, called from native code.
+    template<typename OpType>
+    static u64 execute_instruction(Bytecode::Interpreter&, OpType const&);
+    template<typename OpType>
+    static u64 execute_comparison_and_jump(Bytecode::Interpreter&, OpType const&);
+    static u64 to_boolean(Bytecode::Interpreter&, size_t operand_index);
+    static void enter_unwind_context(Bytecode::Interpreter&);
+    static void schedule_jump(Bytecode::Interpreter&, size_t target);
+    static u64 continue_pending_unwind(Bytecode::Interpreter&, size_t program_counter, size_t resume_target);
+    static u64 handle_exception_at(Bytecode::Interpreter&, size_t program_counter, Value exception);
+
+    Bytecode::Executable& m_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+
+    Assembler::Label m_dispatch;
+    Assembler::Label m_exit;
+
+    HashMap<size_t, size_t> m_native_offsets_for_bytecode_offsets;
+
+    struct BytecodeJump {
+        size_t end_of_displacement { 0 };
+        size_t bytecode_target { 0 };
+    };
+    Vector<BytecodeJump> m_bytecode_jumps;
+};
+
+}
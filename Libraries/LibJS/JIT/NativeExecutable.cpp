@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/VM.h>
+
+#if !JS_HAS_BASELINE_JIT
+#    error "The baseline JIT only supports x86-64 with the System V calling convention"
+#endif
+
+#if !defined(AK_OS_WINDOWS)
+#    include <sys/mman.h>
+#endif
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::create(ReadonlyBytes code, HashMap<size_t, size_t> native_offsets_for_bytecode_offsets)
+{
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        dbgln("JIT: Failed to allocate {} bytes for native code", code.size());
+        return nullptr;
+    }
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("JIT: Failed to make native code executable");
+        munmap(memory, code.size());
+        return nullptr;
+    }
+    return adopt_own(*new NativeExecutable(memory, code.size(), move(native_offsets_for_bytecode_offsets)));
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t code_size, HashMap<size_t, size_t> native_offsets_for_bytecode_offsets)
+    : m_code(code)
+    , m_code_size(code_size)
+    , m_native_offsets_for_bytecode_offsets(move(native_offsets_for_bytecode_offsets))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    munmap(m_code, m_code_size);
+}
+
+FlatPtr NativeExecutable::native_address_for_bytecode_offset(size_t bytecode_offset) const
+{
+    auto native_offset = m_native_offsets_for_bytecode_offsets.get(bytecode_offset);
+    VERIFY(native_offset.has_value());
+    return reinterpret_cast<FlatPtr>(m_code) + *native_offset;
+}
+
+bool NativeExecutable::run(Bytecode::Interpreter& interpreter, Value* registers, size_t entry_point) const
+{
+    auto native_offset = m_native_offsets_for_bytecode_offsets.get(entry_point);
+    if (!native_offset.has_value())
+        return false;
+
+    if (interpreter.vm().did_reach_stack_space_limit()) [[unlikely]] {
+        interpreter.reg(Bytecode::Register::exception()) = interpreter.vm().throw_completion<InternalError>(ErrorType::CallStackSizeExceeded).value();
+        return true;
+    }
+
+    // NOTE: The native code starts with a shared prologue that takes the interpreter, the register file,
+    //       and the address to jump to once the callee-saved registers are set up.
+    using EntryFunction = void (*)(Bytecode::Interpreter*, Value*, void const*);
+    auto entry = reinterpret_cast<EntryFunction>(m_code);
+    entry(&interpreter, registers, reinterpret_cast<u8 const*>(m_code) + *native_offset);
+    return true;
+}
+
+}
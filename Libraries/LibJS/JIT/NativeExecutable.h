@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// Machine code generated by the JIT compiler for one Bytecode::Executable.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    // Copies `code` into freshly mapped memory and makes it executable.
+    // Returns nullptr if we were unable to get executable memory from the system.
+    static OwnPtr<NativeExecutable> create(ReadonlyBytes code, HashMap<size_t, size_t> native_offsets_for_bytecode_offsets);
+
+    ~NativeExecutable();
+
+    // Runs the native code starting at the instruction at `entry_point`.
+    // Returns false if there is no native code for that instruction, in which case nothing has been executed.
+    bool run(Bytecode::Interpreter&, Value* registers, size_t entry_point) const;
+
+    // Returns the native address of the instruction at `bytecode_offset` in the executable memory.
+    FlatPtr native_address_for_bytecode_offset(size_t bytecode_offset) const;
+
+    size_t code_size() const { return m_code_size; }
+
+private:
+    NativeExecutable(void* code, size_t code_size, HashMap<size_t, size_t>);
+
+    void* m_code { nullptr };
+    size_t m_code_size { 0 };
+    HashMap<size_t, size_t> m_native_offsets_for_bytecode_offsets;
+};
+
+}
@@ -223,11 +223,17 @@ static consteval Array<TokenType, 256> make_single_char_tokens_array()
 static constexpr auto s_single_char_tokens = make_single_char_tokens_array();
 
 Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t line_column)
-    : m_source(source)
+    : Lexer(ByteString { source }, filename, { line_number, line_column + 1, 0 })
+{
+}
+
+Lexer::Lexer(ByteString source, StringView filename, Position const& start)
+    : m_source(move(source))
+    , m_position(start.offset)
     , m_current_token(TokenType::Eof, {}, {}, {}, 0, 0, 0)
     , m_filename(String::from_utf8(filename).release_value_but_fixme_should_propagate_errors())
-    , m_line_number(line_number)
-    , m_line_column(line_column)
+    , m_line_number(start.line)
+    , m_line_column(start.column - 1)
     , m_parsed_identifiers(adopt_ref(*new ParsedIdentifiers))
 {
     if (s_keywords.is_empty()) {
@@ -12,6 +12,7 @@
 #include <AK/HashMap.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
+#include <LibJS/Position.h>
 
 namespace JS {
 
@@ -19,6 +20,9 @@ class Lexer {
 public:
     explicit Lexer(StringView source, StringView filename = "(unknown)"sv, size_t line_number = 1, size_t line_column = 0);
 
+    // Lexes the source starting at the given position, without copying it.
+    Lexer(ByteString source, StringView filename, Position const& start);
+
     Token next();
 
     ByteString const& source() const { return m_source; }
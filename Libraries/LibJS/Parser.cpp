@@ -21,6 +21,17 @@
 
 namespace JS {
 
+bool g_lazy_function_parsing = false;
+LazyParsingStatistics g_lazy_parsing_statistics;
+
+void LazyParsingStatistics::dump() const
+{
+    warnln("\033[37;1mLazy function parsing\033[0m");
+    warnln("  skipped functions:        {} ({} bytes)", skipped_functions, skipped_bytes);
+    warnln("  parsed on first call:     {}", lazily_parsed_functions);
+    warnln("  parsed eagerly:           {}", eagerly_parsed_functions);
+}
+
 class ScopePusher {
 
     // NOTE: We really only need ModuleTopLevel and NotModuleTopLevel as the only
@@ -354,6 +365,9 @@ public:
 
             if (m_type == ScopeType::Program) {
                 auto can_use_global_for_identifier = !(identifier_group.used_inside_with_statement || identifier_group.might_be_variable_in_lexical_scope_in_named_function_assignment || identifier_group.used_inside_scope_with_eval || m_parser.m_state.initiated_by_eval);
+                // NOTE: When parsing a lazy function, the program scope stands in for all the scopes around the function.
+                if (m_parser.m_lazy_function_global_names.has_value() && !m_parser.m_lazy_function_global_names->contains(identifier_group_name))
+                    can_use_global_for_identifier = false;
                 if (can_use_global_for_identifier) {
                     for (auto& identifier : identifier_group.identifiers)
                         identifier->set_is_global();
@@ -680,6 +694,13 @@ Parser::ParserState::ParserState(Lexer l, Program::Type program_type)
     current_token = lexer.next();
 }
 
+Parser::Parser(Lexer lexer, NonnullRefPtr<SourceCode const> source_code, Program::Type program_type)
+    : m_source_code(move(source_code))
+    , m_state(move(lexer), program_type)
+    , m_program_type(program_type)
+{
+}
+
 Parser::Parser(Lexer lexer, Program::Type program_type, Optional<EvalInitialState> initial_state_for_eval)
     : m_source_code(SourceCode::create(lexer.filename(), String::from_byte_string(lexer.source()).release_value_but_fixme_should_propagate_errors()))
     , m_state(move(lexer), program_type)
@@ -766,16 +787,33 @@ bool Parser::parse_directive(ScopeNode& body)
 
 NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
 {
-    auto rule_start = push_start();
-    auto program = adopt_ref(*new Program({ m_source_code, rule_start.position(), position() }, m_program_type));
-    ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
+    Optional<ParserState> state_before_lazy_parse;
+    if (m_lazy_function_parsing)
+        state_before_lazy_parse = m_state;
 
-    if (m_program_type == Program::Type::Script)
-        parse_script(program, starts_in_strict_mode);
-    else
-        parse_module(program);
+    auto program = [&] {
+        auto rule_start = push_start();
+        auto program = adopt_ref(*new Program({ m_source_code, rule_start.position(), position() }, m_program_type));
+        ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
+
+        if (m_program_type == Program::Type::Script)
+            parse_script(program, starts_in_strict_mode);
+        else
+            parse_module(program);
+
+        program->set_end_offset({}, position().offset);
+        return program;
+    }();
+
+    // Skipping a function body only looks at tokens, which in rare cases (a regular expression literal where the lexer
+    // expected a division) can lose track of where the body ends. Errors are then reported by a full parse.
+    if (state_before_lazy_parse.has_value() && has_errors()) {
+        m_state = state_before_lazy_parse.release_value();
+        m_token_memoizations.clear();
+        m_lazy_function_parsing = false;
+        return parse_program(starts_in_strict_mode);
+    }
 
-    program->set_end_offset({}, position().offset);
     return program;
 }
 
@@ -2923,6 +2961,11 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
         : push_start();
     VERIFY(!(parse_options & FunctionNodeParseOptions::IsGetterFunction && parse_options & FunctionNodeParseOptions::IsSetterFunction));
 
+    // NOTE: Only plain function declarations and expressions are parsed lazily, as they can be parsed again on their own.
+    auto const lazy_parse_options = parse_options & FunctionNodeParseOptions::HasDefaultExportName;
+    auto const can_skip_body = m_lazy_function_parsing && (parse_options & ~FunctionNodeParseOptions::HasDefaultExportName) == FunctionNodeParseOptions::CheckForFunctionAndName;
+    auto const outer_strict_mode = m_state.strict_mode;
+
     TemporaryChange super_property_access_rollback(m_state.allow_super_property_lookup, !!(parse_options & FunctionNodeParseOptions::AllowSuperPropertyLookup));
     TemporaryChange super_constructor_call_rollback(m_state.allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
     TemporaryChange break_context_rollback(m_state.in_break_context, false);
@@ -2986,7 +3029,8 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     i32 function_length = -1;
     RefPtr<FunctionParameters const> parameters;
     FunctionParsingInsights parsing_insights;
-    auto body = [&] {
+    RefPtr<LazyFunctionBody> lazy_body;
+    auto body = [&]() -> NonnullRefPtr<FunctionBody const> {
         ScopePusher function_scope = ScopePusher::function_scope(*this, name);
 
         consume(TokenType::ParenOpen);
@@ -3005,7 +3049,46 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
 
         consume(TokenType::CurlyOpen);
 
-        return parse_function_body(*parameters, function_kind, parsing_insights);
+        auto skipped_body = can_skip_body ? skip_function_body(function_kind) : Optional<SkippedFunctionBody> {};
+        if (!skipped_body.has_value())
+            return parse_function_body(*parameters, function_kind, parsing_insights);
+
+        auto placeholder_body = create_ast_node<FunctionBody>({ m_source_code, rule_start.position(), position() });
+        function_scope.set_scope_node(placeholder_body);
+        function_scope.set_function_parameters(*parameters);
+
+        if (skipped_body->has_use_strict) {
+            if (!is_simple_parameter_list(*parameters))
+                syntax_error("Illegal 'use strict' directive in function with non-simple parameter list"_string);
+        }
+        if (skipped_body->has_use_strict || outer_strict_mode)
+            placeholder_body->set_strict_mode();
+
+        lazy_body = adopt_ref(*new LazyFunctionBody(
+            m_state.lexer.source(),
+            m_source_code,
+            rule_start.position(),
+            FunctionNodeParseOptions::CheckForFunctionAndName | lazy_parse_options,
+            m_program_type == Program::Type::Module,
+            outer_strict_mode));
+        lazy_body->free_identifiers.ensure_capacity(skipped_body->referenced_names.size());
+        for (auto const& referenced_name : skipped_body->referenced_names) {
+            auto identifier = create_ast_node<Identifier>({ m_source_code, rule_start.position(), position() }, referenced_name);
+            function_scope.register_identifier(identifier);
+            lazy_body->free_identifiers.unchecked_append(move(identifier));
+        }
+
+        if (skipped_body->contains_direct_call_to_eval) {
+            function_scope.set_contains_direct_call_to_eval();
+            function_scope.set_uses_this();
+        }
+
+        // NOTE: These are conservative, the actual insights are gathered when the function is parsed on its first call.
+        parsing_insights.contains_direct_call_to_eval = skipped_body->contains_direct_call_to_eval;
+        parsing_insights.uses_this = true;
+        parsing_insights.uses_this_from_environment = skipped_body->contains_direct_call_to_eval;
+        m_state.function_might_need_arguments_object = true;
+        return placeholder_body;
     }();
 
     auto local_variables_names = body->local_variables_names();
@@ -3024,11 +3107,137 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
         parsing_insights.uses_this = true;
         parsing_insights.uses_this_from_environment = true;
     }
-    return create_ast_node<FunctionNodeType>(
+    auto function_node = create_ast_node<FunctionNodeType>(
         { m_source_code, rule_start.position(), position() },
         name, move(source_text), move(body), parameters.release_nonnull(), function_length,
         function_kind, has_strict_directive, parsing_insights,
         move(local_variables_names));
+
+    if (lazy_body) {
+        function_node->set_lazy_body(lazy_body.release_nonnull());
+        ++g_lazy_parsing_statistics.skipped_functions;
+        g_lazy_parsing_statistics.skipped_bytes += function_end_offset - function_start_offset;
+    } else if (!(parse_options & FunctionNodeParseOptions::ParseBodyEagerly)) {
+        ++g_lazy_parsing_statistics.eagerly_parsed_functions;
+    }
+    return function_node;
+}
+
+Optional<Parser::SkippedFunctionBody> Parser::skip_function_body(FunctionKind function_kind)
+{
+    // NOTE: This only looks at tokens, so it can't tell which names the body declares. Every identifier in the body is
+    //       treated as a possible reference to a binding in an enclosing scope, which keeps those bindings out of locals.
+    save_state();
+
+    SkippedFunctionBody result;
+
+    auto is_generator = function_kind == FunctionKind::Generator || function_kind == FunctionKind::AsyncGenerator;
+    auto is_async = function_kind == FunctionKind::Async || function_kind == FunctionKind::AsyncGenerator;
+
+    // For each open parenthesis, whether it starts the condition of an if, for, while or with statement.
+    Vector<bool, 16> open_parentheses;
+    bool previous_closed_condition = false;
+
+    // The lexer treats a slash after identifier names and closing parentheses as a division, which the parser
+    // corrects where needed. We do the same for the cases that matter in practice.
+    auto slash_starts_regex_literal = [&](Token const& previous_token) {
+        switch (previous_token.type()) {
+        case TokenType::Case:
+        case TokenType::Delete:
+        case TokenType::Do:
+        case TokenType::Else:
+        case TokenType::In:
+        case TokenType::Instanceof:
+        case TokenType::New:
+        case TokenType::Return:
+        case TokenType::Throw:
+        case TokenType::Typeof:
+        case TokenType::Void:
+            return true;
+        case TokenType::Yield:
+            return is_generator;
+        case TokenType::Await:
+            return is_async;
+        case TokenType::ParenClose:
+            return previous_closed_condition;
+        default:
+            return false;
+        }
+    };
+
+    auto advance = [&] {
+        auto token = m_state.current_token;
+        m_state.current_token = m_state.lexer.next();
+        if (m_state.current_token.type() == TokenType::Slash || m_state.current_token.type() == TokenType::SlashEquals) {
+            if (slash_starts_regex_literal(token))
+                m_state.current_token = m_state.lexer.force_slash_as_regex();
+        }
+        return token;
+    };
+
+    while (match(TokenType::StringLiteral)) {
+        auto token = advance();
+        if (!match(TokenType::Semicolon) && !match(TokenType::CurlyClose) && !m_state.current_token.trivia_contains_line_terminator())
+            break;
+        if (token.value() == "'use strict'"sv || token.value() == "\"use strict\""sv)
+            result.has_use_strict = true;
+        if (match(TokenType::Semicolon))
+            advance();
+    }
+
+    size_t curly_depth = 0;
+    auto previous_type = TokenType::CurlyOpen;
+    bool previous_was_eval = false;
+
+    while (true) {
+        auto type = m_state.current_token.type();
+        bool is_eval = false;
+
+        switch (type) {
+        case TokenType::Eof:
+        case TokenType::Invalid:
+        case TokenType::PrivateIdentifier:
+            load_state();
+            return {};
+        case TokenType::CurlyOpen:
+            ++curly_depth;
+            break;
+        case TokenType::CurlyClose:
+            if (curly_depth == 0) {
+                discard_saved_state();
+                m_state.previous_token_was_period = false;
+                return result;
+            }
+            --curly_depth;
+            break;
+        case TokenType::ParenOpen:
+            if (previous_was_eval)
+                result.contains_direct_call_to_eval = true;
+            open_parentheses.append(previous_type == TokenType::If || previous_type == TokenType::For || previous_type == TokenType::While || previous_type == TokenType::With);
+            break;
+        case TokenType::Identifier:
+        case TokenType::Async:
+        case TokenType::Await:
+        case TokenType::Let:
+        case TokenType::Yield: {
+            if (previous_type == TokenType::Period || previous_type == TokenType::QuestionMarkPeriod)
+                break;
+            auto name = m_state.current_token.fly_string_value();
+            if (name == "arguments"sv)
+                break;
+            is_eval = name == "eval"sv;
+            result.referenced_names.set(move(name));
+            break;
+        }
+        default:
+            break;
+        }
+
+        previous_closed_condition = type == TokenType::ParenClose && !open_parentheses.is_empty() && open_parentheses.take_last();
+        previous_was_eval = is_eval;
+        previous_type = type;
+        advance();
+    }
 }
 
 NonnullRefPtr<FunctionParameters const> Parser::parse_formal_parameters(int& function_length, u16 parse_options)
@@ -5209,6 +5418,34 @@ Parser::ForbiddenTokens Parser::ForbiddenTokens::forbid(std::initializer_list<To
 template NonnullRefPtr<FunctionExpression> Parser::parse_function_node(u16, Optional<Position> const&);
 template NonnullRefPtr<FunctionDeclaration> Parser::parse_function_node(u16, Optional<Position> const&);
 
+Result<NonnullRefPtr<FunctionExpression>, Vector<ParserError>> Parser::parse_lazy_function(LazyFunctionBody const& lazy_body)
+{
+    auto program_type = lazy_body.is_module ? Program::Type::Module : Program::Type::Script;
+    auto parser = Parser { Lexer { lazy_body.source, lazy_body.source_code->filename(), lazy_body.start }, lazy_body.source_code, program_type };
+    parser.m_lazy_function_parsing = true;
+    parser.m_state.strict_mode = lazy_body.strict_mode;
+
+    HashTable<FlyString> global_names;
+    for (auto const& identifier : lazy_body.free_identifiers) {
+        if (identifier->is_global())
+            global_names.set(identifier->string());
+    }
+    parser.m_lazy_function_global_names = move(global_names);
+
+    // NOTE: Any kind of function can be parsed as an expression, which only differs in whether it needs a name.
+    auto program = adopt_ref(*new Program({ lazy_body.source_code, lazy_body.start, lazy_body.start }, program_type));
+    auto function = [&] {
+        ScopePusher program_scope = ScopePusher::program_scope(parser, *program);
+        return parser.parse_function_node<FunctionExpression>(lazy_body.parse_options | FunctionNodeParseOptions::ParseBodyEagerly);
+    }();
+
+    if (parser.has_errors())
+        return parser.errors();
+
+    ++g_lazy_parsing_statistics.lazily_parsed_functions;
+    return function;
+}
+
 NonnullRefPtr<Identifier const> Parser::create_identifier_and_register_in_current_scope(SourceRange range, FlyString string, Optional<DeclarationKind> declaration_kind)
 {
     auto id = create_ast_node<Identifier const>(range, string);
@@ -11,8 +11,10 @@
 #include <AK/Assertions.h>
 #include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Result.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/AST.h>
+#include <LibJS/Export.h>
 #include <LibJS/Lexer.h>
 #include <LibJS/ParserError.h>
 #include <LibJS/Runtime/FunctionConstructor.h>
@@ -40,9 +42,26 @@ struct FunctionNodeParseOptions {
         IsAsyncFunction = 1 << 7,
         HasDefaultExportName = 1 << 8,
         IsConstructor = 1 << 9,
+        ParseBodyEagerly = 1 << 10,
     };
 };
 
+// Set by `js --lazy-parse`, makes scripts and modules skip function bodies until the function is first called.
+// NOTE: This is not spec compliant. Early errors inside a skipped body are only thrown as a SyntaxError when the
+//       function is called, instead of when the script is parsed, and not at all if it never is.
+JS_API extern bool g_lazy_function_parsing;
+
+struct JS_API LazyParsingStatistics {
+    size_t skipped_functions { 0 };
+    size_t skipped_bytes { 0 };
+    size_t lazily_parsed_functions { 0 };
+    size_t eagerly_parsed_functions { 0 };
+
+    void dump() const;
+};
+
+JS_API extern LazyParsingStatistics g_lazy_parsing_statistics;
+
 class ScopePusher;
 
 class Parser {
@@ -58,6 +77,12 @@ public:
 
     NonnullRefPtr<Program> parse_program(bool starts_in_strict_mode = false);
 
+    // Skims over the bodies of plain function declarations and expressions instead of parsing them, leaving an
+    // empty placeholder body and a LazyFunctionBody behind. The function is parsed properly on its first call.
+    void enable_lazy_function_parsing() { m_lazy_function_parsing = true; }
+
+    static Result<NonnullRefPtr<FunctionExpression>, Vector<ParserError>> parse_lazy_function(LazyFunctionBody const&);
+
     template<typename FunctionNodeType>
     NonnullRefPtr<FunctionNodeType> parse_function_node(u16 parse_options = FunctionNodeParseOptions::CheckForFunctionAndName, Optional<Position> const& function_start = {});
     NonnullRefPtr<FunctionParameters const> parse_formal_parameters(int& function_length, u16 parse_options = 0);
@@ -217,6 +242,8 @@ public:
 private:
     friend class ScopePusher;
 
+    Parser(Lexer, NonnullRefPtr<SourceCode const>, Program::Type);
+
     void parse_script(Program& program, bool starts_in_strict_mode);
     void parse_module(Program& program);
 
@@ -274,6 +301,13 @@ private:
     FlyString consume_string_value();
     ModuleRequest parse_module_request();
 
+    struct SkippedFunctionBody {
+        HashTable<FlyString> referenced_names;
+        bool has_use_strict { false };
+        bool contains_direct_call_to_eval { false };
+    };
+    Optional<SkippedFunctionBody> skip_function_body(FunctionKind);
+
     struct RulePosition {
         AK_MAKE_NONCOPYABLE(RulePosition);
         AK_MAKE_NONMOVABLE(RulePosition);
@@ -341,6 +375,11 @@ private:
     Vector<ParserState> m_saved_state;
     HashMap<size_t, TokenMemoization> m_token_memoizations;
     Program::Type m_program_type;
+
+    bool m_lazy_function_parsing { false };
+
+    // When parsing a lazy function, the names that the original parse resolved to globals.
+    Optional<HashTable<FlyString>> m_lazy_function_global_names;
 };
 
 }
@@ -1081,7 +1081,7 @@ Object* create_unmapped_arguments_object(VM& vm, ReadonlySpan<Value> arguments)
         auto value = arguments[index];
 
         // b. Perform ! CreateDataPropertyOrThrow(obj, ! ToString(𝔽(index)), val).
-        object->indexed_properties().put(index, value);
+        object->mutable_indexed_properties().put(index, value);
 
         // c. Set index to index + 1.
     }
@@ -1124,7 +1124,7 @@ Object* create_mapped_arguments_object(VM& vm, FunctionObject& function, Nonnull
         auto value = arguments[index];
 
         // b. Perform ! CreateDataPropertyOrThrow(obj, ! ToString(𝔽(index)), val).
-        object->indexed_properties().put(index, value);
+        object->mutable_indexed_properties().put(index, value);
 
         // c. Set index to index + 1.
     }
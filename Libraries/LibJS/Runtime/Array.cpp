@@ -146,7 +146,7 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     // a. Let deleteSucceeded be ! A.[[Delete]](P).
     // b. If deleteSucceeded is false, then
     // i. Set newLenDesc.[[Value]] to ! ToUint32(P) + 1𝔽.
-    bool success = indexed_properties().set_array_like_size(new_length);
+    bool success = mutable_indexed_properties().set_array_like_size(new_length);
 
     // ii. If newWritable is false, set newLenDesc.[[Writable]] to false.
     // iii. Perform ! OrdinaryDefineOwnProperty(A, "length", newLenDesc).
@@ -173,9 +173,31 @@ ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object
     // 1. Let items be a new empty List.
     auto items = GC::RootVector<Value> { vm.heap() };
 
+    // OPTIMIZATION: Reading the elements of an array with fast elements has no side effects, so they can be
+    //               collected straight from the storage. Holes read through to a prototype chain without indices.
+    size_t k = 0;
+    if (is<Array>(object) && static_cast<Array const&>(object).has_fast_elements()) {
+        auto const* storage = object.indexed_properties().storage();
+        if (storage && storage->array_like_size() >= length) {
+            auto elements = static_cast<SimpleIndexedPropertyStorage const&>(*storage).packed_elements();
+            items.ensure_capacity(length);
+            for (; k < length; ++k) {
+                auto value = elements[k];
+                if (value.is_accessor())
+                    break;
+                if (value.is_special_empty_value()) {
+                    if (holes == Holes::ReadThroughHoles)
+                        items.append(js_undefined());
+                    continue;
+                }
+                items.append(value);
+            }
+        }
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
+    for (; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -299,40 +321,51 @@ ThrowCompletionOr<Optional<PropertyDescriptor>> Array::internal_get_own_property
     return Object::internal_get_own_property(property_key);
 }
 
-ThrowCompletionOr<bool> Array::internal_set(PropertyKey const& property_key, Value value, Value receiver, CacheablePropertyMetadata* cacheable_metadata, PropertyLookupPhase phase)
+bool Array::has_default_prototype_chain() const
 {
-    auto& vm = this->vm();
+    auto const& intrinsics = m_realm->intrinsics();
+    auto const* array_prototype = shape().prototype();
+    if (!array_prototype)
+        return false;
+    if (!array_prototype->indexed_properties().is_empty())
+        return false;
+    auto const& array_prototype_shape = array_prototype->shape();
+    if (intrinsics.default_array_prototype_shape().ptr() != &array_prototype_shape)
+        return false;
 
-    auto default_prototype_chain_intact = [&] {
-        auto const& intrinsics = m_realm->intrinsics();
-        auto* array_prototype = shape().prototype();
-        if (!array_prototype)
-            return false;
-        if (!array_prototype->indexed_properties().is_empty())
-            return false;
-        auto& array_prototype_shape = shape().prototype()->shape();
-        if (intrinsics.default_array_prototype_shape().ptr() != &array_prototype_shape)
-            return false;
+    auto const* object_prototype = array_prototype_shape.prototype();
+    if (!object_prototype)
+        return false;
+    if (!object_prototype->indexed_properties().is_empty())
+        return false;
+    auto const& object_prototype_shape = object_prototype->shape();
+    if (intrinsics.default_object_prototype_shape().ptr() != &object_prototype_shape)
+        return false;
+    if (object_prototype_shape.prototype())
+        return false;
 
-        auto* object_prototype = array_prototype_shape.prototype();
-        if (!object_prototype)
-            return false;
-        if (!object_prototype->indexed_properties().is_empty())
-            return false;
-        auto& object_prototype_shape = array_prototype_shape.prototype()->shape();
-        if (intrinsics.default_object_prototype_shape().ptr() != &object_prototype_shape)
-            return false;
-        if (object_prototype_shape.prototype())
-            return false;
+    return true;
+}
 
-        return true;
-    };
+bool Array::has_fast_elements() const
+{
+    if (m_is_proxy_target || !m_is_extensible || !m_length_writable || may_interfere_with_indexed_property_access())
+        return false;
+    auto const* storage = indexed_properties().storage();
+    if (storage && !storage->is_simple_storage())
+        return false;
+    return has_default_prototype_chain();
+}
+
+ThrowCompletionOr<bool> Array::internal_set(PropertyKey const& property_key, Value value, Value receiver, CacheablePropertyMetadata* cacheable_metadata, PropertyLookupPhase phase)
+{
+    auto& vm = this->vm();
 
     VERIFY(receiver.is_object());
     auto& receiver_object = receiver.as_object();
 
     // Fast path for arrays with intact prototype chain
-    if (&receiver_object == this && !m_is_proxy_target && default_prototype_chain_intact()) {
+    if (&receiver_object == this && !m_is_proxy_target && has_default_prototype_chain()) {
         if (property_key.is_number()) {
             auto index = property_key.as_number();
             auto property_descriptor = TRY(internal_get_own_property(property_key));
@@ -343,14 +376,14 @@ ThrowCompletionOr<bool> Array::internal_set(PropertyKey const& property_key, Val
                 attributes.set_writable(true);
                 attributes.set_enumerable(true);
                 attributes.set_configurable(true);
-                indexed_properties().put(index, value, attributes);
+                mutable_indexed_properties().put(index, value, attributes);
                 return true;
             }
             if (property_descriptor->is_data_descriptor()) {
                 if (property_descriptor->writable.has_value() && !*property_descriptor->writable)
                     return false;
                 auto attributes = property_descriptor->attributes();
-                indexed_properties().put(index, value, attributes);
+                mutable_indexed_properties().put(index, value, attributes);
                 return true;
             }
         } else if (property_key == vm.names.length) {
@@ -391,7 +424,7 @@ ThrowCompletionOr<bool> Array::internal_define_own_property(PropertyKey const& p
 
         // h. Let succeeded be ! OrdinaryDefineOwnProperty(A, P, Desc).
         bool succeeded = true;
-        auto* storage = indexed_properties().storage();
+        auto const* storage = indexed_properties().storage();
         auto attributes = property_descriptor.attributes();
         // OPTIMIZATION: Fast path for arrays with simple indexed properties storage.
         if (property_descriptor.is_data_descriptor() && attributes == default_attributes && storage && storage->is_simple_storage()) {
@@ -401,7 +434,7 @@ ThrowCompletionOr<bool> Array::internal_define_own_property(PropertyKey const& p
                     return false;
             }
 
-            storage->put(property_key.as_number(), property_descriptor.value.value());
+            mutable_indexed_properties().storage()->put(property_key.as_number(), property_descriptor.value.value());
         } else {
             succeeded = MUST(Object::internal_define_own_property(property_key, property_descriptor, precomputed_get_own_property));
         }
@@ -22,6 +22,7 @@ namespace JS {
 class Array : public Object {
     JS_OBJECT(Array, Object);
     GC_DECLARE_ALLOCATOR(Array);
+    GC_DECLARE_WRITE_BARRIER(Array);
 
 public:
     static ThrowCompletionOr<GC::Ref<Array>> create(Realm&, u64 length, Object* prototype = nullptr);
@@ -58,6 +59,11 @@ public:
 
     void set_is_proxy_target(bool is_proxy_target) { m_is_proxy_target = is_proxy_target; }
 
+    // NON-STANDARD: Whether elements can be read from and written to the simple indexed property storage
+    //               directly, with the same observable result as going through the internal methods.
+    //               Holes read through to the prototype chain, which is known to have no indexed properties.
+    [[nodiscard]] bool has_fast_elements() const;
+
     virtual void visit_edges(Cell::Visitor& visitor) override;
 
 protected:
@@ -68,6 +74,8 @@ private:
 
     ThrowCompletionOr<bool> set_length(PropertyDescriptor const&);
 
+    bool has_default_prototype_chain() const;
+
     GC::Ref<Realm> m_realm;
     bool m_length_writable { true };
     bool m_is_proxy_target { false };
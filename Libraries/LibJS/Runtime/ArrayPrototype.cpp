@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -145,6 +146,61 @@ static ThrowCompletionOr<Object*> array_species_create(VM& vm, Object& original_
     return TRY(construct(vm, constructor.as_function(), Value(length))).ptr();
 }
 
+// Returns the storage of an array whose elements can be accessed directly, see Array::has_fast_elements().
+static SimpleIndexedPropertyStorage const* fast_elements_of(Object const& object)
+{
+    if (!is<Array>(object) || !static_cast<Array const&>(object).has_fast_elements())
+        return nullptr;
+    return static_cast<SimpleIndexedPropertyStorage const*>(object.indexed_properties().storage());
+}
+
+static SimpleIndexedPropertyStorage* mutable_fast_elements_of(Object& object)
+{
+    if (!fast_elements_of(object))
+        return nullptr;
+    return static_cast<SimpleIndexedPropertyStorage*>(object.mutable_indexed_properties().storage());
+}
+
+// Performs HasProperty(O, index) followed by Get(O, index) if the property is present, reading the element
+// straight from the storage if possible.
+static ThrowCompletionOr<Optional<Value>> get_if_present(Object& object, size_t index)
+{
+    if (auto const* storage = fast_elements_of(object)) {
+        if (index >= storage->array_like_size())
+            return Optional<Value> {};
+        auto value = storage->packed_elements()[index];
+        if (value.is_special_empty_value())
+            return Optional<Value> {};
+        if (!value.is_accessor())
+            return value;
+    }
+
+    auto property_key = PropertyKey { index };
+    if (!TRY(object.has_property(property_key)))
+        return Optional<Value> {};
+    return TRY(object.get(property_key));
+}
+
+// Compares the decimal string representations of two Int32 values, without allocating them.
+static bool int32_string_less_than(i32 a, i32 b)
+{
+    auto to_decimal = [](i32 value, Span<char> buffer) {
+        auto magnitude = value < 0 ? -static_cast<u32>(value) : static_cast<u32>(value);
+        size_t start = buffer.size();
+        do {
+            buffer[--start] = '0' + (magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0)
+            buffer[--start] = '-';
+        return StringView { buffer.data() + start, buffer.size() - start };
+    };
+
+    char a_buffer[11];
+    char b_buffer[11];
+    return to_decimal(a, a_buffer) < to_decimal(b, b_buffer);
+}
+
 // 23.1.3.1 Array.prototype.at ( index ), https://tc39.es/ecma262/#sec-array.prototype.at
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::at)
 {
@@ -379,6 +435,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    // OPTIMIZATION: Arrays with fast elements can be filled in their storage directly.
+    if (auto* storage = mutable_fast_elements_of(this_object); storage && to <= storage->array_like_size()) {
+        for (u64 i = from; i < to; i++)
+            storage->put(i, vm.argument(0));
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -795,6 +858,43 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Search the storage of arrays with fast elements directly. Only a Number can be strictly
+    //               equal to the elements of numeric arrays, and Int32 arrays compare without converting.
+    if (auto const* storage = fast_elements_of(object); storage && storage->array_like_size() >= length) {
+        auto elements = storage->packed_elements();
+        auto element_kind = storage->element_kind();
+
+        if (element_kind == ElementKind::PackedInt32 || element_kind == ElementKind::PackedDouble) {
+            if (!search_element.is_number() || search_element.is_nan())
+                return Value(-1);
+
+            if (element_kind == ElementKind::PackedInt32 && search_element.is_int32()) {
+                auto needle = search_element.as_i32();
+                for (; k < length; ++k) {
+                    if (elements[k].as_i32() == needle)
+                        return Value(k);
+                }
+                return Value(-1);
+            }
+
+            auto needle = search_element.as_double();
+            for (; k < length; ++k) {
+                if (elements[k].as_double() == needle)
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+
+        // Holes are not present, and reading the other elements has no side effects until we reach an accessor.
+        for (; k < length; ++k) {
+            auto element = elements[k];
+            if (element.is_accessor())
+                break;
+            if (!element.is_special_empty_value() && is_strictly_equal(search_element, element))
+                return Value(k);
+        }
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -959,18 +1059,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         auto property_key = PropertyKey { k };
 
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
-
         // c. If kPresent is true, then
-        if (k_present) {
-            // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
-
+        //    i. Let kValue be ? Get(O, Pk).
+        // OPTIMIZATION: The callback may change either array in any way, so whether their elements can be
+        //               accessed directly is checked again on every iteration.
+        auto k_value = TRY(get_if_present(object, k));
+        if (k_value.has_value()) {
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
-            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
 
             // iii. Perform ? CreateDataPropertyOrThrow(A, Pk, mappedValue).
-            TRY(array->create_data_property_or_throw(property_key, mapped_value));
+            if (is<Array>(*array) && static_cast<Array const&>(*array).has_fast_elements())
+                array->mutable_indexed_properties().put(k, mapped_value);
+            else
+                TRY(array->create_data_property_or_throw(property_key, mapped_value));
         }
 
         // d. Set k to k + 1.
@@ -1005,6 +1107,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+
+    // OPTIMIZATION: Arrays with fast elements can be appended to in their storage directly, which also updates their length.
+    if (is<Array>(*this_object) && static_cast<Array const&>(*this_object).has_fast_elements()) {
+        for (size_t i = 0; i < argument_count; ++i)
+            this_object->mutable_indexed_properties().append(vm.argument(i));
+        return Value(new_length);
+    }
+
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1415,6 +1525,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
         return TRY(compare_array_elements(vm, x, y, comparefn.is_undefined() ? nullptr : &comparefn.as_function()));
     };
 
+    // OPTIMIZATION: Comparing the string representations of Int32 values has no side effects, and distinct values
+    //               have distinct representations, so packed Int32 arrays can be sorted in place without a stable sort.
+    if (auto* storage = mutable_fast_elements_of(object); storage && comparefn.is_undefined()
+        && storage->element_kind() == ElementKind::PackedInt32 && storage->array_like_size() == length) {
+        Vector<i32> values;
+        values.ensure_capacity(length);
+        for (auto value : storage->packed_elements())
+            values.unchecked_append(value.as_i32());
+        quick_sort(values, int32_string_less_than);
+        for (size_t i = 0; i < values.size(); ++i)
+            storage->put(i, Value(values[i]));
+        return object;
+    }
+
     // 5. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, skip-holes).
     auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
 
@@ -1427,7 +1551,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 8. Repeat, while j < itemCount,
     for (; j < item_count; ++j) {
         // a. Perform ? Set(obj, ! ToString(𝔽(j)), sortedList[j], true).
-        TRY(object->set(j, sorted_list[j], Object::ShouldThrowExceptions::Yes));
+        // OPTIMIZATION: The comparator may have changed the array, so this is checked again for every element.
+        if (auto* storage = mutable_fast_elements_of(object); storage && j < storage->array_like_size())
+            storage->put(j, sorted_list[j]);
+        else
+            TRY(object->set(j, sorted_list[j], Object::ShouldThrowExceptions::Yes));
         // b. Set j to j + 1.
     }
 
@@ -13,6 +13,7 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
@@ -132,6 +133,7 @@ GC::Ref<ECMAScriptFunctionObject> ECMAScriptFunctionObject::create_from_function
             function_node.is_arrow_function(),
             function_node.parsing_insights(),
             function_node.local_variables_names()));
+        shared_data->m_lazy_body = function_node.lazy_body();
         function_node.set_shared_data(shared_data);
     }
 
@@ -167,13 +169,6 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
     , m_is_arrow_function(is_arrow_function)
     , m_uses_this(parsing_insights.uses_this)
 {
-    if (m_is_arrow_function)
-        m_this_mode = ThisMode::Lexical;
-    else if (m_strict)
-        m_this_mode = ThisMode::Strict;
-    else
-        m_this_mode = ThisMode::Global;
-
     // 15.1.3 Static Semantics: IsSimpleParameterList, https://tc39.es/ecma262/#sec-static-semantics-issimpleparameterlist
     m_has_simple_parameter_list = all_of(m_formal_parameters->parameters(), [&](auto& parameter) {
         if (parameter.is_rest)
@@ -185,6 +180,52 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
         return true;
     });
 
+    prepare_function_declaration_instantiation(vm, parsing_insights.uses_this_from_environment);
+}
+
+ThrowCompletionOr<void> SharedFunctionInstanceData::parse_lazy_body(VM& vm)
+{
+    if (!m_lazy_body)
+        return {};
+
+    auto result = Parser::parse_lazy_function(*m_lazy_body);
+    if (result.is_error())
+        return vm.throw_completion<SyntaxError>(result.error().first().to_string());
+    auto function = result.release_value();
+
+    // NOTE: Only the parameter bindings change, their shape (and thus the function's length) is the same as before.
+    m_formal_parameters = function->parameters();
+    m_ecmascript_code = function->body_ptr();
+    m_local_variables_names = function->local_variables_names();
+    m_strict = function->is_strict_mode();
+    m_might_need_arguments_object = function->might_need_arguments_object();
+    m_contains_direct_call_to_eval = function->contains_direct_call_to_eval();
+    m_uses_this = function->parsing_insights().uses_this;
+    m_lazy_body = nullptr;
+
+    m_has_parameter_expressions = false;
+    m_has_duplicates = false;
+    m_parameter_names.clear();
+    m_functions_to_initialize.clear();
+    m_var_names_to_initialize_binding.clear();
+    m_function_names_to_initialize_binding.clear();
+    m_function_environment_bindings_count = 0;
+    m_var_environment_bindings_count = 0;
+    m_lex_environment_bindings_count = 0;
+
+    prepare_function_declaration_instantiation(vm, function->uses_this_from_environment());
+    return {};
+}
+
+void SharedFunctionInstanceData::prepare_function_declaration_instantiation(VM& vm, bool uses_this_from_environment)
+{
+    if (m_is_arrow_function)
+        m_this_mode = ThisMode::Lexical;
+    else if (m_strict)
+        m_this_mode = ThisMode::Strict;
+    else
+        m_this_mode = ThisMode::Global;
+
     // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
     //       and then reused in all subsequent function instantiations.
 
@@ -277,7 +318,7 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
 
     size_t parameter_environment_bindings_count = 0;
     // 19. If strict is true or hasParameterExpressions is false, then
-    if (strict || !m_has_parameter_expressions) {
+    if (m_strict || !m_has_parameter_expressions) {
         // a. NOTE: Only a single Environment Record is needed for the parameters, since calls to eval in strict mode code cannot create new bindings which are visible outside of the eval.
         // b. Let env be the LexicalEnvironment of calleeContext
         // NOTE: Here we are only interested in the size of the environment.
@@ -414,7 +455,7 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
         }));
     }
 
-    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || parsing_insights.uses_this_from_environment || m_contains_direct_call_to_eval;
+    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || uses_this_from_environment || m_contains_direct_call_to_eval;
 }
 
 ECMAScriptFunctionObject::ECMAScriptFunctionObject(
@@ -484,6 +525,7 @@ void ECMAScriptFunctionObject::initialize(Realm& realm)
 ThrowCompletionOr<void> ECMAScriptFunctionObject::get_stack_frame_size(size_t& registers_and_constants_and_locals_count, size_t& argument_count)
 {
     if (!m_bytecode_executable) {
+        TRY(m_shared_data->parse_lazy_body(vm()));
         if (!ecmascript_code().bytecode_executable()) {
             if (is_module_wrapper()) {
                 const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm(), ecmascript_code(), kind(), name())));
@@ -549,6 +591,7 @@ ThrowCompletionOr<GC::Ref<Object>> ECMAScriptFunctionObject::internal_construct(
     auto& vm = this->vm();
 
     if (!m_bytecode_executable) {
+        TRY(m_shared_data->parse_lazy_body(vm));
         if (!ecmascript_code().bytecode_executable()) {
             if (is_module_wrapper()) {
                 const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, ecmascript_code(), kind(), name())));
@@ -48,6 +48,9 @@ public:
         FunctionParsingInsights const&,
         Vector<LocalVariable> local_variables_names);
 
+    // Parses the function if its body was skipped by a lazy parse. This must happen before it is compiled.
+    ThrowCompletionOr<void> parse_lazy_body(VM&);
+
     RefPtr<FunctionParameters const> m_formal_parameters; // [[FormalParameters]]
     RefPtr<Statement const> m_ecmascript_code;            // [[ECMAScriptCode]]
 
@@ -95,6 +98,11 @@ public:
     Variant<PropertyKey, PrivateName, Empty> m_class_field_initializer_name; // [[ClassFieldInitializerName]]
     ConstructorKind m_constructor_kind : 1 { ConstructorKind::Base };        // [[ConstructorKind]]
     bool m_is_class_constructor : 1 { false };                               // [[IsClassConstructor]]
+
+    RefPtr<LazyFunctionBody const> m_lazy_body;
+
+private:
+    void prepare_function_declaration_instantiation(VM&, bool uses_this_from_environment);
 };
 
 // 10.2 ECMAScript Function Objects, https://tc39.es/ecma262/#sec-ecmascript-function-objects
@@ -77,10 +77,10 @@ JS_DEFINE_NATIVE_FUNCTION(FunctionPrototype::apply)
     // OPTIMIZATION: If argArray has a simple indexed storage without holes and doesn't interfere with indexed property access,
     //               we can skip CreateListFromArrayLike and directly use the storage elements.
     auto& arg_array_object = arg_array.as_object();
-    auto* storage = arg_array_object.indexed_properties().storage();
+    auto const* storage = arg_array_object.indexed_properties().storage();
     if (!arg_array_object.may_interfere_with_indexed_property_access() && storage && storage->is_simple_storage()) {
         auto length = TRY(length_of_array_like(vm, arg_array_object));
-        auto const* simple_storage = static_cast<SimpleIndexedPropertyStorage*>(storage);
+        auto const* simple_storage = static_cast<SimpleIndexedPropertyStorage const*>(storage);
         auto storage_elements = simple_storage->elements().span();
         if (!simple_storage->has_empty_elements() && storage_elements.size() >= length)
             return TRY(JS::call(vm, function, this_arg, storage_elements.slice(0, length)));
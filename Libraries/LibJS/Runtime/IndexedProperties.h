@@ -19,6 +19,23 @@ struct ValueAndAttributes {
     Optional<u32> property_offset {};
 };
 
+// Tracks what is known about the elements of an object's indexed property storage, so that fast paths
+// can skip per-element type checks. The packed kinds only ever widen on write (PackedInt32 -> PackedDouble
+// -> PackedElements); a hole makes the elements holey until it is filled again, and switching to generic
+// storage is permanent.
+enum class ElementKind : u8 {
+    // Every element is an Int32 value.
+    PackedInt32,
+    // Every element is a Number (Int32 or double) value.
+    PackedDouble,
+    // Every element is present, but may hold any value.
+    PackedElements,
+    // Some elements below the array-like size are empty.
+    HoleyElements,
+    // Elements live in a sparse map and may have non-default attributes.
+    Generic,
+};
+
 class IndexedProperties;
 class IndexedPropertyIterator;
 class GenericIndexedPropertyStorage;
@@ -94,13 +111,26 @@ public:
 
     bool has_empty_elements() const { return m_number_of_empty_elements.value() > 0; }
 
+    ElementKind element_kind() const { return has_empty_elements() ? ElementKind::HoleyElements : m_packed_kind; }
+
+    // The elements below the array-like size. Empty values mark holes unless the kind is packed.
+    ReadonlySpan<Value> packed_elements() const { return m_packed_elements.span().trim(m_array_size); }
+
 private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
 
+    void widen_element_kind(Value value)
+    {
+        if (m_packed_kind == ElementKind::PackedElements || value.is_int32() || value.is_special_empty_value())
+            return;
+        m_packed_kind = value.is_number() ? ElementKind::PackedDouble : ElementKind::PackedElements;
+    }
+
     Checked<size_t> m_number_of_empty_elements { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_packed_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -175,6 +205,15 @@ public:
     IndexedPropertyStorage* storage() { return m_storage; }
     IndexedPropertyStorage const* storage() const { return m_storage; }
 
+    ElementKind element_kind() const
+    {
+        if (!m_storage)
+            return ElementKind::PackedInt32;
+        if (!m_storage->is_simple_storage())
+            return ElementKind::Generic;
+        return static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).element_kind();
+    }
+
     size_t real_size() const;
 
     Vector<u32> indices() const;
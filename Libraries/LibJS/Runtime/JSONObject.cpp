@@ -19,7 +19,10 @@
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/FunctionObject.h>
 #include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/IndexedProperties.h>
+#include <LibJS/Runtime/Intrinsics.h>
 #include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/JSONParser.h>
 #include <LibJS/Runtime/NumberObject.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/RawJSONObject.h>
@@ -108,6 +111,12 @@ ThrowCompletionOr<Optional<String>> JSONObject::stringify_impl(VM& vm, Value val
         state.gap = String {};
     }
 
+    // OPTIMIZATION: Without a replacer or gap, plain data can be serialized straight from its shapes and storage.
+    if (!state.replacer_function && !state.property_list.has_value() && state.gap.is_empty() && value.is_object()) {
+        if (auto result = serialize_json_value_without_side_effects(vm, value.as_object()); result.has_value())
+            return result.release_value();
+    }
+
     auto wrapper = Object::create(realm, realm.intrinsics().object_prototype());
     MUST(wrapper->create_data_property_or_throw(String {}, value));
     return serialize_json_property(vm, state, String {}, wrapper);
@@ -360,14 +369,25 @@ ThrowCompletionOr<String> JSONObject::serialize_json_array(VM& vm, StringifyStat
 }
 
 // 25.5.2.2 QuoteJSONString ( value ), https://tc39.es/ecma262/#sec-quotejsonstring
-String JSONObject::quote_json_string(String string)
+static void append_quoted_json_string(StringBuilder& builder, StringView string)
 {
     // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
-    StringBuilder builder;
     builder.append('"');
 
+    // OPTIMIZATION: Most strings contain nothing that needs to be escaped, so everything up to the first byte that might
+    //               (an ASCII control character, quotation mark or reverse solidus, or the lead byte of U+D000..U+DFFF,
+    //               which includes the surrogates) is appended as is.
+    auto bytes = string.bytes();
+    size_t plain_length = 0;
+    for (; plain_length < bytes.size(); ++plain_length) {
+        auto byte = bytes[plain_length];
+        if (byte < 0x20 || byte == '"' || byte == '\\' || byte == 0xED)
+            break;
+    }
+    builder.append(string.substring_view(0, plain_length));
+
     // 2. For each code point C of StringToCodePoints(value), do
-    auto utf_view = Utf8View(string);
+    auto utf_view = Utf8View(string.substring_view(plain_length));
     for (auto code_point : utf_view) {
         // a. If C is listed in the “Code Point” column of Table 70, then
         // i. Set product to the string-concatenation of product and the escape sequence for C as specified in the “Escape Sequence” column of the corresponding row.
@@ -409,11 +429,195 @@ String JSONObject::quote_json_string(String string)
     }
     // 3. Set product to the string-concatenation of product and the code unit 0x0022 (QUOTATION MARK).
     builder.append('"');
+}
+
+String JSONObject::quote_json_string(String string)
+{
+    StringBuilder builder;
+    append_quoted_json_string(builder, string);
 
     // 4. Return product.
     return builder.to_string_without_validation();
 }
 
+// Serializes plain data (ordinary objects and fast arrays with the default prototype chain, and primitives other than
+// BigInts) by reading shapes and storage directly. Since nothing it looks at can run user code, bailing out halfway
+// and starting over with SerializeJSONProperty is unobservable.
+class SideEffectFreeSerializer {
+public:
+    explicit SideEffectFreeSerializer(VM& vm)
+        : m_vm(vm)
+        , m_intrinsics(vm.current_realm()->intrinsics())
+    {
+    }
+
+    bool serialize(Value value)
+    {
+        if (value.is_null()) {
+            m_builder.append("null"sv);
+            return true;
+        }
+        if (value.is_boolean()) {
+            m_builder.append(value.as_bool() ? "true"sv : "false"sv);
+            return true;
+        }
+        if (value.is_string()) {
+            append_quoted_json_string(m_builder, value.as_string().utf8_string_view());
+            return true;
+        }
+        if (value.is_int32()) {
+            m_builder.appendff("{}", value.as_i32());
+            return true;
+        }
+        if (value.is_number()) {
+            if (value.is_finite_number())
+                m_builder.append(number_to_string(value.as_double()));
+            else
+                m_builder.append("null"sv);
+            return true;
+        }
+
+        // NOTE: BigInts throw, and functions are only omitted if they don't have a toJSON method; leave both to the spec steps.
+        if (!value.is_object() || value.is_function())
+            return false;
+
+        // NOTE: Cycles throw, and so does running out of stack, which the spec steps will do as well.
+        auto& object = value.as_object();
+        if (m_vm.did_reach_stack_space_limit() || m_seen_objects.contains(&object))
+            return false;
+
+        if (is<Array>(object))
+            return serialize_array(static_cast<Array&>(object));
+        if (object.is_plain_object())
+            return serialize_object(object);
+        return false;
+    }
+
+    String to_string() { return m_builder.to_string_without_validation(); }
+
+private:
+    // The quoted names of a shape's enumerable string-keyed properties, in property order, followed by a colon.
+    struct QuotedProperty {
+        String quoted_key;
+        u32 offset { 0 };
+    };
+
+    // Returns the quoted properties of this shape, or nullptr if the object has its own toJSON property.
+    Vector<QuotedProperty> const* quoted_properties_for(Shape const& shape)
+    {
+        if (auto it = m_quoted_properties.find(&shape); it != m_quoted_properties.end())
+            return it->value.has_value() ? &it->value.value() : nullptr;
+
+        Optional<Vector<QuotedProperty>> properties;
+        if (!shape.lookup(m_vm.names.toJSON).has_value()) {
+            properties.emplace();
+            properties->ensure_capacity(shape.property_count());
+            StringBuilder builder;
+            for (auto const& [key, metadata] : shape.property_table()) {
+                if (!key.is_string() || !metadata.attributes.is_enumerable())
+                    continue;
+                builder.clear();
+                append_quoted_json_string(builder, key.as_string());
+                builder.append(':');
+                properties->append({ builder.to_string_without_validation(), metadata.offset });
+            }
+        }
+
+        auto& entry = m_quoted_properties.ensure(&shape, [&] { return move(properties); });
+        return entry.has_value() ? &entry.value() : nullptr;
+    }
+
+    bool has_default_object_prototype(Object const* prototype) const
+    {
+        return prototype == m_intrinsics.object_prototype()
+            && &prototype->shape() == m_intrinsics.default_object_prototype_shape().ptr()
+            && prototype->indexed_properties().is_empty();
+    }
+
+    // 25.5.2.4 SerializeJSONObject ( state, value ), https://tc39.es/ecma262/#sec-serializejsonobject
+    bool serialize_object(Object& object)
+    {
+        // NOTE: Array index properties are not part of the shape, and would have to be serialized first.
+        if (!object.indexed_properties().is_empty())
+            return false;
+
+        auto const& shape = object.shape();
+        if (shape.prototype() && !has_default_object_prototype(shape.prototype()))
+            return false;
+
+        auto const* properties = quoted_properties_for(shape);
+        if (!properties)
+            return false;
+
+        m_seen_objects.set(&object);
+        m_builder.append('{');
+        bool first = true;
+        for (auto const& property : *properties) {
+            auto value = object.get_direct(property.offset);
+            if (value.is_accessor())
+                return false;
+            if (value.is_undefined() || value.is_symbol())
+                continue;
+            if (!first)
+                m_builder.append(',');
+            first = false;
+            m_builder.append(property.quoted_key);
+            if (!serialize(value))
+                return false;
+        }
+        m_builder.append('}');
+        m_seen_objects.remove(&object);
+        return true;
+    }
+
+    // 25.5.2.5 SerializeJSONArray ( state, value ), https://tc39.es/ecma262/#sec-serializejsonarray
+    bool serialize_array(Array& array)
+    {
+        // NOTE: The default prototype chain has no toJSON methods, but the array might have its own.
+        if (!array.has_fast_elements() || array.shape().lookup(m_vm.names.toJSON).has_value())
+            return false;
+
+        ReadonlySpan<Value> elements;
+        if (auto const* storage = array.indexed_properties().storage())
+            elements = static_cast<SimpleIndexedPropertyStorage const&>(*storage).packed_elements();
+        auto length = array.indexed_properties().array_like_size();
+
+        m_seen_objects.set(&array);
+        m_builder.append('[');
+        for (size_t i = 0; i < length; ++i) {
+            if (i != 0)
+                m_builder.append(',');
+            auto value = i < elements.size() ? elements[i] : js_special_empty_value();
+            if (value.is_accessor())
+                return false;
+            // NOTE: Holes read through to the (empty) indexed properties of the default prototype chain.
+            if (value.is_special_empty_value() || value.is_undefined() || value.is_symbol()) {
+                m_builder.append("null"sv);
+                continue;
+            }
+            if (!serialize(value))
+                return false;
+        }
+        m_builder.append(']');
+        m_seen_objects.remove(&array);
+        return true;
+    }
+
+    VM& m_vm;
+    Intrinsics& m_intrinsics;
+    StringBuilder m_builder;
+    HashTable<Object const*> m_seen_objects;
+    HashMap<Shape const*, Optional<Vector<QuotedProperty>>> m_quoted_properties;
+};
+
+Optional<String> JSONObject::serialize_json_value_without_side_effects(VM& vm, Object& object)
+{
+    SideEffectFreeSerializer serializer(vm);
+    if (!serializer.serialize(&object))
+        return {};
+    return serializer.to_string();
+}
+
 // 25.5.1 JSON.parse ( text [ , reviver ] ), https://tc39.es/ecma262/#sec-json.parse
 JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
 {
@@ -450,18 +654,14 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
 // 25.5.1.1 ParseJSON ( text ), https://tc39.es/ecma262/#sec-ParseJSON
 ThrowCompletionOr<Value> JSONObject::parse_json(VM& vm, StringView text)
 {
-    auto json = JsonValue::from_string(text);
-
     // 1. If StringToCodePoints(text) is not a valid JSON text as specified in ECMA-404, throw a SyntaxError exception.
-    if (json.is_error())
-        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-
     // 2. Let scriptString be the string-concatenation of "(", text, and ");".
     // 3. Let script be ParseText(scriptString, Script).
     // 4. NOTE: The early error rules defined in 13.2.5.1 have special handling for the above invocation of ParseText.
     // 5. Assert: script is a Parse Node.
     // 6. Let result be ! Evaluation of script.
-    auto result = JSONObject::parse_json_value(vm, json.value());
+    // NOTE: JSONParser validates the text and evaluates it in a single pass.
+    auto result = TRY(JSONParser::parse(vm, text));
 
     // 7. NOTE: The PropertyDefinitionEvaluation semantics defined in 13.2.5.5 have special handling for the above evaluation.
     // 8. Assert: result is either a String, a Number, a Boolean, an Object that is defined by either an ArrayLiteral or an ObjectLiteral, or null.
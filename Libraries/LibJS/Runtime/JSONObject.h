@@ -41,6 +41,7 @@ private:
     static ThrowCompletionOr<String> serialize_json_object(VM&, StringifyState&, Object&);
     static ThrowCompletionOr<String> serialize_json_array(VM&, StringifyState&, Object&);
     static String quote_json_string(String);
+    static Optional<String> serialize_json_value_without_side_effects(VM&, Object&);
 
     // Parse helpers
     static Object* parse_json_object(VM&, JsonObject const&);
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
+#include <AK/FloatingPointStringConversions.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/Utf8View.h>
+#include <LibGC/ConservativeVector.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/JSONParser.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/VM.h>
+
+namespace JS {
+
+// Objects with more properties than this are turned into dictionaries by Object::storage_set(), so there is no
+// shared shape to reuse for them.
+static constexpr size_t max_keys_for_shared_shape = 64;
+
+static constexpr bool is_json_whitespace(u8 byte)
+{
+    return byte == ' ' || byte == '\t' || byte == '\n' || byte == '\r';
+}
+
+// Returns the offset of the first quotation mark, reverse solidus or (unescaped, and therefore invalid) control character.
+static size_t find_end_of_string_literal(ReadonlyBytes bytes)
+{
+    using AK::SIMD::u8x16;
+    using AK::SIMD::u64x2;
+
+    size_t offset = 0;
+
+    // OPTIMIZATION: Look at 16 bytes at a time. Matching bytes are all ones in the mask, so on our (little-endian)
+    //               targets the first match is the lowest set byte.
+    for (; offset + sizeof(u8x16) <= bytes.size(); offset += sizeof(u8x16)) {
+        auto chunk = AK::SIMD::load_unaligned<u8x16>(bytes.offset_pointer(offset));
+        auto mask = bit_cast<u64x2>((chunk == '"') | (chunk == '\\') | (chunk < 0x20));
+        if (mask[0] != 0)
+            return offset + count_trailing_zeroes(mask[0]) / 8;
+        if (mask[1] != 0)
+            return offset + 8 + count_trailing_zeroes(mask[1]) / 8;
+    }
+
+    for (; offset < bytes.size(); ++offset) {
+        auto byte = bytes[offset];
+        if (byte == '"' || byte == '\\' || byte < 0x20)
+            break;
+    }
+    return offset;
+}
+
+unsigned JSONParser::KeySequenceTraits::hash(ReadonlySpan<FlyString> keys)
+{
+    unsigned hash = 0;
+    for (auto const& key : keys)
+        hash = pair_int_hash(hash, key.hash());
+    return hash;
+}
+
+JSONParser::JSONParser(VM& vm, StringView text)
+    : GenericLexer(text)
+    , m_vm(vm)
+    , m_realm(*vm.current_realm())
+{
+}
+
+// 25.5.1.1 ParseJSON ( text ), https://tc39.es/ecma262/#sec-ParseJSON
+ThrowCompletionOr<Value> JSONParser::parse(VM& vm, StringView text)
+{
+    // NOTE: Strings are created from slices of the text without validating them again.
+    if (!Utf8View { text }.validate())
+        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+
+    JSONParser parser(vm, text);
+    auto value = TRY(parser.parse_value());
+
+    parser.skip_whitespace();
+    if (!parser.is_eof())
+        return parser.syntax_error();
+
+    return value;
+}
+
+Completion JSONParser::syntax_error()
+{
+    return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+}
+
+void JSONParser::skip_whitespace()
+{
+    using AK::SIMD::u8x16;
+    using AK::SIMD::u64x2;
+
+    auto bytes = m_input.bytes();
+
+    // Most tokens are separated by a single space or nothing at all; only longer runs, such as indentation, are worth
+    // looking at 16 bytes at a time.
+    if (m_index >= bytes.size() || !is_json_whitespace(bytes[m_index]))
+        return;
+    ++m_index;
+
+    for (; m_index + sizeof(u8x16) <= bytes.size(); m_index += sizeof(u8x16)) {
+        auto chunk = AK::SIMD::load_unaligned<u8x16>(bytes.offset_pointer(m_index));
+        auto mask = bit_cast<u64x2>(~((chunk == ' ') | (chunk == '\t') | (chunk == '\n') | (chunk == '\r')));
+        if (mask[0] != 0) {
+            m_index += count_trailing_zeroes(mask[0]) / 8;
+            return;
+        }
+        if (mask[1] != 0) {
+            m_index += 8 + count_trailing_zeroes(mask[1]) / 8;
+            return;
+        }
+    }
+
+    while (m_index < bytes.size() && is_json_whitespace(bytes[m_index]))
+        ++m_index;
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_value()
+{
+    skip_whitespace();
+
+    switch (peek()) {
+    case '{':
+        return parse_object();
+    case '[':
+        return parse_array();
+    case '"': {
+        bool has_escapes = false;
+        auto string = TRY(consume_string(has_escapes));
+        return PrimitiveString::create(m_vm, String::from_utf8_without_validation(string.bytes()));
+    }
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return parse_number();
+    case 't':
+        if (consume_specific("true"sv))
+            return Value(true);
+        break;
+    case 'f':
+        if (consume_specific("false"sv))
+            return Value(false);
+        break;
+    case 'n':
+        if (consume_specific("null"sv))
+            return js_null();
+        break;
+    }
+
+    return syntax_error();
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_object()
+{
+    if (m_vm.did_reach_stack_space_limit())
+        return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+    VERIFY(consume_specific('{'));
+
+    Vector<FlyString, 16> keys;
+    GC::ConservativeVector<Value> values(m_vm.heap());
+
+    skip_whitespace();
+    if (peek() != '}') {
+        for (;;) {
+            skip_whitespace();
+            keys.append(TRY(parse_key()));
+
+            skip_whitespace();
+            if (!consume_specific(':'))
+                return syntax_error();
+
+            values.append(TRY(parse_value()));
+
+            skip_whitespace();
+            if (consume_specific(','))
+                continue;
+            if (peek() == '}')
+                break;
+            return syntax_error();
+        }
+    }
+
+    VERIFY(consume_specific('}'));
+    return create_object(keys, values);
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_array()
+{
+    if (m_vm.did_reach_stack_space_limit())
+        return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+    VERIFY(consume_specific('['));
+
+    GC::ConservativeVector<Value> elements(m_vm.heap());
+
+    skip_whitespace();
+    if (peek() != ']') {
+        for (;;) {
+            elements.append(TRY(parse_value()));
+
+            skip_whitespace();
+            if (consume_specific(','))
+                continue;
+            if (peek() == ']')
+                break;
+            return syntax_error();
+        }
+    }
+
+    VERIFY(consume_specific(']'));
+
+    auto array = MUST(Array::create(m_realm, 0));
+    array->set_indexed_property_elements(move(static_cast<Vector<Value>&>(elements)));
+    return array;
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_number()
+{
+    auto start = m_index;
+    bool negative = consume_specific('-');
+
+    if (consume_specific('0')) {
+        // NOTE: Leading zeros are not allowed, which the caller notices when the next digit is not followed by a separator.
+    } else if (is_ascii_digit(peek())) {
+        ignore_while(is_ascii_digit);
+    } else {
+        return syntax_error();
+    }
+    auto integer_end = m_index;
+
+    bool is_integer = true;
+    if (consume_specific('.')) {
+        if (!is_ascii_digit(peek()))
+            return syntax_error();
+        ignore_while(is_ascii_digit);
+        is_integer = false;
+    }
+    if (peek() == 'e' || peek() == 'E') {
+        ignore();
+        if (peek() == '+' || peek() == '-')
+            ignore();
+        if (!is_ascii_digit(peek()))
+            return syntax_error();
+        ignore_while(is_ascii_digit);
+        is_integer = false;
+    }
+
+    // OPTIMIZATION: Integers with up to 15 digits are exactly representable as doubles, so they can be accumulated
+    //               directly instead of going through the floating point parser.
+    auto integer_start = start + (negative ? 1 : 0);
+    if (is_integer && integer_end - integer_start <= 15) {
+        i64 value = 0;
+        for (auto digit : m_input.substring_view(integer_start, integer_end - integer_start))
+            value = value * 10 + (digit - '0');
+        if (negative)
+            return value == 0 ? Value(-0.0) : Value(static_cast<double>(-value));
+        return Value(static_cast<double>(value));
+    }
+
+    auto number = m_input.substring_view(start, m_index - start);
+    auto const* characters = number.characters_without_null_termination();
+    auto result = parse_first_floating_point<double>(characters, characters + number.length());
+    if (!result.parsed_value() || result.end_ptr != characters + number.length())
+        return syntax_error();
+    return Value(result.value);
+}
+
+ThrowCompletionOr<FlyString> JSONParser::parse_key()
+{
+    if (peek() != '"')
+        return syntax_error();
+
+    bool has_escapes = false;
+    auto key = TRY(consume_string(has_escapes));
+    if (has_escapes)
+        return FlyString::from_utf8_without_validation(key.bytes());
+
+    // NOTE: Keys without escapes point into the text, which outlives the parser.
+    return m_interned_keys.ensure(key, [&] {
+        return FlyString::from_utf8_without_validation(key.bytes());
+    });
+}
+
+// Consumes a string literal. Unless the string contains escape sequences, the result points into the text. Otherwise,
+// it points into m_string_buffer and is only valid until the next string is consumed.
+ThrowCompletionOr<StringView> JSONParser::consume_string(bool& has_escapes)
+{
+    VERIFY(consume_specific('"'));
+
+    auto consume_literal = [&] {
+        auto literal_start = m_index;
+        m_index += find_end_of_string_literal(m_input.bytes().slice(m_index));
+        return m_input.substring_view(literal_start, m_index - literal_start);
+    };
+
+    auto literal = consume_literal();
+    if (consume_specific('"')) {
+        has_escapes = false;
+        return literal;
+    }
+
+    has_escapes = true;
+    m_string_buffer.clear();
+    m_string_buffer.append(literal);
+
+    for (;;) {
+        if (consume_specific('"'))
+            return m_string_buffer.string_view();
+
+        // Anything else that ends a literal is either the end of the text or an unescaped control character.
+        if (!consume_specific('\\'))
+            return syntax_error();
+
+        switch (peek()) {
+        case '"':
+        case '\\':
+        case '/':
+            m_string_buffer.append(consume());
+            break;
+        case 'b':
+            ignore();
+            m_string_buffer.append('\b');
+            break;
+        case 'f':
+            ignore();
+            m_string_buffer.append('\f');
+            break;
+        case 'n':
+            ignore();
+            m_string_buffer.append('\n');
+            break;
+        case 'r':
+            ignore();
+            m_string_buffer.append('\r');
+            break;
+        case 't':
+            ignore();
+            m_string_buffer.append('\t');
+            break;
+        case 'u': {
+            ignore();
+            auto code_point = decode_single_or_paired_surrogate();
+            if (code_point.is_error())
+                return syntax_error();
+            m_string_buffer.append_code_point(code_point.value());
+            break;
+        }
+        default:
+            return syntax_error();
+        }
+
+        m_string_buffer.append(consume_literal());
+    }
+}
+
+GC::Ptr<Shape> JSONParser::shape_for_keys(ReadonlySpan<FlyString> keys)
+{
+    if (keys.size() > max_keys_for_shared_shape)
+        return nullptr;
+
+    auto hash = KeySequenceTraits::hash(keys);
+    auto it = m_shapes.find(hash, [&](auto& entry) { return entry.key.span() == keys; });
+    if (it != m_shapes.end())
+        return it->value.ptr();
+
+    auto shape = [&] -> GC::Ptr<Shape> {
+        GC::Ref<Shape> shape = m_realm.intrinsics().new_object_shape();
+        for (auto const& key : keys) {
+            PropertyKey property_key { key };
+            // Array indices are stored as indexed properties, and duplicate keys overwrite the earlier property.
+            // Neither results in a shape with one property per key.
+            if (property_key.is_number() || shape->lookup(property_key).has_value())
+                return nullptr;
+            shape = shape->create_put_transition(property_key, default_attributes);
+        }
+        return shape;
+    }();
+
+    m_shapes.set(Vector<FlyString> { keys }, shape ? GC::make_root(*shape) : GC::Root<Shape> {});
+    return shape;
+}
+
+GC::Ref<Object> JSONParser::create_object(ReadonlySpan<FlyString> keys, ReadonlySpan<Value> values)
+{
+    if (auto shape = shape_for_keys(keys)) {
+        auto object = Object::create_with_premade_shape(*shape);
+        for (size_t i = 0; i < values.size(); ++i)
+            object->put_direct(i, values[i]);
+        return object;
+    }
+
+    auto object = Object::create(m_realm, m_realm.intrinsics().object_prototype());
+    for (size_t i = 0; i < keys.size(); ++i)
+        object->define_direct_property(keys[i], values[i], default_attributes);
+    return object;
+}
+
+}
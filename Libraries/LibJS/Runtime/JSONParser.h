@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/GenericLexer.h>
+#include <AK/HashMap.h>
+#include <AK/StringBuilder.h>
+#include <LibGC/Root.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/Completion.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS {
+
+// Parses JSON text straight into JS values, without building an intermediate AK::JsonValue tree.
+//
+// Keys are interned for the duration of a parse, and objects with the same sequence of keys are created with a
+// shared Shape that is looked up once per object, instead of transitioning to it one property at a time.
+class JSONParser : private GenericLexer {
+public:
+    static ThrowCompletionOr<Value> parse(VM&, StringView text);
+
+private:
+    JSONParser(VM&, StringView text);
+
+    ThrowCompletionOr<Value> parse_value();
+    ThrowCompletionOr<Value> parse_object();
+    ThrowCompletionOr<Value> parse_array();
+    ThrowCompletionOr<Value> parse_number();
+    ThrowCompletionOr<FlyString> parse_key();
+    ThrowCompletionOr<StringView> consume_string(bool& has_escapes);
+
+    void skip_whitespace();
+
+    GC::Ptr<Shape> shape_for_keys(ReadonlySpan<FlyString>);
+    GC::Ref<Object> create_object(ReadonlySpan<FlyString> keys, ReadonlySpan<Value> values);
+
+    Completion syntax_error();
+
+    struct KeySequenceTraits : public DefaultTraits<Vector<FlyString>> {
+        static unsigned hash(ReadonlySpan<FlyString>);
+        static unsigned hash(Vector<FlyString> const& keys) { return hash(keys.span()); }
+        static bool equals(Vector<FlyString> const& a, Vector<FlyString> const& b) { return a == b; }
+    };
+
+    VM& m_vm;
+    Realm& m_realm;
+    StringBuilder m_string_buffer;
+    HashMap<StringView, FlyString> m_interned_keys;
+    HashMap<Vector<FlyString>, GC::Root<Shape>, KeySequenceTraits> m_shapes;
+};
+
+}
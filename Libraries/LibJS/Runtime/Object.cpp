@@ -34,11 +34,15 @@ static HashMap<GC::Ptr<Object const>, HashMap<FlyString, Object::IntrinsicAccess
 // 10.1.12 OrdinaryObjectCreate ( proto [ , additionalInternalSlotsList ] ), https://tc39.es/ecma262/#sec-ordinaryobjectcreate
 GC::Ref<Object> Object::create(Realm& realm, Object* prototype)
 {
+    GC::Ptr<Object> object;
     if (!prototype)
-        return realm.create<Object>(realm.intrinsics().empty_object_shape());
-    if (prototype == realm.intrinsics().object_prototype())
-        return realm.create<Object>(realm.intrinsics().new_object_shape());
-    return realm.create<Object>(ConstructWithPrototypeTag::Tag, *prototype);
+        object = realm.create<Object>(realm.intrinsics().empty_object_shape());
+    else if (prototype == realm.intrinsics().object_prototype())
+        object = realm.create<Object>(realm.intrinsics().new_object_shape());
+    else
+        object = realm.create<Object>(ConstructWithPrototypeTag::Tag, *prototype);
+    object->m_is_plain_object = true;
+    return *object;
 }
 
 GC::Ref<Object> Object::create_prototype(Realm& realm, Object* prototype)
@@ -46,12 +50,16 @@ GC::Ref<Object> Object::create_prototype(Realm& realm, Object* prototype)
     auto shape = realm.heap().allocate<Shape>(realm);
     if (prototype)
         shape->set_prototype_without_transition(prototype);
-    return realm.create<Object>(shape);
+    auto object = realm.create<Object>(shape);
+    object->m_is_plain_object = true;
+    return object;
 }
 
 GC::Ref<Object> Object::create_with_premade_shape(Shape& shape)
 {
-    return shape.realm().create<Object>(shape);
+    auto object = shape.realm().create<Object>(shape);
+    object->m_is_plain_object = true;
+    return object;
 }
 
 Object::Object(GlobalObjectTag, Realm& realm, MayInterfereWithIndexedPropertyAccess may_interfere_with_indexed_property_access)
@@ -104,6 +112,7 @@ void Object::initialize(Realm&)
 void Object::unsafe_set_shape(Shape& shape)
 {
     m_shape = shape;
+    write_barrier(&shape);
     m_storage.resize(shape.property_count());
 }
 
@@ -546,6 +555,7 @@ ThrowCompletionOr<void> Object::private_field_add(PrivateName const& name, Value
 
     // 4. Append PrivateElement { [[Key]]: P, [[Kind]]: field, [[Value]]: value } to O.[[PrivateElements]].
     m_private_elements->empend(name, PrivateElement::Kind::Field, value);
+    write_barrier(value);
 
     // 5. Return unused.
     return {};
@@ -573,6 +583,7 @@ ThrowCompletionOr<void> Object::private_method_or_accessor_add(PrivateElement el
         m_private_elements = make<Vector<PrivateElement>>();
 
     // 5. Append method to O.[[PrivateElements]].
+    write_barrier(element.value);
     m_private_elements->append(move(element));
 
     // 6. Return unused.
@@ -629,6 +640,7 @@ ThrowCompletionOr<void> Object::private_set(PrivateName const& name, Value value
     if (entry->kind == PrivateElement::Kind::Field) {
         // a. Set entry.[[Value]] to value.
         entry->value = value;
+        write_barrier(value);
         return {};
     }
     // 4. Else if entry.[[Kind]] is method, then
@@ -1192,8 +1204,11 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
             return {};
 
         if (m_has_intrinsic_accessors) {
-            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
-                const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value()) {
+                auto& mutable_this = const_cast<Object&>(*this);
+                mutable_this.m_storage[metadata->offset] = (*accessor)(shape().realm());
+                mutable_this.write_barrier(mutable_this.m_storage[metadata->offset]);
+            }
         }
 
         value = m_storage[metadata->offset];
@@ -1218,6 +1233,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     if (property_key.is_number()) {
         auto index = property_key.as_number();
         m_indexed_properties.put(index, value, attributes);
+        write_barrier(value);
         return;
     }
 
@@ -1238,6 +1254,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
         else
             set_shape(*m_shape->create_put_transition(property_key, attributes));
         m_storage.append(value);
+        write_barrier(value);
         return;
     }
 
@@ -1249,6 +1266,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     }
 
     m_storage[metadata->offset] = value;
+    write_barrier(value);
 }
 
 void Object::storage_delete(PropertyKey const& property_key)
@@ -1268,6 +1286,7 @@ void Object::storage_delete(PropertyKey const& property_key)
 
     if (m_shape->is_cacheable_dictionary()) {
         m_shape = m_shape->create_uncacheable_dictionary_transition();
+        write_barrier(m_shape.ptr());
     }
     if (m_shape->is_uncacheable_dictionary()) {
         m_shape->remove_property_without_transition(property_key, metadata->offset);
@@ -1275,6 +1294,7 @@ void Object::storage_delete(PropertyKey const& property_key)
         return;
     }
     m_shape = m_shape->create_delete_transition(property_key);
+    write_barrier(m_shape.ptr());
     m_storage.remove(metadata->offset);
 }
 
@@ -1283,6 +1303,7 @@ void Object::set_prototype(Object* new_prototype)
     if (prototype() == new_prototype)
         return;
     m_shape = shape().create_prototype_transition(new_prototype);
+    write_barrier(m_shape.ptr());
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
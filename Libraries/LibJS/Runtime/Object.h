@@ -55,6 +55,7 @@ class Object : public Cell
     , public Weakable<Object> {
     GC_CELL(Object, Cell);
     GC_DECLARE_ALLOCATOR(Object);
+    GC_DECLARE_WRITE_BARRIER(Object);
 
 public:
     static GC::Ref<Object> create_prototype(Realm&, Object* prototype);
@@ -226,13 +227,27 @@ public:
     void set_has_parameter_map() { m_has_parameter_map = true; }
 
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void revoke_weak_ptrs_before_sweep() override { revoke_weak_ptrs(); }
 
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        m_storage[index] = value;
+        write_barrier(value);
+    }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    IndexedProperties& mutable_indexed_properties()
+    {
+        // NOTE: We can't see what the caller is going to store, so assume the worst.
+        write_barrier();
+        return m_indexed_properties;
+    }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(move(values));
+        write_barrier();
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -249,6 +264,9 @@ public:
     [[nodiscard]] bool is_typed_array() const { return m_is_typed_array; }
     void set_is_typed_array() { m_is_typed_array = true; }
 
+    // True for objects made by Object::create() and friends, which are never exotic.
+    [[nodiscard]] bool is_plain_object() const { return m_is_plain_object; }
+
     Object const* prototype() const { return shape().prototype(); }
 
 protected:
@@ -275,12 +293,18 @@ protected:
     bool m_is_typed_array { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        m_shape = &shape;
+        write_barrier(&shape);
+    }
 
     Object* prototype() { return shape().prototype(); }
 
     bool m_may_interfere_with_indexed_property_access { false };
 
+    bool m_is_plain_object { false };
+
     // True if this object has lazily allocated intrinsic properties.
     bool m_has_intrinsic_accessors { false };
 
@@ -22,6 +22,7 @@ namespace JS {
 class PrimitiveString : public Cell {
     GC_CELL(PrimitiveString, Cell);
     GC_DECLARE_ALLOCATOR(PrimitiveString);
+    GC_DECLARE_WRITE_BARRIER(PrimitiveString);
 
 public:
     [[nodiscard]] static GC::Ref<PrimitiveString> create(VM&, Utf16String);
@@ -80,6 +81,7 @@ private:
 class RopeString final : public PrimitiveString {
     GC_CELL(RopeString, PrimitiveString);
     GC_DECLARE_ALLOCATOR(RopeString);
+    GC_DECLARE_WRITE_BARRIER(RopeString);
 
 public:
     virtual ~RopeString() override;
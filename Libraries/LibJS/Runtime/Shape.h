@@ -44,6 +44,8 @@ public:
     void set_valid(bool valid) { m_valid = valid; }
 
 private:
+    virtual void revoke_weak_ptrs_before_sweep() override { revoke_weak_ptrs(); }
+
     bool m_valid { true };
     size_t padding { 0 };
 };
@@ -115,6 +117,7 @@ private:
     void invalidate_all_prototype_chains_leading_to_this();
 
     virtual void visit_edges(Visitor&) override;
+    virtual void revoke_weak_ptrs_before_sweep() override { revoke_weak_ptrs(); }
 
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_forward_transition(TransitionKey const&);
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_prototype_transition(Object* prototype);
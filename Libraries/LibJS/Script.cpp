@@ -19,6 +19,8 @@ Result<GC::Ref<Script>, Vector<ParserError>> Script::parse(StringView source_tex
 {
     // 1. Let script be ParseText(sourceText, Script).
     auto parser = Parser(Lexer(source_text, filename, line_number_offset));
+    if (g_lazy_function_parsing)
+        parser.enable_lazy_function_parsing();
     auto script = parser.parse_program();
 
     // 2. If script is a List of errors, return body.
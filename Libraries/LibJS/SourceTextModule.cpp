@@ -133,6 +133,8 @@ Result<GC::Ref<SourceTextModule>, Vector<ParserError>> SourceTextModule::parse(S
 {
     // 1. Let body be ParseText(sourceText, Module).
     auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
+    if (g_lazy_function_parsing)
+        parser.enable_lazy_function_parsing();
     auto body = parser.parse_program();
 
     // 2. If body is a List of errors, return body.
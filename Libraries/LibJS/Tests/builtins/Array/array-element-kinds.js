@@ -0,0 +1,105 @@
+test("numeric arrays widen to hold other values", () => {
+    const array = [1, 2, 3];
+    array[1] = 2.5;
+    expect(array).toEqual([1, 2.5, 3]);
+    array[2] = "foo";
+    expect(array).toEqual([1, 2.5, "foo"]);
+    array[0] = 1;
+    expect(array.indexOf("foo")).toBe(2);
+    expect(array.indexOf(2.5)).toBe(1);
+});
+
+test("indexOf on numeric arrays", () => {
+    const array = [1, 2, 3, -0, 2];
+    expect(array.indexOf(2)).toBe(1);
+    expect(array.indexOf(2, 2)).toBe(4);
+    expect(array.indexOf(2.0)).toBe(1);
+    expect(array.indexOf(0)).toBe(3);
+    expect(array.indexOf("2")).toBe(-1);
+    expect(array.indexOf(NaN)).toBe(-1);
+    expect([1.5, NaN].indexOf(NaN)).toBe(-1);
+    expect([1.5, 2.5].indexOf(2.5)).toBe(1);
+});
+
+test("holes read through to the prototype chain", () => {
+    const array = [1, , 3];
+    expect(array.indexOf(undefined)).toBe(-1);
+    const mapped = array.map(x => x * 2);
+    expect(mapped).toHaveLength(3);
+    expect(1 in mapped).toBeFalse();
+
+    Array.prototype[1] = 2;
+    try {
+        expect(array.indexOf(2)).toBe(1);
+        expect(array.map(x => x * 2)).toEqual([2, 4, 6]);
+    } finally {
+        delete Array.prototype[1];
+    }
+});
+
+test("appending respects setters on the prototype chain", () => {
+    const array = [1, 2];
+    let setterValue;
+    Object.defineProperty(Array.prototype, 2, {
+        set(value) {
+            setterValue = value;
+        },
+        configurable: true,
+    });
+    try {
+        expect(array.push(3)).toBe(3);
+        expect(setterValue).toBe(3);
+        expect(array.hasOwnProperty(2)).toBeFalse();
+
+        array[array.length] = 4;
+        expect(setterValue).toBe(4);
+    } finally {
+        delete Array.prototype[2];
+    }
+
+    expect(array.push(5, 6)).toBe(5);
+    array[array.length] = 7;
+    expect(array.length).toBe(6);
+    expect(array[5]).toBe(7);
+});
+
+test("appending to non-extensible arrays", () => {
+    const array = Object.preventExtensions([1, 2]);
+    expect(() => {
+        array.push(3);
+    }).toThrow(TypeError);
+    expect(array).toEqual([1, 2]);
+});
+
+test("default sort of Int32 arrays compares string representations", () => {
+    expect([10, 9, 1, -1, -10, 100, 0, -2147483648, 2147483647].sort()).toEqual([
+        -1, -10, -2147483648, 0, 1, 10, 100, 2147483647, 9,
+    ]);
+    expect([3, 1, 2].sort((a, b) => b - a)).toEqual([3, 2, 1]);
+
+    const holey = [3, , 1].sort();
+    expect(holey).toHaveLength(3);
+    expect(holey[0]).toBe(1);
+    expect(holey[1]).toBe(3);
+    expect(2 in holey).toBeFalse();
+});
+
+test("map callback changing the source array", () => {
+    const array = [1, 2, 3, 4];
+    const result = array.map((x, i) => {
+        if (i === 0) array.length = 2;
+        return x;
+    });
+    expect(result).toHaveLength(4);
+    expect(result[0]).toBe(1);
+    expect(result[1]).toBe(2);
+    expect(2 in result).toBeFalse();
+    expect(3 in result).toBeFalse();
+});
+
+test("fill", () => {
+    const array = [1, 2, 3];
+    array.fill("x", 1);
+    expect(array).toEqual([1, "x", "x"]);
+    expect(new Array(3).fill(0)).toEqual([0, 0, 0]);
+});
@@ -74,3 +74,44 @@ test("does not truncate large integers", () => {
     expect(JSON.parse("18446744073709551616")).toEqual(18446744073709551616);
     expect(JSON.parse("18446744073709551617")).toEqual(18446744073709551617);
 });
+
+test("objects with the same keys", () => {
+    const result = JSON.parse('[{"a":1,"b":2},{"a":3,"b":4},{"b":5,"a":6},{"a":7,"b":8,"a":9},{"0":1,"a":2}]');
+    expect(result).toEqual([{ a: 1, b: 2 }, { a: 3, b: 4 }, { b: 5, a: 6 }, { a: 9, b: 8 }, { 0: 1, a: 2 }]);
+    expect(Object.keys(result[2])).toEqual(["b", "a"]);
+    expect(Object.keys(result[3])).toEqual(["a", "b"]);
+    expect(Object.keys(result[4])).toEqual(["0", "a"]);
+
+    result[0].c = 3;
+    expect(result[1].c).toBeUndefined();
+    expect(Object.getPrototypeOf(result[1])).toBe(Object.prototype);
+});
+
+test("string escapes", () => {
+    expect(JSON.parse('"a\\"b\\\\c\\/d\\b\\f\\n\\r\\t"')).toBe('a"b\\c/d\b\f\n\r\t');
+    expect(JSON.parse('"\\u0041\\ud83d\\ude00x"')).toBe("A\u{1F600}x");
+    expect(JSON.parse('{"\\u0061":1,"a":2}')).toEqual({ a: 2 });
+    expect(JSON.parse('"' + "x".repeat(40) + '\\n"')).toBe("x".repeat(40) + "\n");
+
+    ['"\\x"', '"\\u00g0"', '"a\nb"', '"abc', '"' + "x".repeat(40)].forEach(test => {
+        expect(() => {
+            JSON.parse(test);
+        }).toThrow(SyntaxError);
+    });
+});
+
+test("whitespace", () => {
+    const indent = " ".repeat(40);
+    expect(JSON.parse(`${indent}[\n${indent}1,\t\r\n${indent}{ "a" : [ ] }\n${indent}]${indent}`)).toEqual([1, { a: [] }]);
+});
+
+test("number syntax", () => {
+    expect(JSON.parse("1e3")).toBe(1000);
+    expect(JSON.parse("-1.5E-2")).toBe(-0.015);
+    expect(JSON.parse("123456789012345")).toBe(123456789012345);
+    ["01", "-", "1.", ".1", "1e", "+1", "- 1", "0x10"].forEach(test => {
+        expect(() => {
+            JSON.parse(test);
+        }).toThrow(SyntaxError);
+    });
+});
@@ -0,0 +1,84 @@
+test("objects with the same shape", () => {
+    const records = [
+        { id: 1, name: "a", tags: ["x", "y"] },
+        { id: 2, name: "b\n", tags: [] },
+        { id: 3.5, name: "😀", tags: [null, undefined, () => {}, Symbol()] },
+    ];
+    expect(JSON.stringify(records)).toBe(
+        '[{"id":1,"name":"a","tags":["x","y"]},{"id":2,"name":"b\\n","tags":[]},{"id":3.5,"name":"😀","tags":[null,null,null,null]}]'
+    );
+});
+
+test("omitted and special values", () => {
+    expect(JSON.stringify({ a: undefined, b: Symbol(), c: () => {}, d: NaN, e: -0, f: Infinity })).toBe(
+        '{"d":null,"e":0,"f":null}'
+    );
+    expect(JSON.stringify([1, , 3])).toBe("[1,null,3]");
+    expect(JSON.stringify(new Array(3))).toBe("[null,null,null]");
+    expect(JSON.stringify(Object.create(null, { a: { value: 1, enumerable: true }, b: { value: 2 } }))).toBe('{"a":1}');
+    expect(JSON.stringify({ ['"key"']: 1 })).toBe('{"\\"key\\"":1}');
+});
+
+test("deleted properties", () => {
+    const object = { a: 1, b: 2, c: 3 };
+    delete object.b;
+    object.d = 4;
+    expect(JSON.stringify(object)).toBe('{"a":1,"c":3,"d":4}');
+});
+
+test("toJSON methods", () => {
+    expect(JSON.stringify({ a: { toJSON: () => "x" } })).toBe('{"a":"x"}');
+    const array = [1];
+    array.toJSON = () => "array";
+    expect(JSON.stringify({ array })).toBe('{"array":"array"}');
+
+    Object.prototype.toJSON = function () {
+        return "object";
+    };
+    try {
+        expect(JSON.stringify([{ a: 1 }])).toBe('["object"]');
+    } finally {
+        delete Object.prototype.toJSON;
+    }
+    expect(JSON.stringify([{ a: 1 }])).toBe('[{"a":1}]');
+});
+
+test("getters and holes read through the prototype chain", () => {
+    let calls = 0;
+    const object = {
+        a: 1,
+        get b() {
+            ++calls;
+            return 2;
+        },
+    };
+    expect(JSON.stringify([object, object])).toBe('[{"a":1,"b":2},{"a":1,"b":2}]');
+    expect(calls).toBe(2);
+
+    Array.prototype[1] = "inherited";
+    try {
+        expect(JSON.stringify([1, , 3])).toBe('[1,"inherited",3]');
+    } finally {
+        delete Array.prototype[1];
+    }
+});
+
+test("array index keys come first", () => {
+    expect(JSON.stringify({ b: 1, 1: 2, a: 3, 0: 4 })).toBe('{"0":4,"1":2,"b":1,"a":3}');
+});
+
+test("exotic objects with the default prototype", () => {
+    const withObjectPrototype = object => Object.setPrototypeOf(object, Object.prototype);
+
+    expect(JSON.stringify(withObjectPrototype(new String("ab")))).toBe('"[object String]"');
+    expect(JSON.stringify(withObjectPrototype(new Number(1)))).toBe("null");
+    expect(JSON.stringify(withObjectPrototype(new Uint8Array([1, 2])))).toBe('{"0":1,"1":2}');
+    expect(JSON.stringify(new Proxy({ a: 1 }, { get: () => 2 }))).toBe('{"a":2}');
+    expect(JSON.stringify({ raw: JSON.rawJSON("1e1000") })).toBe('{"raw":1e1000}');
+
+    function mapped(a) {
+        a = 2;
+        return arguments;
+    }
+    expect(JSON.stringify(mapped(1))).toBe('{"0":2}');
+});
@@ -0,0 +1,218 @@
+// These exercise the rewrites done by Bytecode::Optimizer. Run `js --dump-bytecode-passes` on a snippet to see them.
+
+function locationOfFrame(error, functionName) {
+    const frame = error.stack.split("\n").find(line => line.startsWith(`    at ${functionName} (`));
+    return frame.match(/:(\d+:\d+)\)$/)[1];
+}
+
+function errorFrom(callback) {
+    try {
+        callback();
+    } catch (error) {
+        return error;
+    }
+    expect().fail("callback did not throw");
+}
+
+describe("constant folding", () => {
+    test("arithmetic on constant numbers", () => {
+        const a = 1 + 2;
+        const b = 7 - 10;
+        const c = 6 * 7;
+        const d = 1 / 4;
+        const e = -7 % 3;
+        const f = 2 ** 10;
+        expect([a, b, c, d, e, f]).toEqual([3, -3, 42, 0.25, -1, 1024]);
+    });
+
+    test("bitwise operations on constant numbers", () => {
+        expect(0b1100 & 0b1010).toBe(0b1000);
+        expect(0b1100 | 0b1010).toBe(0b1110);
+        expect(0b1100 ^ 0b1010).toBe(0b0110);
+        expect(1 << 31).toBe(-2147483648);
+        expect(-16 >> 2).toBe(-4);
+        expect(-1 >>> 28).toBe(15);
+        expect(~5).toBe(-6);
+    });
+
+    test("signed zero and NaN survive folding", () => {
+        expect(Object.is(-0, 0)).toBeFalse();
+        expect(Object.is(0 * -1, -0)).toBeTrue();
+        expect(1 / (0 * -1)).toBe(-Infinity);
+        expect(0 / 0).toBeNaN();
+        expect(NaN === NaN).toBeFalse();
+        expect(NaN !== NaN).toBeTrue();
+        expect(NaN < 1).toBeFalse();
+        expect(NaN >= 1).toBeFalse();
+    });
+
+    test("operations on non-numbers are not folded", () => {
+        expect(1 + "2").toBe("12");
+        expect("3" * "4").toBe(12);
+        expect(null + 1).toBe(1);
+        expect(!"").toBeTrue();
+        expect(!{}).toBeFalse();
+        expect(+"42").toBe(42);
+    });
+
+    test("constants propagated through locals", () => {
+        let x = 10;
+        let y = x * 2;
+        x = 3;
+        expect(x + y).toBe(23);
+    });
+
+    test("values changed in another block are not propagated", () => {
+        let x = 1;
+        for (let i = 0; i < 3; ++i) x = x * 2;
+        expect(x).toBe(8);
+    });
+
+    test("conditional jumps on constants", () => {
+        let taken = [];
+        if (1 < 2) taken.push("lt");
+        if (2 <= 1) taken.push("le");
+        if (0) taken.push("zero");
+        if ("") taken.push("empty string");
+        if (null ?? true) taken.push("nullish");
+        while (false) taken.push("never");
+        expect(taken).toEqual(["lt", "nullish"]);
+    });
+});
+
+describe("unreachable block removal", () => {
+    test("function declarations in dead branches are still hoisted", () => {
+        function outer() {
+            if (false) {
+                function inner() {}
+            }
+            return typeof inner;
+        }
+        expect(outer()).toBe("undefined");
+    });
+
+    test("finally blocks after a folded condition still run", () => {
+        let log = [];
+        function f() {
+            try {
+                if (1 === 1) return "returned";
+                log.push("unreachable");
+            } finally {
+                log.push("finally");
+            }
+        }
+        expect(f()).toBe("returned");
+        expect(log).toEqual(["finally"]);
+    });
+});
+
+describe("move coalescing and dead stores", () => {
+    test("results land in the right local", () => {
+        function f(a, b) {
+            let sum = a + b;
+            let product = a * b;
+            let swap = sum;
+            sum = product;
+            product = swap;
+            return [sum, product];
+        }
+        expect(f(3, 4)).toEqual([12, 7]);
+    });
+
+    test("arguments read before their local is overwritten", () => {
+        function f(a, b) {
+            a = a + b;
+            b = a - b;
+            a = a - b;
+            return [a, b];
+        }
+        expect(f(1, 2)).toEqual([2, 1]);
+    });
+
+    test("self-assignment", () => {
+        let x = 5;
+        x = x;
+        expect(x).toBe(5);
+    });
+
+    test("deeply nested expressions", () => {
+        function f(a) {
+            return ((a + 1) * (a + 2) - (a + 3) * (a + 4)) / (a + 5 - (a + 6));
+        }
+        expect(f(1)).toBe((2 * 3 - 4 * 5) / (6 - 7));
+    });
+});
+
+describe("fused method calls", () => {
+    test("this value and arguments", () => {
+        const o = {
+            value: 40,
+            add(a, b) {
+                return this.value + a + b;
+            },
+        };
+        function call(o) {
+            return o.add(1, 1);
+        }
+        expect(call(o)).toBe(42);
+    });
+
+    test("getters run once per call", () => {
+        let getterCalls = 0;
+        const o = {
+            get method() {
+                ++getterCalls;
+                return () => "result";
+            },
+        };
+        function call(o) {
+            return o.method();
+        }
+        expect(call(o)).toBe("result");
+        expect(call(o)).toBe("result");
+        expect(getterCalls).toBe(2);
+    });
+
+    test("megamorphic receivers", () => {
+        function call(o) {
+            return o.f();
+        }
+        const results = [];
+        for (let i = 0; i < 16; ++i) results.push(call({ ["unique" + i]: i, f: () => i }));
+        expect(results).toEqual(Array.from({ length: 16 }, (_, i) => i));
+    });
+
+    test("calling a non-function reports the call site", () => {
+        function callMissing(o) {
+            return o.missing();
+        }
+        const error = errorFrom(() => callMissing({}));
+        expect(error).toBeInstanceOf(TypeError);
+        expect(error.message).toBe("undefined is not a function (evaluated from 'o.missing')");
+        expect(locationOfFrame(error, "callMissing")).toBe("187:29");
+    });
+
+    test("calling a method on undefined reports the call site", () => {
+        function callOnUndefined(o) {
+            return o.method();
+        }
+        const error = errorFrom(() => callOnUndefined(undefined));
+        expect(error).toBeInstanceOf(TypeError);
+        expect(error.message).toBe('Cannot access property "method" on undefined object "o"');
+        expect(locationOfFrame(error, "callOnUndefined")).toBe("197:28");
+    });
+
+    test("errors thrown by the callee point at the call in the caller", () => {
+        const o = {
+            throws() {
+                throw new Error("from callee");
+            },
+        };
+        function callThrowing(o) {
+            return o.throws();
+        }
+        const error = errorFrom(() => callThrowing(o));
+        expect(error.message).toBe("from callee");
+        expect(locationOfFrame(error, "callThrowing")).toBe("212:28");
+    });
+});
@@ -16,3 +16,76 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Megamorphic get and put sites", () => {
+    const objects = [];
+    for (let i = 0; i < 16; ++i) {
+        const o = { ["unique" + i]: i };
+        o.value = i;
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.value;
+    }
+
+    function put(o, value) {
+        o.value = value;
+    }
+
+    for (let round = 0; round < 3; ++round) {
+        for (let i = 0; i < objects.length; ++i) {
+            expect(get(objects[i])).toBe(i + round);
+            put(objects[i], i + round + 1);
+        }
+    }
+});
+
+test("Megamorphic cache invalidated by prototype chain changes", () => {
+    const proto = {
+        get value() {
+            return "getter";
+        },
+    };
+    const objects = [];
+    for (let i = 0; i < 16; ++i) {
+        const o = Object.create(proto);
+        o["unique" + i] = i;
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.value;
+    }
+
+    for (const o of objects) expect(get(o)).toBe("getter");
+
+    Object.defineProperty(proto, "value", { value: "data" });
+    for (const o of objects) expect(get(o)).toBe("data");
+
+    Object.setPrototypeOf(proto, { other: 1 });
+    delete proto.value;
+    for (const o of objects) expect(get(o)).toBeUndefined();
+});
+
+test("Megamorphic put site does not write to non-writable properties", () => {
+    const objects = [];
+    for (let i = 0; i < 16; ++i) {
+        const o = { ["unique" + i]: i, value: 1 };
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.value;
+    }
+
+    function put(o) {
+        o.value = 2;
+    }
+
+    for (const o of objects) get(o);
+    Object.defineProperty(objects[0], "value", { writable: false });
+    for (const o of objects) put(o);
+    expect(objects[0].value).toBe(1);
+    expect(objects[1].value).toBe(2);
+});
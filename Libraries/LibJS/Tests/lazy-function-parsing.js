@@ -0,0 +1,230 @@
+// evaluateSourceWithLazyParsing() parses like `js --lazy-parse`: the bodies of plain functions are skipped,
+// and only parsed when the function is first called.
+
+describe("normal behavior", () => {
+    test("calling a lazily parsed function", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function lazyAdd(a, b) {
+                return a + b;
+            }
+            lazyAdd(1, 2) + lazyAdd(3, 4);
+        `);
+        expect(result).toBe(10);
+    });
+
+    test("function expressions and nested functions", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            var lazyOuter = function (n) {
+                function inner(m) {
+                    return function () {
+                        return n * m;
+                    };
+                }
+                return inner(n + 1)();
+            };
+            lazyOuter(6);
+        `);
+        expect(result).toBe(42);
+    });
+
+    test("closures over outer bindings", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            let lazyCounter = 0;
+            function lazyIncrement() {
+                return ++lazyCounter;
+            }
+            function lazyRead() {
+                return lazyCounter;
+            }
+            lazyIncrement();
+            lazyIncrement();
+            [lazyRead(), lazyCounter];
+        `);
+        expect(result).toEqual([2, 2]);
+    });
+
+    test("outer bindings declared in a function that is itself lazily parsed", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function lazyMakeAccumulator() {
+                let total = 0;
+                function add(value) {
+                    total += value;
+                    return total;
+                }
+                return add;
+            }
+            const lazyAccumulator = lazyMakeAccumulator();
+            lazyAccumulator(5);
+            lazyAccumulator(10);
+        `);
+        expect(result).toBe(15);
+    });
+
+    test("direct eval inside a lazily parsed body sees outer bindings", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function lazyEvalOuter() {
+                let secret = "found";
+                function inner() {
+                    return eval("secret");
+                }
+                return inner();
+            }
+            lazyEvalOuter();
+        `);
+        expect(result).toBe("found");
+    });
+
+    test("arguments, default parameters and this", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function lazyArguments(a, b = a * 2) {
+                return [arguments.length, a, b, typeof this];
+            }
+            lazyArguments.call({}, 3);
+        `);
+        expect(result).toEqual([1, 3, 6, "object"]);
+    });
+
+    test("strict mode is inherited and detected inside the body", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function lazySloppyThis() {
+                return typeof this;
+            }
+            function lazyStrictThis() {
+                "use strict";
+                return typeof this;
+            }
+            [lazySloppyThis(), lazyStrictThis()];
+        `);
+        expect(result).toEqual(["object", "undefined"]);
+
+        const strictResult = evaluateSourceWithLazyParsing(`
+            "use strict";
+            function lazyInheritedStrictThis() {
+                return typeof this;
+            }
+            lazyInheritedStrictThis();
+        `);
+        expect(strictResult).toBe("undefined");
+    });
+
+    test("generators and async functions", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function* lazyGenerator() {
+                yield 1;
+                yield 2;
+            }
+            [...lazyGenerator()];
+        `);
+        expect(result).toEqual([1, 2]);
+
+        const promise = evaluateSourceWithLazyParsing(`
+            async function lazyAsync(value) {
+                return await value;
+            }
+            lazyAsync(7);
+        `);
+        let resolved;
+        promise.then(value => {
+            resolved = value;
+        });
+        runQueuedPromiseJobs();
+        expect(resolved).toBe(7);
+    });
+
+    test("constructing a lazily parsed function", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function LazyPoint(x, y) {
+                this.x = x;
+                this.y = y;
+            }
+            const lazyPoint = new LazyPoint(1, 2);
+            [lazyPoint instanceof LazyPoint, lazyPoint.x, lazyPoint.y];
+        `);
+        expect(result).toEqual([true, 1, 2]);
+    });
+
+    test("length and name are known before the first call", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function lazyLength(a, b, c = 1, d) {}
+            [lazyLength.length, lazyLength.name];
+        `);
+        expect(result).toEqual([2, "lazyLength"]);
+    });
+
+    test("bodies that confuse the skimmer are parsed eagerly instead", () => {
+        const result = evaluateSourceWithLazyParsing(`
+            function lazyRegExpWithBrace() {
+                return /}/.source + /{/.source;
+            }
+            lazyRegExpWithBrace();
+        `);
+        expect(result).toBe("}{");
+    });
+});
+
+describe("Function.prototype.toString", () => {
+    test("returns the source text before and after the first call", () => {
+        const source = `function lazyToString(a, b) {
+                // A comment, and some    odd spacing.
+                return a  +  b;
+            }`;
+        const lazyToString = evaluateSourceWithLazyParsing(`${source}\nlazyToString;`);
+        expect(lazyToString.toString()).toBe(source);
+        expect(lazyToString(1, 2)).toBe(3);
+        expect(lazyToString.toString()).toBe(source);
+    });
+
+    test("function expressions and nested functions", () => {
+        const inner = `function inner() { return "}"; }`;
+        const outer = `function () {
+                ${inner}
+                return inner;
+            }`;
+        const lazyOuterExpression = evaluateSourceWithLazyParsing(`(${outer});`);
+        expect(lazyOuterExpression.toString()).toBe(outer);
+        expect(lazyOuterExpression().toString()).toBe(inner);
+    });
+});
+
+describe("errors", () => {
+    test("early errors in a skipped body are thrown on every call", () => {
+        const lazyBroken = evaluateSourceWithLazyParsing(`
+            function lazyBroken() {
+                let a;
+                let a;
+            }
+            lazyBroken;
+        `);
+        expect(lazyBroken.toString().includes("let a;")).toBeTrue();
+        expect(() => {
+            lazyBroken();
+        }).toThrowWithMessage(SyntaxError, "Identifier 'a' already declared");
+        expect(() => {
+            new lazyBroken();
+        }).toThrowWithMessage(SyntaxError, "Identifier 'a' already declared");
+    });
+
+    test("a strict directive with non-simple parameters is reported eagerly", () => {
+        expect(() => {
+            evaluateSourceWithLazyParsing(`function lazyNonSimpleStrict(a = 1) { "use strict"; }`);
+        }).toThrowWithMessage(SyntaxError, "Illegal 'use strict' directive in function with non-simple parameter list");
+    });
+
+    test("syntax errors that unbalance the braces are reported eagerly", () => {
+        expect(() => {
+            evaluateSourceWithLazyParsing(`function lazyUnbalanced() { if (true) { }`);
+        }).toThrow(SyntaxError);
+    });
+
+    test("runtime errors inside a lazily parsed body", () => {
+        const lazyThrows = evaluateSourceWithLazyParsing(`
+            function lazyThrows() {
+                return lazyUndeclaredVariable;
+            }
+            lazyThrows;
+        `);
+        expect(() => {
+            lazyThrows();
+        }).toThrowWithMessage(ReferenceError, "'lazyUndeclaredVariable' is not defined");
+    });
+});
@@ -47,8 +47,26 @@ static OrderedHashMap<CacheKey<Parser>, regex::Parser::Result> s_parser_cache;
 template<class Parser>
 static size_t s_cached_bytecode_size = 0;
 
+template<class Parser>
+static RegexCacheStatistics s_cache_statistics;
+
 static constexpr auto MaxRegexCachedBytecodeSize = 1 * MiB;
 
+// Returns the optimized parse result for this pattern and these options, and marks it as the most recently used one.
+template<class Parser>
+static Optional<regex::Parser::Result> lookup_cached_parse_result(CacheKey<Parser> const& key)
+{
+    auto result = s_parser_cache<Parser>.take(key);
+    if (!result.has_value()) {
+        ++s_cache_statistics<Parser>.misses;
+        return {};
+    }
+
+    ++s_cache_statistics<Parser>.hits;
+    s_parser_cache<Parser>.set(key, *result);
+    return result;
+}
+
 template<class Parser>
 static void cache_parse_result(regex::Parser::Result const& result, CacheKey<Parser> const& key)
 {
@@ -56,19 +74,40 @@ static void cache_parse_result(regex::Parser::Result const& result, CacheKey<Par
     if (bytecode_size > MaxRegexCachedBytecodeSize)
         return;
 
-    while (bytecode_size + s_cached_bytecode_size<Parser> > MaxRegexCachedBytecodeSize)
+    // Evict the least recently used entries until there is room for this one.
+    while (bytecode_size + s_cached_bytecode_size<Parser> > MaxRegexCachedBytecodeSize) {
         s_cached_bytecode_size<Parser> -= s_parser_cache<Parser>.take_first().bytecode.size() * sizeof(ByteCodeValueType);
+        ++s_cache_statistics<Parser>.evictions;
+    }
 
     s_parser_cache<Parser>.set(key, result);
     s_cached_bytecode_size<Parser> += bytecode_size;
 }
 
+template<class Parser>
+RegexCacheStatistics Regex<Parser>::cache_statistics()
+{
+    auto statistics = s_cache_statistics<Parser>;
+    statistics.entries = s_parser_cache<Parser>.size();
+    statistics.bytecode_size = s_cached_bytecode_size<Parser>;
+    return statistics;
+}
+
+void RegexCacheStatistics::dump() const
+{
+    auto lookups = hits + misses;
+    warnln("\033[37;1mCompiled regex cache\033[0m");
+    warnln("  lookups:                  {} ({:.1}% hits)", lookups, lookups ? 100.0 * hits / lookups : 0.0);
+    warnln("  evictions:                {}", evictions);
+    warnln("  entries:                  {} ({} bytes of bytecode)", entries, bytecode_size);
+}
+
 template<class Parser>
 Regex<Parser>::Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
     : pattern_value(move(pattern))
 {
-    if (auto cache_entry = s_parser_cache<Parser>.get({ pattern_value, regex_options }); cache_entry.has_value()) {
-        parser_result = cache_entry.value();
+    if (auto cache_entry = lookup_cached_parse_result<Parser>({ pattern_value, regex_options }); cache_entry.has_value()) {
+        parser_result = cache_entry.release_value();
     } else {
         regex::Lexer lexer(pattern_value);
 
@@ -88,9 +127,18 @@ Regex<Parser>::Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsT
 template<class Parser>
 Regex<Parser>::Regex(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
     : pattern_value(move(pattern))
-    , parser_result(move(parse_result))
 {
-    run_optimization_passes();
+    // NOTE: The parse result is the same for every evaluation of a regular expression literal, so only the first one
+    //       has to run the optimization passes on it.
+    if (auto cache_entry = lookup_cached_parse_result<Parser>({ pattern_value, regex_options }); cache_entry.has_value()) {
+        parser_result = cache_entry.release_value();
+    } else {
+        parser_result = move(parse_result);
+        run_optimization_passes();
+        if (parser_result.error == regex::Error::NoError)
+            cache_parse_result<Parser>(parser_result, { pattern_value, regex_options });
+    }
+
     if (parser_result.error == regex::Error::NoError)
         matcher = make<Matcher<Parser>>(this, regex_options | static_cast<decltype(regex_options.value())>(parser_result.options.value()));
 }
@@ -209,6 +257,10 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
 
+    // The prefilter skips ahead to the next position a match could start at, which is only useful if we're searching.
+    auto const* prefilter = continue_search && !only_start_of_line ? m_pattern->parser_result.optimization_data.prefilter.ptr() : nullptr;
+    auto insensitive = input.regex_options.has_flag_set(AllFlags::Insensitive);
+
     auto compare_range = [insensitive = input.regex_options & AllFlags::Insensitive](auto needle, CharRange range) {
         auto upper_case_needle = needle;
         auto lower_case_needle = needle;
@@ -270,12 +322,43 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
+        // Unicode views are indexed by code point, which the prefilter can't skip through.
+        auto const* view_prefilter = view.unicode() ? nullptr : prefilter;
+
+        // Rather than trying every position, the NFA can find out in one pass where (or whether) the next match starts.
+        auto* searcher = continue_search && !only_start_of_line ? nfa_matcher(input) : nullptr;
+        bool should_search = true;
+
         for (; view_index <= view_length; ++view_index) {
             if (view_index == view_length) {
                 if (input.regex_options.has_flag_set(AllFlags::Multiline))
                     break;
             }
 
+            if (view_prefilter) {
+                // Every match consumes at least one character, so there are no more matches if there are no more candidates.
+                auto candidate = view_prefilter->find_candidate(input.view, view_index, insensitive);
+                if (!candidate.has_value())
+                    break;
+                view_index = *candidate;
+            }
+
+            // NOTE: A match does start at or after the position the search found, so until we find it, there's no need to search again.
+            if (searcher && should_search) {
+                size_t match_start = 0;
+                auto result = searcher->search(input, view_index, match_start, operations);
+                if (result == NFAMatcher::SearchResult::NoMatch)
+                    break;
+                if (result == NFAMatcher::SearchResult::Unsupported) {
+                    searcher = nullptr;
+                } else {
+                    should_search = false;
+                    view_index = match_start;
+                    if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
+                        break;
+                }
+            }
+
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
             //        the vm. Add new OpCode for MinMatchLengthFromSp with the value of
@@ -286,7 +369,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
-            if (auto& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges; !starting_ranges.is_empty()) {
+            if (auto& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges; !view_prefilter && !starting_ranges.is_empty()) {
                 if (!binary_search(starting_ranges, input.view.code_unit_at(view_index), nullptr, compare_range))
                     goto done_matching;
             }
@@ -320,6 +403,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
                 if (continue_search) {
                     append_match(input, state, view_index);
+                    should_search = true;
 
                     bool has_zero_length = state.string_position == view_index;
                     view_index = state.string_position - (has_zero_length ? 0 : 1);
@@ -474,6 +558,17 @@ struct SufficientlyUniformValueTraits : DefaultTraits<u64> {
     }
 };
 
+template<class Parser>
+NFAMatcher* Matcher<Parser>::nfa_matcher(MatchInput const& input) const
+{
+    auto const& nfa_program = m_pattern->parser_result.optimization_data.nfa_program;
+    if (!nfa_program || input.regex_options.has_flag_set(AllFlags::Internal_BacktrackingOnly))
+        return nullptr;
+    if (!m_nfa_matcher)
+        m_nfa_matcher = make<NFAMatcher>(*nfa_program, m_pattern->parser_result.capture_groups_count);
+    return m_nfa_matcher.ptr();
+}
+
 template<class Parser>
 bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t& operations) const
 {
@@ -483,6 +578,11 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
     size_t recursion_level = 0;
 #endif
 
+    if (auto* nfa_matcher = this->nfa_matcher(input)) {
+        if (auto result = nfa_matcher->execute(input, state, operations); result.has_value())
+            return result.value();
+    }
+
     auto& bytecode = m_pattern->parser_result.bytecode;
 
     for (;;) {
@@ -43,6 +43,18 @@ struct REGEX_API RegexResult final {
     size_t n_named_capture_groups { 0 };
 };
 
+// Hit rates of the cache of optimized parse results, which is keyed on pattern and options, and shared by all
+// Regex objects that use the same parser.
+struct REGEX_API RegexCacheStatistics {
+    u64 hits { 0 };
+    u64 misses { 0 };
+    u64 evictions { 0 };
+    size_t entries { 0 };
+    size_t bytecode_size { 0 };
+
+    void dump() const;
+};
+
 template<class Parser>
 class REGEX_API Regex;
 
@@ -72,9 +84,11 @@ public:
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    NFAMatcher* nfa_matcher(MatchInput const&) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+    mutable OwnPtr<NFAMatcher> m_nfa_matcher;
 };
 
 template<class Parser>
@@ -93,6 +107,8 @@ public:
     Regex(Regex&&);
     Regex& operator=(Regex&&);
 
+    static RegexCacheStatistics cache_statistics();
+
     typename ParserTraits<Parser>::OptionsType options() const;
     ByteString error_string(Optional<ByteString> message = {}) const;
 
@@ -0,0 +1,868 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <LibRegex/RegexNFA.h>
+
+namespace regex {
+
+// Collects the characters of a compare that matches a string, and returns false if the compare may consume anything
+// but a single character, and so cannot be run by the NFA.
+static bool classify_compare(OpCode_Compare const& compare, bool can_split_strings, Vector<u32>& string)
+{
+    auto const& bytecode = compare.bytecode();
+    auto const argument_count = compare.arguments_count();
+    size_t offset = compare.state().instruction_position + 3;
+
+    for (size_t i = 0; i < argument_count; ++i) {
+        switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+        case CharacterCompareType::Reference:
+            return false;
+        case CharacterCompareType::String: {
+            // Only ASCII strings are split, as their characters have the same length in every kind of view.
+            if (argument_count != 1 || !can_split_strings)
+                return false;
+            auto length = bytecode.at(offset++);
+            if (length == 0)
+                return false;
+            for (size_t k = 0; k < length; ++k) {
+                auto ch = bytecode.at(offset + k);
+                if (ch >= 0x80)
+                    return false;
+                string.append(ch);
+            }
+            return true;
+        }
+        case CharacterCompareType::LookupTable: {
+            auto count = bytecode.at(offset++);
+            offset += count;
+            break;
+        }
+        case CharacterCompareType::Char:
+        case CharacterCompareType::CharClass:
+        case CharacterCompareType::CharRange:
+        case CharacterCompareType::Property:
+        case CharacterCompareType::GeneralCategory:
+        case CharacterCompareType::Script:
+        case CharacterCompareType::ScriptExtension:
+            ++offset;
+            break;
+        case CharacterCompareType::Undefined:
+        case CharacterCompareType::Inverse:
+        case CharacterCompareType::TemporaryInverse:
+        case CharacterCompareType::AnyChar:
+        case CharacterCompareType::RangeExpressionDummy:
+        case CharacterCompareType::And:
+        case CharacterCompareType::Or:
+        case CharacterCompareType::EndAndOr:
+            break;
+        }
+    }
+
+    return true;
+}
+
+// Returns whether the target can be reached from an instruction without passing a checkpoint with the given id, and
+// if epsilon_only is set, without consuming any input.
+static bool can_reach_avoiding_checkpoint(Vector<NFAProgram::Instruction> const& instructions, Vector<Optional<size_t>> const& checkpoints, u32 from, u32 target, size_t checkpoint, bool epsilon_only)
+{
+    using Type = NFAProgram::Instruction::Type;
+
+    Vector<bool> visited;
+    visited.resize(instructions.size());
+
+    Vector<u32> worklist;
+    worklist.append(from);
+    while (!worklist.is_empty()) {
+        auto index = worklist.take_last();
+        if (index == target)
+            return true;
+        if (visited[index])
+            continue;
+        visited[index] = true;
+
+        if (checkpoints[index] == checkpoint)
+            continue;
+
+        auto const& instruction = instructions[index];
+        switch (instruction.type) {
+        case Type::Match:
+        case Type::Fail:
+            break;
+        case Type::Consume:
+            if (!epsilon_only)
+                worklist.append(instruction.next);
+            break;
+        case Type::Fork:
+            worklist.append(instruction.alternative);
+            worklist.append(instruction.next);
+            break;
+        case Type::Assert:
+        case Type::Jump:
+        case Type::SaveLeftCaptureGroup:
+        case Type::SaveRightCaptureGroup:
+        case Type::ClearCaptureGroup:
+            worklist.append(instruction.next);
+            break;
+        }
+    }
+
+    return false;
+}
+
+RefPtr<NFAProgram const> NFAProgram::compile(ByteCode const& bytecode, AllOptions options)
+{
+    using Type = Instruction::Type;
+
+    auto const bytecode_size = bytecode.size();
+    auto const can_split_strings = !options.has_flag_set(AllFlags::Insensitive);
+
+    // First, find out which instruction each opcode starts at, so that jumps can be resolved in a single pass.
+    HashMap<size_t, u32> instruction_for_position;
+    u32 instruction_count = 0;
+    bool has_forks = false;
+
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        instruction_for_position.set(state.instruction_position, instruction_count);
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Repeat:
+        case OpCodeId::ResetRepeat:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::PopSaved:
+            return nullptr;
+        case OpCodeId::Compare: {
+            Vector<u32> string;
+            if (!classify_compare(static_cast<OpCode_Compare const&>(opcode), can_split_strings, string))
+                return nullptr;
+            instruction_count += max<u32>(string.size(), 1);
+            break;
+        }
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+            has_forks = true;
+            ++instruction_count;
+            break;
+        case OpCodeId::JumpNonEmpty:
+            if (static_cast<OpCode_JumpNonEmpty const&>(opcode).form() != OpCodeId::Jump)
+                has_forks = true;
+            ++instruction_count;
+            break;
+        case OpCodeId::Jump:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::Exit:
+            ++instruction_count;
+            break;
+        }
+
+        state.instruction_position += opcode.size();
+    }
+
+    // Without forks, the backtracking matcher never backtracks, and there is nothing to gain.
+    if (!has_forks)
+        return nullptr;
+
+    auto const match_instruction = instruction_count;
+    auto resolve = [&](size_t position, ssize_t offset) -> Optional<u32> {
+        auto target = static_cast<ssize_t>(position) + offset;
+        if (target < 0)
+            return {};
+        if (static_cast<size_t>(target) >= bytecode_size)
+            return match_instruction;
+        return instruction_for_position.get(target);
+    };
+
+    auto program = adopt_ref(*new NFAProgram);
+    auto& instructions = program->m_instructions;
+    instructions.ensure_capacity(instruction_count + 1);
+
+    // The checkpoint id of each Checkpoint instruction, and the JumpNonEmpty instructions that refer to them.
+    Vector<Optional<size_t>> checkpoints;
+    checkpoints.resize(instruction_count + 1);
+    struct NonEmptyJump {
+        u32 instruction;
+        size_t checkpoint;
+    };
+    Vector<NonEmptyJump> non_empty_jumps;
+
+    auto copy_opcode = [&](OpCode const& opcode) {
+        auto position = program->m_bytecode.size();
+        for (size_t i = 0; i < opcode.size(); ++i)
+            program->m_bytecode.append(bytecode.at(state.instruction_position + i));
+        return position;
+    };
+
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto const position = state.instruction_position;
+        auto const next = resolve(position + opcode.size(), 0).value();
+
+        auto add_fork = [&](OpCodeId form, ssize_t offset) {
+            auto target = resolve(position + opcode.size(), offset);
+            if (!target.has_value())
+                return false;
+
+            switch (form) {
+            case OpCodeId::Jump:
+                instructions.append({ .type = Type::Jump, .next = *target });
+                return true;
+            case OpCodeId::ForkJump:
+            case OpCodeId::ForkReplaceJump:
+                instructions.append({ .type = Type::Fork, .next = *target, .alternative = next });
+                return true;
+            case OpCodeId::ForkStay:
+            case OpCodeId::ForkReplaceStay:
+                instructions.append({ .type = Type::Fork, .next = next, .alternative = *target });
+                return true;
+            default:
+                return false;
+            }
+        };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            Vector<u32> string;
+            classify_compare(static_cast<OpCode_Compare const&>(opcode), can_split_strings, string);
+            if (string.is_empty()) {
+                instructions.append({ .type = Type::Consume, .next = next, .position = copy_opcode(opcode) });
+                break;
+            }
+
+            program->m_has_split_strings = true;
+            for (size_t i = 0; i < string.size(); ++i) {
+                auto character_position = program->m_bytecode.size();
+                program->m_bytecode.empend(static_cast<ByteCodeValueType>(OpCodeId::Compare));
+                program->m_bytecode.empend(1u); // number of arguments
+                program->m_bytecode.empend(2u); // size of arguments
+                program->m_bytecode.empend(static_cast<ByteCodeValueType>(CharacterCompareType::Char));
+                program->m_bytecode.empend(string[i]);
+
+                auto character_next = i + 1 < string.size() ? static_cast<u32>(instructions.size() + 1) : next;
+                instructions.append({ .type = Type::Consume, .next = character_next, .position = character_position });
+            }
+            break;
+        }
+        case OpCodeId::Jump:
+            if (!add_fork(OpCodeId::Jump, static_cast<OpCode_Jump const&>(opcode).offset()))
+                return nullptr;
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            if (!add_fork(OpCodeId::ForkJump, static_cast<OpCode_ForkJump const&>(opcode).offset()))
+                return nullptr;
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            if (!add_fork(OpCodeId::ForkStay, static_cast<OpCode_ForkStay const&>(opcode).offset()))
+                return nullptr;
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            auto const& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            non_empty_jumps.append({ static_cast<u32>(instructions.size()), static_cast<size_t>(jump.checkpoint()) });
+            if (!add_fork(jump.form(), jump.offset()))
+                return nullptr;
+            break;
+        }
+        case OpCodeId::Checkpoint:
+            checkpoints[instructions.size()] = static_cast<OpCode_Checkpoint const&>(opcode).id();
+            instructions.append({ .type = Type::Jump, .next = next });
+            break;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            program->m_has_assertions = true;
+            instructions.append({ .type = Type::Assert, .next = next, .position = copy_opcode(opcode) });
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+            program->m_has_capture_groups = true;
+            instructions.append({ .type = Type::SaveLeftCaptureGroup, .next = next, .capture_group = static_cast<OpCode_SaveLeftCaptureGroup const&>(opcode).id() });
+            break;
+        case OpCodeId::SaveRightCaptureGroup:
+            program->m_has_capture_groups = true;
+            instructions.append({ .type = Type::SaveRightCaptureGroup, .next = next, .capture_group = static_cast<OpCode_SaveRightCaptureGroup const&>(opcode).id() });
+            break;
+        case OpCodeId::SaveRightNamedCaptureGroup: {
+            auto const& save = static_cast<OpCode_SaveRightNamedCaptureGroup const&>(opcode);
+            program->m_has_capture_groups = true;
+            instructions.append({ .type = Type::SaveRightCaptureGroup, .next = next, .capture_group = save.id(), .capture_group_name = static_cast<ssize_t>(save.name_string_table_index()) });
+            break;
+        }
+        case OpCodeId::ClearCaptureGroup:
+            program->m_has_capture_groups = true;
+            instructions.append({ .type = Type::ClearCaptureGroup, .next = next, .capture_group = static_cast<OpCode_ClearCaptureGroup const&>(opcode).id() });
+            break;
+        case OpCodeId::Exit:
+            // An Exit before the end of the bytecode only succeeds past the end of the input, which the NFA never gets to.
+            instructions.append({ .type = Type::Fail });
+            break;
+        case OpCodeId::Repeat:
+        case OpCodeId::ResetRepeat:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::PopSaved:
+            VERIFY_NOT_REACHED();
+        }
+
+        state.instruction_position += opcode.size();
+    }
+
+    VERIFY(instructions.size() == match_instruction);
+    instructions.append({ .type = Type::Match });
+
+    // The NFA has no checkpoints, so it takes every JumpNonEmpty as if the input had advanced since its checkpoint.
+    // That is only correct if every path to the jump passes the checkpoint, and then consumes at least one character.
+    for (auto const& jump : non_empty_jumps) {
+        if (can_reach_avoiding_checkpoint(instructions, checkpoints, 0, jump.instruction, jump.checkpoint, false))
+            return nullptr;
+        for (u32 i = 0; i < instructions.size(); ++i) {
+            if (checkpoints[i] != jump.checkpoint)
+                continue;
+            if (can_reach_avoiding_checkpoint(instructions, checkpoints, instructions[i].next, jump.instruction, jump.checkpoint, true))
+                return nullptr;
+        }
+    }
+
+    return program;
+}
+
+NFAMatcher::NFAMatcher(NonnullRefPtr<NFAProgram const> program, size_t capture_group_count)
+    : m_program(move(program))
+    , m_capture_group_count(capture_group_count)
+{
+    m_visited.resize(m_program->instructions().size());
+}
+
+static bool can_run_on(NFAProgram const& program, MatchInput const& input)
+{
+    // In unicode mode, the characters of byte views are decoded as UTF-8 by some compares but not by others.
+    if (input.view.unicode() && !input.view.is_u16_view())
+        return false;
+    if (program.has_split_strings() && input.regex_options.has_flag_set(AllFlags::Insensitive))
+        return false;
+    return true;
+}
+
+Optional<bool> NFAMatcher::execute(MatchInput const& input, MatchState& state, size_t& operations)
+{
+    if (!can_run_on(*m_program, input))
+        return {};
+
+    if (!m_program->has_assertions()) {
+        size_t end_position = 0;
+        size_t end_code_unit_position = 0;
+        switch (run_dfa(m_anchored_dfa, input, state.string_position, state.string_position_in_code_units, end_position, end_code_unit_position, operations)) {
+        case DFAResult::NoMatch:
+            return false;
+        case DFAResult::Match:
+            // The DFA does not track captures, so if there are any, the Pike VM has to find them.
+            if (m_program->has_capture_groups() && !input.regex_options.has_flag_set(AllFlags::SkipSubExprResults))
+                break;
+            state.string_position = end_position;
+            state.string_position_in_code_units = end_code_unit_position;
+            return true;
+        case DFAResult::Unknown:
+            break;
+        }
+    }
+
+    return run_pike_vm(input, state, operations);
+}
+
+NFAMatcher::SearchResult NFAMatcher::search(MatchInput const& input, size_t from, size_t& match_start, size_t& operations)
+{
+    if (!can_run_on(*m_program, input))
+        return SearchResult::Unsupported;
+
+    // The DFA can't tell where a match starts, but it is much quicker than the Pike VM at finding out whether there is one.
+    if (!m_program->has_assertions()) {
+        size_t end_position = 0;
+        size_t end_code_unit_position = 0;
+        switch (run_dfa(m_unanchored_dfa, input, from, from, end_position, end_code_unit_position, operations)) {
+        case DFAResult::NoMatch:
+            return SearchResult::NoMatch;
+        case DFAResult::Match:
+            match_start = from;
+            return SearchResult::Match;
+        case DFAResult::Unknown:
+            break;
+        }
+    }
+
+    return search_with_pike_vm(input, from, match_start, operations);
+}
+
+ExecutionResult NFAMatcher::run_opcode(Instruction const& instruction, MatchInput const& input, size_t position, size_t code_unit_position)
+{
+    m_scratch_state.instruction_position = instruction.position;
+    m_scratch_state.string_position = position;
+    m_scratch_state.string_position_in_code_units = code_unit_position;
+
+    auto& opcode = m_program->bytecode().get_opcode(m_scratch_state);
+    return opcode.execute(input, m_scratch_state);
+}
+
+NFAMatcher::StepResult NFAMatcher::consume(Instruction const& instruction, MatchInput const& input, size_t position, size_t code_unit_position, size_t& next_code_unit_position)
+{
+    if (run_opcode(instruction, input, position, code_unit_position) != ExecutionResult::Continue)
+        return StepResult::Failed;
+
+    // All threads move through the input in lockstep, which only works if every compare consumes a single character.
+    if (m_scratch_state.string_position != position + 1)
+        return StepResult::Unsupported;
+
+    next_code_unit_position = m_scratch_state.string_position_in_code_units;
+    return StepResult::Advanced;
+}
+
+Optional<bool> NFAMatcher::run_pike_vm(MatchInput const& input, MatchState& state, size_t& operations)
+{
+    auto const& instructions = m_program->instructions();
+    auto position = state.string_position;
+    auto code_unit_position = state.string_position_in_code_units;
+
+    Thread initial_thread;
+    if (state.capture_group_count != 0 && input.match_index < state.capture_group_matches_size()) {
+        for (auto const& match : state.capture_group_matches(input.match_index))
+            initial_thread.captures.append(match);
+    }
+
+    m_current_threads.clear();
+    ++m_generation;
+    add_thread(m_current_threads, move(initial_thread), input, position, code_unit_position);
+
+    Optional<Thread> matched_thread;
+    size_t match_end_position = 0;
+    size_t match_end_code_unit_position = 0;
+
+    while (!m_current_threads.is_empty()) {
+        m_next_threads.clear();
+        ++m_generation;
+
+        Optional<size_t> next_code_unit_position;
+        for (auto& thread : m_current_threads) {
+            ++operations;
+
+            auto const& instruction = instructions[thread.instruction];
+            if (instruction.type == Instruction::Type::Match) {
+                // The remaining threads have a lower priority than this match, so they can be dropped.
+                matched_thread = move(thread);
+                match_end_position = position;
+                match_end_code_unit_position = code_unit_position;
+                break;
+            }
+
+            size_t thread_code_unit_position = 0;
+            switch (consume(instruction, input, position, code_unit_position, thread_code_unit_position)) {
+            case StepResult::Failed:
+                continue;
+            case StepResult::Unsupported:
+                return {};
+            case StepResult::Advanced:
+                break;
+            }
+
+            if (next_code_unit_position.has_value() && *next_code_unit_position != thread_code_unit_position)
+                return {};
+            next_code_unit_position = thread_code_unit_position;
+
+            thread.instruction = instruction.next;
+            add_thread(m_next_threads, move(thread), input, position + 1, thread_code_unit_position);
+        }
+
+        swap(m_current_threads, m_next_threads);
+        ++position;
+        code_unit_position = next_code_unit_position.value_or(code_unit_position);
+    }
+
+    if (!matched_thread.has_value())
+        return false;
+
+    state.string_position = match_end_position;
+    state.string_position_in_code_units = match_end_code_unit_position;
+
+    if (auto const& captures = matched_thread->captures; !captures.is_empty()) {
+        if (input.match_index >= state.capture_group_matches_size()) {
+            state.flat_capture_group_matches.ensure_capacity((input.match_index + 1) * state.capture_group_count);
+            for (size_t i = state.capture_group_matches_size(); i <= input.match_index; ++i)
+                for (size_t j = 0; j < state.capture_group_count; ++j)
+                    state.flat_capture_group_matches.append({});
+        }
+
+        auto matches = state.mutable_capture_group_matches(input.match_index);
+        for (size_t i = 0; i < matches.size(); ++i)
+            matches[i] = captures[i];
+    }
+
+    return true;
+}
+
+// Runs the Pike VM with a new thread seeded at every position, after all the threads that started earlier. Earlier
+// starts thus have a higher priority, and the first start that leads to a match is the one that wins.
+NFAMatcher::SearchResult NFAMatcher::search_with_pike_vm(MatchInput const& input, size_t from, size_t& match_start, size_t& operations)
+{
+    auto const& instructions = m_program->instructions();
+    auto const length = input.view.length();
+    auto position = from;
+
+    m_current_threads.clear();
+    ++m_generation;
+    add_thread(m_current_threads, { 0, {}, position }, input, position, position);
+
+    Optional<size_t> found_start;
+    while (!m_current_threads.is_empty() || (!found_start.has_value() && position < length)) {
+        // Once no thread that started before the match is left, no earlier start can match anymore.
+        if (found_start.has_value() && m_current_threads.first().start_position >= *found_start)
+            break;
+
+        m_next_threads.clear();
+        ++m_generation;
+
+        for (auto& thread : m_current_threads) {
+            ++operations;
+
+            auto const& instruction = instructions[thread.instruction];
+            if (instruction.type == Instruction::Type::Match) {
+                found_start = thread.start_position;
+                break;
+            }
+
+            size_t next_code_unit_position = 0;
+            switch (consume(instruction, input, position, position, next_code_unit_position)) {
+            case StepResult::Failed:
+                continue;
+            case StepResult::Unsupported:
+                return SearchResult::Unsupported;
+            case StepResult::Advanced:
+                break;
+            }
+
+            // Seeded threads start at the code unit position equal to their position, so every thread has to stay there.
+            if (next_code_unit_position != position + 1)
+                return SearchResult::Unsupported;
+
+            thread.instruction = instruction.next;
+            add_thread(m_next_threads, move(thread), input, position + 1, position + 1);
+        }
+
+        if (!found_start.has_value() && position < length)
+            add_thread(m_next_threads, { 0, {}, position + 1 }, input, position + 1, position + 1);
+
+        swap(m_current_threads, m_next_threads);
+        ++position;
+    }
+
+    if (!found_start.has_value())
+        return SearchResult::NoMatch;
+    match_start = *found_start;
+    return SearchResult::Match;
+}
+
+// Follows the epsilon transitions from a thread in priority order, and adds the threads that end up at a Consume or a
+// Match instruction to the list, unless a thread with a higher priority got to the same instruction first.
+void NFAMatcher::add_thread(Vector<Thread>& threads, Thread thread, MatchInput const& input, size_t position, size_t code_unit_position)
+{
+    using Type = Instruction::Type;
+    auto const& instructions = m_program->instructions();
+
+    m_thread_stack.append(move(thread));
+    while (!m_thread_stack.is_empty()) {
+        auto current = m_thread_stack.take_last();
+        if (m_visited[current.instruction] == m_generation)
+            continue;
+        m_visited[current.instruction] = m_generation;
+
+        auto const& instruction = instructions[current.instruction];
+        switch (instruction.type) {
+        case Type::Consume:
+        case Type::Match:
+            threads.append(move(current));
+            continue;
+        case Type::Fail:
+            continue;
+        case Type::Fork:
+            m_thread_stack.append({ instruction.alternative, current.captures, current.start_position });
+            break;
+        case Type::Jump:
+            break;
+        case Type::Assert:
+            if (run_opcode(instruction, input, position, code_unit_position) != ExecutionResult::Continue)
+                continue;
+            break;
+        case Type::SaveLeftCaptureGroup:
+        case Type::SaveRightCaptureGroup:
+        case Type::ClearCaptureGroup:
+            if (!update_captures(instruction, input, position, current.captures))
+                continue;
+            break;
+        }
+
+        current.instruction = instruction.next;
+        m_thread_stack.append(move(current));
+    }
+}
+
+// Mirrors the capture group opcodes of the backtracking matcher, on the captures of a single match.
+bool NFAMatcher::update_captures(Instruction const& instruction, MatchInput const& input, size_t position, COWVector<Match>& captures) const
+{
+    auto const index = instruction.capture_group - 1;
+
+    switch (instruction.type) {
+    case Instruction::Type::SaveLeftCaptureGroup:
+        if (captures.is_empty())
+            captures.resize(m_capture_group_count);
+        captures.mutable_at(index).left_column = position;
+        return true;
+    case Instruction::Type::SaveRightCaptureGroup: {
+        if (captures.is_empty())
+            return false;
+
+        auto const start_position = captures.at(index).left_column;
+        if (position < start_position)
+            return false;
+        if (start_position < captures.at(index).column)
+            return true;
+
+        auto view = input.view.substring_view(start_position, position - start_position);
+        if (instruction.capture_group_name >= 0)
+            captures.mutable_at(index) = { view, static_cast<size_t>(instruction.capture_group_name), input.line, start_position, input.global_offset + start_position };
+        else
+            captures.mutable_at(index) = { view, input.line, start_position, input.global_offset + start_position };
+        return true;
+    }
+    case Instruction::Type::ClearCaptureGroup:
+        if (!captures.is_empty())
+            captures.mutable_at(index).reset();
+        return true;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+unsigned NFAMatcher::DFAStateKeyTraits::hash(Vector<u32> const& threads)
+{
+    unsigned hash = 0;
+    for (auto instruction : threads)
+        hash = pair_int_hash(hash, instruction);
+    return hash;
+}
+
+NFAMatcher::DFAResult NFAMatcher::run_dfa(DFA& dfa, MatchInput const& input, size_t position, size_t code_unit_position, size_t& end_position, size_t& end_code_unit_position, size_t& operations)
+{
+    // Transitions depend on how the compares see the input, so they are only valid for one set of options and one
+    // kind of view.
+    if (m_dfa_options != input.regex_options.value() || m_dfa_is_unicode != input.view.unicode() || m_dfa_is_u16 != input.view.is_u16_view())
+        reset_dfas(input);
+    if (dfa.disabled)
+        return DFAResult::Unknown;
+
+    // Outside of unicode mode, compares may still decode surrogate pairs, so a surrogate code unit alone does not
+    // determine where a transition goes.
+    auto const may_decode_surrogates = input.view.is_u16_view() && !input.view.unicode();
+
+    auto const length = input.view.length();
+    auto current = dfa.start_state;
+    bool matched = false;
+
+    for (;;) {
+        auto& dfa_state = *dfa.states[current];
+        if (dfa_state.accepting) {
+            matched = true;
+            end_position = position;
+            end_code_unit_position = code_unit_position;
+            // The end of an unanchored match depends on where it starts, so the first one is as good as any.
+            if (dfa.unanchored)
+                break;
+        }
+        if (dfa_state.threads.is_empty() || position >= length)
+            break;
+
+        ++operations;
+
+        auto character = input.view.code_unit_at(code_unit_position);
+        DFATransition transition;
+        if (character < dfa_state.ascii_transitions.size() && dfa_state.ascii_transitions[character] != unknown_dfa_transition) {
+            transition = { dfa_state.ascii_transitions[character], 1 };
+        } else if (auto cached_transition = dfa_state.transitions.get(character); cached_transition.has_value()) {
+            transition = *cached_transition;
+        } else {
+            u8 code_units = 0;
+            auto next = compute_dfa_transition(dfa, current, input, position, code_unit_position, code_units);
+            if (!next.has_value()) {
+                if (dfa.disabled) {
+                    dfa.states.clear();
+                    dfa.state_for_threads.clear();
+                }
+                return DFAResult::Unknown;
+            }
+            transition = { *next, code_units };
+
+            auto next_is_dead = dfa.states[*next]->threads.is_empty() && !dfa.states[*next]->accepting;
+            if (character < dfa_state.ascii_transitions.size() && (code_units == 1 || next_is_dead))
+                dfa_state.ascii_transitions[character] = *next;
+            else if (!may_decode_surrogates || (character & 0xf800) != 0xd800)
+                dfa_state.transitions.set(character, transition);
+        }
+
+        current = transition.state;
+        ++position;
+        code_unit_position += transition.code_units;
+
+        // The start threads are added at the code unit position equal to their position, like in search_with_pike_vm().
+        if (dfa.unanchored && code_unit_position != position)
+            return DFAResult::Unknown;
+    }
+
+    return matched ? DFAResult::Match : DFAResult::NoMatch;
+}
+
+void NFAMatcher::reset_dfas(MatchInput const& input)
+{
+    m_dfa_options = input.regex_options.value();
+    m_dfa_is_unicode = input.view.unicode();
+    m_dfa_is_u16 = input.view.is_u16_view();
+    reset_dfa(m_anchored_dfa);
+    reset_dfa(m_unanchored_dfa);
+}
+
+void NFAMatcher::reset_dfa(DFA& dfa)
+{
+    dfa.states.clear();
+    dfa.state_for_threads.clear();
+    dfa.disabled = false;
+
+    Vector<u32> threads;
+    ++m_generation;
+    auto accepting = add_dfa_threads(threads, 0);
+    dfa.start_state = dfa_state_for(dfa, move(threads), accepting).value();
+}
+
+// Like add_thread(), but without captures. Stops at the first Match instruction, and returns whether it found one.
+bool NFAMatcher::add_dfa_threads(Vector<u32>& threads, u32 instruction)
+{
+    using Type = Instruction::Type;
+    auto const& instructions = m_program->instructions();
+
+    m_instruction_stack.append(instruction);
+    while (!m_instruction_stack.is_empty()) {
+        auto index = m_instruction_stack.take_last();
+        if (m_visited[index] == m_generation)
+            continue;
+        m_visited[index] = m_generation;
+
+        auto const& current = instructions[index];
+        switch (current.type) {
+        case Type::Consume:
+            threads.append(index);
+            break;
+        case Type::Match:
+            m_instruction_stack.clear();
+            return true;
+        case Type::Fail:
+            break;
+        case Type::Fork:
+            m_instruction_stack.append(current.alternative);
+            m_instruction_stack.append(current.next);
+            break;
+        case Type::Jump:
+        case Type::SaveLeftCaptureGroup:
+        case Type::SaveRightCaptureGroup:
+        case Type::ClearCaptureGroup:
+            m_instruction_stack.append(current.next);
+            break;
+        case Type::Assert:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    return false;
+}
+
+Optional<u32> NFAMatcher::compute_dfa_transition(DFA& dfa, u32 from, MatchInput const& input, size_t position, size_t code_unit_position, u8& code_units)
+{
+    auto const& instructions = m_program->instructions();
+
+    Vector<u32> threads;
+    bool accepting = false;
+    Optional<size_t> next_code_unit_position;
+
+    ++m_generation;
+    for (auto instruction : dfa.states[from]->threads) {
+        size_t thread_code_unit_position = 0;
+        switch (consume(instructions[instruction], input, position, code_unit_position, thread_code_unit_position)) {
+        case StepResult::Failed:
+            continue;
+        case StepResult::Unsupported:
+            return {};
+        case StepResult::Advanced:
+            break;
+        }
+
+        if (next_code_unit_position.has_value() && *next_code_unit_position != thread_code_unit_position)
+            return {};
+        next_code_unit_position = thread_code_unit_position;
+
+        // Threads after the first one to match have a lower priority than that match, so they are dropped.
+        if (add_dfa_threads(threads, instructions[instruction].next)) {
+            accepting = true;
+            break;
+        }
+    }
+
+    // A search may also start at the next position, with a lower priority than any thread that started earlier.
+    if (dfa.unanchored && !accepting)
+        accepting = add_dfa_threads(threads, 0);
+
+    if (next_code_unit_position.has_value())
+        code_units = *next_code_unit_position - code_unit_position;
+    else
+        code_units = dfa.unanchored ? 1 : 0;
+    return dfa_state_for(dfa, move(threads), accepting);
+}
+
+Optional<u32> NFAMatcher::dfa_state_for(DFA& dfa, Vector<u32>&& threads, bool accepting)
+{
+    // Instruction indices never reach this value, so it can mark accepting states in the key.
+    if (accepting)
+        threads.append(unknown_dfa_transition);
+
+    if (auto index = dfa.state_for_threads.get(threads); index.has_value())
+        return *index;
+
+    if (dfa.states.size() >= max_dfa_states) {
+        dfa.disabled = true;
+        return {};
+    }
+
+    auto state = make<DFAState>();
+    state->threads = threads;
+    if (accepting)
+        state->threads.take_last();
+    state->accepting = accepting;
+    state->ascii_transitions.fill(unknown_dfa_transition);
+
+    auto index = static_cast<u32>(dfa.states.size());
+    dfa.states.append(move(state));
+    dfa.state_for_threads.set(move(threads), index);
+    return index;
+}
+
+}
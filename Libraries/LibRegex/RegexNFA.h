@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/COWVector.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A Thompson NFA compiled from the bytecode of a pattern.
+//
+// Only patterns whose compares never need to look back at the input can be compiled: there must be no backreferences,
+// no lookaround, and no counted repetition. Every instruction of the NFA either consumes exactly one character, or
+// is an epsilon transition (jumps, forks, assertions and capture group bookkeeping). Forks keep the priority order of
+// the bytecode, so the NFA finds the same match (and captures) as the backtracking matcher would.
+class REGEX_API NFAProgram : public RefCounted<NFAProgram> {
+public:
+    struct Instruction {
+        enum class Type : u8 {
+            Consume,
+            Assert,
+            Jump,
+            Fork,
+            SaveLeftCaptureGroup,
+            SaveRightCaptureGroup,
+            ClearCaptureGroup,
+            Match,
+            Fail,
+        };
+
+        Type type { Type::Fail };
+        u32 next { 0 };            // The instruction to continue with; for forks, the one with the higher priority.
+        u32 alternative { 0 };     // For forks, the instruction with the lower priority.
+        size_t position { 0 };     // For Consume and Assert, the position of the opcode in the program's bytecode.
+        size_t capture_group { 0 }; // For capture group instructions, the id of the group.
+        ssize_t capture_group_name { -1 };
+    };
+
+    // Returns null if the bytecode needs the backtracking matcher, or would not benefit from running on an NFA.
+    static RefPtr<NFAProgram const> compile(ByteCode const&, AllOptions);
+
+    Vector<Instruction> const& instructions() const { return m_instructions; }
+    ByteCode const& bytecode() const { return m_bytecode; }
+
+    bool has_assertions() const { return m_has_assertions; }
+    bool has_capture_groups() const { return m_has_capture_groups; }
+
+    // Multi-character string compares are split into one compare per character, which is only equivalent as long as
+    // they are compared case-sensitively.
+    bool has_split_strings() const { return m_has_split_strings; }
+
+private:
+    NFAProgram() = default;
+
+    Vector<Instruction> m_instructions;
+    ByteCode m_bytecode; // The compares and assertions of the pattern, which are run by the Consume and Assert instructions.
+    bool m_has_assertions { false };
+    bool m_has_capture_groups { false };
+    bool m_has_split_strings { false };
+};
+
+// Runs an NFAProgram in place of the backtracking matcher, for one start position at a time, or searches for the first
+// start position at which it matches.
+//
+// The NFA is simulated as a Pike VM, which advances all threads through the input in lockstep and drops threads that
+// reach an instruction some higher-priority thread has already reached at the same position; this bounds the work per
+// character by the size of the program, whereas backtracking may take exponential time on patterns like (a|aa)*b.
+//
+// Programs without assertions are additionally run as a DFA whose states (the ordered sets of Pike VM threads) and
+// transitions are built lazily while matching and cached. The Pike VM is then only needed to find the captures of a
+// match the DFA has found. The number of DFA states is bounded; patterns that need more states than that fall back to
+// the Pike VM.
+//
+// A search seeds a new lowest-priority thread at every position instead of restarting at each one, so it takes a single
+// pass over the input to find out whether there is a match at all, and for the Pike VM, where the first one starts.
+class REGEX_API NFAMatcher {
+public:
+    NFAMatcher(NonnullRefPtr<NFAProgram const>, size_t capture_group_count);
+
+    // Matches starting at state.string_position, and on success leaves the end position and the captures in the state,
+    // like Matcher::execute() does. Returns an empty Optional if this input has to go to the backtracking matcher.
+    Optional<bool> execute(MatchInput const&, MatchState&, size_t& operations);
+
+    enum class SearchResult : u8 {
+        NoMatch,
+        Match,
+        Unsupported,
+    };
+
+    // Looks for the first position from `from` on at which execute() would succeed, for start positions that are also
+    // code unit positions, like the ones Matcher::match() tries. On a match, match_start is the earliest position that
+    // match may start at: its exact start if the Pike VM had to run, or just `from` if the DFA could tell that there is
+    // a match. Finding the match itself is left to execute().
+    SearchResult search(MatchInput const&, size_t from, size_t& match_start, size_t& operations);
+
+    static constexpr size_t max_dfa_states = 256;
+
+private:
+    using Instruction = NFAProgram::Instruction;
+
+    enum class StepResult : u8 {
+        Failed,
+        Advanced,
+        Unsupported,
+    };
+
+    struct Thread {
+        u32 instruction { 0 };
+        COWVector<Match> captures;   // Empty until the thread enters a capture group.
+        size_t start_position { 0 }; // Only tracked by search().
+    };
+
+    struct DFATransition {
+        u32 state { 0 };
+        u8 code_units { 0 };
+    };
+
+    struct DFAState {
+        Vector<u32> threads; // The Consume instructions of the live threads, in priority order.
+        bool accepting { false };
+        AK::Array<u32, 128> ascii_transitions;
+        HashMap<u32, DFATransition> transitions;
+    };
+
+    struct DFAStateKeyTraits : public DefaultTraits<Vector<u32>> {
+        static unsigned hash(Vector<u32> const&);
+    };
+
+    struct DFA {
+        Vector<NonnullOwnPtr<DFAState>> states;
+        HashMap<Vector<u32>, u32, DFAStateKeyTraits> state_for_threads;
+        u32 start_state { 0 };
+        bool disabled { false };
+        bool unanchored { false }; // Adds the start threads to every state, with the lowest priority.
+    };
+
+    enum class DFAResult : u8 {
+        NoMatch,
+        Match,
+        Unknown,
+    };
+
+    static constexpr u32 unknown_dfa_transition = NumericLimits<u32>::max();
+
+    ExecutionResult run_opcode(Instruction const&, MatchInput const&, size_t position, size_t code_unit_position);
+    StepResult consume(Instruction const&, MatchInput const&, size_t position, size_t code_unit_position, size_t& next_code_unit_position);
+
+    Optional<bool> run_pike_vm(MatchInput const&, MatchState&, size_t& operations);
+    SearchResult search_with_pike_vm(MatchInput const&, size_t from, size_t& match_start, size_t& operations);
+    void add_thread(Vector<Thread>&, Thread, MatchInput const&, size_t position, size_t code_unit_position);
+    bool update_captures(Instruction const&, MatchInput const&, size_t position, COWVector<Match>& captures) const;
+
+    DFAResult run_dfa(DFA&, MatchInput const&, size_t position, size_t code_unit_position, size_t& end_position, size_t& end_code_unit_position, size_t& operations);
+    void reset_dfas(MatchInput const&);
+    void reset_dfa(DFA&);
+    bool add_dfa_threads(Vector<u32>&, u32 instruction);
+    Optional<u32> compute_dfa_transition(DFA&, u32 from, MatchInput const&, size_t position, size_t code_unit_position, u8& code_units);
+    Optional<u32> dfa_state_for(DFA&, Vector<u32>&& threads, bool accepting);
+
+    NonnullRefPtr<NFAProgram const> m_program;
+    size_t m_capture_group_count { 0 };
+    MatchState m_scratch_state { 0 };
+
+    Vector<Thread> m_current_threads;
+    Vector<Thread> m_next_threads;
+    Vector<Thread> m_thread_stack;
+    Vector<u32> m_instruction_stack;
+    Vector<size_t> m_visited;
+    size_t m_generation { 0 };
+
+    DFA m_anchored_dfa;
+    DFA m_unanchored_dfa { .unanchored = true };
+    Optional<AllFlags> m_dfa_options;
+    bool m_dfa_is_unicode { false };
+    bool m_dfa_is_u16 { false };
+};
+
+}
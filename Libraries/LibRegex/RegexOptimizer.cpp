@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Function.h>
+#include <AK/GenericShorthands.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
 #include <AK/RedBlackTree.h>
@@ -32,9 +33,13 @@ void Regex<Parser>::run_optimization_passes()
 
     rewrite_with_useless_jumps_removed();
 
+    auto& optimization_data = parser_result.optimization_data;
+
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        optimization_data.prefilter = Prefilter::create({}, *optimization_data.pure_substring_search);
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
@@ -43,6 +48,11 @@ void Regex<Parser>::run_optimization_passes()
     fill_optimization_data(split_basic_blocks(parser_result.bytecode));
 
     parser_result.bytecode.flatten();
+
+    if (!optimization_data.only_start_of_line)
+        optimization_data.prefilter = Prefilter::create(optimization_data.starting_ranges, optimization_data.literal_prefix.value_or({}));
+
+    optimization_data.nfa_program = NFAProgram::compile(parser_result.bytecode, parser_result.options);
 }
 
 struct StaticallyInterpretedCompares {
@@ -180,6 +190,161 @@ static bool interpret_compares(Vector<CompareTypeAndValuePair> const& lhs, Stati
     return true;
 }
 
+struct StartingRange {
+    u32 from { 0 };
+    u32 to { 0 };
+};
+
+// Collects the characters that a match can start with, by following every path from the start of the bytecode up to
+// its first compare. Returns false if they can't be determined statically, or if the pattern can match without
+// consuming anything at all.
+static bool collect_starting_ranges(ByteCode const& bytecode, Vector<StartingRange>& ranges)
+{
+    Vector<bool> visited;
+    visited.resize(bytecode.size());
+    Vector<size_t> worklist;
+
+    auto enqueue = [&](ssize_t target) {
+        // Falling off the end of the bytecode means the pattern has matched.
+        if (target < 0 || static_cast<size_t>(target) >= bytecode.size())
+            return false;
+        if (!visited[target]) {
+            visited[target] = true;
+            worklist.append(target);
+        }
+        return true;
+    };
+
+    if (!enqueue(0))
+        return false;
+
+    auto state = MatchState::only_for_enumeration();
+    while (!worklist.is_empty()) {
+        state.instruction_position = worklist.take_last();
+        auto& opcode = bytecode.get_opcode(state);
+        ssize_t next = state.instruction_position + opcode.size();
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto flat_compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
+            for (auto const& compare : flat_compares) {
+                // Inverted compares (such as [^]) may match characters that interpret_compares() does not record, and
+                // backreferences may match the empty string.
+                if (first_is_one_of(compare.type, CharacterCompareType::Inverse, CharacterCompareType::TemporaryInverse, CharacterCompareType::Reference))
+                    return false;
+            }
+
+            StaticallyInterpretedCompares compares;
+            if (!interpret_compares(flat_compares, compares) || compares.has_any_unicode_property)
+                return false;
+
+            // FIXME: We should be able to handle these cases (jump ahead while...)
+            if (!compares.char_classes.is_empty() || !compares.negated_char_classes.is_empty() || !compares.negated_ranges.is_empty())
+                return false;
+
+            for (auto it = compares.ranges.begin(); it != compares.ranges.end(); ++it)
+                ranges.append({ it.key(), *it });
+            break;
+        }
+        case OpCodeId::Jump:
+            if (!enqueue(next + static_cast<OpCode_Jump const&>(opcode).offset()))
+                return false;
+            break;
+        case OpCodeId::JumpNonEmpty:
+            if (!enqueue(next + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset()) || !enqueue(next))
+                return false;
+            break;
+        case OpCodeId::ForkJump:
+            if (!enqueue(next + static_cast<OpCode_ForkJump const&>(opcode).offset()) || !enqueue(next))
+                return false;
+            break;
+        case OpCodeId::ForkStay:
+            if (!enqueue(next + static_cast<OpCode_ForkStay const&>(opcode).offset()) || !enqueue(next))
+                return false;
+            break;
+        case OpCodeId::ForkReplaceJump:
+            if (!enqueue(next + static_cast<OpCode_ForkReplaceJump const&>(opcode).offset()) || !enqueue(next))
+                return false;
+            break;
+        case OpCodeId::ForkReplaceStay:
+            if (!enqueue(next + static_cast<OpCode_ForkReplaceStay const&>(opcode).offset()) || !enqueue(next))
+                return false;
+            break;
+        case OpCodeId::Repeat:
+            if (!enqueue(state.instruction_position - static_cast<OpCode_Repeat const&>(opcode).offset()) || !enqueue(next))
+                return false;
+            break;
+        case OpCodeId::Checkpoint:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::ResetRepeat:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            // These do not 'match' anything, and only ever make the set of starting characters smaller.
+            if (!enqueue(next))
+                return false;
+            break;
+        default:
+            // Lookaround and the like; don't bother.
+            return false;
+        }
+    }
+
+    return !ranges.is_empty();
+}
+
+// Matcher::match() binary searches the starting ranges, so they need to be sorted and must not overlap.
+static Vector<StartingRange> merge_starting_ranges(Vector<StartingRange> ranges)
+{
+    quick_sort(ranges, [](auto& a, auto& b) { return a.from < b.from; });
+
+    Vector<StartingRange> merged;
+    for (auto range : ranges) {
+        if (!merged.is_empty() && range.from <= merged.last().to + 1)
+            merged.last().to = max(merged.last().to, range.to);
+        else
+            merged.append(range);
+    }
+    return merged;
+}
+
+// Returns the ASCII string that every match starts with, if any.
+static ByteString collect_literal_prefix(ByteCode const& bytecode)
+{
+    StringBuilder builder;
+    auto state = MatchState::only_for_enumeration();
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            // Only a compare against a single character or string has to match exactly those characters.
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            if (compare.arguments_count() != 1)
+                return builder.to_byte_string();
+            for (auto const& flat_compare : compare.flat_compares()) {
+                if (flat_compare.type != CharacterCompareType::Char || flat_compare.value > 0x7f)
+                    return builder.to_byte_string();
+                builder.append(static_cast<char>(flat_compare.value));
+            }
+            break;
+        }
+        case OpCodeId::Checkpoint:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            break;
+        default:
+            return builder.to_byte_string();
+        }
+        state.instruction_position += opcode.size();
+    }
+    return builder.to_byte_string();
+}
+
 template<class Parser>
 void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
 {
@@ -212,23 +377,6 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
     for (state.instruction_position = block.start; state.instruction_position < block.end;) {
         auto& opcode = bytecode.get_opcode(state);
         switch (opcode.opcode_id()) {
-        case OpCodeId::Compare: {
-            auto flat_compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
-            StaticallyInterpretedCompares compares;
-            if (!interpret_compares(flat_compares, compares))
-                return; // No idea, the bytecode is too complex.
-
-            if (compares.has_any_unicode_property)
-                return; // Faster to just run the bytecode.
-
-            // FIXME: We should be able to handle these cases (jump ahead while...)
-            if (!compares.char_classes.is_empty() || !compares.negated_char_classes.is_empty() || !compares.negated_ranges.is_empty())
-                return;
-
-            for (auto it = compares.ranges.begin(); it != compares.ranges.end(); ++it)
-                parser_result.optimization_data.starting_ranges.append({ it.key(), *it });
-            return;
-        }
         case OpCodeId::CheckBegin:
             parser_result.optimization_data.only_start_of_line = true;
             return;
@@ -240,9 +388,23 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
             state.instruction_position += opcode.size();
             continue;
         default:
-            return;
+            break;
         }
+        break;
     }
+
+    // Unicode case-insensitive compares fold more than just ASCII, which the starting ranges can't account for.
+    auto is_unicode = parser_result.options.has_flag_set(AllFlags::Unicode) || parser_result.options.has_flag_set(AllFlags::UnicodeSets);
+    auto is_unicode_insensitive = is_unicode && parser_result.options.has_flag_set(AllFlags::Insensitive);
+
+    Vector<StartingRange> starting_ranges;
+    if (!is_unicode_insensitive && collect_starting_ranges(bytecode, starting_ranges)) {
+        for (auto range : merge_starting_ranges(move(starting_ranges)))
+            parser_result.optimization_data.starting_ranges.append({ range.from, range.to });
+    }
+
+    if (auto literal_prefix = collect_literal_prefix(bytecode); !literal_prefix.is_empty())
+        parser_result.optimization_data.literal_prefix = move(literal_prefix);
 }
 
 template<typename Parser>
@@ -34,6 +34,7 @@ enum class AllFlags {
     Internal_BrowserExtended = __Regex_Internal_BrowserExtended,         // Only for ECMA262, Enable the behaviors defined in section B.1.4. of the ECMA262 spec.
     Internal_ConsiderNewline = __Regex_Internal_ConsiderNewline,         // Only for ECMA262, Allow multiline matches to consider newlines as line boundaries.
     Internal_ECMA262DotSemantics = __Regex_Internal_ECMA262DotSemantics, // Use ECMA262 dot semantics: disallow matching CR/LF/LS/PS instead of just CR.
+    Internal_BacktrackingOnly = __Regex_Internal_BacktrackingOnly,       // Always use the backtracking matcher, e.g. to compare it against the NFA matcher.
     Last = Internal_BrowserExtended,
 };
 
@@ -50,6 +51,7 @@ enum class PosixFlags : FlagsUnderlyingType {
     SkipSubExprResults = (FlagsUnderlyingType)AllFlags::SkipSubExprResults,
     Multiline = (FlagsUnderlyingType)AllFlags::Multiline,
     SingleMatch = (FlagsUnderlyingType)AllFlags::SingleMatch,
+    BacktrackingOnly = (FlagsUnderlyingType)AllFlags::Internal_BacktrackingOnly,
 };
 
 enum class ECMAScriptFlags : FlagsUnderlyingType {
@@ -65,6 +67,7 @@ enum class ECMAScriptFlags : FlagsUnderlyingType {
     Multiline = (FlagsUnderlyingType)AllFlags::Multiline,
     UnicodeSets = (FlagsUnderlyingType)AllFlags::UnicodeSets,
     BrowserExtended = (FlagsUnderlyingType)AllFlags::Internal_BrowserExtended,
+    BacktrackingOnly = (FlagsUnderlyingType)AllFlags::Internal_BacktrackingOnly,
 };
 
 template<class T>
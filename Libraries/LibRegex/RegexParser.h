@@ -9,7 +9,9 @@
 #include "RegexByteCode.h"
 #include "RegexError.h"
 #include "RegexLexer.h"
+#include "RegexNFA.h"
 #include "RegexOptions.h"
+#include "RegexPrefilter.h"
 
 #include <AK/FlyString.h>
 #include <AK/Forward.h>
@@ -67,6 +69,12 @@ public:
             // If populated, the pattern only accepts strings that start with a character in these ranges.
             Vector<CharRange> starting_ranges;
             bool only_start_of_line = false;
+            // If populated, every match starts with this string (compared case-sensitively).
+            Optional<ByteString> literal_prefix;
+            // If populated, used to skip ahead to the positions where a match could start.
+            Optional<Prefilter> prefilter;
+            // If populated, the pattern can be matched without backtracking.
+            RefPtr<NFAProgram const> nfa_program;
         } optimization_data {};
     };
 
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexPrefilter.h"
+
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
+#include <AK/QuickSort.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+
+namespace regex {
+
+using AK::SIMD::u16x8;
+using AK::SIMD::u64x2;
+using AK::SIMD::u8x16;
+
+template<typename CodeUnit>
+using VectorFor = Conditional<sizeof(CodeUnit) == 1, u8x16, u16x8>;
+
+// Calls the callback with the index of every lane that is set in the comparison mask, in order, until it returns true.
+template<typename CodeUnit, typename Mask, typename Callback>
+ALWAYS_INLINE static bool for_each_set_lane(Mask mask, Callback callback)
+{
+    static constexpr size_t bits_per_lane = sizeof(CodeUnit) * 8;
+    static constexpr u64 lane_bits = NumericLimits<CodeUnit>::max();
+
+    auto halves = bit_cast<u64x2>(mask);
+    for (size_t half = 0; half < 2; ++half) {
+        for (u64 bits = halves[half]; bits != 0;) {
+            auto lane = count_trailing_zeroes(bits) / bits_per_lane;
+            if (callback(half * (64 / bits_per_lane) + lane))
+                return true;
+            bits &= ~(lane_bits << (lane * bits_per_lane));
+        }
+    }
+    return false;
+}
+
+static Optional<Vector<Prefilter::Range, Prefilter::max_ranges>> merge_ranges(Vector<Prefilter::Range>& ranges)
+{
+    quick_sort(ranges, [](auto& a, auto& b) { return a.from < b.from; });
+
+    Vector<Prefilter::Range, Prefilter::max_ranges> merged;
+    for (auto range : ranges) {
+        if (!merged.is_empty() && range.from <= merged.last().to + 1) {
+            merged.last().to = max(merged.last().to, range.to);
+            continue;
+        }
+        if (merged.size() == Prefilter::max_ranges)
+            return {};
+        merged.append(range);
+    }
+    return merged;
+}
+
+Optional<Prefilter> Prefilter::create(Vector<CharRange> const& starting_ranges, StringView literal_prefix)
+{
+    Prefilter prefilter;
+
+    // A single character is found just as quickly by its range.
+    if (literal_prefix.length() >= 2 && all_of(literal_prefix, [](char ch) { return is_ascii(ch); }))
+        prefilter.m_literal_prefix = literal_prefix;
+
+    Vector<Range> ranges;
+    for (auto const& range : starting_ranges)
+        ranges.append({ range.from, range.to });
+    if (ranges.is_empty() && !literal_prefix.is_empty() && is_ascii(literal_prefix[0]))
+        ranges.append({ static_cast<u8>(literal_prefix[0]), static_cast<u8>(literal_prefix[0]) });
+
+    if (ranges.is_empty())
+        return {};
+
+    // Case-insensitive compares lowercase both sides before comparing (see OpCode_Compare::compare_character_range()),
+    // so also accept everything that lowercases into a range, and the other case of every letter that is accepted.
+    Vector<Range> insensitive_ranges;
+    for (auto range : ranges) {
+        insensitive_ranges.append(range);
+        insensitive_ranges.append({ to_ascii_lowercase(range.from), to_ascii_lowercase(range.to) });
+    }
+    for (size_t i = 0, size = insensitive_ranges.size(); i < size; ++i) {
+        auto range = insensitive_ranges[i];
+        if (auto from = max(range.from, u32('a')), to = min(range.to, u32('z')); from <= to)
+            insensitive_ranges.append({ to_ascii_uppercase(from), to_ascii_uppercase(to) });
+        if (auto from = max(range.from, u32('A')), to = min(range.to, u32('Z')); from <= to)
+            insensitive_ranges.append({ to_ascii_lowercase(from), to_ascii_lowercase(to) });
+    }
+
+    prefilter.m_ranges = merge_ranges(ranges);
+    prefilter.m_insensitive_ranges = merge_ranges(insensitive_ranges);
+
+    if (prefilter.m_literal_prefix.is_empty() && !prefilter.m_ranges.has_value() && !prefilter.m_insensitive_ranges.has_value())
+        return {};
+    return prefilter;
+}
+
+Optional<size_t> Prefilter::find_candidate(RegexStringView const& view, size_t start, bool insensitive) const
+{
+    VERIFY(!view.unicode());
+
+    auto find = [&]<typename CodeUnit>(ReadonlySpan<CodeUnit> code_units) -> Optional<size_t> {
+        if (start >= code_units.size())
+            return {};
+        if (!insensitive && !m_literal_prefix.is_empty())
+            return find_literal(code_units, start);
+        if (auto const& ranges = insensitive ? m_insensitive_ranges : m_ranges; ranges.has_value())
+            return find_in_ranges(code_units, start, *ranges);
+        return start;
+    };
+
+    if (view.is_u16_view()) {
+        auto const& u16_view = view.u16_view();
+        return find(ReadonlySpan<u16> { u16_view.data(), u16_view.length_in_code_units() });
+    }
+    return find(view.string_view().bytes());
+}
+
+template<typename CodeUnit>
+Optional<size_t> Prefilter::find_literal(ReadonlySpan<CodeUnit> input, size_t start) const
+{
+    using VectorType = VectorFor<CodeUnit>;
+    static constexpr size_t lanes = sizeof(VectorType) / sizeof(CodeUnit);
+
+    auto literal = m_literal_prefix.bytes();
+    if (input.size() < literal.size())
+        return {};
+
+    auto const last_start = input.size() - literal.size();
+    auto const first = static_cast<CodeUnit>(literal[0]);
+    auto const second = static_cast<CodeUnit>(literal[1]);
+
+    auto rest_matches_at = [&](size_t position) {
+        for (size_t i = 2; i < literal.size(); ++i) {
+            if (input[position + i] != literal[i])
+                return false;
+        }
+        return true;
+    };
+
+    // Look for the first two characters of the literal at once, which rules out most false positives, and only
+    // compare the rest at the positions where both of them are found.
+    size_t position = start;
+    Optional<size_t> result;
+    for (; position + lanes < input.size() && position <= last_start; position += lanes) {
+        auto current = AK::SIMD::load_unaligned<VectorType>(input.offset_pointer(position));
+        auto next = AK::SIMD::load_unaligned<VectorType>(input.offset_pointer(position + 1));
+
+        bool done = for_each_set_lane<CodeUnit>((current == first) & (next == second), [&](size_t lane) {
+            if (position + lane > last_start)
+                return true;
+            if (!rest_matches_at(position + lane))
+                return false;
+            result = position + lane;
+            return true;
+        });
+        if (done)
+            return result;
+    }
+
+    for (; position <= last_start; ++position) {
+        if (input[position] == first && input[position + 1] == second && rest_matches_at(position))
+            return position;
+    }
+    return {};
+}
+
+template<typename CodeUnit>
+Optional<size_t> Prefilter::find_in_ranges(ReadonlySpan<CodeUnit> input, size_t start, Vector<Range, max_ranges> const& ranges)
+{
+    using VectorType = VectorFor<CodeUnit>;
+    static constexpr size_t lanes = sizeof(VectorType) / sizeof(CodeUnit);
+
+    // Ranges are sorted, so only the first few can contain code units of this size.
+    Vector<Range, max_ranges> clamped_ranges;
+    for (auto range : ranges) {
+        if (range.from > NumericLimits<CodeUnit>::max())
+            break;
+        clamped_ranges.append({ range.from, min<u32>(range.to, NumericLimits<CodeUnit>::max()) });
+    }
+    if (clamped_ranges.is_empty())
+        return {};
+
+    auto in_ranges = [&](CodeUnit code_unit) {
+        return any_of(clamped_ranges, [&](auto range) { return code_unit >= range.from && code_unit <= range.to; });
+    };
+
+    size_t position = start;
+    for (; position + lanes <= input.size(); position += lanes) {
+        auto chunk = AK::SIMD::load_unaligned<VectorType>(input.offset_pointer(position));
+
+        decltype(chunk == chunk) mask {};
+        for (auto range : clamped_ranges)
+            mask |= (chunk >= static_cast<CodeUnit>(range.from)) & (chunk <= static_cast<CodeUnit>(range.to));
+
+        Optional<size_t> result;
+        if (for_each_set_lane<CodeUnit>(mask, [&](size_t lane) { result = position + lane; return true; }))
+            return result;
+    }
+
+    for (; position < input.size(); ++position) {
+        if (in_ranges(input[position]))
+            return position;
+    }
+    return {};
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Finds the positions in the input where a match could start, so that a search does not have to run the matcher at
+// every position. The input is scanned 16 bytes at a time, either for a literal string that every match starts with,
+// or for any of a small set of character ranges that contains the first character of every match.
+class REGEX_API Prefilter {
+public:
+    struct Range {
+        u32 from { 0 };
+        u32 to { 0 };
+    };
+
+    static constexpr size_t max_ranges = 8;
+
+    // Returns an empty Optional if neither the literal prefix nor the starting ranges make for a useful prefilter.
+    static Optional<Prefilter> create(Vector<CharRange> const& starting_ranges, StringView literal_prefix);
+
+    // Returns the code unit position of the first candidate at or after `start`, or an empty Optional if no match can
+    // start there. Only views that are indexed in code units (i.e. non-Unicode ones) are supported.
+    Optional<size_t> find_candidate(RegexStringView const&, size_t start, bool insensitive) const;
+
+    StringView literal_prefix() const { return m_literal_prefix; }
+
+private:
+    Prefilter() = default;
+
+    template<typename CodeUnit>
+    Optional<size_t> find_literal(ReadonlySpan<CodeUnit>, size_t start) const;
+
+    template<typename CodeUnit>
+    static Optional<size_t> find_in_ranges(ReadonlySpan<CodeUnit>, size_t start, Vector<Range, max_ranges> const&);
+
+    ByteString m_literal_prefix; // Only ASCII characters, compared case-sensitively.
+    Optional<Vector<Range, max_ranges>> m_ranges;
+    Optional<Vector<Range, max_ranges>> m_insensitive_ranges; // Also contains the other ASCII case of every letter.
+};
+
+}
@@ -90,6 +90,8 @@ int main(int argc, char** argv)
     StringView specified_test_root;
     ByteString common_path;
     Vector<ByteString> test_globs;
+    bool gc_generational = false;
+    size_t gc_marking_threads = 1;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(print_times, "Show duration of each test", "show-time", 't');
@@ -112,7 +114,10 @@ int main(int argc, char** argv)
     args_parser.add_option(print_json, "Show results as JSON", "json", 'j');
     args_parser.add_option(per_file, "Show detailed per-file results as JSON (implies -j)", "per-file");
     args_parser.add_option(g_collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
+    args_parser.add_option(gc_generational, "Use generational garbage collection", "gc-generational", {});
+    args_parser.add_option(gc_marking_threads, "Number of threads used for GC marking (0 = one per CPU core)", "gc-marking-threads", {}, "count");
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::g_lazy_function_parsing, "Parse function bodies lazily on first call (syntax errors in a body are only reported when it's called)", "lazy-parse", {});
     args_parser.add_option(test_globs, "Only run tests matching the given glob", "filter", 'f', "glob");
     for (auto& entry : g_extra_args)
         args_parser.add_option(*entry.key, entry.value.get<0>().characters(), entry.value.get<1>().characters(), entry.value.get<2>());
@@ -186,6 +191,8 @@ int main(int argc, char** argv)
         g_vm = JS::VM::create();
         g_vm->set_dynamic_imports_allowed(true);
     }
+    g_vm->heap().set_marking_thread_count(gc_marking_threads);
+    g_vm->heap().set_generational_collection_enabled(gc_generational);
 
     Test::JS::TestRunner test_runner(test_root, common_path, print_times, print_progress, print_json, per_file);
     test_runner.run(test_globs);
@@ -14,6 +14,15 @@
 
 namespace Wasm {
 
+RegisterProgram const* WasmFunction::register_program(Store& store) const
+{
+    if (!m_tried_to_lower) {
+        m_tried_to_lower = true;
+        m_register_program = RegisterProgram::compile(*this, store);
+    }
+    return m_register_program.ptr();
+}
+
 Optional<FunctionAddress> Store::allocate(ModuleInstance& instance, Module const& module, CodeSection::Code const& code, TypeIndex type_index)
 {
     FunctionAddress address { m_functions.size() };
@@ -47,7 +56,7 @@ Optional<TableAddress> Store::allocate(TableType const& type)
 Optional<MemoryAddress> Store::allocate(MemoryType const& type)
 {
     MemoryAddress address { m_memories.size() };
-    auto instance = MemoryInstance::create(type);
+    auto instance = MemoryInstance::create(type, m_should_use_guard_pages ? MemoryInstance::UseGuardPages::Yes : MemoryInstance::UseGuardPages::No);
     if (instance.is_error())
         return {};
 
@@ -141,7 +150,9 @@ ErrorOr<void, ValidationError> AbstractMachine::validate(Module& module)
         return ValidationError { module.validation_error() };
     }
 
-    auto result = Validator {}.validate(module);
+    Validator validator;
+    validator.set_thread_count(m_validation_thread_count);
+    auto result = validator.validate(module);
     if (result.is_error()) {
         module.set_validation_error(result.error().error_string);
         return result.release_error();
@@ -239,6 +250,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
     }
 
     BytecodeInterpreter interpreter(m_stack_info);
+    interpreter.set_register_programs_enabled(m_register_programs_enabled);
     auto handle = register_scoped(interpreter);
 
     for (auto& entry : module.global_section().entries()) {
@@ -369,7 +381,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                     };
                 }
                 if (!data.init.is_empty())
-                    instance->data().overwrite(offset, data.init.data(), data.init.size());
+                    instance->bytes().overwrite(offset, data.init.data(), data.init.size());
                 return {};
             },
             [&](DataSection::Data::Passive const& passive) -> Optional<InstantiationError> {
@@ -492,6 +504,7 @@ Optional<InstantiationError> AbstractMachine::allocate_all_final_phase(Module co
 Result AbstractMachine::invoke(FunctionAddress address, Vector<Value> arguments)
 {
     BytecodeInterpreter interpreter(m_stack_info);
+    interpreter.set_register_programs_enabled(m_register_programs_enabled);
     auto handle = register_scoped(interpreter);
     return invoke(interpreter, address, move(arguments));
 }
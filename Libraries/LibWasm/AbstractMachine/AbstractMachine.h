@@ -13,6 +13,8 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/AbstractMachine/GuardedMemory.h>
+#include <LibWasm/AbstractMachine/RegisterProgram.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -345,11 +347,16 @@ public:
     auto& code() const { return m_code; }
     RefPtr<Module const> module_ref() const { return m_module.strong_ref(); }
 
+    // Lowers the function on first use. Returns null if the function can only run on the stack interpreter.
+    RegisterProgram const* register_program(Store&) const;
+
 private:
     FunctionType m_type;
     WeakPtr<Module const> m_module;
     ModuleInstance const& m_module_instance;
     CodeSection::Code const& m_code;
+    mutable OwnPtr<RegisterProgram> m_register_program;
+    mutable bool m_tried_to_lower { false };
 };
 
 class HostFunction {
@@ -415,10 +422,21 @@ private:
 
 class MemoryInstance {
 public:
-    static ErrorOr<MemoryInstance> create(MemoryType const& type)
+    enum class UseGuardPages {
+        No,
+        Yes,
+    };
+
+    static ErrorOr<MemoryInstance> create(MemoryType const& type, UseGuardPages use_guard_pages = UseGuardPages::No)
     {
         MemoryInstance instance { type };
 
+        // Without the address space for the reservation, this is just a memory that has to be bounds checked.
+        if (use_guard_pages == UseGuardPages::Yes) {
+            if (auto guarded_memory = GuardedMemory::create(); !guarded_memory.is_error())
+                instance.m_guarded_memory = guarded_memory.release_value();
+        }
+
         if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
             return Error::from_string_literal("Failed to grow to requested size");
 
@@ -427,8 +445,24 @@ public:
 
     auto& type() const { return m_type; }
     auto size() const { return m_size; }
-    auto& data() const { return m_data; }
-    auto& data() { return m_data; }
+
+    // Guarded memories are not backed by a ByteBuffer, use bytes() to access their contents.
+    auto& data() const
+    {
+        VERIFY(!m_guarded_memory);
+        return m_data;
+    }
+    auto& data()
+    {
+        VERIFY(!m_guarded_memory);
+        return m_data;
+    }
+
+    Bytes bytes() { return m_guarded_memory ? Bytes { m_guarded_memory->data(), m_size } : m_data.bytes(); }
+    ReadonlyBytes bytes() const { return m_guarded_memory ? ReadonlyBytes { m_guarded_memory->data(), m_size } : m_data.bytes(); }
+
+    // If set, accesses past the end of this memory fault instead of having to be bounds checked (see GuardedMemory).
+    GuardedMemory const* guarded_memory() const { return m_guarded_memory.ptr(); }
 
     enum class InhibitGrowCallback {
         No,
@@ -444,7 +478,7 @@ public:
     {
         if (size_to_grow == 0)
             return true;
-        u64 new_size = m_data.size() + size_to_grow;
+        u64 new_size = m_size + size_to_grow;
         // Can't grow past 2^16 pages.
         if (new_size >= Constants::page_size * 65536)
             return false;
@@ -452,12 +486,18 @@ public:
             if (max.value() * Constants::page_size < new_size)
                 return false;
         }
-        auto previous_size = m_size;
-        if (m_data.try_resize(new_size).is_error())
-            return false;
+        if (m_guarded_memory) {
+            // The pages that become accessible are already zeroed, and nothing moves.
+            if (m_guarded_memory->grow(new_size).is_error())
+                return false;
+        } else {
+            auto previous_size = m_size;
+            if (m_data.try_resize(new_size).is_error())
+                return false;
+            // The spec requires that we zero out everything on grow
+            __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
+        }
         m_size = new_size;
-        // The spec requires that we zero out everything on grow
-        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
 
         // NOTE: This exists because wasm-js-api wants to execute code after a successful grow,
         //       See [this issue](https://github.com/WebAssembly/spec/issues/1635) for more details.
@@ -486,6 +526,7 @@ private:
     MemoryType m_type;
     size_t m_size { 0 };
     ByteBuffer m_data;
+    OwnPtr<GuardedMemory> m_guarded_memory;
 };
 
 class GlobalInstance {
@@ -564,6 +605,10 @@ public:
     DataInstance* get(DataAddress);
     ElementInstance* get(ElementAddress);
 
+    // Memories that are allocated from now on are guarded where that is supported (see GuardedMemory).
+    // Their contents are only accessible through MemoryInstance::bytes(), not as a ByteBuffer.
+    void enable_guard_pages_for_memories() { m_should_use_guard_pages = GuardedMemory::is_supported(); }
+
 private:
     Vector<FunctionInstance> m_functions;
     Vector<TableInstance> m_tables;
@@ -571,6 +616,7 @@ private:
     Vector<GlobalInstance> m_globals;
     Vector<ElementInstance> m_elements;
     Vector<DataInstance> m_datas;
+    bool m_should_use_guard_pages { false };
 };
 
 class Label {
@@ -609,6 +655,8 @@ public:
     auto arity() const { return m_arity; }
     auto label_index() const { return m_label_index; }
     auto& label_index() { return m_label_index; }
+    auto register_program() const { return m_register_program; }
+    void set_register_program(RegisterProgram const* program) { m_register_program = program; }
 
 private:
     ModuleInstance const& m_module;
@@ -616,6 +664,7 @@ private:
     Expression const& m_expression;
     size_t m_arity { 0 };
     size_t m_label_index { 0 };
+    RegisterProgram const* m_register_program { nullptr };
 };
 
 using InstantiationResult = AK::ErrorOr<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -639,6 +688,11 @@ public:
     auto& store() { return m_store; }
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
+    // See BytecodeInterpreter::set_register_programs_enabled().
+    void set_register_programs_enabled(bool enabled) { m_register_programs_enabled = enabled; }
+    bool register_programs_enabled() const { return m_register_programs_enabled; }
+    // See Validator::set_thread_count().
+    void set_validation_thread_count(size_t count) { m_validation_thread_count = count; }
 
     void visit_external_resources(HostVisitOps const&);
 
@@ -673,6 +727,8 @@ private:
     StackInfo m_stack_info;
     HashTable<Interpreter*> m_active_interpreters;
     bool m_should_limit_instruction_count { false };
+    bool m_register_programs_enabled { true };
+    size_t m_validation_thread_count { 1 };
 };
 
 class Linker {
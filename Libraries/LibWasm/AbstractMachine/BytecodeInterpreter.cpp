@@ -33,6 +33,11 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
+    if (auto const* program = configuration.frame().register_program(); program && uses_register_programs()) {
+        interpret_register_program(configuration, *program);
+        return;
+    }
+
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
@@ -83,7 +88,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
+    auto slice = memory->bytes().slice(instance_address, sizeof(ReadType));
     entry = Value(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
@@ -108,7 +113,7 @@ void BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instru
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-load({} : {}) -> stack", instance_address, M * N / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M * N / 8);
+    auto slice = memory->bytes().slice(instance_address, M * N / 8);
     using V64 = NativeVectorType<M, N, SetSign>;
     using V128 = NativeVectorType<M * 2, N, SetSign>;
 
@@ -134,7 +139,7 @@ void BytecodeInterpreter::load_and_push_lane_n(Configuration& configuration, Ins
         m_trap = Trap::from_string("Memory access out of bounds");
         return;
     }
-    auto slice = memory->data().bytes().slice(instance_address, N / 8);
+    auto slice = memory->bytes().slice(instance_address, N / 8);
     auto dst = bit_cast<u8*>(&vector) + memarg_and_lane.lane * N / 8;
     memcpy(dst, slice.data(), N / 8);
     configuration.value_stack().append(Value(vector));
@@ -152,7 +157,7 @@ void BytecodeInterpreter::load_and_push_zero_n(Configuration& configuration, Ins
         m_trap = Trap::from_string("Memory access out of bounds");
         return;
     }
-    auto slice = memory->data().bytes().slice(instance_address, N / 8);
+    auto slice = memory->bytes().slice(instance_address, N / 8);
     u128 vector = 0;
     memcpy(&vector, slice.data(), N / 8);
     configuration.value_stack().append(Value(vector));
@@ -173,7 +178,7 @@ void BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-splat({} : {}) -> stack", instance_address, M / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M / 8);
+    auto slice = memory->bytes().slice(instance_address, M / 8);
     auto value = read_value<NativeIntegralType<M>>(slice);
     set_top_m_splat<M, NativeIntegralType>(configuration, value);
 }
@@ -259,6 +264,549 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
         configuration.value_stack().unchecked_append(entry);
 }
 
+// Registers hold the low 64 bits of the Value that they stand for, so that converting between them is lossless.
+template<typename T>
+ALWAYS_INLINE static T from_register(u64 value)
+{
+    if constexpr (sizeof(T) == sizeof(u64))
+        return bit_cast<T>(value);
+    else
+        return bit_cast<T>(static_cast<u32>(value));
+}
+
+template<typename T>
+ALWAYS_INLINE static u64 to_register(T value)
+{
+    if constexpr (sizeof(T) == sizeof(u64))
+        return bit_cast<u64>(value);
+    else
+        return static_cast<u64>(static_cast<i64>(bit_cast<i32>(value)));
+}
+
+// A v128 takes up two registers, the low half first.
+template<typename T>
+ALWAYS_INLINE static T read_register(u64 const* registers, u32 index)
+{
+    if constexpr (IsSame<T, u128>)
+        return u128(registers[index], registers[index + 1]);
+    else
+        return from_register<T>(registers[index]);
+}
+
+template<typename T>
+ALWAYS_INLINE static void write_register(u64* registers, u32 index, T value)
+{
+    if constexpr (IsSame<T, u128>) {
+        registers[index] = value.low();
+        registers[index + 1] = value.high();
+    } else {
+        registers[index] = to_register<T>(value);
+    }
+}
+
+template<typename PushType, typename T>
+ALWAYS_INLINE static Optional<StringView> write_result(u64* registers, u32 index, T result)
+{
+    if constexpr (IsSpecializationOf<T, AK::ErrorOr>) {
+        if (result.is_error())
+            return result.error();
+        write_register(registers, index, static_cast<PushType>(result.release_value()));
+    } else {
+        write_register(registers, index, static_cast<PushType>(result));
+    }
+    return {};
+}
+
+static void value_to_registers(ValueType type, Value const& value, u64* registers)
+{
+    if (registers_for(type) == 2)
+        write_register(registers, 0, value.value());
+    else
+        registers[0] = value.to<u64>();
+}
+
+static Value value_from_registers(ValueType type, u64 const* registers)
+{
+    if (registers_for(type) == 2)
+        return Value(read_register<u128>(registers, 0));
+    return Value(registers[0]);
+}
+
+template<typename T>
+using RawMemoryType = Conditional<sizeof(T) == 8, u64, Conditional<sizeof(T) == 4, u32, Conditional<sizeof(T) == 2, u16, u8>>>;
+
+template<typename T>
+ALWAYS_INLINE static T read_from_memory(u8 const* data)
+{
+    if constexpr (IsSame<T, u128>) {
+        return u128(read_from_memory<u64>(data), read_from_memory<u64>(data + sizeof(u64)));
+    } else {
+        RawMemoryType<T> raw;
+        __builtin_memcpy(&raw, data, sizeof(raw));
+        return bit_cast<T>(AK::convert_between_host_and_little_endian(raw));
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE static void write_to_memory(u8* data, T value)
+{
+    if constexpr (IsSame<T, u128>) {
+        write_to_memory(data, value.low());
+        write_to_memory(data + sizeof(u64), value.high());
+    } else {
+        auto raw = AK::convert_between_host_and_little_endian(bit_cast<RawMemoryType<T>>(value));
+        __builtin_memcpy(data, &raw, sizeof(raw));
+    }
+}
+
+void BytecodeInterpreter::interpret_register_program(Configuration& configuration, RegisterProgram const& program)
+{
+    auto& locals = configuration.frame().locals();
+    auto base = m_registers.size();
+    m_registers.resize(base + program.register_count());
+    for (size_t i = 0, reg = base; i < locals.size(); ++i) {
+        auto type = program.local_types()[i];
+        value_to_registers(type, locals[i], m_registers.data() + reg);
+        reg += registers_for(type);
+    }
+
+    // Accesses to guarded memories are not bounds checked, and fault instead when they're out of bounds.
+    auto completed = GuardedMemory::run_catching_faults([&] {
+        run_register_program(configuration, configuration.frame().module(), program, base);
+    });
+    if (!completed)
+        m_trap = Trap::from_string("Memory access out of bounds");
+
+    if (!did_trap()) {
+        configuration.value_stack().ensure_capacity(configuration.value_stack().size() + program.result_types().size());
+        for (size_t reg = base + program.local_register_count(); auto type : program.result_types()) {
+            configuration.value_stack().unchecked_append(value_from_registers(type, m_registers.data() + reg));
+            reg += registers_for(type);
+        }
+    }
+    m_registers.shrink(base, true);
+}
+
+void BytecodeInterpreter::call_from_register_program(Configuration& configuration, FunctionAddress address, size_t first_register)
+{
+    TRAP_IF_NOT(m_stack_info.size_free() >= Constants::minimum_stack_space_to_keep_free, "{}: {}", Constants::stack_exhaustion_message);
+
+    auto& store = configuration.store();
+    auto* function = store.get(address);
+    auto const& type = function->visit([](auto const& function) -> FunctionType const& { return function.type(); });
+
+    // Calls between lowered functions pass their arguments and results straight between the two register frames.
+    if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
+        if (auto const* program = wasm_function->register_program(store)) {
+            auto& module = wasm_function->module();
+            auto base = m_registers.size();
+            m_registers.resize(base + program->register_count());
+            for (size_t i = 0; i < program->parameter_register_count(); ++i)
+                m_registers[base + i] = m_registers[first_register + i];
+
+            run_register_program(configuration, module, *program, base);
+
+            if (!did_trap()) {
+                for (size_t i = 0; i < program->result_register_count(); ++i)
+                    m_registers[first_register + i] = m_registers[base + program->local_register_count() + i];
+            }
+            m_registers.shrink(base, true);
+            return;
+        }
+    }
+
+    // Whatever runs now is not ours to catch faults for, see GuardedMemory::run_catching_faults().
+    GuardedMemory::set_accessed_memory(nullptr);
+
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type.parameters().size());
+    for (size_t reg = first_register; auto parameter : type.parameters()) {
+        arguments.unchecked_append(value_from_registers(parameter, m_registers.data() + reg));
+        reg += registers_for(parameter);
+    }
+
+    Result result { Trap::from_string("") };
+    if (function->has<WasmFunction>()) {
+        CallFrameHandle handle { *this, configuration };
+        result = configuration.call(*this, address, move(arguments));
+    } else {
+        result = configuration.call(*this, address, move(arguments));
+    }
+
+    if (result.is_trap()) {
+        m_trap = move(result.trap());
+        return;
+    }
+
+    // The results come back in reverse order, see call_address().
+    auto& values = result.values();
+    for (size_t i = 0, reg = first_register; i < values.size(); ++i) {
+        auto result_type = type.results()[i];
+        value_to_registers(result_type, values[values.size() - 1 - i], m_registers.data() + reg);
+        reg += registers_for(result_type);
+    }
+}
+
+#define TRAP_IF_NOT_RETURN_EMPTY(x)     \
+    do {                                \
+        if (trap_if_not(x, #x##sv))     \
+            return {};                  \
+    } while (false)
+
+Optional<FunctionAddress> BytecodeInterpreter::resolve_indirect_call(Configuration& configuration, ModuleInstance const& module, TableIndex table_index, TypeIndex type_index, i32 index)
+{
+    // These are the same checks as call_indirect in interpret_instruction(), so that both trap with the same messages.
+    auto table_address = module.tables()[table_index.value()];
+    auto table_instance = configuration.store().get(table_address);
+    TRAP_IF_NOT_RETURN_EMPTY(index >= 0);
+    TRAP_IF_NOT_RETURN_EMPTY(static_cast<size_t>(index) < table_instance->elements().size());
+    auto element = table_instance->elements()[index];
+    TRAP_IF_NOT_RETURN_EMPTY(element.ref().has<Reference::Func>());
+    auto address = element.ref().get<Reference::Func>().address;
+    auto const& type_actual = configuration.store().get(address)->visit([](auto& f) -> decltype(auto) { return f.type(); });
+    auto const& type_expected = module.types()[type_index.value()];
+    TRAP_IF_NOT_RETURN_EMPTY(type_actual.parameters().size() == type_expected.parameters().size());
+    TRAP_IF_NOT_RETURN_EMPTY(type_actual.results().size() == type_expected.results().size());
+    TRAP_IF_NOT_RETURN_EMPTY(type_actual.parameters() == type_expected.parameters());
+    TRAP_IF_NOT_RETURN_EMPTY(type_actual.results() == type_expected.results());
+    return address;
+}
+
+#undef TRAP_IF_NOT_RETURN_EMPTY
+
+void BytecodeInterpreter::run_register_program(Configuration& configuration, ModuleInstance const& module, RegisterProgram const& program, size_t base)
+{
+    using Op = RegisterProgram::Op;
+
+    auto const* instructions = program.instructions().data();
+    auto const* branch_table = program.branch_table().data();
+    auto* registers = m_registers.data() + base;
+
+    static void* const bounds_checked_dispatch_table[] = {
+#define __ENUMERATE_LABEL(name, ...) &&handle_##name,
+        ENUMERATE_WASM_REGISTER_CONTROL_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_LOAD_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_STORE_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_UNARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_BINARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_VECTOR_UNARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_VECTOR_BINARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_VECTOR_SHIFT_OPS(__ENUMERATE_LABEL)
+#undef __ENUMERATE_LABEL
+    };
+
+    // Loads and stores on a guarded memory rely on its guard region to catch the accesses that are out of bounds.
+    static void* const guarded_dispatch_table[] = {
+#define __ENUMERATE_LABEL(name, ...) &&handle_##name,
+#define __ENUMERATE_GUARDED_LABEL(name, ...) &&handle_guarded_##name,
+        ENUMERATE_WASM_REGISTER_CONTROL_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_LOAD_OPS(__ENUMERATE_GUARDED_LABEL)
+        ENUMERATE_WASM_REGISTER_STORE_OPS(__ENUMERATE_GUARDED_LABEL)
+        ENUMERATE_WASM_REGISTER_UNARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_BINARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_VECTOR_UNARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_VECTOR_BINARY_OPS(__ENUMERATE_LABEL)
+        ENUMERATE_WASM_REGISTER_VECTOR_SHIFT_OPS(__ENUMERATE_LABEL)
+#undef __ENUMERATE_GUARDED_LABEL
+#undef __ENUMERATE_LABEL
+    };
+
+    void* const* dispatch_table = bounds_checked_dispatch_table;
+    u8* memory_data = nullptr;
+    u64 memory_size = 0;
+    auto refresh_memory = [&] {
+        if (module.memories().is_empty()) {
+            GuardedMemory::set_accessed_memory(nullptr);
+            return;
+        }
+        auto* memory = configuration.store().get(module.memories()[0]);
+        memory_data = memory->bytes().data();
+        memory_size = memory->size();
+        GuardedMemory::set_accessed_memory(memory->guarded_memory());
+        dispatch_table = memory->guarded_memory() ? guarded_dispatch_table : bounds_checked_dispatch_table;
+    };
+    refresh_memory();
+
+    // Calls can grow the register file, and anything they do can grow or move the memory.
+    auto after_call = [&] {
+        registers = m_registers.data() + base;
+        refresh_memory();
+    };
+
+    auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+    u64 executed_instructions = 0;
+    size_t pc = 0;
+
+#define DISPATCH() goto* dispatch_table[to_underlying(instructions[pc].op)]
+
+#define DISPATCH_NEXT() \
+    do {                \
+        ++pc;           \
+        DISPATCH();     \
+    } while (0)
+
+    // Every loop goes through a backward jump, so that is where the instruction limit is enforced. The number of
+    // instructions that were jumped back over stands in for the number of instructions executed.
+#define JUMP_TO(target)                                                                                                            \
+    do {                                                                                                                           \
+        size_t target_pc = (target);                                                                                               \
+        if (should_limit_instruction_count && target_pc <= pc) {                                                                   \
+            executed_instructions += pc - target_pc + 1;                                                                           \
+            if (executed_instructions >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {                    \
+                m_trap = Trap::from_string("Exceeded maximum allowed number of instructions");                                     \
+                return;                                                                                                            \
+            }                                                                                                                      \
+        }                                                                                                                          \
+        pc = target_pc;                                                                                                            \
+        DISPATCH();                                                                                                                \
+    } while (0)
+
+    DISPATCH();
+
+handle_Jump:
+    JUMP_TO(instructions[pc].immediate);
+
+handle_JumpIfZero: {
+    auto& instruction = instructions[pc];
+    if (static_cast<u32>(registers[instruction.lhs]) == 0)
+        JUMP_TO(instruction.immediate);
+    DISPATCH_NEXT();
+}
+
+handle_JumpIfNotZero: {
+    auto& instruction = instructions[pc];
+    if (static_cast<u32>(registers[instruction.lhs]) != 0)
+        JUMP_TO(instruction.immediate);
+    DISPATCH_NEXT();
+}
+
+handle_BranchTable: {
+    auto& instruction = instructions[pc];
+    auto index = min(static_cast<u32>(registers[instruction.lhs]), instruction.rhs);
+    pc = branch_table[instruction.immediate + index];
+    DISPATCH();
+}
+
+handle_Return:
+    return;
+
+handle_Unreachable:
+    m_trap = Trap::from_string("Unreachable");
+    return;
+
+handle_Move: {
+    auto& instruction = instructions[pc];
+    registers[instruction.dst] = registers[instruction.lhs];
+    DISPATCH_NEXT();
+}
+
+handle_MoveWide: {
+    auto& instruction = instructions[pc];
+    registers[instruction.dst] = registers[instruction.lhs];
+    registers[instruction.dst + 1] = registers[instruction.lhs + 1];
+    DISPATCH_NEXT();
+}
+
+handle_Const: {
+    auto& instruction = instructions[pc];
+    registers[instruction.dst] = instruction.immediate;
+    DISPATCH_NEXT();
+}
+
+handle_Select: {
+    auto& instruction = instructions[pc];
+    registers[instruction.dst] = static_cast<u32>(registers[instruction.immediate]) != 0 ? registers[instruction.lhs] : registers[instruction.rhs];
+    DISPATCH_NEXT();
+}
+
+handle_SelectWide: {
+    auto& instruction = instructions[pc];
+    auto source = static_cast<u32>(registers[instruction.immediate]) != 0 ? instruction.lhs : instruction.rhs;
+    registers[instruction.dst] = registers[source];
+    registers[instruction.dst + 1] = registers[source + 1];
+    DISPATCH_NEXT();
+}
+
+handle_Call: {
+    auto& instruction = instructions[pc];
+    call_from_register_program(configuration, module.functions()[instruction.immediate], base + instruction.dst);
+    if (did_trap())
+        return;
+    after_call();
+    DISPATCH_NEXT();
+}
+
+handle_CallIndirect: {
+    auto& instruction = instructions[pc];
+    auto address = resolve_indirect_call(configuration, module, TableIndex(instruction.immediate >> 32), TypeIndex(instruction.immediate & 0xffffffff), from_register<i32>(registers[instruction.lhs]));
+    if (!address.has_value())
+        return;
+    call_from_register_program(configuration, *address, base + instruction.dst);
+    if (did_trap())
+        return;
+    after_call();
+    DISPATCH_NEXT();
+}
+
+handle_GlobalGet: {
+    auto& instruction = instructions[pc];
+    auto* global = configuration.store().get(module.globals()[instruction.immediate]);
+    value_to_registers(global->type().type(), global->value(), registers + instruction.dst);
+    DISPATCH_NEXT();
+}
+
+handle_GlobalSet: {
+    auto& instruction = instructions[pc];
+    auto* global = configuration.store().get(module.globals()[instruction.immediate]);
+    global->set_value(value_from_registers(global->type().type(), registers + instruction.lhs));
+    DISPATCH_NEXT();
+}
+
+handle_MemorySize: {
+    auto& instruction = instructions[pc];
+    registers[instruction.dst] = to_register(static_cast<i32>(memory_size / Constants::page_size));
+    DISPATCH_NEXT();
+}
+
+handle_MemoryGrow: {
+    auto& instruction = instructions[pc];
+    auto* instance = configuration.store().get(module.memories()[0]);
+    i32 old_pages = instance->size() / Constants::page_size;
+    auto new_pages = from_register<i32>(registers[instruction.lhs]);
+    if (instance->grow(new_pages * Constants::page_size))
+        registers[instruction.dst] = to_register(old_pages);
+    else
+        registers[instruction.dst] = to_register<i32>(-1);
+    refresh_memory();
+    DISPATCH_NEXT();
+}
+
+handle_RefIsNull: {
+    auto& instruction = instructions[pc];
+    // The high half of a reference tells its kind apart, see Value(Reference).
+    auto is_null = (registers[instruction.lhs + 1] & 3) >= 2;
+    registers[instruction.dst] = to_register<i32>(is_null ? 1 : 0);
+    DISPATCH_NEXT();
+}
+
+handle_TableGet: {
+    // These trap with the same messages as table.get and table.set in interpret_instruction().
+    auto& instruction = instructions[pc];
+    auto* table = configuration.store().get(module.tables()[instruction.immediate]);
+    auto index = static_cast<size_t>(from_register<i32>(registers[instruction.lhs]));
+    if (trap_if_not(index < table->elements().size(), "index < table->elements().size()"sv))
+        return;
+    write_register(registers, instruction.dst, Value(table->elements()[index]).value());
+    DISPATCH_NEXT();
+}
+
+handle_TableSet: {
+    auto& instruction = instructions[pc];
+    auto* table = configuration.store().get(module.tables()[instruction.immediate]);
+    auto index = static_cast<size_t>(from_register<i32>(registers[instruction.lhs]));
+    if (trap_if_not(index < table->elements().size(), "index < table->elements().size()"sv))
+        return;
+    table->elements()[index] = Value(read_register<u128>(registers, instruction.rhs)).to<Reference>();
+    DISPATCH_NEXT();
+}
+
+#define __HANDLE_LOAD(name, ReadType, PushType)                                                                     \
+    handle_##name:                                                                                                  \
+    {                                                                                                               \
+        auto& instruction = instructions[pc];                                                                       \
+        u64 instance_address = static_cast<u64>(static_cast<u32>(registers[instruction.lhs])) + instruction.immediate; \
+        if (instance_address + sizeof(ReadType) > memory_size) [[unlikely]] {                                       \
+            m_trap = Trap::from_string("Memory access out of bounds");                                              \
+            return;                                                                                                 \
+        }                                                                                                           \
+        auto value = read_from_memory<ReadType>(memory_data + instance_address);                                   \
+        write_register(registers, instruction.dst, static_cast<PushType>(value));                                  \
+        DISPATCH_NEXT();                                                                                            \
+    }
+    ENUMERATE_WASM_REGISTER_LOAD_OPS(__HANDLE_LOAD)
+#undef __HANDLE_LOAD
+
+#define __HANDLE_STORE(name, PopType, StoreType)                                                                    \
+    handle_##name:                                                                                                  \
+    {                                                                                                               \
+        auto& instruction = instructions[pc];                                                                       \
+        u64 instance_address = static_cast<u64>(static_cast<u32>(registers[instruction.lhs])) + instruction.immediate; \
+        if (instance_address + sizeof(StoreType) > memory_size) [[unlikely]] {                                      \
+            m_trap = Trap::from_string("Memory access out of bounds");                                              \
+            return;                                                                                                 \
+        }                                                                                                           \
+        auto value = static_cast<StoreType>(read_register<PopType>(registers, instruction.rhs));                    \
+        write_to_memory(memory_data + instance_address, value);                                                     \
+        DISPATCH_NEXT();                                                                                            \
+    }
+    ENUMERATE_WASM_REGISTER_STORE_OPS(__HANDLE_STORE)
+#undef __HANDLE_STORE
+
+#define __HANDLE_GUARDED_LOAD(name, ReadType, PushType)                                                             \
+    handle_guarded_##name:                                                                                          \
+    {                                                                                                               \
+        auto& instruction = instructions[pc];                                                                       \
+        u64 instance_address = static_cast<u64>(static_cast<u32>(registers[instruction.lhs])) + instruction.immediate; \
+        auto value = read_from_memory<ReadType>(memory_data + instance_address);                                   \
+        write_register(registers, instruction.dst, static_cast<PushType>(value));                                  \
+        DISPATCH_NEXT();                                                                                            \
+    }
+    ENUMERATE_WASM_REGISTER_LOAD_OPS(__HANDLE_GUARDED_LOAD)
+#undef __HANDLE_GUARDED_LOAD
+
+#define __HANDLE_GUARDED_STORE(name, PopType, StoreType)                                                            \
+    handle_guarded_##name:                                                                                          \
+    {                                                                                                               \
+        auto& instruction = instructions[pc];                                                                       \
+        u64 instance_address = static_cast<u64>(static_cast<u32>(registers[instruction.lhs])) + instruction.immediate; \
+        auto value = static_cast<StoreType>(read_register<PopType>(registers, instruction.rhs));                    \
+        write_to_memory(memory_data + instance_address, value);                                                     \
+        DISPATCH_NEXT();                                                                                            \
+    }
+    ENUMERATE_WASM_REGISTER_STORE_OPS(__HANDLE_GUARDED_STORE)
+#undef __HANDLE_GUARDED_STORE
+
+#define __HANDLE_UNARY(name, PopType, PushType, ...)                                                           \
+    handle_##name:                                                                                             \
+    {                                                                                                          \
+        auto& instruction = instructions[pc];                                                                  \
+        auto operand = read_register<PopType>(registers, instruction.lhs);                                     \
+        if (auto error = write_result<PushType>(registers, instruction.dst, __VA_ARGS__ {}(operand)); error.has_value()) { \
+            trap_if_not(false, *error);                                                                        \
+            return;                                                                                            \
+        }                                                                                                      \
+        DISPATCH_NEXT();                                                                                       \
+    }
+    ENUMERATE_WASM_REGISTER_UNARY_OPS(__HANDLE_UNARY)
+    ENUMERATE_WASM_REGISTER_VECTOR_UNARY_OPS(__HANDLE_UNARY)
+#undef __HANDLE_UNARY
+
+#define __HANDLE_BINARY_WITH_TYPES(name, LhsType, RhsType, PushType, ...)                                             \
+    handle_##name:                                                                                                     \
+    {                                                                                                                  \
+        auto& instruction = instructions[pc];                                                                          \
+        auto lhs = read_register<LhsType>(registers, instruction.lhs);                                                 \
+        auto rhs = read_register<RhsType>(registers, instruction.rhs);                                                 \
+        if (auto error = write_result<PushType>(registers, instruction.dst, __VA_ARGS__ {}(lhs, rhs)); error.has_value()) { \
+            trap_if_not(false, *error);                                                                                \
+            return;                                                                                                    \
+        }                                                                                                              \
+        DISPATCH_NEXT();                                                                                               \
+    }
+#define __HANDLE_BINARY(name, PopType, PushType, ...) __HANDLE_BINARY_WITH_TYPES(name, PopType, PopType, PushType, __VA_ARGS__)
+#define __HANDLE_VECTOR_SHIFT(name, ...) __HANDLE_BINARY_WITH_TYPES(name, u128, i32, u128, __VA_ARGS__)
+    ENUMERATE_WASM_REGISTER_BINARY_OPS(__HANDLE_BINARY)
+    ENUMERATE_WASM_REGISTER_VECTOR_BINARY_OPS(__HANDLE_BINARY)
+    ENUMERATE_WASM_REGISTER_VECTOR_SHIFT_OPS(__HANDLE_VECTOR_SHIFT)
+#undef __HANDLE_VECTOR_SHIFT
+#undef __HANDLE_BINARY
+#undef __HANDLE_BINARY_WITH_TYPES
+
+#undef JUMP_TO
+#undef DISPATCH_NEXT
+#undef DISPATCH
+}
+
 template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS, typename... Args>
 void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration, Args&&... args)
 {
@@ -364,7 +912,7 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    data.copy_to(memory->bytes().slice(instance_address, data.size()));
 }
 
 template<typename T>
@@ -657,7 +1205,7 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         u8 value = static_cast<u8>(configuration.value_stack().take_last().to<u32>());
         auto destination_offset = configuration.value_stack().take_last().to<u32>();
 
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
+        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->size());
 
         if (count == 0)
             return;
@@ -686,8 +1234,8 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         source_position.saturating_add(count);
         Checked<size_t> destination_position = destination_offset;
         destination_position.saturating_add(count);
-        TRAP_IF_NOT(source_position <= source_instance->data().size());
-        TRAP_IF_NOT(destination_position <= destination_instance->data().size());
+        TRAP_IF_NOT(source_position <= source_instance->size());
+        TRAP_IF_NOT(destination_position <= destination_instance->size());
 
         if (count == 0)
             return;
@@ -695,12 +1243,12 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         Instruction::MemoryArgument memarg { 0, 0, args.dst_index };
         if (destination_offset <= source_offset) {
             for (auto i = 0; i < count; ++i) {
-                auto value = source_instance->data()[source_offset + i];
+                auto value = source_instance->bytes()[source_offset + i];
                 store_to_memory(configuration, memarg, { &value, sizeof(value) }, destination_offset + i);
             }
         } else {
             for (auto i = count - 1; i >= 0; --i) {
-                auto value = source_instance->data()[source_offset + i];
+                auto value = source_instance->bytes()[source_offset + i];
                 store_to_memory(configuration, memarg, { &value, sizeof(value) }, destination_offset + i);
             }
         }
@@ -723,7 +1271,7 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         Checked<size_t> destination_position = destination_offset;
         destination_position.saturating_add(count);
         TRAP_IF_NOT(source_position <= data.data().size());
-        TRAP_IF_NOT(destination_position <= memory->data().size());
+        TRAP_IF_NOT(destination_position <= memory->size());
 
         if (count == 0)
             return;
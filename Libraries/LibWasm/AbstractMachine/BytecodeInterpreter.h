@@ -9,6 +9,7 @@
 #include <AK/StackInfo.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
+#include <LibWasm/AbstractMachine/RegisterProgram.h>
 
 namespace Wasm {
 
@@ -52,7 +53,18 @@ struct BytecodeInterpreter : public Interpreter {
         IndirectCall,
     };
 
+    // Forces every function onto the stack interpreter, e.g. to compare the two tiers.
+    void set_register_programs_enabled(bool enabled) { m_register_programs_enabled = enabled; }
+
 protected:
+    // Whether functions that were lowered to a RegisterProgram run that, instead of their Wasm instructions.
+    virtual bool uses_register_programs() const { return m_register_programs_enabled; }
+
+    void interpret_register_program(Configuration&, RegisterProgram const&);
+    void run_register_program(Configuration&, ModuleInstance const&, RegisterProgram const&, size_t register_base);
+    void call_from_register_program(Configuration&, FunctionAddress, size_t first_register);
+    Optional<FunctionAddress> resolve_indirect_call(Configuration&, ModuleInstance const&, TableIndex, TypeIndex, i32 index);
+
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
@@ -104,6 +116,10 @@ protected:
 
     Variant<Trap, Empty> m_trap;
     StackInfo const& m_stack_info;
+
+    // The register frames of all running RegisterPrograms, innermost last.
+    Vector<u64> m_registers;
+    bool m_register_programs_enabled { true };
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
@@ -117,6 +133,9 @@ struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
 
 private:
+    // The hooks need to see every Wasm instruction.
+    virtual bool uses_register_programs() const override { return BytecodeInterpreter::uses_register_programs() && !pre_interpret_hook && !post_interpret_hook; }
+
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
 };
 
@@ -31,12 +31,14 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
                 locals.append(Value(local.type()));
         }
 
-        set_frame(Frame {
+        Frame frame {
             wasm_function->module(),
             move(locals),
             wasm_function->code().func().body(),
             wasm_function->type().results().size(),
-        });
+        };
+        frame.set_register_program(wasm_function->register_program(m_store));
+        set_frame(move(frame));
         m_ip = 0;
         return execute(interpreter);
     }
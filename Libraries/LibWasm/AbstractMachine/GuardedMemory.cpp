@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Platform.h>
+#include <LibWasm/AbstractMachine/GuardedMemory.h>
+
+#if defined(AK_ARCH_64_BIT) && !defined(AK_OS_WINDOWS)
+#    define WASM_GUARDED_MEMORY_SUPPORTED
+#endif
+
+#ifdef WASM_GUARDED_MEMORY_SUPPORTED
+#    include <LibCore/System.h>
+#    include <setjmp.h>
+#    include <signal.h>
+#    include <sys/mman.h>
+#endif
+
+namespace Wasm {
+
+#ifdef WASM_GUARDED_MEMORY_SUPPORTED
+
+struct FaultRecovery {
+    sigjmp_buf jump_buffer;
+    FaultRecovery* previous { nullptr };
+    GuardedMemory const* previous_accessed_memory { nullptr };
+};
+
+static thread_local FaultRecovery* t_fault_recovery { nullptr };
+static thread_local GuardedMemory const* t_accessed_memory { nullptr };
+
+static struct sigaction s_previous_segv_action;
+static struct sigaction s_previous_bus_action;
+
+static void handle_fault(int signal, siginfo_t* info, void* context)
+{
+    if (auto* recovery = t_fault_recovery; recovery && t_accessed_memory && t_accessed_memory->is_in_guard_region(bit_cast<FlatPtr>(info->si_addr)))
+        siglongjmp(recovery->jump_buffer, 1);
+
+    // Not a fault on a guard region, so whoever handled it before us gets to.
+    auto const& previous_action = signal == SIGSEGV ? s_previous_segv_action : s_previous_bus_action;
+    if (previous_action.sa_flags & SA_SIGINFO) {
+        previous_action.sa_sigaction(signal, info, context);
+        return;
+    }
+    if (previous_action.sa_handler == SIG_DFL || previous_action.sa_handler == SIG_IGN) {
+        // Returning retries the faulting access, which then gets the default treatment.
+        ::signal(signal, SIG_DFL);
+        return;
+    }
+    previous_action.sa_handler(signal);
+}
+
+static bool install_fault_handler()
+{
+    struct sigaction action {};
+    action.sa_sigaction = handle_fault;
+    // SA_NODEFER keeps the signal unblocked after we jump out of the handler, so that the jump buffer doesn't need to
+    // save and restore the signal mask (which would cost a syscall on every run_catching_faults()).
+    action.sa_flags = SA_SIGINFO | SA_NODEFER | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+
+    if (auto result = Core::System::sigaction(SIGSEGV, &action, &s_previous_segv_action); result.is_error()) {
+        dbgln("LibWasm: Failed to install the guarded memory fault handler: {}", result.error());
+        return false;
+    }
+    // Some systems (e.g. macOS) report accesses to PROT_NONE pages as SIGBUS.
+    if (auto result = Core::System::sigaction(SIGBUS, &action, &s_previous_bus_action); result.is_error()) {
+        dbgln("LibWasm: Failed to install the guarded memory fault handler: {}", result.error());
+        MUST(Core::System::sigaction(SIGSEGV, &s_previous_segv_action, nullptr));
+        return false;
+    }
+    return true;
+}
+
+bool GuardedMemory::is_supported()
+{
+    static bool const has_fault_handler = install_fault_handler();
+    return has_fault_handler;
+}
+
+ErrorOr<NonnullOwnPtr<GuardedMemory>> GuardedMemory::create()
+{
+    if (!is_supported())
+        return Error::from_string_literal("Guarded memories are not supported");
+
+    // Nothing is committed until grow() makes it accessible, so this only costs address space.
+    auto* data = TRY(Core::System::mmap(nullptr, reservation_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+    return adopt_own(*new GuardedMemory(static_cast<u8*>(data)));
+}
+
+GuardedMemory::~GuardedMemory()
+{
+    MUST(Core::System::munmap(m_data, reservation_size));
+}
+
+ErrorOr<void> GuardedMemory::grow(size_t new_size)
+{
+    VERIFY(new_size >= m_size);
+    VERIFY(new_size <= reservation_size - Constants::page_size);
+    if (new_size == m_size)
+        return {};
+
+    // Fresh anonymous pages are zero-filled the first time they're touched.
+    if (::mprotect(m_data + m_size, new_size - m_size, PROT_READ | PROT_WRITE) < 0)
+        return Error::from_syscall("mprotect"sv, errno);
+    m_size = new_size;
+    return {};
+}
+
+bool GuardedMemory::run_catching_faults(void (*callback)(void const*), void const* context)
+{
+    FaultRecovery recovery;
+    recovery.previous = t_fault_recovery;
+    recovery.previous_accessed_memory = t_accessed_memory;
+    t_fault_recovery = &recovery;
+
+    bool completed = true;
+    if (sigsetjmp(recovery.jump_buffer, 0) == 0)
+        callback(context);
+    else
+        completed = false;
+
+    t_fault_recovery = recovery.previous;
+    t_accessed_memory = recovery.previous_accessed_memory;
+    return completed;
+}
+
+void GuardedMemory::set_accessed_memory(GuardedMemory const* memory)
+{
+    t_accessed_memory = memory;
+}
+
+#else
+
+bool GuardedMemory::is_supported()
+{
+    return false;
+}
+
+ErrorOr<NonnullOwnPtr<GuardedMemory>> GuardedMemory::create()
+{
+    return Error::from_string_literal("Guarded memories are not supported");
+}
+
+GuardedMemory::~GuardedMemory() = default;
+
+ErrorOr<void> GuardedMemory::grow(size_t)
+{
+    VERIFY_NOT_REACHED();
+}
+
+bool GuardedMemory::run_catching_faults(void (*callback)(void const*), void const* context)
+{
+    callback(context);
+    return true;
+}
+
+void GuardedMemory::set_accessed_memory(GuardedMemory const*)
+{
+}
+
+#endif
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Types.h>
+#include <LibWasm/Constants.h>
+
+namespace Wasm {
+
+// Backing storage for a linear memory that never moves and never needs to be bounds checked.
+// All the address space that a memory access can reach (a 32-bit address plus a 32-bit offset) is reserved up front,
+// of which only the first size() bytes are accessible. Growing makes more of it accessible, without copying anything.
+// Touching anything past size() faults; code that skips its bounds checks runs through run_catching_faults(), which
+// turns those faults into a normal return.
+class GuardedMemory {
+    AK_MAKE_NONCOPYABLE(GuardedMemory);
+    AK_MAKE_NONMOVABLE(GuardedMemory);
+
+public:
+    static constexpr u64 reservation_size = (2ull << 32) + Constants::page_size;
+
+    // Only 64-bit hosts have the address space to spare, and the faults are only caught on hosts with POSIX signals.
+    static bool is_supported();
+
+    static ErrorOr<NonnullOwnPtr<GuardedMemory>> create();
+    ~GuardedMemory();
+
+    u8* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    // The newly accessible bytes read as zero.
+    ErrorOr<void> grow(size_t new_size);
+
+    bool is_in_guard_region(FlatPtr address) const
+    {
+        auto start = bit_cast<FlatPtr>(m_data);
+        return address >= start + m_size && address < start + reservation_size;
+    }
+
+    // Runs the callback, and returns false if it was cut short by a fault on the guard region of the memory that was
+    // last passed to set_accessed_memory() on this thread. Nothing between here and the faulting access is unwound,
+    // so the callback may only have trivially destructible objects alive while it accesses guarded memory.
+    // (This can't take an AK::Function, as jumping out of one leaves it believing that it is still being called.)
+    template<typename Callback>
+    static bool run_catching_faults(Callback const& callback)
+    {
+        return run_catching_faults(
+            [](void const* context) { (*static_cast<Callback const*>(context))(); },
+            &callback);
+    }
+
+    // Faults are only caught for one memory at a time, and not at all while this is null (or outside of
+    // run_catching_faults()). Code that calls out to something that may not expect its faults to be caught
+    // should clear this first.
+    static void set_accessed_memory(GuardedMemory const*);
+
+private:
+    static bool run_catching_faults(void (*)(void const*), void const* context);
+
+    explicit GuardedMemory(u8* data)
+        : m_data(data)
+    {
+    }
+
+    u8* m_data { nullptr };
+    size_t m_size { 0 };
+};
+
+}
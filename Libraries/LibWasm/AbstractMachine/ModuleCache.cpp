@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/Memory.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Authentication/HMAC.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibCrypto/SecureRandom.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+namespace Wasm {
+
+static constexpr u32 module_cache_magic = 0x43564d57; // "WMVC"
+static constexpr u32 module_cache_format_version = 2;
+static constexpr size_t module_cache_secret_size = 32;
+
+ModuleCache::KeyBuilder::KeyBuilder()
+    : m_hasher(Crypto::Hash::SHA256::create())
+{
+}
+
+ModuleCache::KeyBuilder::~KeyBuilder() = default;
+
+void ModuleCache::KeyBuilder::append(ReadonlyBytes bytes)
+{
+    m_hasher->update(bytes);
+}
+
+ModuleCache::Key ModuleCache::KeyBuilder::finish()
+{
+    auto digest = m_hasher->digest();
+    Key key;
+    digest.bytes().copy_to(key);
+    return key;
+}
+
+static ErrorOr<ByteBuffer> read_secret(StringView path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto secret = TRY(file->read_until_eof());
+    if (secret.size() != module_cache_secret_size)
+        return Error::from_string_literal("Malformed module cache secret");
+    return secret;
+}
+
+static ErrorOr<ByteBuffer> read_or_create_secret(ByteString const& directory)
+{
+    auto path = ByteString::formatted("{}/secret", directory);
+    if (auto secret = read_secret(path); !secret.is_error() || secret.error().code() != ENOENT)
+        return secret;
+
+    auto secret = TRY(ByteBuffer::create_uninitialized(module_cache_secret_size));
+    Crypto::fill_with_secure_random(secret);
+
+    // NOTE: Link a complete file into place, so that concurrent readers never see a partially written secret. If another
+    //       process created one first, that one is used instead.
+    auto temporary_path = ByteString::formatted("{}.{}", path, getpid());
+    auto write = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600));
+        TRY(file->write_until_depleted(secret));
+        file->close();
+        TRY(Core::System::link(temporary_path, path));
+        return {};
+    };
+    auto result = write();
+    (void)Core::System::unlink(temporary_path);
+    if (result.is_error()) {
+        if (result.error().code() == EEXIST)
+            return read_secret(path);
+        return result.release_error();
+    }
+    return secret;
+}
+
+ErrorOr<NonnullOwnPtr<ModuleCache>> ModuleCache::create(ByteString directory)
+{
+    return create(move(directory), Validator::build_identifier());
+}
+
+ErrorOr<NonnullOwnPtr<ModuleCache>> ModuleCache::create(ByteString directory, ByteString build_identifier)
+{
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes, 0700));
+    auto secret = TRY(read_or_create_secret(directory));
+    return adopt_nonnull_own_or_enomem(new (nothrow) ModuleCache(move(directory), move(build_identifier), move(secret)));
+}
+
+ModuleCache::ModuleCache(ByteString directory, ByteString build_identifier, ByteBuffer secret)
+    : m_directory(move(directory))
+    , m_build_identifier(move(build_identifier))
+    , m_secret(move(secret))
+{
+}
+
+ModuleCache::Key ModuleCache::key_for(ReadonlyBytes module_bytes)
+{
+    KeyBuilder builder;
+    builder.append(module_bytes);
+    return builder.finish();
+}
+
+ByteString ModuleCache::path_for(Key const& key) const
+{
+    StringBuilder builder;
+    builder.append(m_directory);
+    builder.append('/');
+    for (auto byte : key)
+        builder.appendff("{:02x}", byte);
+    builder.append(".wasmvc"sv);
+    return builder.to_byte_string();
+}
+
+// Signs the module's key along with the build that validated it. An entry is only trusted if its signature matches.
+ModuleCache::Key ModuleCache::signature_for(Key const& key) const
+{
+    Crypto::Authentication::HMAC hmac(Crypto::Hash::HashKind::SHA256, m_secret);
+    hmac.update(m_build_identifier.view());
+    hmac.update(key.span());
+    auto digest = hmac.digest();
+    Key signature;
+    digest.bytes().copy_to(signature);
+    return signature;
+}
+
+static ErrorOr<void> write_entry(Stream& stream, StringView build_identifier, ModuleCache::Key const& key, ModuleCache::Key const& signature)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(module_cache_magic));
+    TRY(stream.write_value<LittleEndian<u32>>(module_cache_format_version));
+    TRY(stream.write_value<LittleEndian<u32>>(build_identifier.length()));
+    TRY(stream.write_until_depleted(build_identifier.bytes()));
+    TRY(stream.write_until_depleted(key));
+    TRY(stream.write_until_depleted(signature));
+    return {};
+}
+
+static ErrorOr<void> check_entry(ReadonlyBytes data, StringView build_identifier, ModuleCache::Key const& key, ModuleCache::Key const& signature)
+{
+    FixedMemoryStream stream { data };
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != module_cache_magic)
+        return Error::from_string_literal("Not a module cache entry");
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != module_cache_format_version)
+        return Error::from_string_literal("Unsupported format version");
+    auto build_identifier_length = TRY(stream.read_value<LittleEndian<u32>>());
+    if (build_identifier_length != build_identifier.length())
+        return Error::from_string_literal("Written by a different build of the validator");
+    auto stored_build_identifier = TRY(ByteBuffer::create_uninitialized(build_identifier_length));
+    TRY(stream.read_until_filled(stored_build_identifier));
+    if (StringView { stored_build_identifier.bytes() } != build_identifier)
+        return Error::from_string_literal("Written by a different build of the validator");
+    ModuleCache::Key stored_key;
+    TRY(stream.read_until_filled(stored_key));
+    if (stored_key != key)
+        return Error::from_string_literal("Module does not match");
+    ModuleCache::Key stored_signature;
+    TRY(stream.read_until_filled(stored_signature));
+    if (!timing_safe_compare(stored_signature.data(), signature.data(), signature.size()))
+        return Error::from_string_literal("Signature does not match");
+    if (!stream.is_eof())
+        return Error::from_string_literal("Trailing data");
+    return {};
+}
+
+bool ModuleCache::load(Module& module, Key const& key) const
+{
+    if (module.validation_status() != Module::ValidationStatus::Unchecked)
+        return false;
+
+    auto path = path_for(key);
+    auto file = Core::File::open(path, Core::File::OpenMode::Read);
+    if (file.is_error())
+        return false;
+    auto data = file.value()->read_until_eof();
+    if (data.is_error())
+        return false;
+
+    if (auto result = check_entry(data.value(), m_build_identifier, key, signature_for(key)); result.is_error()) {
+        dbgln_if(WASM_VALIDATOR_DEBUG, "ModuleCache: Ignoring {}: {}", path, result.error());
+        return false;
+    }
+
+    dbgln_if(WASM_VALIDATOR_DEBUG, "ModuleCache: Skipping validation of function bodies that were validated before");
+    module.set_function_bodies_validated_by_earlier_run({});
+    return true;
+}
+
+void ModuleCache::store(Module const& module, Key const& key) const
+{
+    if (module.validation_status() != Module::ValidationStatus::Valid)
+        return;
+
+    // NOTE: Write to a temporary file first, so that concurrent readers never see a partially written entry.
+    auto path = path_for(key);
+    auto temporary_path = ByteString::formatted("{}.{}", path, getpid());
+    auto write = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600));
+        TRY(write_entry(*file, m_build_identifier, key, signature_for(key)));
+        file->close();
+        TRY(Core::System::rename(temporary_path, path));
+        return {};
+    };
+    if (auto result = write(); result.is_error()) {
+        dbgln("ModuleCache: Unable to write {}: {}", path, result.error());
+        (void)Core::System::unlink(temporary_path);
+    }
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibWasm/Types.h>
+
+namespace Crypto::Hash {
+
+class SHA256;
+
+}
+
+namespace Wasm {
+
+// An on-disk cache of the modules whose function bodies passed validation, keyed by a hash of their bytes.
+//
+// Only the function bodies are skipped when a module is found in the cache; the rest of the module is cheap to
+// validate, and is validated again every time. Modules are still parsed when they're loaded, as decoding them again is
+// cheap next to validating them.
+//
+// Entries are signed with a secret that's created alongside them, so that a file that was put in the directory by
+// anything other than a ModuleCache holding the same secret is ignored. They also record the build of the validator that
+// accepted the module, so entries from another build are ignored as well.
+class ModuleCache {
+public:
+    using Key = Array<u8, 32>;
+
+    // Computes the key of a module whose bytes arrive in chunks.
+    class KeyBuilder {
+    public:
+        KeyBuilder();
+        ~KeyBuilder();
+
+        void append(ReadonlyBytes);
+        Key finish();
+
+    private:
+        NonnullOwnPtr<Crypto::Hash::SHA256> m_hasher;
+    };
+
+    // Reads the secret from the directory, or creates both if they don't exist yet. Tests can pass another build
+    // identifier to act as a different build of the validator.
+    static ErrorOr<NonnullOwnPtr<ModuleCache>> create(ByteString directory);
+    static ErrorOr<NonnullOwnPtr<ModuleCache>> create(ByteString directory, ByteString build_identifier);
+
+    static Key key_for(ReadonlyBytes module_bytes);
+
+    // Marks the module's function bodies as valid if an earlier validation of the same bytes is stored, and returns
+    // whether it did. The module still has to be validated.
+    bool load(Module&, Key const&) const;
+
+    // Records that the module with this key is valid. Modules that are not known to be valid are not stored.
+    void store(Module const&, Key const&) const;
+
+private:
+    ModuleCache(ByteString directory, ByteString build_identifier, ByteBuffer secret);
+
+    ByteString path_for(Key const&) const;
+    Key signature_for(Key const&) const;
+
+    ByteString m_directory;
+    ByteString m_build_identifier;
+    ByteBuffer m_secret;
+};
+
+}
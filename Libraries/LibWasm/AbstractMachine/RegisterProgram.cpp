@@ -0,0 +1,678 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/RegisterProgram.h>
+#include <LibWasm/Opcode.h>
+#include <LibWasm/Printer/Printer.h>
+
+namespace Wasm {
+
+class RegisterProgramCompiler {
+public:
+    RegisterProgramCompiler(WasmFunction const& function, Store& store)
+        : m_function(function)
+        , m_module(function.module())
+        , m_store(store)
+    {
+    }
+
+    OwnPtr<RegisterProgram> compile();
+
+private:
+    using Op = RegisterProgram::Op;
+
+    enum class FrameKind {
+        Function,
+        Block,
+        Loop,
+        If,
+    };
+
+    struct ControlFrame {
+        FrameKind kind;
+        FunctionType type;
+        size_t entry_height { 0 };
+        u32 entry_register { 0 };
+        size_t loop_start { 0 };
+        Optional<size_t> jump_to_else;
+        Vector<size_t> jumps_to_end;
+
+        Vector<ValueType> const& branch_types() const { return kind == FrameKind::Loop ? type.parameters() : type.results(); }
+    };
+
+    // A value on the stack. Its stack slot starts at `home`, but values that were read from a local stay in the local's
+    // registers (starting at `reg`) until something needs them in their slot.
+    struct Operand {
+        u32 reg;
+        u32 home;
+        u32 width;
+    };
+
+    bool compile_instruction(Instruction const&);
+    bool skip_unreachable_instruction(Instruction const&);
+
+    Optional<FunctionType> block_type(BlockType const&) const;
+
+    size_t height() const { return m_operands.size(); }
+    u32 next_home() const { return m_operands.is_empty() ? m_local_register_count : m_operands.last().home + m_operands.last().width; }
+    u32 home_at(size_t height) const { return height < this->height() ? m_operands[height].home : next_home(); }
+
+    size_t emit(Op op, u32 dst = 0, u32 lhs = 0, u32 rhs = 0, u64 immediate = 0)
+    {
+        m_instructions.append({ op, dst, lhs, rhs, immediate });
+        return m_instructions.size() - 1;
+    }
+
+    size_t here() const { return m_instructions.size(); }
+    void bind_label_here() { m_label_position = here(); }
+    void patch_jump(size_t jump, size_t target) { m_instructions[jump].immediate = target; }
+
+    u32 push(u32 width = 1);
+    void push(ValueType type) { push(registers_for(type)); }
+    void push_local(u32 local);
+    u32 pop() { return m_operands.take_last().reg; }
+    void materialize(size_t height);
+    void materialize_all();
+    void materialize_top(size_t count);
+    void materialize_local(u32 local);
+    void reset_operands(size_t height, Vector<ValueType> const& pushed_types);
+    void set_local(u32 local);
+    void emit_move(u32 destination, u32 source, u32 width) { emit(width == 2 ? Op::MoveWide : Op::Move, destination, source); }
+
+    void emit_branch_moves(ControlFrame const&);
+    void emit_branch(size_t depth);
+    void emit_conditional_branch(size_t depth, u32 condition);
+    void enter_frame(FrameKind, FunctionType const&);
+    void end_frame();
+
+    WasmFunction const& m_function;
+    ModuleInstance const& m_module;
+    Store& m_store;
+
+    Vector<RegisterProgram::Instruction> m_instructions;
+    Vector<u32> m_branch_table;
+    Vector<ControlFrame> m_frames;
+
+    Vector<Operand> m_operands;
+
+    Vector<ValueType> m_local_types;
+    Vector<u32> m_local_registers;
+    u32 m_local_register_count { 0 };
+    u32 m_max_register_count { 0 };
+    size_t m_unreachable_depth { 0 };
+    bool m_unreachable { false };
+    Optional<size_t> m_label_position;
+};
+
+static bool writes_only_dst(RegisterProgram::Op op)
+{
+    using Op = RegisterProgram::Op;
+    switch (op) {
+    case Op::Jump:
+    case Op::JumpIfZero:
+    case Op::JumpIfNotZero:
+    case Op::BranchTable:
+    case Op::Return:
+    case Op::Unreachable:
+    case Op::Call:
+    case Op::CallIndirect:
+    case Op::GlobalSet:
+    case Op::TableSet:
+#define __ENUMERATE_STORE(name, ...) case Op::name:
+        ENUMERATE_WASM_REGISTER_STORE_OPS(__ENUMERATE_STORE)
+#undef __ENUMERATE_STORE
+        return false;
+    default:
+        return true;
+    }
+}
+
+Optional<FunctionType> RegisterProgramCompiler::block_type(BlockType const& type) const
+{
+    switch (type.kind()) {
+    case BlockType::Empty:
+        return FunctionType { {}, {} };
+    case BlockType::Type:
+        return FunctionType { {}, { type.value_type() } };
+    case BlockType::Index:
+        if (type.type_index().value() >= m_module.types().size())
+            return {};
+        return m_module.types()[type.type_index().value()];
+    }
+    VERIFY_NOT_REACHED();
+}
+
+u32 RegisterProgramCompiler::push(u32 width)
+{
+    auto home = next_home();
+    m_operands.append({ home, home, width });
+    m_max_register_count = max(m_max_register_count, home + width);
+    return home;
+}
+
+void RegisterProgramCompiler::push_local(u32 local)
+{
+    auto home = next_home();
+    auto width = registers_for(m_local_types[local]);
+    m_operands.append({ m_local_registers[local], home, width });
+    m_max_register_count = max(m_max_register_count, home + width);
+}
+
+void RegisterProgramCompiler::materialize(size_t height)
+{
+    auto& operand = m_operands[height];
+    if (operand.reg == operand.home)
+        return;
+    emit_move(operand.home, operand.reg, operand.width);
+    operand.reg = operand.home;
+}
+
+void RegisterProgramCompiler::materialize_all()
+{
+    for (size_t i = 0; i < height(); ++i)
+        materialize(i);
+}
+
+void RegisterProgramCompiler::materialize_top(size_t count)
+{
+    for (size_t i = height() - count; i < height(); ++i)
+        materialize(i);
+}
+
+void RegisterProgramCompiler::materialize_local(u32 local)
+{
+    auto reg = m_local_registers[local];
+    for (size_t i = 0; i < height(); ++i) {
+        if (m_operands[i].reg == reg)
+            materialize(i);
+    }
+}
+
+// The values below `height` are left where they are, as nothing in a block can touch the values below it.
+void RegisterProgramCompiler::reset_operands(size_t height, Vector<ValueType> const& pushed_types)
+{
+    m_operands.shrink(height);
+    for (auto type : pushed_types)
+        push(type);
+}
+
+void RegisterProgramCompiler::set_local(u32 local)
+{
+    auto reg = m_local_registers[local];
+    auto value = m_operands.last();
+    if (value.reg == reg) {
+        pop();
+        return;
+    }
+
+    bool local_is_on_stack = false;
+    for (size_t i = 0; i < height() - 1; ++i)
+        local_is_on_stack |= m_operands[i].reg == reg;
+
+    // `<op>; local.set x` becomes `<op>` writing straight into x, as long as nothing jumps in between the two, and
+    // nothing on the stack still needs the old value of x.
+    if (value.reg == value.home && !local_is_on_stack && !m_instructions.is_empty() && m_label_position != here()) {
+        auto& last = m_instructions.last();
+        if (writes_only_dst(last.op) && last.dst == value.reg) {
+            last.dst = reg;
+            pop();
+            return;
+        }
+    }
+
+    materialize_local(local);
+    emit_move(reg, pop(), value.width);
+}
+
+void RegisterProgramCompiler::emit_branch_moves(ControlFrame const& frame)
+{
+    auto arity = frame.branch_types().size();
+    auto destination = frame.entry_register;
+    for (size_t i = 0; i < arity; ++i) {
+        auto const& source = m_operands[height() - arity + i];
+        if (source.reg != destination)
+            emit_move(destination, source.reg, source.width);
+        destination += source.width;
+    }
+}
+
+void RegisterProgramCompiler::emit_branch(size_t depth)
+{
+    auto& frame = m_frames[m_frames.size() - 1 - depth];
+    emit_branch_moves(frame);
+    if (frame.kind == FrameKind::Loop) {
+        emit(Op::Jump, 0, 0, 0, frame.loop_start);
+        return;
+    }
+    frame.jumps_to_end.append(emit(Op::Jump));
+}
+
+void RegisterProgramCompiler::emit_conditional_branch(size_t depth, u32 condition)
+{
+    auto& frame = m_frames[m_frames.size() - 1 - depth];
+    auto arity = frame.branch_types().size();
+
+    bool needs_moves = false;
+    auto destination = frame.entry_register;
+    for (size_t i = 0; i < arity; ++i) {
+        auto const& source = m_operands[height() - arity + i];
+        needs_moves |= source.reg != destination;
+        destination += source.width;
+    }
+
+    if (!needs_moves) {
+        auto jump = emit(Op::JumpIfNotZero, 0, condition, 0, frame.kind == FrameKind::Loop ? frame.loop_start : 0);
+        if (frame.kind != FrameKind::Loop)
+            frame.jumps_to_end.append(jump);
+        return;
+    }
+
+    auto skip = emit(Op::JumpIfZero, 0, condition);
+    emit_branch(depth);
+    patch_jump(skip, here());
+    bind_label_here();
+}
+
+void RegisterProgramCompiler::enter_frame(FrameKind kind, FunctionType const& type)
+{
+    // Values below the block's parameters may alias locals that the block writes to, and the block's code has to find
+    // its parameters in their slots no matter how it was entered.
+    materialize_all();
+
+    ControlFrame frame { .kind = kind, .type = type };
+    frame.entry_height = height() - type.parameters().size();
+    frame.entry_register = home_at(frame.entry_height);
+    if (kind == FrameKind::Loop) {
+        frame.loop_start = here();
+        bind_label_here();
+    }
+    m_frames.append(move(frame));
+}
+
+void RegisterProgramCompiler::end_frame()
+{
+    auto frame = m_frames.take_last();
+    bool reachable = !m_unreachable;
+
+    if (reachable)
+        materialize_all();
+
+    if (frame.jump_to_else.has_value()) {
+        // An `if` without an `else` falls through to its end when the condition is false.
+        patch_jump(*frame.jump_to_else, here());
+        reachable = true;
+    }
+    for (auto jump : frame.jumps_to_end)
+        patch_jump(jump, here());
+    if (!frame.jumps_to_end.is_empty())
+        reachable = true;
+    bind_label_here();
+
+    m_unreachable = !reachable;
+    if (reachable)
+        reset_operands(frame.entry_height, frame.type.results());
+
+    if (frame.kind == FrameKind::Function && reachable) {
+        emit(Op::Return);
+        m_unreachable = true;
+    }
+}
+
+bool RegisterProgramCompiler::skip_unreachable_instruction(Instruction const& instruction)
+{
+    switch (instruction.opcode().value()) {
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::if_.value():
+        ++m_unreachable_depth;
+        return true;
+    case Instructions::structured_else.value():
+        return m_unreachable_depth > 0;
+    case Instructions::structured_end.value():
+        if (m_unreachable_depth == 0)
+            return false;
+        --m_unreachable_depth;
+        return true;
+    default:
+        return true;
+    }
+}
+
+bool RegisterProgramCompiler::compile_instruction(Instruction const& instruction)
+{
+    auto opcode = instruction.opcode();
+
+    switch (opcode.value()) {
+    case Instructions::unreachable.value():
+        emit(Op::Unreachable);
+        m_unreachable = true;
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::if_.value(): {
+        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+        auto type = block_type(args.block_type);
+        if (!type.has_value())
+            return false;
+
+        if (opcode == Instructions::if_) {
+            auto condition = pop();
+            materialize_all();
+            auto jump = emit(Op::JumpIfZero, 0, condition);
+            enter_frame(FrameKind::If, *type);
+            m_frames.last().jump_to_else = jump;
+            return true;
+        }
+
+        enter_frame(opcode == Instructions::loop ? FrameKind::Loop : FrameKind::Block, *type);
+        return true;
+    }
+    case Instructions::structured_else.value(): {
+        auto& frame = m_frames.last();
+        if (!m_unreachable) {
+            materialize_all();
+            frame.jumps_to_end.append(emit(Op::Jump));
+        }
+        patch_jump(*frame.jump_to_else, here());
+        bind_label_here();
+        frame.jump_to_else.clear();
+        m_unreachable = false;
+        reset_operands(frame.entry_height, frame.type.parameters());
+        return true;
+    }
+    case Instructions::structured_end.value():
+        end_frame();
+        return true;
+    case Instructions::br.value():
+        emit_branch(instruction.arguments().get<LabelIndex>().value());
+        m_unreachable = true;
+        return true;
+    case Instructions::br_if.value():
+        emit_conditional_branch(instruction.arguments().get<LabelIndex>().value(), pop());
+        return true;
+    case Instructions::br_table.value(): {
+        auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto index = pop();
+        emit(Op::BranchTable, 0, index, args.labels.size(), m_branch_table.size());
+        auto first_entry = m_branch_table.size();
+        m_branch_table.resize(first_entry + args.labels.size() + 1);
+
+        // Every entry gets a stub that moves the results in place and jumps to the target.
+        for (size_t i = 0; i <= args.labels.size(); ++i) {
+            m_branch_table[first_entry + i] = here();
+            bind_label_here();
+            emit_branch(i < args.labels.size() ? args.labels[i].value() : args.default_.value());
+        }
+        m_unreachable = true;
+        return true;
+    }
+    case Instructions::return_.value():
+        emit_branch_moves(m_frames.first());
+        emit(Op::Return);
+        m_unreachable = true;
+        return true;
+    case Instructions::call.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>().value();
+        if (index >= m_module.functions().size())
+            return false;
+        auto* callee = m_store.get(m_module.functions()[index]);
+        if (!callee)
+            return false;
+        auto const& type = callee->visit([](auto const& function) -> FunctionType const& { return function.type(); });
+
+        materialize_top(type.parameters().size());
+        auto first_argument = height() - type.parameters().size();
+        emit(Op::Call, home_at(first_argument), 0, 0, index);
+        reset_operands(first_argument, type.results());
+        return true;
+    }
+    case Instructions::call_indirect.value(): {
+        auto& args = instruction.arguments().get<Instruction::IndirectCallArgs>();
+        if (args.type.value() >= m_module.types().size())
+            return false;
+        auto const& type = m_module.types()[args.type.value()];
+
+        auto index = pop();
+        materialize_top(type.parameters().size());
+        auto first_argument = height() - type.parameters().size();
+        emit(Op::CallIndirect, home_at(first_argument), index, 0, (static_cast<u64>(args.table.value()) << 32) | args.type.value());
+        reset_operands(first_argument, type.results());
+        return true;
+    }
+    case Instructions::drop.value():
+        pop();
+        return true;
+    case Instructions::select.value():
+    case Instructions::select_typed.value(): {
+        auto condition = pop();
+        auto rhs = pop();
+        auto width = m_operands.last().width;
+        auto lhs = pop();
+        emit(width == 2 ? Op::SelectWide : Op::Select, push(width), lhs, rhs, condition);
+        return true;
+    }
+    case Instructions::local_get.value():
+        push_local(instruction.arguments().get<LocalIndex>().value());
+        return true;
+    case Instructions::local_set.value():
+        set_local(instruction.arguments().get<LocalIndex>().value());
+        return true;
+    case Instructions::local_tee.value(): {
+        auto local = instruction.arguments().get<LocalIndex>().value();
+        set_local(local);
+        push_local(local);
+        return true;
+    }
+    case Instructions::global_get.value():
+    case Instructions::global_set.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (index >= m_module.globals().size())
+            return false;
+        auto* global = m_store.get(m_module.globals()[index]);
+        if (!global)
+            return false;
+        if (opcode == Instructions::global_get)
+            emit(Op::GlobalGet, push(registers_for(global->type().type())), 0, 0, index);
+        else
+            emit(Op::GlobalSet, 0, pop(), 0, index);
+        return true;
+    }
+    case Instructions::memory_size.value():
+    case Instructions::memory_grow.value(): {
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        if (opcode == Instructions::memory_size) {
+            emit(Op::MemorySize, push());
+        } else {
+            auto pages = pop();
+            emit(Op::MemoryGrow, push(), pages);
+        }
+        return true;
+    }
+    case Instructions::i32_const.value():
+        emit(Op::Const, push(), 0, 0, static_cast<u64>(static_cast<i64>(instruction.arguments().get<i32>())));
+        return true;
+    case Instructions::i64_const.value():
+        emit(Op::Const, push(), 0, 0, bit_cast<u64>(instruction.arguments().get<i64>()));
+        return true;
+    case Instructions::f32_const.value():
+        emit(Op::Const, push(), 0, 0, static_cast<u64>(static_cast<i64>(bit_cast<i32>(instruction.arguments().get<float>()))));
+        return true;
+    case Instructions::f64_const.value():
+        emit(Op::Const, push(), 0, 0, bit_cast<u64>(instruction.arguments().get<double>()));
+        return true;
+    case Instructions::v128_const.value(): {
+        auto value = instruction.arguments().get<u128>();
+        auto dst = push(2);
+        emit(Op::Const, dst, 0, 0, value.low());
+        emit(Op::Const, dst + 1, 0, 0, value.high());
+        return true;
+    }
+    case Instructions::ref_null.value(): {
+        auto value = Value(instruction.arguments().get<ValueType>()).value();
+        auto dst = push(2);
+        emit(Op::Const, dst, 0, 0, value.low());
+        emit(Op::Const, dst + 1, 0, 0, value.high());
+        return true;
+    }
+    case Instructions::ref_func.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>().value();
+        if (index >= m_module.functions().size())
+            return false;
+        auto address = m_module.functions()[index];
+        auto value = Value(Reference { Reference::Func { address, m_store.get_module_for(address) } }).value();
+        auto dst = push(2);
+        emit(Op::Const, dst, 0, 0, value.low());
+        emit(Op::Const, dst + 1, 0, 0, value.high());
+        return true;
+    }
+    case Instructions::ref_is_null.value(): {
+        auto reference = pop();
+        emit(Op::RefIsNull, push(), reference);
+        return true;
+    }
+    case Instructions::table_get.value():
+    case Instructions::table_set.value(): {
+        auto table = instruction.arguments().get<TableIndex>().value();
+        if (table >= m_module.tables().size())
+            return false;
+        if (opcode == Instructions::table_get) {
+            auto index = pop();
+            emit(Op::TableGet, push(2), index, 0, table);
+        } else {
+            auto reference = pop();
+            auto index = pop();
+            emit(Op::TableSet, 0, index, reference, table);
+        }
+        return true;
+    }
+
+#define __COMPILE_LOAD(name, ReadType, PushType)                                     \
+    case Instructions::name.value(): {                                               \
+        auto& args = instruction.arguments().get<Instruction::MemoryArgument>();     \
+        if (args.memory_index.value() != 0)                                          \
+            return false;                                                            \
+        auto address = pop();                                                        \
+        emit(Op::name, push(registers_for<PushType>()), address, 0, args.offset);    \
+        return true;                                                                 \
+    }
+        ENUMERATE_WASM_REGISTER_LOAD_OPS(__COMPILE_LOAD)
+#undef __COMPILE_LOAD
+
+#define __COMPILE_STORE(name, ...)                                               \
+    case Instructions::name.value(): {                                           \
+        auto& args = instruction.arguments().get<Instruction::MemoryArgument>(); \
+        if (args.memory_index.value() != 0)                                      \
+            return false;                                                        \
+        auto value = pop();                                                      \
+        auto address = pop();                                                    \
+        emit(Op::name, 0, address, value, args.offset);                          \
+        return true;                                                             \
+    }
+        ENUMERATE_WASM_REGISTER_STORE_OPS(__COMPILE_STORE)
+#undef __COMPILE_STORE
+
+#define __COMPILE_UNARY(name, PopType, PushType, ...)                 \
+    case Instructions::name.value(): {                                \
+        auto operand = pop();                                         \
+        emit(Op::name, push(registers_for<PushType>()), operand);     \
+        return true;                                                  \
+    }
+        ENUMERATE_WASM_REGISTER_UNARY_OPS(__COMPILE_UNARY)
+        ENUMERATE_WASM_REGISTER_VECTOR_UNARY_OPS(__COMPILE_UNARY)
+#undef __COMPILE_UNARY
+
+#define __COMPILE_BINARY(name, PopType, PushType, ...)               \
+    case Instructions::name.value(): {                               \
+        auto rhs = pop();                                            \
+        auto lhs = pop();                                            \
+        emit(Op::name, push(registers_for<PushType>()), lhs, rhs);   \
+        return true;                                                 \
+    }
+        ENUMERATE_WASM_REGISTER_BINARY_OPS(__COMPILE_BINARY)
+        ENUMERATE_WASM_REGISTER_VECTOR_BINARY_OPS(__COMPILE_BINARY)
+#undef __COMPILE_BINARY
+
+#define __COMPILE_VECTOR_SHIFT(name, ...)    \
+    case Instructions::name.value(): {       \
+        auto rhs = pop();                    \
+        auto lhs = pop();                    \
+        emit(Op::name, push(2), lhs, rhs);   \
+        return true;                         \
+    }
+        ENUMERATE_WASM_REGISTER_VECTOR_SHIFT_OPS(__COMPILE_VECTOR_SHIFT)
+#undef __COMPILE_VECTOR_SHIFT
+
+    default:
+        dbgln_if(WASM_TRACE_DEBUG, "Not lowering function to registers, because of {}", instruction_name(opcode));
+        return false;
+    }
+}
+
+OwnPtr<RegisterProgram> RegisterProgramCompiler::compile()
+{
+    auto const& type = m_function.type();
+
+    size_t local_count = type.parameters().size();
+    for (auto& locals : m_function.code().func().locals())
+        local_count += locals.n();
+    if (local_count > NumericLimits<u32>::max() / 4)
+        return nullptr;
+
+    m_local_types.ensure_capacity(local_count);
+    m_local_types.extend(type.parameters());
+    for (auto& locals : m_function.code().func().locals()) {
+        for (size_t i = 0; i < locals.n(); ++i)
+            m_local_types.append(locals.type());
+    }
+    m_local_registers.ensure_capacity(local_count);
+    size_t parameter_register_count = 0;
+    for (size_t i = 0; i < m_local_types.size(); ++i) {
+        if (i == type.parameters().size())
+            parameter_register_count = m_local_register_count;
+        m_local_registers.append(m_local_register_count);
+        m_local_register_count += registers_for(m_local_types[i]);
+    }
+    if (type.parameters().size() == m_local_types.size())
+        parameter_register_count = m_local_register_count;
+    m_max_register_count = m_local_register_count;
+
+    m_frames.append({ .kind = FrameKind::Function, .type = FunctionType { {}, type.results() }, .entry_register = m_local_register_count });
+
+    for (auto& instruction : m_function.code().func().body().instructions()) {
+        if (m_unreachable && skip_unreachable_instruction(instruction))
+            continue;
+        if (!compile_instruction(instruction))
+            return nullptr;
+    }
+
+    // The function body does not include its final `end`.
+    end_frame();
+    VERIFY(m_frames.is_empty());
+
+    auto program = adopt_own(*new RegisterProgram);
+    program->m_instructions = move(m_instructions);
+    program->m_branch_table = move(m_branch_table);
+    program->m_local_types = move(m_local_types);
+    program->m_result_types = type.results();
+    program->m_local_register_count = m_local_register_count;
+    program->m_parameter_register_count = parameter_register_count;
+    for (auto result : type.results())
+        program->m_result_register_count += registers_for(result);
+    program->m_register_count = m_max_register_count;
+    return program;
+}
+
+OwnPtr<RegisterProgram> RegisterProgram::compile(WasmFunction const& function, Store& store)
+{
+    return RegisterProgramCompiler { function, store }.compile();
+}
+
+}
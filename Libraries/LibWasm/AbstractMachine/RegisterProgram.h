@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+class Store;
+class WasmFunction;
+
+// M(name, PopType, PushType, Operator), for the operators that take a single operand.
+#define ENUMERATE_WASM_REGISTER_UNARY_OPS(M)                                 \
+    M(i32_eqz, i32, i32, Operators::EqualsZero)                              \
+    M(i64_eqz, i64, i32, Operators::EqualsZero)                              \
+    M(i32_clz, i32, i32, Operators::CountLeadingZeros)                       \
+    M(i32_ctz, i32, i32, Operators::CountTrailingZeros)                      \
+    M(i32_popcnt, i32, i32, Operators::PopCount)                             \
+    M(i64_clz, i64, i64, Operators::CountLeadingZeros)                       \
+    M(i64_ctz, i64, i64, Operators::CountTrailingZeros)                      \
+    M(i64_popcnt, i64, i64, Operators::PopCount)                             \
+    M(f32_abs, float, float, Operators::Absolute)                            \
+    M(f32_neg, float, float, Operators::Negate)                              \
+    M(f32_ceil, float, float, Operators::Ceil)                               \
+    M(f32_floor, float, float, Operators::Floor)                             \
+    M(f32_trunc, float, float, Operators::Truncate)                          \
+    M(f32_nearest, float, float, Operators::NearbyIntegral)                  \
+    M(f32_sqrt, float, float, Operators::SquareRoot)                         \
+    M(f64_abs, double, double, Operators::Absolute)                          \
+    M(f64_neg, double, double, Operators::Negate)                            \
+    M(f64_ceil, double, double, Operators::Ceil)                             \
+    M(f64_floor, double, double, Operators::Floor)                           \
+    M(f64_trunc, double, double, Operators::Truncate)                        \
+    M(f64_nearest, double, double, Operators::NearbyIntegral)                \
+    M(f64_sqrt, double, double, Operators::SquareRoot)                       \
+    M(i32_wrap_i64, i64, i32, Operators::Wrap<i32>)                          \
+    M(i32_trunc_sf32, float, i32, Operators::CheckedTruncate<i32>)           \
+    M(i32_trunc_uf32, float, i32, Operators::CheckedTruncate<u32>)           \
+    M(i32_trunc_sf64, double, i32, Operators::CheckedTruncate<i32>)          \
+    M(i32_trunc_uf64, double, i32, Operators::CheckedTruncate<u32>)          \
+    M(i64_trunc_sf32, float, i64, Operators::CheckedTruncate<i64>)           \
+    M(i64_trunc_uf32, float, i64, Operators::CheckedTruncate<u64>)           \
+    M(i64_trunc_sf64, double, i64, Operators::CheckedTruncate<i64>)          \
+    M(i64_trunc_uf64, double, i64, Operators::CheckedTruncate<u64>)          \
+    M(i64_extend_si32, i32, i64, Operators::Extend<i64>)                     \
+    M(i64_extend_ui32, u32, i64, Operators::Extend<i64>)                     \
+    M(f32_convert_si32, i32, float, Operators::Convert<float>)               \
+    M(f32_convert_ui32, u32, float, Operators::Convert<float>)               \
+    M(f32_convert_si64, i64, float, Operators::Convert<float>)               \
+    M(f32_convert_ui64, u64, float, Operators::Convert<float>)               \
+    M(f32_demote_f64, double, float, Operators::Demote)                      \
+    M(f64_convert_si32, i32, double, Operators::Convert<double>)             \
+    M(f64_convert_ui32, u32, double, Operators::Convert<double>)             \
+    M(f64_convert_si64, i64, double, Operators::Convert<double>)             \
+    M(f64_convert_ui64, u64, double, Operators::Convert<double>)             \
+    M(f64_promote_f32, float, double, Operators::Promote)                    \
+    M(i32_reinterpret_f32, float, i32, Operators::Reinterpret<i32>)          \
+    M(i64_reinterpret_f64, double, i64, Operators::Reinterpret<i64>)         \
+    M(f32_reinterpret_i32, i32, float, Operators::Reinterpret<float>)        \
+    M(f64_reinterpret_i64, i64, double, Operators::Reinterpret<double>)      \
+    M(i32_extend8_s, i32, i32, Operators::SignExtend<i8>)                    \
+    M(i32_extend16_s, i32, i32, Operators::SignExtend<i16>)                  \
+    M(i64_extend8_s, i64, i64, Operators::SignExtend<i8>)                    \
+    M(i64_extend16_s, i64, i64, Operators::SignExtend<i16>)                  \
+    M(i64_extend32_s, i64, i64, Operators::SignExtend<i32>)                  \
+    M(i32_trunc_sat_f32_s, float, i32, Operators::SaturatingTruncate<i32>)   \
+    M(i32_trunc_sat_f32_u, float, i32, Operators::SaturatingTruncate<u32>)   \
+    M(i32_trunc_sat_f64_s, double, i32, Operators::SaturatingTruncate<i32>)  \
+    M(i32_trunc_sat_f64_u, double, i32, Operators::SaturatingTruncate<u32>)  \
+    M(i64_trunc_sat_f32_s, float, i64, Operators::SaturatingTruncate<i64>)   \
+    M(i64_trunc_sat_f32_u, float, i64, Operators::SaturatingTruncate<u64>)   \
+    M(i64_trunc_sat_f64_s, double, i64, Operators::SaturatingTruncate<i64>)  \
+    M(i64_trunc_sat_f64_u, double, i64, Operators::SaturatingTruncate<u64>)
+
+// M(name, PopType, PushType, Operator), for the operators that take two operands of the same type.
+#define ENUMERATE_WASM_REGISTER_BINARY_OPS(M)                     \
+    M(i32_eq, i32, i32, Operators::Equals)                        \
+    M(i32_ne, i32, i32, Operators::NotEquals)                     \
+    M(i32_lts, i32, i32, Operators::LessThan)                     \
+    M(i32_ltu, u32, i32, Operators::LessThan)                     \
+    M(i32_gts, i32, i32, Operators::GreaterThan)                  \
+    M(i32_gtu, u32, i32, Operators::GreaterThan)                  \
+    M(i32_les, i32, i32, Operators::LessThanOrEquals)             \
+    M(i32_leu, u32, i32, Operators::LessThanOrEquals)             \
+    M(i32_ges, i32, i32, Operators::GreaterThanOrEquals)          \
+    M(i32_geu, u32, i32, Operators::GreaterThanOrEquals)          \
+    M(i64_eq, i64, i32, Operators::Equals)                        \
+    M(i64_ne, i64, i32, Operators::NotEquals)                     \
+    M(i64_lts, i64, i32, Operators::LessThan)                     \
+    M(i64_ltu, u64, i32, Operators::LessThan)                     \
+    M(i64_gts, i64, i32, Operators::GreaterThan)                  \
+    M(i64_gtu, u64, i32, Operators::GreaterThan)                  \
+    M(i64_les, i64, i32, Operators::LessThanOrEquals)             \
+    M(i64_leu, u64, i32, Operators::LessThanOrEquals)             \
+    M(i64_ges, i64, i32, Operators::GreaterThanOrEquals)          \
+    M(i64_geu, u64, i32, Operators::GreaterThanOrEquals)          \
+    M(f32_eq, float, i32, Operators::Equals)                      \
+    M(f32_ne, float, i32, Operators::NotEquals)                   \
+    M(f32_lt, float, i32, Operators::LessThan)                    \
+    M(f32_gt, float, i32, Operators::GreaterThan)                 \
+    M(f32_le, float, i32, Operators::LessThanOrEquals)            \
+    M(f32_ge, float, i32, Operators::GreaterThanOrEquals)         \
+    M(f64_eq, double, i32, Operators::Equals)                     \
+    M(f64_ne, double, i32, Operators::NotEquals)                  \
+    M(f64_lt, double, i32, Operators::LessThan)                   \
+    M(f64_gt, double, i32, Operators::GreaterThan)                \
+    M(f64_le, double, i32, Operators::LessThanOrEquals)           \
+    M(f64_ge, double, i32, Operators::GreaterThanOrEquals)        \
+    M(i32_add, u32, i32, Operators::Add)                          \
+    M(i32_sub, u32, i32, Operators::Subtract)                     \
+    M(i32_mul, u32, i32, Operators::Multiply)                     \
+    M(i32_divs, i32, i32, Operators::Divide)                      \
+    M(i32_divu, u32, i32, Operators::Divide)                      \
+    M(i32_rems, i32, i32, Operators::Modulo)                      \
+    M(i32_remu, u32, i32, Operators::Modulo)                      \
+    M(i32_and, i32, i32, Operators::BitAnd)                       \
+    M(i32_or, i32, i32, Operators::BitOr)                         \
+    M(i32_xor, i32, i32, Operators::BitXor)                       \
+    M(i32_shl, u32, i32, Operators::BitShiftLeft)                 \
+    M(i32_shrs, i32, i32, Operators::BitShiftRight)               \
+    M(i32_shru, u32, i32, Operators::BitShiftRight)               \
+    M(i32_rotl, u32, i32, Operators::BitRotateLeft)               \
+    M(i32_rotr, u32, i32, Operators::BitRotateRight)              \
+    M(i64_add, u64, i64, Operators::Add)                          \
+    M(i64_sub, u64, i64, Operators::Subtract)                     \
+    M(i64_mul, u64, i64, Operators::Multiply)                     \
+    M(i64_divs, i64, i64, Operators::Divide)                      \
+    M(i64_divu, u64, i64, Operators::Divide)                      \
+    M(i64_rems, i64, i64, Operators::Modulo)                      \
+    M(i64_remu, u64, i64, Operators::Modulo)                      \
+    M(i64_and, i64, i64, Operators::BitAnd)                       \
+    M(i64_or, i64, i64, Operators::BitOr)                         \
+    M(i64_xor, i64, i64, Operators::BitXor)                       \
+    M(i64_shl, u64, i64, Operators::BitShiftLeft)                 \
+    M(i64_shrs, i64, i64, Operators::BitShiftRight)               \
+    M(i64_shru, u64, i64, Operators::BitShiftRight)               \
+    M(i64_rotl, u64, i64, Operators::BitRotateLeft)               \
+    M(i64_rotr, u64, i64, Operators::BitRotateRight)              \
+    M(f32_add, float, float, Operators::Add)                      \
+    M(f32_sub, float, float, Operators::Subtract)                 \
+    M(f32_mul, float, float, Operators::Multiply)                 \
+    M(f32_div, float, float, Operators::Divide)                   \
+    M(f32_min, float, float, Operators::Minimum)                  \
+    M(f32_max, float, float, Operators::Maximum)                  \
+    M(f32_copysign, float, float, Operators::CopySign)            \
+    M(f64_add, double, double, Operators::Add)                    \
+    M(f64_sub, double, double, Operators::Subtract)               \
+    M(f64_mul, double, double, Operators::Multiply)               \
+    M(f64_div, double, double, Operators::Divide)                 \
+    M(f64_min, double, double, Operators::Minimum)                \
+    M(f64_max, double, double, Operators::Maximum)                \
+    M(f64_copysign, double, double, Operators::CopySign)
+
+// M(name, PopType, PushType, Operator...), for the vector operators that take a single operand.
+#define ENUMERATE_WASM_REGISTER_VECTOR_UNARY_OPS(M)                                                                             \
+    M(i8x16_abs, u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::Absolute>)                                          \
+    M(i8x16_neg, u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::Negate>)                                            \
+    M(i8x16_all_true, u128, i32, Operators::VectorAllTrue<16>)                                                                  \
+    M(i8x16_popcnt, u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::PopCount>)                                       \
+    M(i16x8_abs, u128, u128, Operators::VectorIntegerUnaryOp<8, Operators::Absolute>)                                           \
+    M(i16x8_neg, u128, u128, Operators::VectorIntegerUnaryOp<8, Operators::Negate>)                                             \
+    M(i16x8_all_true, u128, i32, Operators::VectorAllTrue<8>)                                                                   \
+    M(i16x8_extend_low_i8x16_s, u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::Low, MakeSigned>)              \
+    M(i16x8_extend_high_i8x16_s, u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::High, MakeSigned>)            \
+    M(i16x8_extend_low_i8x16_u, u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::Low, MakeUnsigned>)            \
+    M(i16x8_extend_high_i8x16_u, u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::High, MakeUnsigned>)          \
+    M(i16x8_extadd_pairwise_i8x16_s, u128, u128, Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeSigned>)          \
+    M(i16x8_extadd_pairwise_i8x16_u, u128, u128, Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeUnsigned>)        \
+    M(i32x4_abs, u128, u128, Operators::VectorIntegerUnaryOp<4, Operators::Absolute>)                                           \
+    M(i32x4_neg, u128, u128, Operators::VectorIntegerUnaryOp<4, Operators::Negate, MakeUnsigned>)                               \
+    M(i32x4_all_true, u128, i32, Operators::VectorAllTrue<4>)                                                                   \
+    M(i32x4_extend_low_i16x8_s, u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::Low, MakeSigned>)              \
+    M(i32x4_extend_high_i16x8_s, u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::High, MakeSigned>)            \
+    M(i32x4_extend_low_i16x8_u, u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::Low, MakeUnsigned>)            \
+    M(i32x4_extend_high_i16x8_u, u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::High, MakeUnsigned>)          \
+    M(i32x4_extadd_pairwise_i16x8_s, u128, u128, Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeSigned>)          \
+    M(i32x4_extadd_pairwise_i16x8_u, u128, u128, Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeUnsigned>)        \
+    M(i64x2_abs, u128, u128, Operators::VectorIntegerUnaryOp<2, Operators::Absolute>)                                           \
+    M(i64x2_neg, u128, u128, Operators::VectorIntegerUnaryOp<2, Operators::Negate, MakeUnsigned>)                               \
+    M(i64x2_all_true, u128, i32, Operators::VectorAllTrue<2>)                                                                   \
+    M(i64x2_extend_low_i32x4_s, u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::Low, MakeSigned>)              \
+    M(i64x2_extend_high_i32x4_s, u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::High, MakeSigned>)            \
+    M(i64x2_extend_low_i32x4_u, u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::Low, MakeUnsigned>)            \
+    M(i64x2_extend_high_i32x4_u, u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::High, MakeUnsigned>)          \
+    M(f32x4_ceil, u128, u128, Operators::VectorFloatUnaryOp<4, Operators::Ceil>)                                                \
+    M(f32x4_floor, u128, u128, Operators::VectorFloatUnaryOp<4, Operators::Floor>)                                              \
+    M(f32x4_trunc, u128, u128, Operators::VectorFloatUnaryOp<4, Operators::Truncate>)                                           \
+    M(f32x4_nearest, u128, u128, Operators::VectorFloatUnaryOp<4, Operators::NearbyIntegral>)                                   \
+    M(f32x4_sqrt, u128, u128, Operators::VectorFloatUnaryOp<4, Operators::SquareRoot>)                                          \
+    M(f32x4_neg, u128, u128, Operators::VectorFloatUnaryOp<4, Operators::Negate>)                                               \
+    M(f32x4_abs, u128, u128, Operators::VectorFloatUnaryOp<4, Operators::Absolute>)                                             \
+    M(f64x2_ceil, u128, u128, Operators::VectorFloatUnaryOp<2, Operators::Ceil>)                                                \
+    M(f64x2_floor, u128, u128, Operators::VectorFloatUnaryOp<2, Operators::Floor>)                                              \
+    M(f64x2_trunc, u128, u128, Operators::VectorFloatUnaryOp<2, Operators::Truncate>)                                           \
+    M(f64x2_nearest, u128, u128, Operators::VectorFloatUnaryOp<2, Operators::NearbyIntegral>)                                   \
+    M(f64x2_sqrt, u128, u128, Operators::VectorFloatUnaryOp<2, Operators::SquareRoot>)                                          \
+    M(f64x2_neg, u128, u128, Operators::VectorFloatUnaryOp<2, Operators::Negate>)                                               \
+    M(f64x2_abs, u128, u128, Operators::VectorFloatUnaryOp<2, Operators::Absolute>)                                             \
+    M(v128_not, u128, u128, Operators::BitNot)                                                                                  \
+    M(i32x4_trunc_sat_f32x4_s, u128, u128, Operators::VectorConvertOp<4, 4, u32, f32, Operators::SaturatingTruncate<i32>>)      \
+    M(i32x4_trunc_sat_f32x4_u, u128, u128, Operators::VectorConvertOp<4, 4, u32, f32, Operators::SaturatingTruncate<u32>>)      \
+    M(i8x16_bitmask, u128, i32, Operators::VectorBitmask<16>)                                                                   \
+    M(i16x8_bitmask, u128, i32, Operators::VectorBitmask<8>)                                                                    \
+    M(i32x4_bitmask, u128, i32, Operators::VectorBitmask<4>)                                                                    \
+    M(i64x2_bitmask, u128, i32, Operators::VectorBitmask<2>)                                                                    \
+    M(f32x4_convert_i32x4_s, u128, u128, Operators::VectorConvertOp<4, 4, u32, i32, Operators::Convert<f32>>)                   \
+    M(f32x4_convert_i32x4_u, u128, u128, Operators::VectorConvertOp<4, 4, u32, u32, Operators::Convert<f32>>)                   \
+    M(f64x2_convert_low_i32x4_s, u128, u128, Operators::VectorConvertOp<2, 4, u64, i32, Operators::Convert<f64>>)               \
+    M(f64x2_convert_low_i32x4_u, u128, u128, Operators::VectorConvertOp<2, 4, u64, u32, Operators::Convert<f64>>)               \
+    M(f32x4_demote_f64x2_zero, u128, u128, Operators::VectorConvertOp<4, 2, u32, f64, Operators::Convert<f32>>)                 \
+    M(f64x2_promote_low_f32x4, u128, u128, Operators::VectorConvertOp<2, 4, u64, f32, Operators::Convert<f64>>)                 \
+    M(i32x4_trunc_sat_f64x2_s_zero, u128, u128, Operators::VectorConvertOp<4, 2, u32, f64, Operators::SaturatingTruncate<i32>>) \
+    M(i32x4_trunc_sat_f64x2_u_zero, u128, u128, Operators::VectorConvertOp<4, 2, u32, f64, Operators::SaturatingTruncate<u32>>)
+
+// M(name, PopType, PushType, Operator...), for the vector operators that take two operands of the same type.
+#define ENUMERATE_WASM_REGISTER_VECTOR_BINARY_OPS(M)                                                                                          \
+    M(i8x16_swizzle, u128, u128, Operators::VectorSwizzle)                                                                                    \
+    M(i8x16_eq, u128, u128, Operators::VectorCmpOp<16, Operators::Equals>)                                                                    \
+    M(i8x16_ne, u128, u128, Operators::VectorCmpOp<16, Operators::NotEquals>)                                                                 \
+    M(i8x16_lt_s, u128, u128, Operators::VectorCmpOp<16, Operators::LessThan, MakeSigned>)                                                    \
+    M(i8x16_lt_u, u128, u128, Operators::VectorCmpOp<16, Operators::LessThan, MakeUnsigned>)                                                  \
+    M(i8x16_gt_s, u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThan, MakeSigned>)                                                 \
+    M(i8x16_gt_u, u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThan, MakeUnsigned>)                                               \
+    M(i8x16_le_s, u128, u128, Operators::VectorCmpOp<16, Operators::LessThanOrEquals, MakeSigned>)                                            \
+    M(i8x16_le_u, u128, u128, Operators::VectorCmpOp<16, Operators::LessThanOrEquals, MakeUnsigned>)                                          \
+    M(i8x16_ge_s, u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThanOrEquals, MakeSigned>)                                         \
+    M(i8x16_ge_u, u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThanOrEquals, MakeUnsigned>)                                       \
+    M(i8x16_add, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Add>)                                                            \
+    M(i8x16_sub, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Subtract>)                                                       \
+    M(i8x16_avgr_u, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Average, MakeUnsigned>)                                       \
+    M(i8x16_add_sat_s, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Add>, MakeSigned>)             \
+    M(i8x16_add_sat_u, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Add>, MakeUnsigned>)           \
+    M(i8x16_sub_sat_s, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Subtract>, MakeSigned>)        \
+    M(i8x16_sub_sat_u, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Subtract>, MakeUnsigned>)      \
+    M(i8x16_min_s, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Minimum, MakeSigned>)                                          \
+    M(i8x16_min_u, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Minimum, MakeUnsigned>)                                        \
+    M(i8x16_max_s, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Maximum, MakeSigned>)                                          \
+    M(i8x16_max_u, u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Maximum, MakeUnsigned>)                                        \
+    M(i16x8_eq, u128, u128, Operators::VectorCmpOp<8, Operators::Equals>)                                                                     \
+    M(i16x8_ne, u128, u128, Operators::VectorCmpOp<8, Operators::NotEquals>)                                                                  \
+    M(i16x8_lt_s, u128, u128, Operators::VectorCmpOp<8, Operators::LessThan, MakeSigned>)                                                     \
+    M(i16x8_lt_u, u128, u128, Operators::VectorCmpOp<8, Operators::LessThan, MakeUnsigned>)                                                   \
+    M(i16x8_gt_s, u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThan, MakeSigned>)                                                  \
+    M(i16x8_gt_u, u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThan, MakeUnsigned>)                                                \
+    M(i16x8_le_s, u128, u128, Operators::VectorCmpOp<8, Operators::LessThanOrEquals, MakeSigned>)                                             \
+    M(i16x8_le_u, u128, u128, Operators::VectorCmpOp<8, Operators::LessThanOrEquals, MakeUnsigned>)                                           \
+    M(i16x8_ge_s, u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThanOrEquals, MakeSigned>)                                          \
+    M(i16x8_ge_u, u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThanOrEquals, MakeUnsigned>)                                        \
+    M(i16x8_add, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Add>)                                                             \
+    M(i16x8_sub, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Subtract>)                                                        \
+    M(i16x8_mul, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Multiply>)                                                        \
+    M(i16x8_avgr_u, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Average, MakeUnsigned>)                                        \
+    M(i16x8_add_sat_s, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Add>, MakeSigned>)             \
+    M(i16x8_add_sat_u, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Add>, MakeUnsigned>)           \
+    M(i16x8_sub_sat_s, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Subtract>, MakeSigned>)        \
+    M(i16x8_sub_sat_u, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Subtract>, MakeUnsigned>)      \
+    M(i16x8_min_s, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Minimum, MakeSigned>)                                           \
+    M(i16x8_min_u, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Minimum, MakeUnsigned>)                                         \
+    M(i16x8_max_s, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Maximum, MakeSigned>)                                           \
+    M(i16x8_max_u, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Maximum, MakeUnsigned>)                                         \
+    M(i16x8_extmul_low_i8x16_s, u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>)     \
+    M(i16x8_extmul_high_i8x16_s, u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::High, MakeSigned>)   \
+    M(i16x8_extmul_low_i8x16_u, u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::Low, MakeUnsigned>)   \
+    M(i16x8_extmul_high_i8x16_u, u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>) \
+    M(i32x4_eq, u128, u128, Operators::VectorCmpOp<4, Operators::Equals>)                                                                     \
+    M(i32x4_ne, u128, u128, Operators::VectorCmpOp<4, Operators::NotEquals>)                                                                  \
+    M(i32x4_lt_s, u128, u128, Operators::VectorCmpOp<4, Operators::LessThan, MakeSigned>)                                                     \
+    M(i32x4_lt_u, u128, u128, Operators::VectorCmpOp<4, Operators::LessThan, MakeUnsigned>)                                                   \
+    M(i32x4_gt_s, u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThan, MakeSigned>)                                                  \
+    M(i32x4_gt_u, u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThan, MakeUnsigned>)                                                \
+    M(i32x4_le_s, u128, u128, Operators::VectorCmpOp<4, Operators::LessThanOrEquals, MakeSigned>)                                             \
+    M(i32x4_le_u, u128, u128, Operators::VectorCmpOp<4, Operators::LessThanOrEquals, MakeUnsigned>)                                           \
+    M(i32x4_ge_s, u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThanOrEquals, MakeSigned>)                                          \
+    M(i32x4_ge_u, u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThanOrEquals, MakeUnsigned>)                                        \
+    M(i32x4_add, u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Add, MakeUnsigned>)                                               \
+    M(i32x4_sub, u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Subtract, MakeUnsigned>)                                          \
+    M(i32x4_mul, u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Multiply, MakeUnsigned>)                                          \
+    M(i32x4_min_s, u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Minimum, MakeSigned>)                                           \
+    M(i32x4_min_u, u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Minimum, MakeUnsigned>)                                         \
+    M(i32x4_max_s, u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Maximum, MakeSigned>)                                           \
+    M(i32x4_max_u, u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Maximum, MakeUnsigned>)                                         \
+    M(i32x4_extmul_low_i16x8_s, u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>)     \
+    M(i32x4_extmul_high_i16x8_s, u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::High, MakeSigned>)   \
+    M(i32x4_extmul_low_i16x8_u, u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::Low, MakeUnsigned>)   \
+    M(i32x4_extmul_high_i16x8_u, u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>) \
+    M(i64x2_eq, u128, u128, Operators::VectorCmpOp<2, Operators::Equals>)                                                                     \
+    M(i64x2_ne, u128, u128, Operators::VectorCmpOp<2, Operators::NotEquals>)                                                                  \
+    M(i64x2_lt_s, u128, u128, Operators::VectorCmpOp<2, Operators::LessThan, MakeSigned>)                                                     \
+    M(i64x2_gt_s, u128, u128, Operators::VectorCmpOp<2, Operators::GreaterThan, MakeSigned>)                                                  \
+    M(i64x2_le_s, u128, u128, Operators::VectorCmpOp<2, Operators::LessThanOrEquals, MakeSigned>)                                             \
+    M(i64x2_ge_s, u128, u128, Operators::VectorCmpOp<2, Operators::GreaterThanOrEquals, MakeSigned>)                                          \
+    M(i64x2_add, u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Add, MakeUnsigned>)                                               \
+    M(i64x2_sub, u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Subtract, MakeUnsigned>)                                          \
+    M(i64x2_mul, u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Multiply, MakeUnsigned>)                                          \
+    M(i64x2_extmul_low_i32x4_s, u128, u128, Operators::VectorIntegerExtOp<2, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>)     \
+    M(i64x2_extmul_high_i32x4_s, u128, u128, Operators::VectorIntegerExtOp<2, Operators::Multiply, Operators::VectorExt::High, MakeSigned>)   \
+    M(i64x2_extmul_low_i32x4_u, u128, u128, Operators::VectorIntegerExtOp<2, Operators::Multiply, Operators::VectorExt::Low, MakeUnsigned>)   \
+    M(i64x2_extmul_high_i32x4_u, u128, u128, Operators::VectorIntegerExtOp<2, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>) \
+    M(f32x4_eq, u128, u128, Operators::VectorFloatCmpOp<4, Operators::Equals>)                                                                \
+    M(f32x4_ne, u128, u128, Operators::VectorFloatCmpOp<4, Operators::NotEquals>)                                                             \
+    M(f32x4_lt, u128, u128, Operators::VectorFloatCmpOp<4, Operators::LessThan>)                                                              \
+    M(f32x4_gt, u128, u128, Operators::VectorFloatCmpOp<4, Operators::GreaterThan>)                                                           \
+    M(f32x4_le, u128, u128, Operators::VectorFloatCmpOp<4, Operators::LessThanOrEquals>)                                                      \
+    M(f32x4_ge, u128, u128, Operators::VectorFloatCmpOp<4, Operators::GreaterThanOrEquals>)                                                   \
+    M(f32x4_min, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Minimum>)                                                           \
+    M(f32x4_max, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Maximum>)                                                           \
+    M(f64x2_eq, u128, u128, Operators::VectorFloatCmpOp<2, Operators::Equals>)                                                                \
+    M(f64x2_ne, u128, u128, Operators::VectorFloatCmpOp<2, Operators::NotEquals>)                                                             \
+    M(f64x2_lt, u128, u128, Operators::VectorFloatCmpOp<2, Operators::LessThan>)                                                              \
+    M(f64x2_gt, u128, u128, Operators::VectorFloatCmpOp<2, Operators::GreaterThan>)                                                           \
+    M(f64x2_le, u128, u128, Operators::VectorFloatCmpOp<2, Operators::LessThanOrEquals>)                                                      \
+    M(f64x2_ge, u128, u128, Operators::VectorFloatCmpOp<2, Operators::GreaterThanOrEquals>)                                                   \
+    M(f64x2_min, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Minimum>)                                                           \
+    M(f64x2_max, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Maximum>)                                                           \
+    M(f32x4_div, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Divide>)                                                            \
+    M(f32x4_mul, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Multiply>)                                                          \
+    M(f32x4_sub, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Subtract>)                                                          \
+    M(f32x4_add, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Add>)                                                               \
+    M(f32x4_pmin, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::PseudoMinimum>)                                                    \
+    M(f32x4_pmax, u128, u128, Operators::VectorFloatBinaryOp<4, Operators::PseudoMaximum>)                                                    \
+    M(f64x2_div, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Divide>)                                                            \
+    M(f64x2_mul, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Multiply>)                                                          \
+    M(f64x2_sub, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Subtract>)                                                          \
+    M(f64x2_add, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Add>)                                                               \
+    M(f64x2_pmin, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::PseudoMinimum>)                                                    \
+    M(f64x2_pmax, u128, u128, Operators::VectorFloatBinaryOp<2, Operators::PseudoMaximum>)                                                    \
+    M(v128_and, u128, u128, Operators::BitAnd)                                                                                                \
+    M(v128_or, u128, u128, Operators::BitOr)                                                                                                  \
+    M(v128_xor, u128, u128, Operators::BitXor)                                                                                                \
+    M(v128_andnot, u128, u128, Operators::BitAndNot)                                                                                          \
+    M(i32x4_dot_i16x8_s, u128, u128, Operators::VectorDotProduct<4>)                                                                          \
+    M(i8x16_narrow_i16x8_s, u128, u128, Operators::VectorNarrow<16, i8>)                                                                      \
+    M(i8x16_narrow_i16x8_u, u128, u128, Operators::VectorNarrow<16, u8>)                                                                      \
+    M(i16x8_narrow_i32x4_s, u128, u128, Operators::VectorNarrow<8, i16>)                                                                      \
+    M(i16x8_narrow_i32x4_u, u128, u128, Operators::VectorNarrow<8, u16>)                                                                      \
+    M(i16x8_q15mulr_sat_s, u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Q15Mul>, MakeSigned>)
+
+// M(name, Operator...), for the vector operators that shift a v128 by an i32.
+#define ENUMERATE_WASM_REGISTER_VECTOR_SHIFT_OPS(M)               \
+    M(i8x16_shl, Operators::VectorShiftLeft<16>)                  \
+    M(i8x16_shr_u, Operators::VectorShiftRight<16, MakeUnsigned>) \
+    M(i8x16_shr_s, Operators::VectorShiftRight<16, MakeSigned>)   \
+    M(i16x8_shl, Operators::VectorShiftLeft<8>)                   \
+    M(i16x8_shr_u, Operators::VectorShiftRight<8, MakeUnsigned>)  \
+    M(i16x8_shr_s, Operators::VectorShiftRight<8, MakeSigned>)    \
+    M(i32x4_shl, Operators::VectorShiftLeft<4>)                   \
+    M(i32x4_shr_u, Operators::VectorShiftRight<4, MakeUnsigned>)  \
+    M(i32x4_shr_s, Operators::VectorShiftRight<4, MakeSigned>)    \
+    M(i64x2_shl, Operators::VectorShiftLeft<2>)                   \
+    M(i64x2_shr_u, Operators::VectorShiftRight<2, MakeUnsigned>)  \
+    M(i64x2_shr_s, Operators::VectorShiftRight<2, MakeSigned>)
+
+// M(name, ReadType, PushType)
+#define ENUMERATE_WASM_REGISTER_LOAD_OPS(M) \
+    M(i32_load, i32, i32)                   \
+    M(i64_load, i64, i64)                   \
+    M(f32_load, float, float)               \
+    M(f64_load, double, double)             \
+    M(i32_load8_s, i8, i32)                 \
+    M(i32_load8_u, u8, i32)                 \
+    M(i32_load16_s, i16, i32)               \
+    M(i32_load16_u, u16, i32)               \
+    M(i64_load8_s, i8, i64)                 \
+    M(i64_load8_u, u8, i64)                 \
+    M(i64_load16_s, i16, i64)               \
+    M(i64_load16_u, u16, i64)               \
+    M(i64_load32_s, i32, i64)               \
+    M(i64_load32_u, u32, i64)               \
+    M(v128_load, u128, u128)
+
+// M(name, PopType, StoreType)
+#define ENUMERATE_WASM_REGISTER_STORE_OPS(M) \
+    M(i32_store, i32, i32)                   \
+    M(i64_store, i64, i64)                   \
+    M(f32_store, float, float)               \
+    M(f64_store, double, double)             \
+    M(i32_store8, i32, i8)                   \
+    M(i32_store16, i32, i16)                 \
+    M(i64_store8, i64, i8)                   \
+    M(i64_store16, i64, i16)                 \
+    M(i64_store32, i64, i32)                 \
+    M(v128_store, u128, u128)
+
+// Operands are in `dst`, `lhs`, `rhs` and `immediate`, as described next to each op.
+#define ENUMERATE_WASM_REGISTER_CONTROL_OPS(M)                                                                \
+    M(Jump)          /* goto immediate */                                                                     \
+    M(JumpIfZero)    /* if lhs == 0, goto immediate */                                                        \
+    M(JumpIfNotZero) /* if lhs != 0, goto immediate */                                                        \
+    M(BranchTable)   /* goto branch_table[immediate + min(lhs, rhs)] */                                       \
+    M(Return)        /* results are in the registers right after the locals */                                \
+    M(Unreachable)   /* trap */                                                                               \
+    M(Move)          /* dst = lhs */                                                                          \
+    M(MoveWide)      /* dst, dst + 1 = lhs, lhs + 1 */                                                        \
+    M(Const)         /* dst = immediate */                                                                    \
+    M(Select)        /* dst = immediate != 0 ? lhs : rhs, where immediate is the condition register */        \
+    M(SelectWide)    /* the same as Select, for a pair of registers */                                        \
+    M(Call)          /* call function `immediate`, with arguments and results starting at dst */               \
+    M(CallIndirect)  /* call table[immediate >> 32][lhs] with type `immediate & 0xffffffff`, ditto */           \
+    M(GlobalGet)     /* dst = global `immediate`, in as many registers as its type takes */                   \
+    M(GlobalSet)     /* global `immediate` = lhs, ditto */                                                    \
+    M(MemorySize)    /* dst = size of memory 0, in pages */                                                   \
+    M(MemoryGrow)    /* dst = grow memory 0 by lhs pages */                                                   \
+    M(RefIsNull)     /* dst = lhs holds a null reference */                                                   \
+    M(TableGet)      /* dst = table `immediate`[lhs] */                                                       \
+    M(TableSet)      /* table `immediate`[lhs] = rhs */
+
+// A function body lowered from the stack machine to a register machine. Every local and every stack slot gets fixed
+// registers in the frame: locals first, then the stack slots, each taking registers_for() its type. Branch targets are
+// resolved to instruction indices, so no label stack is needed at runtime, and reads of locals are folded into the
+// instructions that consume them.
+//
+// Registers are 64 bits wide, so a v128 takes up two of them (low half first), and so does a reference, which is kept
+// in the same two halves that a Value holds it in. Functions that use anything else than numeric and vector arithmetic,
+// memory 0, and getting and setting table elements (e.g. lane operations or bulk memory operations) stay on the stack
+// interpreter.
+inline u32 registers_for(ValueType type)
+{
+    return type.is_numeric() ? 1 : 2;
+}
+
+template<typename T>
+constexpr u32 registers_for()
+{
+    return sizeof(T) > sizeof(u64) ? 2 : 1;
+}
+
+class RegisterProgram {
+public:
+    enum class Op : u16 {
+#define __ENUMERATE_OP(name, ...) name,
+        ENUMERATE_WASM_REGISTER_CONTROL_OPS(__ENUMERATE_OP)
+        ENUMERATE_WASM_REGISTER_LOAD_OPS(__ENUMERATE_OP)
+        ENUMERATE_WASM_REGISTER_STORE_OPS(__ENUMERATE_OP)
+        ENUMERATE_WASM_REGISTER_UNARY_OPS(__ENUMERATE_OP)
+        ENUMERATE_WASM_REGISTER_BINARY_OPS(__ENUMERATE_OP)
+        ENUMERATE_WASM_REGISTER_VECTOR_UNARY_OPS(__ENUMERATE_OP)
+        ENUMERATE_WASM_REGISTER_VECTOR_BINARY_OPS(__ENUMERATE_OP)
+        ENUMERATE_WASM_REGISTER_VECTOR_SHIFT_OPS(__ENUMERATE_OP)
+#undef __ENUMERATE_OP
+    };
+
+    struct Instruction {
+        Op op;
+        u32 dst { 0 };
+        u32 lhs { 0 };
+        u32 rhs { 0 };
+        u64 immediate { 0 };
+    };
+
+    // Returns null if the function uses anything that the register machine does not support.
+    static OwnPtr<RegisterProgram> compile(WasmFunction const&, Store&);
+
+    auto const& instructions() const { return m_instructions; }
+    auto const& branch_table() const { return m_branch_table; }
+
+    // The types of the parameters and locals, in order, and the registers that they take up in total.
+    auto const& local_types() const { return m_local_types; }
+    size_t local_register_count() const { return m_local_register_count; }
+    size_t parameter_register_count() const { return m_parameter_register_count; }
+
+    auto const& result_types() const { return m_result_types; }
+    size_t result_register_count() const { return m_result_register_count; }
+
+    size_t register_count() const { return m_register_count; }
+
+private:
+    friend class RegisterProgramCompiler;
+
+    RegisterProgram() = default;
+
+    Vector<Instruction> m_instructions;
+    Vector<u32> m_branch_table;
+    Vector<ValueType> m_local_types;
+    Vector<ValueType> m_result_types;
+    size_t m_local_register_count { 0 };
+    size_t m_parameter_register_count { 0 };
+    size_t m_result_register_count { 0 };
+    size_t m_register_count { 0 };
+};
+
+}
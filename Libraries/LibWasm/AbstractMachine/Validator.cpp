@@ -4,15 +4,27 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/HashTable.h>
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibCore/System.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
+#if !defined(AK_OS_WINDOWS)
+#    include <pthread.h>
+#    include <string.h>
+#endif
+
 namespace Wasm {
 
+ByteString Validator::build_identifier()
+{
+    return WASM_VALIDATOR_INPUTS_HASH;
+}
+
 ErrorOr<void, ValidationError> Validator::validate(Module& module)
 {
     // Pre-emptively make invalid. The module will be set to `Valid` at the end
@@ -136,7 +148,8 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
         TRY(validate(module.memory_section()));
         TRY(validate(module.table_section()));
     }
-    TRY(validate(module.code_section()));
+    if (!module.function_bodies_validated_by_earlier_run())
+        TRY(validate(module.code_section()));
 
     module.set_validation_status(Module::ValidationStatus::Valid, {});
     return {};
@@ -253,33 +266,173 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
     return {};
 }
 
+void Validator::set_thread_count(size_t count)
+{
+#if defined(AK_OS_WINDOWS)
+    // FIXME: Support parallel validation on Windows.
+    count = 1;
+#endif
+    if (count == 0)
+        count = max(1u, Core::System::hardware_concurrency());
+    m_thread_count = count;
+}
+
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
+    // Below this, starting the threads costs more than it saves.
+    static constexpr size_t minimum_functions_per_thread = 64;
+
+    auto thread_count = min(m_thread_count, section.functions().size() / minimum_functions_per_thread);
+    if (thread_count > 1)
+        return validate_functions_in_parallel(section, thread_count);
+
     size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
-
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+    for (auto& entry : section.functions())
+        TRY(validate_function(index++, entry));
+
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::validate_function(size_t function_index, CodeSection::Code const& entry)
+{
+    TRY(validate(FunctionIndex { function_index }));
+    auto& function_type = m_context.functions[function_index];
+    auto& function = entry.func();
+
+    auto function_validator = fork();
+    function_validator.m_context.locals = {};
+    function_validator.m_context.locals.extend(function_type.parameters());
+    for (auto& local : function.locals()) {
+        for (size_t i = 0; i < local.n(); ++i)
+            function_validator.m_context.locals.append(local.type());
+    }
+
+    function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+
+    auto results = TRY(function_validator.validate(function.body(), function_type.results()));
+    if (results.result_types.size() != function_type.results().size())
+        return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+
+    return {};
+}
+
+#if defined(AK_OS_WINDOWS)
+
+ErrorOr<void, ValidationError> Validator::validate_functions_in_parallel(CodeSection const&, size_t)
+{
+    VERIFY_NOT_REACHED();
+}
+
+#else
+
+// Copying a context only copies references to its data, and those reference counts must not be touched from several
+// threads at once. This makes a copy that shares nothing with the original.
+static Context unshared_copy(Context const& context)
+{
+    Context copy;
+    copy.types.extend(context.types);
+    copy.functions.extend(context.functions);
+    copy.tables.extend(context.tables);
+    copy.memories.extend(context.memories);
+    copy.globals.extend(context.globals);
+    copy.elements.extend(context.elements);
+    copy.datas.extend(context.datas);
+    copy.locals.extend(context.locals);
+    copy.data_count = context.data_count;
+    for (auto index : context.references->tree)
+        copy.references->tree.insert(index.value(), index);
+    copy.imported_function_count = context.imported_function_count;
+    return copy;
+}
+
+ErrorOr<void, ValidationError> Validator::validate_functions_in_parallel(CodeSection const& section, size_t thread_count)
+{
+    // Functions are handed out in batches, in order. A thread that fails stops everyone from taking more batches, but
+    // all the batches before it are still finished, so the first invalid function is the same one serial validation
+    // would have reported.
+    static constexpr size_t batch_size = 16;
+
+    struct Failure {
+        size_t function_index { 0 };
+        ValidationError error;
+    };
+
+    struct Worker {
+        OwnPtr<Validator> validator;
+        Optional<Failure> failure;
+    };
+
+    auto const& functions = section.functions();
+    Atomic<size_t> next_batch { 0 };
+    Atomic<bool> has_failed { false };
+
+    Vector<Worker> workers;
+    workers.resize(thread_count);
+    for (auto& worker : workers)
+        worker.validator = adopt_own(*new Validator(unshared_copy(m_context)));
+
+    auto run_worker = [&](Worker& worker) {
+        while (!has_failed.load(AK::MemoryOrder::memory_order_relaxed)) {
+            auto first = next_batch.fetch_add(batch_size);
+            if (first >= functions.size())
+                return;
+            auto end = min(first + batch_size, functions.size());
+            for (auto i = first; i < end; ++i) {
+                auto function_index = m_context.imported_function_count + i;
+                if (auto result = worker.validator->validate_function(function_index, functions[i]); result.is_error()) {
+                    worker.failure = Failure { function_index, result.release_error() };
+                    has_failed.store(true);
+                    return;
+                }
+            }
         }
+    };
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+    struct ThreadContext {
+        decltype(run_worker)* run;
+        Worker* worker;
+    };
+    Vector<ThreadContext> thread_contexts;
+    thread_contexts.ensure_capacity(thread_count);
+
+    Vector<pthread_t> helper_threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        thread_contexts.unchecked_append({ &run_worker, &workers[i] });
+        pthread_t thread;
+        auto rc = pthread_create(
+            &thread, nullptr, [](void* argument) -> void* {
+                auto& context = *static_cast<ThreadContext*>(argument);
+                (*context.run)(*context.worker);
+                return nullptr;
+            },
+            &thread_contexts.last());
+        if (rc != 0) {
+            // The threads that did start will pick up this one's share of the work.
+            dbgln("Failed to create Wasm validation thread: {}", strerror(rc));
+            continue;
+        }
+        helper_threads.append(thread);
+    }
+
+    // The calling thread takes part in validation as well.
+    run_worker(workers[0]);
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    for (auto thread : helper_threads)
+        pthread_join(thread, nullptr);
+
+    Optional<Failure> first_failure;
+    for (auto& worker : workers) {
+        if (worker.failure.has_value() && (!first_failure.has_value() || worker.failure->function_index < first_failure->function_index))
+            first_failure = worker.failure.release_value();
     }
+    if (first_failure.has_value())
+        return first_failure.release_value().error;
 
     return {};
 }
 
+#endif
+
 ErrorOr<void, ValidationError> Validator::validate(TableType const& type)
 {
     return validate(type.limits(), (1ull << 32) - 1);
@@ -50,6 +50,11 @@ class Validator {
     AK_MAKE_NONMOVABLE(Validator);
 
 public:
+    // Validation results that were stored (see ModuleCache) are only trusted if they were produced by this build of the
+    // validator. It is a hash of the parser and validator sources, computed by CMake, so it changes whenever they do and
+    // is the same for every build of the same sources.
+    static ByteString build_identifier();
+
     Validator() = default;
 
     [[nodiscard]] Validator fork() const
@@ -57,6 +62,10 @@ public:
         return Validator { m_context };
     }
 
+    // Function bodies are validated on this many threads. With 1 (the default), they're validated serially on the
+    // calling thread. Pass 0 to use one thread per available CPU core.
+    void set_thread_count(size_t);
+
     // Module
     ErrorOr<void, ValidationError> validate(Module&);
     ErrorOr<void, ValidationError> validate(ImportSection const&);
@@ -283,6 +292,9 @@ private:
     {
     }
 
+    ErrorOr<void, ValidationError> validate_function(size_t function_index, CodeSection::Code const&);
+    ErrorOr<void, ValidationError> validate_functions_in_parallel(CodeSection const&, size_t thread_count);
+
     struct Errors {
         static ValidationError invalid(StringView name) { return ByteString::formatted("Invalid {}", name); }
 
@@ -347,6 +359,7 @@ private:
     Context m_context;
     Vector<Frame> m_frames;
     COWVector<GlobalType> m_globals_without_internal_globals;
+    size_t m_thread_count { 1 };
 };
 
 }
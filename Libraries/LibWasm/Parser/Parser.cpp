@@ -1247,6 +1247,66 @@ ParseResult<SectionId> SectionId::parse(Stream& stream)
     }
 }
 
+ParseResult<void> Module::check_section_order(SectionId section_id, SectionId::SectionIdKind& last_section_id)
+{
+    if (section_id.kind() == SectionId::SectionIdKind::Custom)
+        return {};
+    if (section_id.kind() == last_section_id)
+        return ParseError::DuplicateSection;
+    if (section_id.kind() < last_section_id)
+        return ParseError::SectionOutOfOrder;
+    last_section_id = section_id.kind();
+    return {};
+}
+
+ParseResult<void> Module::parse_section(SectionId section_id, Stream& section_stream)
+{
+    switch (section_id.kind()) {
+    case SectionId::SectionIdKind::Custom:
+        m_custom_sections.append(TRY(CustomSection::parse(section_stream)));
+        break;
+    case SectionId::SectionIdKind::Type:
+        m_type_section = TRY(TypeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Import:
+        m_import_section = TRY(ImportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Function:
+        m_function_section = TRY(FunctionSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Table:
+        m_table_section = TRY(TableSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Memory:
+        m_memory_section = TRY(MemorySection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Global:
+        m_global_section = TRY(GlobalSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Export:
+        m_export_section = TRY(ExportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Start:
+        m_start_section = TRY(StartSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Element:
+        m_element_section = TRY(ElementSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Code:
+        m_code_section = TRY(CodeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Data:
+        m_data_section = TRY(DataSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::DataCount:
+        m_data_count_section = TRY(DataCountSection::parse(section_stream));
+        break;
+    default:
+        return ParseError::InvalidIndex;
+    }
+    return {};
+}
+
 ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("Module"sv);
@@ -1270,57 +1330,8 @@ ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
         size_t section_size = TRY_READ(stream, LEB128<u32>, ParseError::ExpectedSize);
         auto section_stream = ConstrainedStream { MaybeOwned<Stream>(stream), section_size };
 
-        if (section_id.kind() != SectionId::SectionIdKind::Custom && section_id.kind() == last_section_id)
-            return ParseError::DuplicateSection;
-
-        switch (section_id.kind()) {
-        case SectionId::SectionIdKind::Custom:
-            module.custom_sections().append(TRY(CustomSection::parse(section_stream)));
-            break;
-        case SectionId::SectionIdKind::Type:
-            module.type_section() = TRY(TypeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Import:
-            module.import_section() = TRY(ImportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Function:
-            module.function_section() = TRY(FunctionSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Table:
-            module.table_section() = TRY(TableSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Memory:
-            module.memory_section() = TRY(MemorySection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Global:
-            module.global_section() = TRY(GlobalSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Export:
-            module.export_section() = TRY(ExportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Start:
-            module.start_section() = TRY(StartSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Element:
-            module.element_section() = TRY(ElementSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Code:
-            module.code_section() = TRY(CodeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Data:
-            module.data_section() = TRY(DataSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::DataCount:
-            module.data_count_section() = TRY(DataCountSection::parse(section_stream));
-            break;
-        default:
-            return ParseError::InvalidIndex;
-        }
-        if (section_id.kind() != SectionId::SectionIdKind::Custom) {
-            if (section_id.kind() < last_section_id)
-                return ParseError::SectionOutOfOrder;
-            last_section_id = section_id.kind();
-        }
+        TRY(check_section_order(section_id, last_section_id));
+        TRY(module.parse_section(section_id, section_stream));
         if (section_stream.remaining() != 0)
             return ParseError::SectionSizeMismatch;
     }
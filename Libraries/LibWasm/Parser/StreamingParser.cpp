@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/LEB128.h>
+#include <AK/MemoryStream.h>
+#include <LibWasm/Parser/StreamingParser.h>
+
+namespace Wasm {
+
+// Returns how many bytes the LEB128-encoded u32 at the start of `bytes` takes up, or nothing if more bytes are needed
+// to tell. An encoding that is too long is reported as complete, so that reading it fails.
+static Optional<size_t> complete_leb128_u32_length(ReadonlyBytes bytes)
+{
+    static constexpr size_t max_length = 5;
+    for (size_t i = 0; i < min(bytes.size(), max_length); ++i) {
+        if ((bytes[i] & 0x80) == 0)
+            return i + 1;
+    }
+    if (bytes.size() >= max_length)
+        return max_length;
+    return {};
+}
+
+static ParseResult<u32> read_leb128_u32(ReadonlyBytes bytes, ParseError error)
+{
+    FixedMemoryStream stream { bytes };
+    auto value_or_error = stream.read_value<LEB128<u32>>();
+    if (value_or_error.is_error())
+        return error;
+    return value_or_error.release_value();
+}
+
+StreamingParser::StreamingParser()
+    : m_module(make_ref_counted<Module>())
+{
+}
+
+ParseResult<void> StreamingParser::append(ReadonlyBytes bytes)
+{
+    m_bytes_received += bytes.size();
+    if (m_buffer.try_append(bytes).is_error())
+        return ParseError::OutOfMemory;
+
+    TRY(parse_available_bytes());
+
+    // Let go of everything that has been parsed, so that only the incomplete section or function is kept around.
+    if (m_offset != 0) {
+        auto remaining_or_error = ByteBuffer::copy(available_bytes());
+        if (remaining_or_error.is_error())
+            return ParseError::OutOfMemory;
+        m_buffer = remaining_or_error.release_value();
+        m_offset = 0;
+    }
+    return {};
+}
+
+ParseResult<NonnullRefPtr<Module>> StreamingParser::finish()
+{
+    TRY(parse_available_bytes());
+    if (m_state != State::SectionHeader || !available_bytes().is_empty())
+        return ParseError::UnexpectedEof;
+
+    dbgln_if(WASM_BINPARSER_DEBUG, "StreamingParser: Parsed a module of {} bytes", m_bytes_received);
+    return m_module;
+}
+
+ParseResult<void> StreamingParser::parse_available_bytes()
+{
+    while (TRY(parse_next())) { }
+    return {};
+}
+
+void StreamingParser::consume(size_t count)
+{
+    VERIFY(count <= available_bytes().size());
+    m_offset += count;
+}
+
+// Parses the next piece of the module if all of its bytes are available, and returns whether it did.
+ParseResult<bool> StreamingParser::parse_next()
+{
+    auto bytes = available_bytes();
+    // The part of the available bytes that belongs to the code section, while in the middle of it.
+    auto code_section_bytes = bytes.trim(m_section_remaining);
+    auto is_code_section_truncated = bytes.size() >= m_section_remaining;
+
+    switch (m_state) {
+    case State::Header: {
+        static constexpr size_t header_size = Module::wasm_magic.size() + Module::wasm_version.size();
+        if (bytes.size() < header_size)
+            return false;
+        if (bytes.trim(4) != Module::wasm_magic.span())
+            return ParseError::InvalidModuleMagic;
+        if (bytes.slice(4, 4) != Module::wasm_version.span())
+            return ParseError::InvalidModuleVersion;
+        consume(header_size);
+        m_state = State::SectionHeader;
+        return true;
+    }
+    case State::SectionHeader: {
+        if (bytes.is_empty())
+            return false;
+        FixedMemoryStream id_stream { bytes.trim(1) };
+        auto section_id = TRY(SectionId::parse(id_stream));
+        auto size_length = complete_leb128_u32_length(bytes.slice(1));
+        if (!size_length.has_value())
+            return false;
+        m_section_remaining = TRY(read_leb128_u32(bytes.slice(1, *size_length), ParseError::ExpectedSize));
+        consume(1 + *size_length);
+
+        TRY(Module::check_section_order(section_id, m_last_section_id));
+        m_section_id = section_id;
+        m_state = section_id.kind() == SectionId::SectionIdKind::Code ? State::CodeEntryCount : State::SectionContents;
+        return true;
+    }
+    case State::SectionContents: {
+        if (bytes.size() < m_section_remaining)
+            return false;
+        FixedMemoryStream section_stream { bytes.trim(m_section_remaining) };
+        TRY(m_module->parse_section(m_section_id, section_stream));
+        if (!section_stream.is_eof())
+            return ParseError::SectionSizeMismatch;
+        consume(m_section_remaining);
+        m_section_remaining = 0;
+        m_state = State::SectionHeader;
+        return true;
+    }
+    case State::CodeEntryCount: {
+        auto count_length = complete_leb128_u32_length(code_section_bytes);
+        if (!count_length.has_value()) {
+            if (is_code_section_truncated)
+                return ParseError::UnexpectedEof;
+            return false;
+        }
+        m_code_entries_remaining = TRY(read_leb128_u32(code_section_bytes.trim(*count_length), ParseError::ExpectedSize));
+        consume(*count_length);
+        m_section_remaining -= *count_length;
+
+        // Every entry takes up at least two bytes, so a count that's larger than that can't be trusted with an allocation.
+        m_code_entries.ensure_capacity(min<size_t>(m_code_entries_remaining, m_section_remaining / 2));
+        m_state = State::CodeEntry;
+        break;
+    }
+    case State::CodeEntry: {
+        if (m_code_entries_remaining == 0)
+            break;
+        auto size_length = complete_leb128_u32_length(code_section_bytes);
+        if (!size_length.has_value()) {
+            if (is_code_section_truncated)
+                return ParseError::UnexpectedEof;
+            return false;
+        }
+        auto entry_size = TRY(read_leb128_u32(code_section_bytes.trim(*size_length), ParseError::InvalidSize));
+        auto entry_length = *size_length + static_cast<size_t>(entry_size);
+        if (entry_length > m_section_remaining)
+            return ParseError::UnexpectedEof;
+        if (bytes.size() < entry_length)
+            return false;
+
+        FixedMemoryStream entry_stream { bytes.trim(entry_length) };
+        m_code_entries.append(TRY(CodeSection::Code::parse(entry_stream)));
+        if (!entry_stream.is_eof())
+            return ParseError::SectionSizeMismatch;
+        consume(entry_length);
+        m_section_remaining -= entry_length;
+        --m_code_entries_remaining;
+        break;
+    }
+    }
+
+    // In the code section, see if that was its last entry.
+    VERIFY(m_state == State::CodeEntry);
+    if (m_code_entries_remaining != 0)
+        return true;
+    if (m_section_remaining != 0)
+        return ParseError::SectionSizeMismatch;
+    m_module->code_section() = CodeSection { move(m_code_entries) };
+    m_code_entries = {};
+    m_state = State::SectionHeader;
+    return true;
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// Parses a module whose bytes arrive in chunks (e.g. from the network), doing the work as the bytes come in instead of
+// after all of them have arrived. Each section is parsed as soon as it is complete, and the code section one function
+// at a time, so that by the time the last chunk arrives there's little left to do.
+class StreamingParser {
+public:
+    StreamingParser();
+
+    // Returns an error as soon as the bytes seen so far can't be the start of a valid module; after that, the parser
+    // must not be used anymore.
+    ParseResult<void> append(ReadonlyBytes);
+    ParseResult<NonnullRefPtr<Module>> finish();
+
+    size_t bytes_received() const { return m_bytes_received; }
+
+private:
+    enum class State {
+        Header,
+        SectionHeader,
+        SectionContents,
+        CodeEntryCount,
+        CodeEntry,
+    };
+
+    ParseResult<void> parse_available_bytes();
+    ParseResult<bool> parse_next();
+    ReadonlyBytes available_bytes() const { return m_buffer.bytes().slice(m_offset); }
+    void consume(size_t);
+
+    NonnullRefPtr<Module> m_module;
+    State m_state { State::Header };
+
+    // Bytes that have been received but not consumed yet start at m_offset.
+    ByteBuffer m_buffer;
+    size_t m_offset { 0 };
+    size_t m_bytes_received { 0 };
+
+    SectionId m_section_id { SectionId::SectionIdKind::Custom };
+    SectionId::SectionIdKind m_last_section_id { SectionId::SectionIdKind::Custom };
+    size_t m_section_remaining { 0 };
+
+    u32 m_code_entries_remaining { 0 };
+    Vector<CodeSection::Code> m_code_entries;
+};
+
+}
@@ -0,0 +1,454 @@
+;; Source of interpreter-tiers.wasm, which is used by interpreter-tiers.js.
+;; The types are listed explicitly so that their indices match the binary. Rebuild it with:
+;;   wat2wasm --enable-all interpreter-tiers.wat -o interpreter-tiers.wasm
+
+(module
+  (type (func (param i32) (result i64)))
+  (type (func (param i32) (result i32)))
+  (type (func (param i32 i32) (result i32)))
+  (type (func))
+  (type (func (param i32) (result i32 i32)))
+  (type (func (param i32) (result v128)))
+  (type (func (result i64)))
+  (type (func (param v128) (result i32)))
+  (type (func (param i32) (result funcref)))
+  (type (func (param funcref) (result funcref)))
+  (type (func (param externref i32) (result externref)))
+
+  (table 2 funcref)
+  (memory 1)
+
+  (global (mut i32) (i32.const 7))
+  (global (mut i64) (i64.const -5))
+  (global (mut v128) (v128.const i32x4 3 0 5 0))
+  (global (mut funcref) (ref.null func))
+
+  ;; 0: loop with br_if, i64 accumulation
+  (func $sum (export "sum") (type 0) (param i32) (result i64) (local i64)
+    block
+      loop
+        local.get 0
+        i32.eqz
+        br_if 1
+        local.get 1
+        local.get 0
+        i64.extend_i32_s
+        i64.add
+        local.set 1
+        local.get 0
+        i32.const 1
+        i32.sub
+        local.set 0
+        br 0
+      end
+    end
+    local.get 1)
+
+  ;; 1: recursive
+  (func $fib (export "fib") (type 1) (param i32) (result i32)
+    local.get 0
+    i32.const 2
+    i32.lt_s
+    if (result i32)
+      local.get 0
+    else
+      local.get 0
+      i32.const 1
+      i32.sub
+      call 1
+      local.get 0
+      i32.const 2
+      i32.sub
+      call 1
+      i32.add
+    end)
+
+  ;; 2: returns 10, 20 or 30, and 99 by default
+  (func $brtable (export "brtable") (type 1) (param i32) (result i32)
+    block
+      block
+        block
+          block
+            local.get 0
+            br_table 0 1 2 3
+          end
+          i32.const 10
+          return
+        end
+        i32.const 20
+        return
+      end
+      i32.const 30
+      return
+    end
+    i32.const 99)
+
+  ;; 3: i32, i64 and byte stores and loads
+  (func $mem (export "mem") (type 0) (param i32) (result i64)
+    i32.const 8
+    local.get 0
+    i32.store
+    i32.const 16
+    i64.const 0x1122334455667788
+    i64.store
+    i32.const 8
+    i32.load
+    i64.extend_i32_s
+    i32.const 16
+    i64.load
+    i64.add
+    i32.const 17
+    i32.load8_u
+    i64.extend_i32_s
+    i64.add)
+
+  ;; 4: g0 += x; return g0 * g1
+  (func $glob (export "glob") (type 0) (param i32) (result i64)
+    global.get 0
+    local.get 0
+    i32.add
+    global.set 0
+    global.get 0
+    i64.extend_i32_s
+    global.get 1
+    i64.mul)
+
+  ;; 5
+  (func $sel (export "sel") (type 1) (param i32) (result i32)
+    i32.const 111
+    i32.const 222
+    local.get 0
+    select)
+
+  ;; 6: traps on division by zero and overflow
+  (func $div (export "div") (type 2) (param i32 i32) (result i32)
+    local.get 0
+    local.get 1
+    i32.div_s)
+
+  ;; 7: traps out of bounds
+  (func $oob (export "oob") (type 1) (param i32) (result i32)
+    local.get 0
+    i32.load)
+
+  ;; 8: local.tee, and a block result carried by br_if
+  (func $tee (export "tee") (type 1) (param i32) (result i32) (local i32)
+    block (result i32)
+      local.get 0
+      local.tee 1
+      local.get 1
+      i32.add
+      local.get 0
+      br_if 0
+      drop
+      i32.const -1
+    end
+    local.get 1
+    i32.add)
+
+  ;; 9
+  (func $unr (export "unr") (type 3)
+    unreachable)
+
+  ;; 10: calls fib or sel through the table
+  (func $ci (export "ci") (type 2) (param i32 i32) (result i32)
+    local.get 1
+    local.get 0
+    call_indirect (type 1))
+
+  ;; 11
+  (func $grow (export "grow") (type 1) (param i32) (result i32)
+    local.get 0
+    memory.grow
+    memory.size
+    i32.add)
+
+  ;; 12: sum of i as f64, truncated
+  (func $fsum (export "fsum") (type 0) (param i32) (result i64) (local f64)
+    block
+      loop
+        local.get 0
+        i32.eqz
+        br_if 1
+        local.get 1
+        local.get 0
+        f64.convert_i32_s
+        f64.add
+        local.set 1
+        local.get 0
+        i32.const 1
+        i32.sub
+        local.set 0
+        br 0
+      end
+    end
+    local.get 1
+    i64.trunc_f64_s)
+
+  ;; 13: iterative fib, which swaps locals through the stack
+  (func $fibi (export "fibi") (type 0) (param i32) (result i64) (local i64 i64)
+    i64.const 1
+    local.set 2
+    block
+      loop
+        local.get 0
+        i32.eqz
+        br_if 1
+        local.get 2
+        local.get 1
+        local.get 2
+        i64.add
+        local.set 2
+        local.set 1
+        local.get 0
+        i32.const 1
+        i32.sub
+        local.set 0
+        br 0
+      end
+    end
+    local.get 1)
+
+  ;; 14: a block with a parameter and two results, and an if without an else
+  (func $multi (export "multi") (type 1) (param i32) (result i32)
+    local.get 0
+    block (type 4) (param i32) (result i32 i32)
+      i32.const 3
+    end
+    i32.mul
+    local.get 0
+    i32.const 5
+    i32.gt_s
+    if
+      local.get 0
+      i32.const 1000
+      i32.add
+      local.set 0
+    end
+    local.get 0
+    i32.add)
+
+  ;; 15: stores and loads in a loop
+  (func $memsum (export "memsum") (type 0) (param i32) (result i64) (local i64 i32)
+    block
+      loop
+        local.get 0
+        i32.eqz
+        br_if 1
+        local.get 0
+        i32.const 0xfff8
+        i32.and
+        local.tee 2
+        local.get 0
+        i32.store
+        local.get 1
+        local.get 2
+        i32.load
+        i64.extend_i32_u
+        i64.add
+        local.set 1
+        local.get 0
+        i32.const 1
+        i32.sub
+        local.set 0
+        br 0
+      end
+    end
+    local.get 1)
+
+  ;; 16: traps out of bounds in a callee
+  (func $nestoob (export "nestoob") (type 1) (param i32) (result i32)
+    local.get 0
+    call 7
+    i32.const 1
+    i32.add)
+
+  ;; 17: v128 accumulation through memory, locals and arithmetic
+  (func $vsum (export "vsum") (type 0) (param i32) (result i64) (local v128 v128)
+    v128.const i32x4 1 2 3 4
+    local.set 2
+    block
+      loop
+        local.get 0
+        i32.eqz
+        br_if 1
+        i32.const 0
+        local.get 0
+        i32.store
+        i32.const 12
+        local.get 0
+        i32.store
+        local.get 1
+        i32.const 0
+        v128.load
+        local.get 2
+        i32x4.mul
+        i32x4.add
+        i32.const 1
+        i32x4.shl
+        local.set 1
+        local.get 0
+        i32.const 1
+        i32.sub
+        local.set 0
+        br 0
+      end
+    end
+    i32.const 32
+    local.get 1
+    v128.store
+    i32.const 32
+    i64.load
+    i32.const 40
+    i64.load
+    i64.add
+    local.get 1
+    local.get 1
+    i8x16.eq
+    i8x16.bitmask
+    i64.extend_i32_s
+    i64.add)
+
+  ;; 18: a v128 result
+  (func $vret (export "vret") (type 5) (param i32) (result v128)
+    v128.const i32x4 1 2 3 4
+    v128.const i32x4 -1 7 0 9
+    local.get 0
+    select
+    v128.not)
+
+  ;; 19: a v128 through a call result, and a block result carried by br_if
+  (func $vcall (export "vcall") (type 0) (param i32) (result i64)
+    i32.const 48
+    block (result v128)
+      local.get 0
+      call 18
+      local.get 0
+      br_if 0
+      drop
+      v128.const i32x4 5 5 5 5
+    end
+    block (result v128)
+      local.get 0
+      call 18
+    end
+    i64x2.add
+    v128.store
+    i32.const 48
+    i64.load
+    i32.const 56
+    i64.load
+    i64.add)
+
+  ;; 20: doubles a v128 global
+  (func $vglob (export "vglob") (type 6) (result i64)
+    global.get 2
+    global.get 2
+    i64x2.add
+    global.set 2
+    i32.const 64
+    global.get 2
+    v128.store
+    i32.const 64
+    i64.load
+    i32.const 72
+    i64.load
+    i64.add)
+
+  ;; 21: not lowered (extract_lane), and called with a v128 from a lowered function
+  (func $vlane (type 7) (param v128) (result i32)
+    local.get 0
+    i32x4.extract_lane 1)
+
+  ;; 22
+  (func $vcallx (export "vcallx") (type 1) (param i32) (result i32)
+    v128.const i32x4 1 2 3 4
+    v128.const i32x4 10 20 30 40
+    i32x4.add
+    call 21
+    local.get 0
+    i32.add)
+
+  ;; 23: table.get and table.set, ref.null, ref.func and ref.is_null
+  (func $refs (export "refs") (type 1) (param i32) (result i32) (local funcref)
+    ref.func 1
+    local.set 1
+    i32.const 1
+    ref.null func
+    table.set 0
+    local.get 0
+    table.get 0
+    ref.is_null
+    i32.const 10
+    i32.mul
+    i32.const 1
+    local.get 1
+    table.set 0
+    local.get 1
+    ref.is_null
+    i32.add
+    i32.const 7
+    i32.const 1
+    call_indirect (type 1)
+    i32.add)
+
+  ;; 24: a funcref result
+  (func $refret (export "refret") (type 8) (param i32) (result funcref)
+    ref.func 1
+    ref.null func
+    local.get 0
+    select (result funcref))
+
+  ;; 25: a funcref global set to sel or null, stored into table[0] and called through it
+  (func $refglob (export "refglob") (type 1) (param i32) (result i32)
+    local.get 0
+    if
+      ref.func 5
+      global.set 3
+    else
+      ref.null func
+      global.set 3
+    end
+    i32.const 0
+    global.get 3
+    table.set 0
+    global.get 3
+    ref.is_null
+    if (result i32)
+      i32.const -1
+    else
+      local.get 0
+      i32.const 0
+      call_indirect (type 1)
+    end)
+
+  ;; 26: lowered identity on a funcref, through a local
+  (func $refid (type 9) (param funcref) (result funcref) (local funcref)
+    local.get 0
+    local.set 1
+    local.get 1)
+
+  ;; 27: the same, but not lowered (table.size)
+  (func $refidx (type 9) (param funcref) (result funcref)
+    table.size 0
+    drop
+    local.get 0)
+
+  ;; 28: a funcref passed to and returned from a lowered and a non-lowered function
+  (func $refarg (export "refarg") (type 1) (param i32) (result i32)
+    ref.func 1
+    ref.null func
+    local.get 0
+    select (result funcref)
+    call 26
+    call 27
+    ref.is_null)
+
+  ;; 29: an externref, or null
+  (func $ext (export "ext") (type 10) (param externref i32) (result externref)
+    local.get 0
+    ref.null extern
+    local.get 1
+    select (result externref))
+
+  (elem (i32.const 0) func 1 5))
@@ -0,0 +1,205 @@
+// Runs the same calls with functions lowered to register programs, and on the stack interpreter.
+// test-wasm --stack-interpreter runs every other test (including the spec tests) on the stack interpreter only.
+
+const contents = readBinaryWasmFile("Fixtures/Modules/interpreter-tiers.wasm");
+
+// Makes the calls on a fresh instance, so that changes to memory, globals and tables start out the same on both tiers.
+// A call is either the name of an export and its arguments, or a function that gets the instance.
+function callsOnTier(registerProgramsEnabled, calls) {
+    const wasEnabled = setRegisterProgramsEnabled(registerProgramsEnabled);
+    try {
+        const module = parseWebAssemblyModule(contents);
+        return calls.map(call => {
+            try {
+                if (typeof call === "function") return call(module);
+                const [name, ...args] = call;
+                const result = module.invoke(module.getExport(name), ...args);
+                // v128 results come back as an ArrayBuffer.
+                if (result instanceof ArrayBuffer) return Array.from(new Uint32Array(result));
+                return result;
+            } catch (error) {
+                return error.message;
+            }
+        });
+    } finally {
+        setRegisterProgramsEnabled(wasEnabled);
+    }
+}
+
+function expectBothTiers(calls, expected) {
+    const stackResults = callsOnTier(false, calls);
+    const registerResults = callsOnTier(true, calls);
+    expect(stackResults).toEqual(expected);
+    expect(registerResults).toEqual(expected);
+}
+
+test("loops and arithmetic", () => {
+    // sum(n): adds n, n - 1, ..., 1 into an i64 local.
+    // fsum(n): the same, through an f64 local.
+    // fibi(n): iterative fibonacci, swapping i64 locals on every iteration.
+    expectBothTiers(
+        [
+            ["sum", 0],
+            ["sum", 100000],
+            ["fsum", 1000],
+            ["fibi", 50],
+        ],
+        [0n, 5000050000n, 500500n, 12586269025n]
+    );
+});
+
+test("calls", () => {
+    // fib(n): recursive fibonacci.
+    // ci(i, x): calls table[i](x) indirectly; the table holds fib and sel.
+    expectBothTiers(
+        [
+            ["fib", 20],
+            ["ci", 0, 3],
+            ["ci", 1, 3],
+        ],
+        [6765, 2, 111]
+    );
+});
+
+test("branches and block results", () => {
+    // brtable(x): br_table to one of four nested blocks, returning 10, 20, 30 or the default 99.
+    // tee(x): local.tee, and a block result carried out by br_if.
+    // multi(x): a block with two results, and an if without an else that changes a local.
+    // sel(x): select between 111 and 222.
+    expectBothTiers(
+        [
+            ["brtable", 0],
+            ["brtable", 1],
+            ["brtable", 2],
+            ["brtable", 3],
+            ["brtable", -1],
+            ["tee", 0],
+            ["tee", 5],
+            ["multi", 2],
+            ["multi", 7],
+            ["sel", 0],
+            ["sel", 1],
+        ],
+        [10, 20, 30, 99, 99, -1, 15, 8, 1028, 222, 111]
+    );
+});
+
+test("memory and globals", () => {
+    // mem(x): stores and loads i32, i64 and byte values.
+    // memsum(n): stores and loads back n words in a loop.
+    // grow(n): the result of memory.grow by n pages, plus the memory size after it.
+    // glob(x): adds x to a mutable i32 global, and multiplies it by an i64 global.
+    expectBothTiers(
+        [
+            ["mem", 12345],
+            ["memsum", 1000],
+            ["grow", 1],
+            ["grow", 70000],
+            ["glob", 3],
+            ["glob", 3],
+        ],
+        [1234605616436521016n, 500500n, 3, 1, -50n, -65n]
+    );
+});
+
+test("traps", () => {
+    // div(a, b): i32.div_s.
+    // oob(x): an i32 load from address x.
+    // nestoob(x): the same load, made through a call.
+    expectBothTiers(
+        [
+            ["div", 7, 2],
+            ["div", -7, 2],
+            ["div", 7, 0],
+            ["div", -2147483648, -1],
+            ["oob", 65532],
+            ["oob", 65534],
+            ["nestoob", 65534],
+            ["unr"],
+            ["ci", 2, 3],
+        ],
+        [
+            3,
+            -3,
+            "Execution trapped: Integer division overflow",
+            "Execution trapped: Integer division overflow",
+            0,
+            "Execution trapped: Memory access out of bounds",
+            "Execution trapped: Memory access out of bounds",
+            "Execution trapped: Unreachable",
+            "Execution trapped: static_cast<size_t>(index) < table_instance->elements().size()",
+        ]
+    );
+});
+
+test("v128 values", () => {
+    // vsum(n): adds up v128 values loaded from memory in a loop, through v128 locals.
+    // vret(x): returns the bitwise not of one of two v128 constants.
+    // vcall(x): a v128 result of a call, carried out of blocks by br_if and by falling through.
+    // vglob(): doubles a mutable v128 global.
+    // vcallx(x): passes a v128 to a function that stays on the stack interpreter.
+    expectBothTiers(
+        [
+            ["vsum", 100],
+            ["vret", 0],
+            ["vret", 1],
+            ["vcall", 0],
+            ["vcall", 1],
+            ["vglob"],
+            ["vglob"],
+            ["vcallx", 5],
+        ],
+        [
+            34359803905n,
+            [0, 4294967288, 4294967295, 4294967286],
+            [4294967294, 4294967293, 4294967292, 4294967291],
+            -30064771063n,
+            -51539607564n,
+            16n,
+            32n,
+            27,
+        ]
+    );
+});
+
+test("reference values", () => {
+    // refs(i): ref.func and ref.null in a funcref local, table.get and table.set on table[i], and ref.is_null.
+    // refret(x): selects between ref.func fib and ref.null.
+    // refglob(x): sets a funcref global to sel or to null, stores it into table[0], and calls it from there.
+    // refarg(x): passes a funcref through a lowered function and one that stays on the stack interpreter.
+    // ext(r, x): selects between an externref argument and ref.null.
+    expectBothTiers(
+        [
+            ["refs", 0],
+            ["refs", 1],
+            ["refs", 2],
+            ["refret", 0],
+            module => module.invoke(module.getExport("refret"), 1) === module.getExport("fib"),
+            ["refglob", 0],
+            ["ci", 0, 3],
+            ["refglob", 1],
+            ["ci", 0, 0],
+            ["refarg", 0],
+            ["refarg", 1],
+            ["ext", 7, 1],
+            ["ext", 7, 0],
+            ["ext", null, 1],
+        ],
+        [
+            13,
+            23,
+            "Execution trapped: index < table->elements().size()",
+            null,
+            true,
+            -1,
+            "Execution trapped: element.ref().has<Reference::Func>()",
+            111,
+            222,
+            1,
+            0,
+            7,
+            null,
+            null,
+        ]
+    );
+});
@@ -0,0 +1,39 @@
+const modules = ["Fixtures/Modules/empty-module.wasm", "Fixtures/Modules/interpreter-tiers.wasm"];
+
+for (const path of modules) {
+    describe(path, () => {
+        const contents = readBinaryWasmFile(path);
+        const expected = printWebAssemblyModule(contents);
+
+        test("split in two at every offset", () => {
+            for (let offset = 0; offset <= contents.length; ++offset)
+                expect(printWebAssemblyModule(contents, [offset])).toBe(expected);
+        });
+
+        test("in chunks of every size", () => {
+            for (let size = 1; size <= contents.length; ++size) {
+                const chunkEnds = [];
+                for (let end = size; end < contents.length; end += size) chunkEnds.push(end);
+                expect(printWebAssemblyModule(contents, chunkEnds)).toBe(expected);
+            }
+        });
+
+        test("truncated at every offset", () => {
+            // Cutting the module between two sections leaves a smaller valid module; anywhere else, both parsers fail.
+            for (let length = 0; length < contents.length; ++length) {
+                const truncated = contents.slice(0, length);
+                let whole;
+                try {
+                    whole = printWebAssemblyModule(truncated);
+                } catch (error) {
+                    expect(error).toBeInstanceOf(SyntaxError);
+                    expect(() => printWebAssemblyModule(truncated, [])).toThrow(SyntaxError);
+                    expect(() => printWebAssemblyModule(truncated, [length >> 1])).toThrow(SyntaxError);
+                    continue;
+                }
+                expect(printWebAssemblyModule(truncated, [])).toBe(whole);
+                expect(printWebAssemblyModule(truncated, [length >> 1])).toBe(whole);
+            }
+        });
+    });
+}
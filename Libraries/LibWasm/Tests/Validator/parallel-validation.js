@@ -0,0 +1,94 @@
+function uleb128(value) {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+}
+
+function vector(items) {
+    return [...uleb128(items.length), ...items.flat()];
+}
+
+function section(id, contents) {
+    return [id, ...uleb128(contents.length), ...contents];
+}
+
+// A module with one function of type [] -> [i32] for each of the given bodies.
+function moduleWithFunctions(bodies) {
+    // prettier-ignore
+    return new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        ...section(0x01, vector([[0x60, 0x00, 0x01, 0x7f]])),
+        ...section(0x03, vector(bodies.map(() => [0x00]))),
+        ...section(0x0a, vector(bodies.map(body => [...uleb128(body.length + 1), 0x00, ...body]))),
+    ]);
+}
+
+const valid = [0x41, 0x01, 0x0b]; // i32.const 1
+const returnsI64 = [0x42, 0x01, 0x0b]; // i64.const 1
+const readsMissingLocal = [0x20, 0x05, 0x0b]; // local.get 5
+
+// Enough functions that every thread gets more than the Validator's minimum of 64.
+const functionCount = 1000;
+const threadCounts = [2, 4, 8];
+
+function functionsWith(invalidBodies) {
+    const bodies = new Array(functionCount).fill(valid);
+    for (const [index, body] of invalidBodies) bodies[index] = body;
+    return moduleWithFunctions(bodies);
+}
+
+function expectSameResultOnEveryThreadCount(module, expected) {
+    expect(validateWebAssemblyModule(module, 1)).toBe(expected);
+    for (const threadCount of threadCounts) expect(validateWebAssemblyModule(module, threadCount)).toBe(expected);
+}
+
+test("valid module", () => {
+    expectSameResultOnEveryThreadCount(functionsWith([]), null);
+});
+
+test("one invalid function", () => {
+    for (const index of [0, 15, 16, 500, functionCount - 1]) {
+        expectSameResultOnEveryThreadCount(
+            functionsWith([[index, returnsI64]]),
+            "Invalid stack state, expected i32 but got i64"
+        );
+        expectSameResultOnEveryThreadCount(functionsWith([[index, readsMissingLocal]]), "Invalid LocalIndex");
+    }
+});
+
+test("the first invalid function is reported", () => {
+    expectSameResultOnEveryThreadCount(
+        functionsWith([
+            [500, returnsI64],
+            [700, readsMissingLocal],
+        ]),
+        "Invalid stack state, expected i32 but got i64"
+    );
+    expectSameResultOnEveryThreadCount(
+        functionsWith([
+            [500, readsMissingLocal],
+            [700, returnsI64],
+        ]),
+        "Invalid LocalIndex"
+    );
+    // Both in the same batch of 16 functions, and in neighboring batches.
+    expectSameResultOnEveryThreadCount(
+        functionsWith([
+            [17, readsMissingLocal],
+            [18, returnsI64],
+        ]),
+        "Invalid LocalIndex"
+    );
+    expectSameResultOnEveryThreadCount(
+        functionsWith([
+            [15, returnsI64],
+            [16, readsMissingLocal],
+        ]),
+        "Invalid stack state, expected i32 but got i64"
+    );
+});
@@ -1025,12 +1025,19 @@ public:
     auto& data_count_section() const { return m_data_count_section; }
 
     void set_validation_status(ValidationStatus status, Badge<Validator>) { set_validation_status(status); }
+    void set_function_bodies_validated_by_earlier_run(Badge<ModuleCache>) { m_function_bodies_validated_by_earlier_run = true; }
+    bool function_bodies_validated_by_earlier_run() const { return m_function_bodies_validated_by_earlier_run; }
     ValidationStatus validation_status() const { return m_validation_status; }
     StringView validation_error() const { return *m_validation_error; }
     void set_validation_error(ByteString error) { m_validation_error = move(error); }
 
     static ParseResult<NonnullRefPtr<Module>> parse(Stream& stream);
 
+    // Checks that a section with the given id may follow the last (non-custom) section, and records it as the last one.
+    static ParseResult<void> check_section_order(SectionId, SectionId::SectionIdKind& last_section_id);
+    // Parses the contents of one section into this module, after its id and size have been read.
+    ParseResult<void> parse_section(SectionId, Stream& section_stream);
+
 private:
     void set_validation_status(ValidationStatus status) { m_validation_status = status; }
 
@@ -1049,6 +1056,7 @@ private:
     DataCountSection m_data_count_section;
 
     ValidationStatus m_validation_status { ValidationStatus::Unchecked };
+    bool m_function_bodies_validated_by_earlier_run { false };
     Optional<ByteString> m_validation_error;
 };
 
@@ -218,6 +218,23 @@ void Animatable::clear_transitions(Optional<CSS::PseudoElement> pseudo_element)
     transition.transition_attributes.clear();
 }
 
+bool Animatable::has_animations_or_transitions() const
+{
+    if (!m_impl)
+        return false;
+    if (!m_impl->associated_animations.is_empty())
+        return true;
+    for (auto const& cached_animation_name_source : m_impl->cached_animation_name_source) {
+        if (cached_animation_name_source)
+            return true;
+    }
+    for (auto const& transition : m_impl->transitions) {
+        if (transition && (transition->cached_transition_property_source || !transition->associated_transitions.is_empty()))
+            return true;
+    }
+    return false;
+}
+
 void Animatable::visit_edges(JS::Cell::Visitor& visitor)
 {
     auto& impl = ensure_impl();
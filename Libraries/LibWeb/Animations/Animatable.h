@@ -67,6 +67,8 @@ public:
     GC::Ptr<CSS::CSSTransition> property_transition(Optional<CSS::PseudoElement>, CSS::PropertyID) const;
     void clear_transitions(Optional<CSS::PseudoElement>);
 
+    [[nodiscard]] bool has_animations_or_transitions() const;
+
 protected:
     void visit_edges(JS::Cell::Visitor&);
 
@@ -48,6 +48,121 @@ ComputedProperties::ComputedProperties() = default;
 
 ComputedProperties::~ComputedProperties() = default;
 
+namespace {
+
+struct PropertyGroupSlot {
+    u8 group { 0 };
+    u8 index { 0 };
+};
+
+}
+
+static Array<PropertyGroupSlot, ComputedProperties::number_of_properties> const& property_group_slots()
+{
+    static auto const slots = [] {
+        Array<PropertyGroupSlot, ComputedProperties::number_of_properties> slots;
+        auto const group_size = ComputedProperties::PropertyGroup::size;
+
+        size_t inherited_count = 0;
+        for (size_t i = 0; i < ComputedProperties::number_of_properties; ++i) {
+            if (is_inherited_property(static_cast<PropertyID>(i)))
+                ++inherited_count;
+        }
+
+        size_t next_inherited = 0;
+        size_t next_non_inherited = ceil_div(inherited_count, group_size) * group_size;
+        for (size_t i = 0; i < ComputedProperties::number_of_properties; ++i) {
+            auto& next = is_inherited_property(static_cast<PropertyID>(i)) ? next_inherited : next_non_inherited;
+            slots[i] = { static_cast<u8>(next / group_size), static_cast<u8>(next % group_size) };
+            ++next;
+        }
+        VERIFY(ceil_div(next_non_inherited, group_size) <= ComputedProperties::max_property_group_count);
+        return slots;
+    }();
+    return slots;
+}
+
+bool ComputedProperties::PropertyGroup::has_same_values_as(PropertyGroup const& other) const
+{
+    for (size_t i = 0; i < size; ++i) {
+        auto const& value = values[i];
+        auto const& other_value = other.values[i];
+        if (value == other_value)
+            continue;
+        if (!value || !other_value || *value != *other_value)
+            return false;
+    }
+    return true;
+}
+
+RefPtr<CSSStyleValue const> const& ComputedProperties::value_slot(PropertyID property_id) const
+{
+    static RefPtr<CSSStyleValue const> const null_value;
+    auto slot = property_group_slots()[to_underlying(property_id)];
+    auto const& group = m_property_groups[slot.group];
+    if (!group)
+        return null_value;
+    return group->values[slot.index];
+}
+
+RefPtr<CSSStyleValue const>& ComputedProperties::mutable_value_slot(PropertyID property_id)
+{
+    auto slot = property_group_slots()[to_underlying(property_id)];
+    auto& group = m_property_groups[slot.group];
+    if (!group) {
+        group = make_ref_counted<PropertyGroup>();
+    } else if (group->ref_count() > 1) {
+        auto copy = make_ref_counted<PropertyGroup>();
+        copy->values = group->values;
+        group = move(copy);
+    }
+    return group->values[slot.index];
+}
+
+void ComputedProperties::share_property_groups(ComputedProperties const* parent, PropertyGroups& recent_groups)
+{
+    for (size_t i = 0; i < max_property_group_count; ++i) {
+        auto& group = m_property_groups[i];
+        if (group) {
+            if (parent && parent->m_property_groups[i] && group->has_same_values_as(*parent->m_property_groups[i]))
+                group = parent->m_property_groups[i];
+            else if (recent_groups[i] && group->has_same_values_as(*recent_groups[i]))
+                group = recent_groups[i];
+        }
+        recent_groups[i] = group;
+    }
+}
+
+void ComputedProperties::measure_memory_usage(MemoryUsage& usage) const
+{
+    auto const fixed_size = sizeof(ComputedProperties) - sizeof(m_property_groups);
+    auto const animated_size = m_animated_property_values.capacity() * (sizeof(PropertyID) + sizeof(NonnullRefPtr<CSSStyleValue const>));
+
+    ++usage.style_count;
+    usage.bytes += sizeof(ComputedProperties) + animated_size;
+    usage.bytes_without_shared_groups += fixed_size + number_of_properties * sizeof(RefPtr<CSSStyleValue const>) + animated_size;
+    for (auto const& group : m_property_groups) {
+        if (group && usage.counted_groups.set(group.ptr()) == HashSetResult::InsertedNewEntry)
+            usage.bytes += sizeof(PropertyGroup);
+    }
+}
+
+GC::Ref<ComputedProperties> ComputedProperties::clone(GC::Heap& heap) const
+{
+    auto clone = heap.allocate<ComputedProperties>();
+    clone->m_animation_name_source = m_animation_name_source;
+    clone->m_transition_property_source = m_transition_property_source;
+    clone->m_property_groups = m_property_groups;
+    clone->m_property_important = m_property_important;
+    clone->m_property_inherited = m_property_inherited;
+    clone->m_math_depth = m_math_depth;
+    clone->m_font_list = m_font_list;
+    clone->m_first_available_computed_font = m_first_available_computed_font;
+    clone->m_line_height = m_line_height;
+    clone->m_attempted_pseudo_class_matches = m_attempted_pseudo_class_matches;
+    return clone;
+}
+
 void ComputedProperties::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -87,14 +202,14 @@ void ComputedProperties::set_property_inherited(PropertyID property_id, Inherite
 
 void ComputedProperties::set_property(PropertyID id, NonnullRefPtr<CSSStyleValue const> value, Inherited inherited, Important important)
 {
-    m_property_values[to_underlying(id)] = move(value);
+    mutable_value_slot(id) = move(value);
     set_property_important(id, important);
     set_property_inherited(id, inherited);
 }
 
 void ComputedProperties::revert_property(PropertyID id, ComputedProperties const& style_for_revert)
 {
-    m_property_values[to_underlying(id)] = style_for_revert.m_property_values[to_underlying(id)];
+    mutable_value_slot(id) = style_for_revert.value_slot(id);
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 }
@@ -117,14 +232,14 @@ CSSStyleValue const& ComputedProperties::property(PropertyID property_id, WithAn
     }
 
     // By the time we call this method, all properties have values assigned.
-    return *m_property_values[to_underlying(property_id)];
+    return *value_slot(property_id);
 }
 
 CSSStyleValue const* ComputedProperties::maybe_null_property(PropertyID property_id) const
 {
     if (auto animated_value = m_animated_property_values.get(property_id); animated_value.has_value())
         return animated_value.value();
-    return m_property_values[to_underlying(property_id)];
+    return value_slot(property_id).ptr();
 }
 
 Variant<LengthPercentage, NormalGap> ComputedProperties::gap_value(PropertyID id) const
@@ -730,25 +845,29 @@ Positioning ComputedProperties::position() const
 
 bool ComputedProperties::operator==(ComputedProperties const& other) const
 {
-    if (m_property_values.size() != other.m_property_values.size())
-        return false;
-
-    for (size_t i = 0; i < m_property_values.size(); ++i) {
-        auto const& my_style = m_property_values[i];
-        auto const& other_style = other.m_property_values[i];
-        if (!my_style) {
-            if (other_style)
-                return false;
+    for (size_t i = 0; i < max_property_group_count; ++i) {
+        auto const& my_group = m_property_groups[i];
+        auto const& other_group = other.m_property_groups[i];
+        if (my_group == other_group)
             continue;
+        // A style without a group has no values for any of its properties.
+        for (size_t j = 0; j < PropertyGroup::size; ++j) {
+            CSSStyleValue const* my_style = my_group ? my_group->values[j].ptr() : nullptr;
+            CSSStyleValue const* other_style = other_group ? other_group->values[j].ptr() : nullptr;
+            if (!my_style) {
+                if (other_style)
+                    return false;
+                continue;
+            }
+            if (!other_style)
+                return false;
+            auto const& my_value = *my_style;
+            auto const& other_value = *other_style;
+            if (my_value.type() != other_value.type())
+                return false;
+            if (my_value != other_value)
+                return false;
         }
-        if (!other_style)
-            return false;
-        auto const& my_value = *my_style;
-        auto const& other_value = *other_style;
-        if (my_value.type() != other_value.type())
-            return false;
-        if (my_value != other_value)
-            return false;
     }
 
     return true;
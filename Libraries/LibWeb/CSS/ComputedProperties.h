@@ -8,7 +8,9 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Ptr.h>
 #include <LibGfx/Font/Font.h>
@@ -32,14 +34,28 @@ public:
     static constexpr double normal_line_height_scale = 1.15;
     static constexpr size_t number_of_properties = to_underlying(last_property_id) + 1;
 
+    // Property values are stored in fixed-size groups, which styles share until one of them changes a value in the group.
+    // Properties are assigned to groups in PropertyID order, which keeps e.g. all the background-* or grid-* properties
+    // together, with inherited and non-inherited properties in separate groups. That way an element can share the
+    // inherited groups of its parent, and the non-inherited groups of any other element that has the same values there.
+    struct PropertyGroup : public RefCounted<PropertyGroup> {
+        static constexpr size_t size = 16;
+
+        bool has_same_values_as(PropertyGroup const&) const;
+
+        Array<RefPtr<CSSStyleValue const>, size> values;
+    };
+    static constexpr size_t max_property_group_count = ceil_div(number_of_properties, PropertyGroup::size) + 1;
+    using PropertyGroups = Array<RefPtr<PropertyGroup>, max_property_group_count>;
+
     virtual ~ComputedProperties() override;
 
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_property_values.size(); ++i) {
-            if (m_property_values[i])
-                callback((PropertyID)i, *m_property_values[i]);
+        for (size_t i = 0; i < number_of_properties; ++i) {
+            if (auto const& value = value_slot((PropertyID)i))
+                callback((PropertyID)i, *value);
         }
     }
 
@@ -219,6 +235,16 @@ public:
 
     bool operator==(ComputedProperties const&) const;
 
+    struct MemoryUsage {
+        size_t style_count { 0 };
+        size_t bytes { 0 };
+        // What the same styles would take up if every one of them stored all of its values by itself.
+        size_t bytes_without_shared_groups { 0 };
+        HashTable<PropertyGroup const*> counted_groups;
+    };
+    // Adds this style to the tally, counting each property group once no matter how many styles share it.
+    void measure_memory_usage(MemoryUsage&) const;
+
     Positioning position() const;
     Optional<int> z_index() const;
 
@@ -250,6 +276,17 @@ private:
 
     ComputedProperties();
 
+    // Used by the style sharing cache. Animated values are left out, as they belong to the element they were applied to.
+    GC::Ref<ComputedProperties> clone(GC::Heap&) const;
+
+    // Replaces each of this style's property groups with the matching group of the parent style or with the one most
+    // recently computed, if it holds the same values, and then remembers this style's groups as the most recent ones.
+    void share_property_groups(ComputedProperties const* parent, PropertyGroups& recent_groups);
+
+    RefPtr<CSSStyleValue const> const& value_slot(PropertyID) const;
+    // Gives this style its own copy of the property's group first, if it's shared with other styles.
+    RefPtr<CSSStyleValue const>& mutable_value_slot(PropertyID);
+
     virtual void visit_edges(Visitor&) override;
 
     Overflow overflow(PropertyID) const;
@@ -258,7 +295,7 @@ private:
     GC::Ptr<CSSStyleDeclaration const> m_animation_name_source;
     GC::Ptr<CSSStyleDeclaration const> m_transition_property_source;
 
-    Array<RefPtr<CSSStyleValue const>, number_of_properties> m_property_values;
+    PropertyGroups m_property_groups;
     Array<u8, ceil_div(number_of_properties, 8uz)> m_property_important {};
     Array<u8, ceil_div(number_of_properties, 8uz)> m_property_inherited {};
 
@@ -1223,6 +1223,14 @@ bool matches(CSS::Selector const& selector, DOM::Element const& element, GC::Ptr
     return matches(selector, selector.compound_selectors().size() - 1, element, shadow_host, context, scope, selector_kind, anchor);
 }
 
+bool element_matches_pseudo_class(CSS::PseudoClass pseudo_class, DOM::Element const& element)
+{
+    VERIFY(CSS::pseudo_class_metadata(pseudo_class).parameter_type == CSS::PseudoClassMetadata::ParameterType::None);
+    CSS::Selector::SimpleSelector::PseudoClassSelector pseudo_class_selector { .type = pseudo_class };
+    MatchContext context;
+    return matches_pseudo_class(pseudo_class_selector, element, nullptr, context, nullptr, SelectorKind::Normal);
+}
+
 static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& simple_selector, DOM::Element const& element, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context)
 {
     if (should_block_shadow_host_matching(simple_selector, shadow_host, element))
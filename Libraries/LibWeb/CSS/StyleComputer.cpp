@@ -1759,7 +1759,7 @@ NonnullRefPtr<CSSStyleValue const> StyleComputer::get_inherit_value(CSS::Propert
 
 void StyleComputer::compute_defaulted_property_value(ComputedProperties& style, DOM::Element const* element, CSS::PropertyID property_id, Optional<CSS::PseudoElement> pseudo_element) const
 {
-    auto& value_slot = style.m_property_values[to_underlying(property_id)];
+    auto& value_slot = style.mutable_value_slot(property_id);
     if (!value_slot) {
         if (is_inherited_property(property_id)) {
             style.set_property(
@@ -2249,7 +2249,7 @@ void StyleComputer::absolutize_values(ComputedProperties& style, GC::Ptr<DOM::El
     //       We have to resolve them right away, so that the *computed* line-height is ready for inheritance.
     //       We can't simply absolutize *all* percentage values against the font size,
     //       because most percentages are relative to containing block metrics.
-    auto& line_height_value_slot = style.m_property_values[to_underlying(CSS::PropertyID::LineHeight)];
+    auto& line_height_value_slot = style.mutable_value_slot(CSS::PropertyID::LineHeight);
     if (line_height_value_slot && line_height_value_slot->is_percentage()) {
         line_height_value_slot = LengthStyleValue::create(
             Length::make_px(CSSPixels::nearest_value_for(font_size * static_cast<double>(line_height_value_slot->as_percentage().percentage().as_fraction()))));
@@ -2262,11 +2262,14 @@ void StyleComputer::absolutize_values(ComputedProperties& style, GC::Ptr<DOM::El
     if (line_height_value_slot && line_height_value_slot->is_length())
         line_height_value_slot = LengthStyleValue::create(Length::make_px(line_height));
 
-    for (size_t i = 0; i < style.m_property_values.size(); ++i) {
-        auto& value_slot = style.m_property_values[i];
-        if (!value_slot)
+    for (size_t i = 0; i < ComputedProperties::number_of_properties; ++i) {
+        auto property_id = static_cast<CSS::PropertyID>(i);
+        auto const& value = style.value_slot(property_id);
+        if (!value)
             continue;
-        value_slot = value_slot->absolutized(viewport_rect(), font_metrics, m_root_element_font_metrics);
+        auto absolutized_value = value->absolutized(viewport_rect(), font_metrics, m_root_element_font_metrics);
+        if (absolutized_value.ptr() != value.ptr())
+            style.mutable_value_slot(property_id) = move(absolutized_value);
     }
 
     style.set_line_height({}, line_height);
@@ -2502,6 +2505,12 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    bool can_use_style_sharing = m_style_sharing_enabled && mode == ComputeStyleMode::Normal && !pseudo_element.has_value();
+    if (can_use_style_sharing) {
+        if (auto style = share_style_of_sibling_if_possible(element))
+            return style;
+    }
+
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
     PseudoClassBitmap attempted_pseudo_class_matches;
@@ -2540,9 +2549,136 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
 
     auto computed_properties = compute_properties(element, pseudo_element, cascaded_properties);
     computed_properties->set_attempted_pseudo_class_matches(attempted_pseudo_class_matches);
+    if (can_use_style_sharing)
+        remember_style_for_sharing(element, computed_properties);
     return computed_properties;
 }
 
+void StyleComputer::start_style_sharing()
+{
+    m_style_sharing_enabled = true;
+    m_style_sharing_statistics = {};
+}
+
+void StyleComputer::stop_style_sharing()
+{
+    m_style_sharing_enabled = false;
+    m_style_sharing_cache.clear();
+}
+
+void StyleComputer::visit_edges(GC::Cell::Visitor& visitor) const
+{
+    for (auto const& candidate : m_style_sharing_cache) {
+        visitor.visit(candidate.element);
+        visitor.visit(candidate.parent_style);
+        visitor.visit(candidate.style);
+    }
+}
+
+// Whether the element's style depends on nothing but its ancestors, its tag name, its attributes and its state.
+// Style is only shared between siblings, so that selectors that look at ancestors match them in the same way.
+static bool is_eligible_for_style_sharing(DOM::Element const& element)
+{
+    auto const* parent = element.parent_or_shadow_host_element();
+    if (!parent || !parent->computed_properties())
+        return false;
+    // NOTE: IDs are unique, so there's no use in looking for another element with the same one.
+    if (element.id().has_value() || element.is_shadow_host())
+        return false;
+    // NOTE: Animations and transitions live on the element, and computing the style is what keeps them up to date.
+    if (element.has_animations_or_transitions())
+        return false;
+    return true;
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    bool same = true;
+    a.for_each_attribute([&](DOM::Attr const& attribute) {
+        if (!same)
+            return;
+        auto value = b.get_attribute_ns(attribute.namespace_uri(), attribute.local_name());
+        same = value.has_value() && *value == attribute.value();
+    });
+    return same;
+}
+
+// Selectors only ever attempted to match these pseudo-classes against the candidate, so if the element is in the same
+// state for all of them, matching it would take the same path and arrive at the same rules.
+static bool matches_same_pseudo_classes(DOM::Element const& candidate, DOM::Element const& element, ComputedProperties const& candidate_style)
+{
+    for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
+        auto pseudo_class = static_cast<PseudoClass>(i);
+        if (!candidate_style.has_attempted_match_against_pseudo_class(pseudo_class))
+            continue;
+        // NOTE: Pseudo-classes with arguments either select by other simple selectors (which were recorded separately),
+        //       look at ancestors or attributes (which are the same), or rule out sharing when the candidate is remembered.
+        if (pseudo_class_metadata(pseudo_class).parameter_type != PseudoClassMetadata::ParameterType::None)
+            continue;
+        if (SelectorEngine::element_matches_pseudo_class(pseudo_class, candidate) != SelectorEngine::element_matches_pseudo_class(pseudo_class, element))
+            return false;
+    }
+    return true;
+}
+
+GC::Ptr<ComputedProperties> StyleComputer::share_style_of_sibling_if_possible(DOM::Element& element) const
+{
+    if (!is_eligible_for_style_sharing(element))
+        return {};
+    ++m_style_sharing_statistics.lookups;
+
+    auto const* parent = element.parent_or_shadow_host_element();
+    auto parent_style = parent->computed_properties();
+
+    for (size_t i = 0; i < m_style_sharing_cache.size(); ++i) {
+        auto const& candidate = m_style_sharing_cache[i];
+        if (candidate.element.ptr() == &element || candidate.parent_style.ptr() != parent_style.ptr())
+            continue;
+        if (candidate.element->parent() != element.parent() || candidate.element->computed_properties().ptr() != candidate.style.ptr())
+            continue;
+        if (candidate.element->local_name() != element.local_name() || candidate.element->namespace_uri() != element.namespace_uri())
+            continue;
+        if (!have_same_attributes(candidate.element, element) || !matches_same_pseudo_classes(candidate.element, element, candidate.style))
+            continue;
+
+        // NOTE: The cascaded values are only read from, so they can be shared outright. The computed values are copied,
+        //       as the element may go on to adjust them (e.g. by running animations).
+        element.set_cascaded_properties({}, candidate.element->cascaded_properties({}));
+        element.set_custom_properties({}, candidate.element->custom_properties({}));
+        if (candidate.element->style_uses_css_custom_properties())
+            element.set_style_uses_css_custom_properties(true);
+        auto style = candidate.style->clone(m_document->heap());
+
+        if (i != 0)
+            m_style_sharing_cache.prepend(m_style_sharing_cache.take(i));
+        ++m_style_sharing_statistics.hits;
+        return style;
+    }
+    return {};
+}
+
+void StyleComputer::remember_style_for_sharing(DOM::Element const& element, ComputedProperties const& style) const
+{
+    if (!is_eligible_for_style_sharing(element))
+        return;
+
+    // Selectors that look at siblings or descendants can match elements differently even if they look alike.
+    if (element.style_affected_by_structural_changes() || element.affected_by_has_pseudo_class_in_subject_position())
+        return;
+    if (style.has_attempted_match_against_pseudo_class(PseudoClass::Has) || style.has_attempted_match_against_pseudo_class(PseudoClass::Dir))
+        return;
+
+    // Computing this style is what starts its animations and transitions, so it can't be shared.
+    if (style.animation_name_source() || style.transition_property_source())
+        return;
+
+    if (m_style_sharing_cache.size() == style_sharing_cache_size)
+        m_style_sharing_cache.take_last();
+    m_style_sharing_cache.prepend({ element, *element.parent_or_shadow_host_element()->computed_properties(), style });
+}
+
 static bool is_monospace(CSSStyleValue const& value)
 {
     if (value.to_keyword() == Keyword::Monospace)
@@ -2774,6 +2910,10 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& elem
         start_needed_transitions(*previous_style, computed_style, element, pseudo_element);
     }
 
+    // 10. Share the property groups that hold the same values as those of the parent or of the last computed style
+    auto const* inheritance_parent = element_to_inherit_style_from(&element, pseudo_element);
+    computed_style->share_property_groups(inheritance_parent ? inheritance_parent->computed_properties().ptr() : nullptr, m_recent_property_groups);
+
     return computed_style;
 }
 
@@ -18,6 +18,7 @@
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
 #include <LibWeb/CSS/CascadeOrigin.h>
 #include <LibWeb/CSS/CascadedProperties.h>
+#include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleInvalidationData.h>
 #include <LibWeb/Forward.h>
@@ -151,6 +152,20 @@ public:
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    // Lets siblings that match the same rules in the same way share the work of computing their style.
+    // NOTE: This is only valid while the DOM can't change, so it's limited to the duration of a style update.
+    void start_style_sharing();
+    void stop_style_sharing();
+
+    // Keeps the elements and styles that are candidates for sharing alive while style sharing is on.
+    void visit_edges(GC::Cell::Visitor&) const;
+
+    struct StyleSharingStatistics {
+        size_t lookups { 0 };
+        size_t hits { 0 };
+    };
+    StyleSharingStatistics const& style_sharing_statistics() const { return m_style_sharing_statistics; }
+
     [[nodiscard]] GC::Ref<ComputedProperties> create_document_style() const;
 
     [[nodiscard]] GC::Ref<ComputedProperties> compute_style(DOM::Element&, Optional<CSS::PseudoElement> = {}) const;
@@ -210,6 +225,8 @@ private:
     struct MatchingFontCandidate;
 
     [[nodiscard]] GC::Ptr<ComputedProperties> compute_style_impl(DOM::Element&, Optional<CSS::PseudoElement>, ComputeStyleMode) const;
+    [[nodiscard]] GC::Ptr<ComputedProperties> share_style_of_sibling_if_possible(DOM::Element&) const;
+    void remember_style_for_sharing(DOM::Element const&, ComputedProperties const&) const;
     [[nodiscard]] GC::Ref<CascadedProperties> compute_cascaded_values(DOM::Element&, Optional<CSS::PseudoElement>, bool& did_match_any_pseudo_element_rules, PseudoClassBitmap& attempted_pseudo_class_matches, ComputeStyleMode) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
@@ -307,6 +324,21 @@ private:
     CSSPixelRect m_viewport_rect;
 
     CountingBloomFilter<u8, 14> m_ancestor_filter;
+
+    struct StyleSharingCandidate {
+        GC::Ref<DOM::Element const> element;
+        GC::Ref<ComputedProperties const> parent_style;
+        GC::Ref<ComputedProperties const> style;
+    };
+
+    // Most recently used first.
+    static constexpr size_t style_sharing_cache_size = 16;
+    mutable Vector<StyleSharingCandidate, style_sharing_cache_size> m_style_sharing_cache;
+    mutable StyleSharingStatistics m_style_sharing_statistics;
+    bool m_style_sharing_enabled { false };
+
+    // The property groups of the last style we computed, which the next one gets to share where its values are the same.
+    mutable ComputedProperties::PropertyGroups m_recent_property_groups;
 };
 
 class FontLoader : public Weakable<FontLoader> {
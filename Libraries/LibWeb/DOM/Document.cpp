@@ -525,6 +525,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_window);
     visitor.visit(m_layout_root);
     visitor.visit(m_style_sheets);
+    m_style_computer->visit_edges(visitor);
     visitor.visit(m_hovered_node);
     visitor.visit(m_inspected_node);
     visitor.visit(m_highlighted_node);
@@ -1553,7 +1554,31 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+    style_computer().start_style_sharing();
+    ScopeGuard stop_style_sharing = [&] { style_computer().stop_style_sharing(); };
     auto invalidation = update_style_recursively(*this, style_computer(), false);
+
+    if constexpr (UPDATE_LAYOUT_DEBUG) {
+        auto const& statistics = style_computer().style_sharing_statistics();
+        auto hit_rate = statistics.lookups ? statistics.hits * 100 / statistics.lookups : 0;
+        dbgln("STYLE {} µs, style sharing: {} hits of {} lookups ({}%)", timer.elapsed_time().to_microseconds(), statistics.hits, statistics.lookups, hit_rate);
+
+        CSS::ComputedProperties::MemoryUsage memory_usage;
+        for_each_shadow_including_inclusive_descendant([&](Node& node) {
+            if (auto* element = as_if<Element>(node); element && element->computed_properties())
+                element->computed_properties()->measure_memory_usage(memory_usage);
+            return TraversalDecision::Continue;
+        });
+        if (memory_usage.style_count) {
+            dbgln("STYLE MEMORY {} elements, {} bytes per element ({} without shared property groups)",
+                memory_usage.style_count,
+                memory_usage.bytes / memory_usage.style_count,
+                memory_usage.bytes_without_shared_groups / memory_usage.style_count);
+        }
+    }
+
     if (!invalidation.is_none())
         invalidate_display_list();
     if (invalidation.rebuild_stacking_context_tree)
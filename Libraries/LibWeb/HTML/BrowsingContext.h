@@ -87,6 +87,7 @@ private:
     explicit BrowsingContext(GC::Ref<Page>);
 
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void revoke_weak_ptrs_before_sweep() override { revoke_weak_ptrs(); }
 
     GC::Ref<Page> m_page;
 
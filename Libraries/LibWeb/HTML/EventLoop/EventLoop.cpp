@@ -214,6 +214,14 @@ void EventLoop::process()
         for (auto& win : same_loop_windows()) {
             win->start_an_idle_period();
         }
+
+        // OPTIMIZATION: If no idle callbacks were queued, use what's left of the idle period to collect garbage,
+        //               so that it's less likely that a collection has to interrupt a task later on.
+        if (!m_task_queue->has_runnable_tasks()) {
+            auto time_remaining = compute_deadline() - HighResolutionTime::unsafe_shared_current_time();
+            if (time_remaining > 0)
+                heap().collect_garbage_if_idle(AK::Duration::from_microseconds(static_cast<i64>(time_remaining * 1000)));
+        }
     }
 
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
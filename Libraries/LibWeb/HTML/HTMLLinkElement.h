@@ -68,6 +68,11 @@ private:
 
     // ^HTMLElement
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void revoke_weak_ptrs_before_sweep() override
+    {
+        Base::revoke_weak_ptrs_before_sweep();
+        ResourceClient::revoke_weak_ptrs();
+    }
     virtual bool is_implicitly_potentially_render_blocking() const override;
 
     struct LinkProcessingOptions {
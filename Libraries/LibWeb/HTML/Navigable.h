@@ -204,6 +204,7 @@ protected:
 
     virtual void visit_edges(Cell::Visitor&) override;
     virtual void finalize() override;
+    virtual void revoke_weak_ptrs_before_sweep() override { revoke_weak_ptrs(); }
 
     // https://html.spec.whatwg.org/multipage/browsing-the-web.html#ongoing-navigation
     Variant<Empty, Traversal, String> m_ongoing_navigation;
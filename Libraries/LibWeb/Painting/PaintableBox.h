@@ -368,6 +368,12 @@ public:
             visitor.visit(GC::Ref { fragment.layout_node() });
     }
 
+    virtual void revoke_weak_ptrs_before_sweep() override
+    {
+        Base::revoke_weak_ptrs_before_sweep();
+        revoke_weak_ptrs();
+    }
+
     virtual void resolve_paint_properties() override;
 
     size_t line_index() const { return m_line_index; }
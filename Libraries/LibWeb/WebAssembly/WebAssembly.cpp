@@ -6,9 +6,11 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Debug.h>
 #include <AK/MemoryStream.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -19,9 +21,12 @@
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
 #include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/Parser/StreamingParser.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/ResponsePrototype.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
 #include <LibWeb/Fetch/Response.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
@@ -38,6 +43,7 @@
 namespace Web::WebAssembly {
 
 static GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM&, ByteBuffer, HTML::Task::Source = HTML::Task::Source::Unspecified);
+static void queue_a_task_to_settle_compilation(JS::VM&, JS::Realm&, GC::Ref<WebIDL::Promise>, JS::ThrowCompletionOr<NonnullRefPtr<Detail::CompiledWebAssemblyModule>>, HTML::Task::Source);
 static GC::Ref<WebIDL::Promise> instantiate_promise_of_module(JS::VM&, GC::Ref<WebIDL::Promise>, GC::Ptr<JS::Object> import_object);
 static GC::Ref<WebIDL::Promise> asynchronously_instantiate_webassembly_module(JS::VM&, GC::Ref<Module>, GC::Ptr<JS::Object> import_object);
 static GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM&, GC::Ref<WebIDL::Promise>);
@@ -45,12 +51,28 @@ static GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM&,
 namespace Detail {
 
 HashMap<GC::Ptr<JS::Object>, WebAssemblyCache> s_caches;
+static OwnPtr<Wasm::ModuleCache> s_module_cache;
 
 WebAssemblyCache& get_cache(JS::Realm& realm)
 {
     return s_caches.ensure(realm.global_object());
 }
 
+Wasm::ModuleCache const* module_cache()
+{
+    return s_module_cache.ptr();
+}
+
+}
+
+void set_module_cache_directory(ByteString directory)
+{
+    auto module_cache = Wasm::ModuleCache::create(directory);
+    if (module_cache.is_error()) {
+        dbgln("Unable to use {} as the WebAssembly module cache: {}", directory, module_cache.error());
+        return;
+    }
+    Detail::s_module_cache = module_cache.release_value();
 }
 
 void visit_edges(JS::Object& object, JS::Cell::Visitor& visitor)
@@ -401,7 +423,9 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
         return vm.throw_completion<LinkError>(MUST(builder.to_string()));
     }
 
+    auto instantiate_timer = Core::ElapsedTimer::start_new();
     auto instance_result = cache.abstract_machine().instantiate(module, link_result.release_value());
+    dbgln_if(LIBWEB_WASM_DEBUG, "Instantiated WebAssembly module in {}ms", instantiate_timer.elapsed_milliseconds());
     if (instance_result.is_error()) {
         return vm.throw_completion<LinkError>(instance_result.error().error);
     }
@@ -409,24 +433,82 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
     return instance_result.release_value();
 }
 
-// // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
-JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+// The part of https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module that follows decoding.
+static JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_parsed_webassembly_module(JS::VM& vm, Wasm::ParseResult<NonnullRefPtr<Wasm::Module>> module_result, Optional<Wasm::ModuleCache::Key> const& cache_key)
 {
-    FixedMemoryStream stream { data.bytes() };
-    auto module_result = Wasm::Module::parse(stream);
     if (module_result.is_error()) {
         return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
     }
 
+    auto* module_cache = Detail::module_cache();
+    auto found_in_module_cache = module_cache && cache_key.has_value() && module_cache->load(module_result.value(), *cache_key);
+    if (found_in_module_cache)
+        dbgln_if(LIBWEB_WASM_DEBUG, "Found WebAssembly module in the module cache, skipping validation of its function bodies");
+
     auto& cache = get_cache(*vm.current_realm());
-    if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
+    auto validate_timer = Core::ElapsedTimer::start_new();
+    auto validation_result = cache.abstract_machine().validate(module_result.value());
+    dbgln_if(LIBWEB_WASM_DEBUG, "Validated WebAssembly module in {}ms", validate_timer.elapsed_milliseconds());
+    if (validation_result.is_error()) {
         return vm.throw_completion<CompileError>(validation_result.error().error_string);
     }
+    if (module_cache && cache_key.has_value() && !found_in_module_cache)
+        module_cache->store(module_result.value(), *cache_key);
     auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
     cache.add_compiled_module(compiled_module);
     return compiled_module;
 }
 
+// // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+{
+    FixedMemoryStream stream { data.bytes() };
+    auto parse_timer = Core::ElapsedTimer::start_new();
+    auto module_result = Wasm::Module::parse(stream);
+    dbgln_if(LIBWEB_WASM_DEBUG, "Parsed WebAssembly module of {} bytes in {}ms", data.size(), parse_timer.elapsed_milliseconds());
+
+    Optional<Wasm::ModuleCache::Key> cache_key;
+    if (module_cache())
+        cache_key = Wasm::ModuleCache::key_for(data.bytes());
+    return compile_a_parsed_webassembly_module(vm, move(module_result), cache_key);
+}
+
+// Like compile_a_webassembly_module(), but for bytes that arrive over time. Decoding happens as they arrive, and only
+// validation is left to do once they've all been received.
+class StreamingCompilation : public RefCounted<StreamingCompilation> {
+public:
+    void append(ReadonlyBytes bytes)
+    {
+        if (m_error.has_value())
+            return;
+        if (m_cache_key_builder)
+            m_cache_key_builder->append(bytes);
+        auto timer = Core::ElapsedTimer::start_new();
+        if (auto result = m_parser.append(bytes); result.is_error())
+            m_error = result.error();
+        m_parse_time += timer.elapsed_time();
+    }
+
+    JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> finish(JS::VM& vm)
+    {
+        auto timer = Core::ElapsedTimer::start_new();
+        auto module_result = m_error.has_value() ? Wasm::ParseResult<NonnullRefPtr<Wasm::Module>> { *m_error } : m_parser.finish();
+        m_parse_time += timer.elapsed_time();
+        dbgln_if(LIBWEB_WASM_DEBUG, "Parsed streamed WebAssembly module of {} bytes in {}ms", m_parser.bytes_received(), m_parse_time.to_milliseconds());
+
+        Optional<Wasm::ModuleCache::Key> cache_key;
+        if (m_cache_key_builder)
+            cache_key = m_cache_key_builder->finish();
+        return compile_a_parsed_webassembly_module(vm, move(module_result), cache_key);
+    }
+
+private:
+    Wasm::StreamingParser m_parser;
+    OwnPtr<Wasm::ModuleCache::KeyBuilder> m_cache_key_builder { module_cache() ? make<Wasm::ModuleCache::KeyBuilder>() : nullptr };
+    Optional<Wasm::ParseError> m_error;
+    AK::Duration m_parse_time;
+};
+
 GC_DEFINE_ALLOCATOR(ExportedWasmFunction);
 
 GC::Ref<ExportedWasmFunction> ExportedWasmFunction::create(JS::Realm& realm, FlyString const& name, Function<JS::ThrowCompletionOr<JS::Value>(JS::VM&)> behavior, Wasm::FunctionAddress exported_address)
@@ -643,31 +725,37 @@ GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, B
         auto module_or_error = Detail::compile_a_webassembly_module(vm, move(bytes));
 
         // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
-        HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
-            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
-            auto& realm = HTML::relevant_realm(*promise->promise());
-
-            // 1. If module is error, reject promise with a CompileError exception.
-            if (module_or_error.is_error()) {
-                WebIDL::reject_promise(realm, promise, module_or_error.error_value());
-            }
-
-            // 2. Otherwise,
-            else {
-                // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
-                // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
-                auto module_object = realm.create<Module>(realm, module_or_error.release_value());
-
-                // 2. Resolve promise with moduleObject.
-                WebIDL::resolve_promise(realm, promise, module_object);
-            }
-        }));
+        queue_a_task_to_settle_compilation(vm, realm, promise, move(module_or_error), task_source);
     }));
 
     // 3. Return promise.
     return promise;
 }
 
+// https://webassembly.github.io/spec/js-api/#asynchronously-compile-a-webassembly-module, step 2.2
+void queue_a_task_to_settle_compilation(JS::VM& vm, JS::Realm& realm, GC::Ref<WebIDL::Promise> promise, JS::ThrowCompletionOr<NonnullRefPtr<Detail::CompiledWebAssemblyModule>> module_or_error, HTML::Task::Source task_source)
+{
+    HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+        auto& realm = HTML::relevant_realm(*promise->promise());
+
+        // 1. If module is error, reject promise with a CompileError exception.
+        if (module_or_error.is_error()) {
+            WebIDL::reject_promise(realm, promise, module_or_error.error_value());
+        }
+
+        // 2. Otherwise,
+        else {
+            // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
+            // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
+            auto module_object = realm.create<Module>(realm, module_or_error.release_value());
+
+            // 2. Resolve promise with moduleObject.
+            WebIDL::resolve_promise(realm, promise, module_object);
+        }
+    }));
+}
+
 // https://webassembly.github.io/spec/js-api/#asynchronously-instantiate-a-webassembly-module
 GC::Ref<WebIDL::Promise> asynchronously_instantiate_webassembly_module(JS::VM& vm, GC::Ref<Module> module_object, GC::Ptr<JS::Object> import_object)
 {
@@ -828,42 +916,43 @@ GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, GC::
         }
 
         // 8. Consume response’s body as an ArrayBuffer, and let bodyPromise be the result.
-        auto body_promise_or_error = response_object.array_buffer();
-        if (body_promise_or_error.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(realm.vm(), body_promise_or_error.release_error());
-            WebIDL::reject_promise(realm, return_value, throw_completion.value());
+        // NOTE: Rather than waiting for the whole body and compiling it afterwards (steps 9 and 10), we decode each chunk
+        //       of it as soon as it arrives, which the note above allows for. The body is read just like consuming it
+        //       would, and the outcome is the same, so the difference isn't observable.
+        if (response_object.is_unusable()) {
+            WebIDL::reject_promise(realm, return_value, vm.throw_completion<JS::TypeError>("Body is unusable"sv).value());
             return JS::js_undefined();
         }
-        auto body_promise = body_promise_or_error.release_value();
 
         // 9. Upon fulfillment of bodyPromise with value bodyArrayBuffer:
-        auto body_fulfillment_steps = GC::create_function(vm.heap(), [&vm, return_value](JS::Value body_array_buffer) -> WebIDL::ExceptionOr<JS::Value> {
-            // 1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
-            VERIFY(body_array_buffer.is_object());
-            auto stable_bytes = WebIDL::get_buffer_source_copy(body_array_buffer.as_object());
-            if (stable_bytes.is_error()) {
-                VERIFY(stable_bytes.error().code() == ENOMEM);
-                WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, vm.throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory)).value());
-                return JS::js_undefined();
-            }
-
-            // 2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
-            auto result = asynchronously_compile_webassembly_module(vm, stable_bytes.release_value(), HTML::Task::Source::Networking);
-
-            // Need to manually convert WebIDL promise to an ECMAScript value here to resolve
-            WebIDL::resolve_promise(HTML::relevant_realm(*return_value->promise()), return_value, result->promise());
-
-            return JS::js_undefined();
+        //    1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
+        //    2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
+        auto compilation_promise = WebIDL::create_promise(realm);
+        WebIDL::resolve_promise(realm, return_value, compilation_promise->promise());
+
+        auto compilation = make_ref_counted<Detail::StreamingCompilation>();
+        auto process_body_chunk = GC::create_function(vm.heap(), [compilation](ByteBuffer bytes) {
+            compilation->append(bytes);
+        });
+        auto process_end_of_body = GC::create_function(vm.heap(), [&vm, &realm, compilation, compilation_promise]() {
+            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+            auto module_or_error = compilation->finish(vm);
+            queue_a_task_to_settle_compilation(vm, realm, compilation_promise, move(module_or_error), HTML::Task::Source::Networking);
         });
 
         // 10. Upon rejection of bodyPromise with reason reason:
-        auto body_rejection_steps = GC::create_function(vm.heap(), [return_value](JS::Value reason) -> WebIDL::ExceptionOr<JS::Value> {
+        auto process_body_error = GC::create_function(vm.heap(), [&realm, compilation_promise](JS::Value reason) {
+            // AD-HOC: An execution context is required for Promise's reject function.
+            HTML::TemporaryExecutionContext context(realm);
+
             // 1. Reject returnValue with reason.
-            WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, reason);
-            return JS::js_undefined();
+            WebIDL::reject_promise(realm, compilation_promise, reason);
         });
 
-        WebIDL::react_to_promise(body_promise, body_fulfillment_steps, body_rejection_steps);
+        if (auto body = response_object.body_impl())
+            body->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { HTML::relevant_global_object(response_object) });
+        else
+            process_end_of_body->function()();
 
         return JS::js_undefined();
     });
@@ -62,14 +62,14 @@ JS::ThrowCompletionOr<void> ObservableArray::append(JS::Value value)
 {
     if (m_on_set_an_indexed_value)
         TRY(Bindings::throw_dom_exception_if_needed(vm(), [&] { return m_on_set_an_indexed_value->function()(value); }));
-    indexed_properties().append(value);
+    mutable_indexed_properties().append(value);
     return {};
 }
 
 void ObservableArray::clear()
 {
     while (!indexed_properties().is_empty()) {
-        auto deleted_value = indexed_properties().storage()->take_first().value;
+        auto deleted_value = mutable_indexed_properties().storage()->take_first().value;
         MUST(m_on_delete_an_indexed_value->function()(deleted_value));
     }
 }
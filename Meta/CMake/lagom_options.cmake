@@ -15,6 +15,7 @@ endif()
 
 serenity_option(ENABLE_ADDRESS_SANITIZER OFF CACHE BOOL "Enable address sanitizer testing in gcc/clang")
 serenity_option(ENABLE_MEMORY_SANITIZER OFF CACHE BOOL "Enable memory sanitizer testing in gcc/clang")
+serenity_option(ENABLE_THREAD_SANITIZER OFF CACHE BOOL "Enable thread sanitizer testing in gcc/clang")
 serenity_option(ENABLE_FUZZERS OFF CACHE BOOL "Build fuzzing targets")
 serenity_option(ENABLE_FUZZERS_LIBFUZZER OFF CACHE BOOL "Build fuzzers using Clang's libFuzzer")
 serenity_option(ENABLE_FUZZERS_OSSFUZZ OFF CACHE BOOL "Build OSS-Fuzz compatible fuzzers")
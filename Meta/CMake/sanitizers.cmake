@@ -10,6 +10,16 @@ if (ENABLE_MEMORY_SANITIZER)
     add_cxx_link_options(-fsanitize=memory -fsanitize-memory-track-origins)
 endif()
 
+if (ENABLE_THREAD_SANITIZER)
+    if (ENABLE_ADDRESS_SANITIZER OR ENABLE_MEMORY_SANITIZER)
+        message(FATAL_ERROR "ENABLE_THREAD_SANITIZER can't be combined with ENABLE_ADDRESS_SANITIZER or ENABLE_MEMORY_SANITIZER")
+    endif()
+    add_cxx_compile_options(-fsanitize=thread -fno-omit-frame-pointer)
+    add_cxx_link_options(-fsanitize=thread)
+    add_swift_compile_options(-sanitize=thread)
+    add_swift_link_options(-sanitize=thread)
+endif()
+
 if (ENABLE_UNDEFINED_SANITIZER AND (APPLE OR NOT ENABLE_SWIFT))
     add_cxx_compile_options(-fsanitize=undefined -fno-omit-frame-pointer)
     if (UNDEFINED_BEHAVIOR_IS_FATAL)
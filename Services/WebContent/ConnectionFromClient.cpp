@@ -12,6 +12,7 @@
 #include <AK/JsonObject.h>
 #include <AK/QuickSort.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
 #include <LibGC/Heap.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
@@ -332,6 +333,31 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "dump-gc-type-statistics") {
+        auto statistics = Web::Bindings::main_thread_vm().heap().live_cell_statistics_by_type();
+        size_t total_bytes = 0;
+        for (auto const& type : statistics)
+            total_bytes += type.live_bytes;
+        dbgln("Live GC cells by type ({} bytes total):", total_bytes);
+        for (auto const& type : statistics)
+            dbgln("  {:>12} bytes {:>9} cells  {}", type.live_bytes, type.live_cells, type.class_name);
+        return;
+    }
+
+    if (request == "write-heap-snapshot") {
+        auto result = [&] -> ErrorOr<void> {
+            auto file = TRY(Core::File::open(argument, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+            auto buffered_file = TRY(Core::OutputBufferedFile::create(move(file)));
+            TRY(Web::Bindings::main_thread_vm().heap().write_heap_snapshot(*buffered_file));
+            return buffered_file->flush();
+        }();
+        if (result.is_error())
+            dbgln("Failed to write heap snapshot to {}: {}", argument, result.error());
+        else
+            dbgln("Wrote heap snapshot to {}", argument);
+        return;
+    }
+
     if (request == "set-line-box-borders") {
         bool state = argument == "on";
         page->set_should_show_line_box_borders(state);
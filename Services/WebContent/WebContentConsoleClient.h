@@ -33,6 +33,11 @@ protected:
     WebContentConsoleClient(JS::Realm&, JS::Console&, PageClient&, ConsoleGlobalEnvironmentExtensions&);
 
     virtual void visit_edges(JS::Cell::Visitor&) override;
+    virtual void revoke_weak_ptrs_before_sweep() override
+    {
+        Base::revoke_weak_ptrs_before_sweep();
+        revoke_weak_ptrs();
+    }
 
     GC::Ref<JS::Realm> m_realm;
     GC::Ref<PageClient> m_client;
@@ -27,6 +27,7 @@
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Platform/AudioCodecPluginAgnostic.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
+#include <LibWeb/WebAssembly/WebAssembly.h>
 #include <LibWebView/Plugins/FontPlugin.h>
 #include <LibWebView/Plugins/ImageCodecPlugin.h>
 #include <LibWebView/SiteIsolation.h>
@@ -114,6 +115,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool is_headless = false;
     bool disable_scrollbar_painting = false;
     StringView echo_server_port_string_view {};
+    StringView wasm_module_cache_path {};
 
     Core::ArgsParser args_parser;
     args_parser.add_option(command_line, "Browser process command line", "command-line", 0, "command_line");
@@ -136,6 +138,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical viewport scrollbars", "disable-scrollbar-painting");
     args_parser.add_option(echo_server_port_string_view, "Echo server port used in test internals", "echo-server-port", 0, "echo_server_port");
     args_parser.add_option(is_headless, "Report that the browser is running in headless mode", "headless");
+    args_parser.add_option(wasm_module_cache_path, "Directory in which to remember validated WebAssembly modules", "wasm-module-cache", 0, "path");
 
     args_parser.parse(arguments);
 
@@ -172,6 +175,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Web::Painting::g_paint_viewport_scrollbars = !disable_scrollbar_painting;
 
+    if (!wasm_module_cache_path.is_empty())
+        Web::WebAssembly::set_module_cache_directory(wasm_module_cache_path);
+
     if (!echo_server_port_string_view.is_empty()) {
         if (auto maybe_echo_server_port = echo_server_port_string_view.to_number<u16>(); maybe_echo_server_port.has_value())
             Web::Internals::Internals::set_echo_server_port(maybe_echo_server_port.value());
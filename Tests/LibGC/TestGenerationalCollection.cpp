@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/WeakPtr.h>
+#include <AK/Weakable.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+class TestCell : public GC::Cell
+    , public Weakable<TestCell> {
+    GC_CELL(TestCell, GC::Cell);
+
+public:
+    GC::Ptr<TestCell> next() const { return m_next; }
+
+protected:
+    GC::Ptr<TestCell> m_next;
+
+private:
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(m_next);
+    }
+
+    virtual void revoke_weak_ptrs_before_sweep() override { revoke_weak_ptrs(); }
+};
+
+class BarrieredCell final : public TestCell {
+    GC_CELL(BarrieredCell, TestCell);
+    GC_DECLARE_ALLOCATOR(BarrieredCell);
+    GC_DECLARE_WRITE_BARRIER(BarrieredCell);
+
+public:
+    void set_next(GC::Ptr<TestCell> next)
+    {
+        m_next = next;
+        write_barrier(next.ptr());
+    }
+};
+
+// Doesn't declare a write barrier, so young generation collections have to re-scan it once it's old.
+class PlainCell final : public TestCell {
+    GC_CELL(PlainCell, TestCell);
+    GC_DECLARE_ALLOCATOR(PlainCell);
+
+public:
+    void set_next(GC::Ptr<TestCell> next) { m_next = next; }
+};
+
+GC_DEFINE_ALLOCATOR(BarrieredCell);
+GC_DEFINE_ALLOCATOR(PlainCell);
+
+static NEVER_INLINE WeakPtr<TestCell> allocate_unreachable_cell(GC::Heap& heap)
+{
+    return heap.allocate<PlainCell>()->make_weak_ptr();
+}
+
+// Stores a pointer to a new young cell in the given cell, so that it's only reachable from there.
+template<typename T>
+static NEVER_INLINE WeakPtr<TestCell> store_young_cell(GC::Heap& heap, T& cell)
+{
+    auto young_cell = heap.allocate<PlainCell>();
+    cell.set_next(young_cell);
+    return young_cell->make_weak_ptr();
+}
+
+// Returns a cell that survived a collection, and then became unreachable.
+static NEVER_INLINE WeakPtr<TestCell> allocate_unreachable_old_cell(GC::Heap& heap)
+{
+    GC::Root<PlainCell> cell = heap.allocate<PlainCell>();
+    heap.collect_garbage();
+    EXPECT(!cell->is_young());
+    return cell->make_weak_ptr();
+}
+
+// Overwrites the stack below us, so that no stale pointer to a cell is found by the conservative root scan.
+static NEVER_INLINE void clobber_stack()
+{
+    volatile u8 garbage[16 * KiB];
+    for (size_t i = 0; i < sizeof(garbage); ++i)
+        garbage[i] = 0;
+}
+
+static NonnullOwnPtr<GC::Heap> create_generational_heap()
+{
+    auto heap = make<GC::Heap>(nullptr, [](auto&) { });
+    heap->set_generational_collection_enabled(true);
+    return heap;
+}
+
+TEST_CASE(young_generation_collection_collects_unreachable_young_cells)
+{
+    auto heap = create_generational_heap();
+
+    auto cell = allocate_unreachable_cell(*heap);
+    EXPECT(cell);
+    clobber_stack();
+
+    heap->collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT(!cell);
+    EXPECT_EQ(heap->statistics().young_generation_collections, 1u);
+    EXPECT_EQ(heap->statistics().full_collections, 0u);
+}
+
+TEST_CASE(young_generation_collection_keeps_old_cells)
+{
+    auto heap = create_generational_heap();
+
+    auto cell = allocate_unreachable_old_cell(*heap);
+    clobber_stack();
+
+    // Only a full collection can tell that an old cell has become unreachable.
+    heap->collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT(cell);
+
+    clobber_stack();
+    heap->collect_garbage();
+    EXPECT(!cell);
+}
+
+TEST_CASE(old_to_young_store_is_remembered)
+{
+    auto heap = create_generational_heap();
+
+    GC::Root<BarrieredCell> old_cell = heap->allocate<BarrieredCell>();
+    heap->collect_garbage();
+    EXPECT(!old_cell->is_young());
+    EXPECT(!old_cell->is_remembered());
+
+    auto young_cell = store_young_cell(*heap, *old_cell);
+    EXPECT(old_cell->is_remembered());
+    clobber_stack();
+
+    // The young cell is only reachable through the old cell, which tracing stops at. The remembered set is what
+    // keeps it alive.
+    heap->collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT(young_cell);
+
+    // The young cell has been promoted, and the remembered set starts over.
+    EXPECT(!young_cell->is_young());
+    EXPECT(!old_cell->is_remembered());
+
+    // Now that both cells are old, overwriting the edge leaves the former young cell for the next full collection.
+    old_cell->set_next(nullptr);
+    EXPECT(!old_cell->is_remembered());
+    clobber_stack();
+    heap->collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT(young_cell);
+    clobber_stack();
+    heap->collect_garbage();
+    EXPECT(!young_cell);
+}
+
+TEST_CASE(stores_that_are_not_old_to_young_are_not_remembered)
+{
+    auto heap = create_generational_heap();
+
+    GC::Root<BarrieredCell> old_cell = heap->allocate<BarrieredCell>();
+    GC::Root<PlainCell> other_old_cell = heap->allocate<PlainCell>();
+    heap->collect_garbage();
+
+    // Old to old.
+    old_cell->set_next(other_old_cell.cell());
+    EXPECT(!old_cell->is_remembered());
+
+    // Young to young, and young to old.
+    GC::Root<BarrieredCell> young_cell = heap->allocate<BarrieredCell>();
+    young_cell->set_next(heap->allocate<PlainCell>());
+    EXPECT(!young_cell->is_remembered());
+    young_cell->set_next(old_cell.cell());
+    EXPECT(!young_cell->is_remembered());
+
+    // Storing null.
+    old_cell->set_next(nullptr);
+    EXPECT(!old_cell->is_remembered());
+}
+
+TEST_CASE(old_cells_without_write_barrier_are_rescanned)
+{
+    auto heap = create_generational_heap();
+
+    GC::Root<PlainCell> old_cell = heap->allocate<PlainCell>();
+    heap->collect_garbage();
+
+    auto young_cell = store_young_cell(*heap, *old_cell);
+    EXPECT(!old_cell->is_remembered());
+    clobber_stack();
+
+    heap->collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT(young_cell);
+    EXPECT_EQ(old_cell->next().ptr(), young_cell.ptr());
+}
+
+TEST_CASE(cells_that_existed_before_enabling_generational_collection_are_old)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    GC::Root<BarrieredCell> cell = heap.allocate<BarrieredCell>();
+
+    heap.set_generational_collection_enabled(true);
+    EXPECT(!cell->is_young());
+
+    auto young_cell = store_young_cell(heap, *cell);
+    EXPECT(cell->is_remembered());
+    clobber_stack();
+
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT(young_cell);
+}
+
+// A large old generation, and a young generation that's mostly garbage, as with short-lived strings and objects.
+// Young generation collections should only pay for the young cells and the remembered set.
+BENCHMARK_CASE(young_generation_collection_with_large_old_generation)
+{
+    auto heap = create_generational_heap();
+
+    static constexpr size_t old_cell_count = 500'000;
+    static constexpr size_t young_cells_per_collection = 50'000;
+    static constexpr size_t collection_count = 100;
+
+    Vector<GC::Root<BarrieredCell>> old_cells;
+    old_cells.ensure_capacity(old_cell_count / 1000);
+    GC::Ptr<TestCell> previous;
+    for (size_t i = 0; i < old_cell_count; ++i) {
+        auto cell = heap->allocate<BarrieredCell>();
+        cell->set_next(previous);
+        previous = cell;
+        if (i % 1000 == 0)
+            old_cells.append(cell);
+    }
+    heap->collect_garbage();
+
+    for (size_t i = 0; i < collection_count; ++i) {
+        for (size_t j = 0; j < young_cells_per_collection; ++j) {
+            auto cell = heap->allocate<PlainCell>();
+            if (j % 1000 == 0)
+                old_cells[j / 1000]->set_next(cell);
+        }
+        heap->collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/HeapBlock.h>
+#include <LibGC/HeapBlockMap.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+class MapTestCell final : public GC::Cell {
+    GC_CELL(MapTestCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(MapTestCell);
+
+    [[maybe_unused]] Array<u64, 2> m_payload {};
+};
+
+GC_DEFINE_ALLOCATOR(MapTestCell);
+
+// HeapBlockMap::add(), remove() and contains() only look at a block's address, so these don't need to be backed
+// by memory.
+static GC::HeapBlock const& block_at(FlatPtr address)
+{
+    VERIFY(address % GC::HeapBlock::block_size == 0);
+    return *bit_cast<GC::HeapBlock const*>(address);
+}
+
+static FlatPtr block_address(size_t block_number)
+{
+    return block_number * GC::HeapBlock::block_size;
+}
+
+TEST_CASE(add_lookup_and_remove)
+{
+    GC::HeapBlockMap map;
+    auto address = block_address(0x12345);
+
+    EXPECT(!map.contains(address));
+    map.add(block_at(address));
+    EXPECT_EQ(map.block_count(), 1u);
+
+    // Every address in the block is found, and nothing around it.
+    EXPECT(map.contains(address));
+    EXPECT(map.contains(address + 1));
+    EXPECT(map.contains(address + GC::HeapBlock::block_size - 1));
+    EXPECT(!map.contains(address - 1));
+    EXPECT(!map.contains(address + GC::HeapBlock::block_size));
+
+    map.remove(block_at(address));
+    EXPECT_EQ(map.block_count(), 0u);
+    EXPECT(!map.contains(address));
+
+    // The block can be added again once it's been removed.
+    map.add(block_at(address));
+    EXPECT(map.contains(address));
+}
+
+TEST_CASE(neighboring_blocks)
+{
+    GC::HeapBlockMap map;
+
+    // These share a leaf, and the last two sit on either side of a leaf boundary.
+    Array<size_t, 4> block_numbers { 0x10000, 0x10001, 0x10fff, 0x11000 };
+    for (auto block_number : block_numbers)
+        map.add(block_at(block_address(block_number)));
+    EXPECT_EQ(map.block_count(), block_numbers.size());
+
+    map.remove(block_at(block_address(0x10000)));
+    EXPECT(!map.contains(block_address(0x10000)));
+    EXPECT(map.contains(block_address(0x10001)));
+
+    map.remove(block_at(block_address(0x10fff)));
+    EXPECT(!map.contains(block_address(0x10fff)));
+    EXPECT(map.contains(block_address(0x11000)));
+    EXPECT(map.contains(block_address(0x10001)));
+
+    // A block number that was never added, between ones that were.
+    EXPECT(!map.contains(block_address(0x10002)));
+}
+
+TEST_CASE(blocks_far_apart)
+{
+    GC::HeapBlockMap map;
+
+    // These end up in different branches at every level of the tree.
+    auto low = block_address(1);
+    auto middle = block_address(0x800'000);
+    auto high = FlatPtr { 0x7fff'0000'0000 } & ~(GC::HeapBlock::block_size - 1);
+    for (auto address : { low, middle, high })
+        map.add(block_at(address));
+
+    EXPECT(map.contains(low));
+    EXPECT(map.contains(middle));
+    EXPECT(map.contains(high));
+
+    // Addresses between the blocks pass the range check, but aren't in any block.
+    EXPECT(!map.contains(block_address(2)));
+    EXPECT(!map.contains(middle + GC::HeapBlock::block_size));
+    EXPECT(!map.contains(high - GC::HeapBlock::block_size));
+    EXPECT(!map.contains((middle + high) / 2));
+
+    map.remove(block_at(middle));
+    EXPECT(!map.contains(middle));
+    EXPECT(map.contains(low));
+    EXPECT(map.contains(high));
+}
+
+TEST_CASE(cell_from_possible_value)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    GC::Root<MapTestCell> cell = heap.allocate<MapTestCell>();
+    auto cell_address = reinterpret_cast<FlatPtr>(cell.cell());
+
+    GC::HeapBlockMap map;
+    EXPECT_EQ(map.cell_from_possible_value(cell_address), nullptr);
+
+    map.add(*GC::HeapBlock::from_cell(cell.cell()));
+    EXPECT_EQ(map.cell_from_possible_value(cell_address), cell.cell());
+
+    // A pointer into the middle of the cell still refers to it.
+    EXPECT_EQ(map.cell_from_possible_value(cell_address + sizeof(GC::Cell) / 2), cell.cell());
+
+    // Values that don't point into any block.
+    int on_the_stack = 0;
+    auto on_the_heap = make<int>(0);
+    EXPECT_EQ(map.cell_from_possible_value(0), nullptr);
+    EXPECT_EQ(map.cell_from_possible_value(reinterpret_cast<FlatPtr>(&on_the_stack)), nullptr);
+    EXPECT_EQ(map.cell_from_possible_value(reinterpret_cast<FlatPtr>(on_the_heap.ptr())), nullptr);
+
+    // The block header isn't part of any cell.
+    EXPECT_EQ(map.cell_from_possible_value(reinterpret_cast<FlatPtr>(GC::HeapBlock::from_cell(cell.cell()))), nullptr);
+
+    map.remove(*GC::HeapBlock::from_cell(cell.cell()));
+    EXPECT_EQ(map.cell_from_possible_value(cell_address), nullptr);
+}
+
+TEST_CASE(for_each_cell_among_possible_values)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    GC::Root<MapTestCell> cell = heap.allocate<MapTestCell>();
+
+    GC::HeapBlockMap map;
+    map.add(*GC::HeapBlock::from_cell(cell.cell()));
+
+    int not_a_cell = 0;
+    Array<FlatPtr, 4> values { 0, reinterpret_cast<FlatPtr>(&not_a_cell), reinterpret_cast<FlatPtr>(cell.cell()), 42 };
+
+    Vector<GC::Cell*> found_cells;
+    map.for_each_cell_among_possible_values(ReadonlyBytes { values.data(), sizeof(values) }, [&](GC::Cell* found_cell) {
+        found_cells.append(found_cell);
+    });
+    EXPECT_EQ(found_cells, (Vector<GC::Cell*> { cell.cell() }));
+}
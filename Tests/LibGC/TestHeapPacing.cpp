@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibTest/TestCase.h>
+
+class PacingTestCell final : public GC::Cell {
+    GC_CELL(PacingTestCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(PacingTestCell);
+
+    [[maybe_unused]] Array<u64, 8> m_payload {};
+};
+
+GC_DEFINE_ALLOCATOR(PacingTestCell);
+
+static constexpr auto slow = AK::Duration::from_seconds(1);
+
+static size_t threshold(size_t live_bytes, size_t collected_bytes, AK::Duration interval, GC::Heap::PacingConfiguration const& configuration = {})
+{
+    return GC::Heap::bytes_threshold_after_full_collection(configuration, live_bytes, collected_bytes, interval);
+}
+
+TEST_CASE(threshold_grows_with_survival_ratio)
+{
+    // Everything survived.
+    EXPECT_EQ(threshold(100 * MiB, 0, slow), 200 * MiB);
+
+    EXPECT_EQ(threshold(100 * MiB, 100 * MiB, slow), 150 * MiB);
+    EXPECT_EQ(threshold(100 * MiB, 300 * MiB, slow), 125 * MiB);
+
+    // Nearly nothing survived, so about as much as is live may be allocated.
+    auto nearly_nothing_survived = threshold(100 * MiB, 100'000 * MiB, slow);
+    EXPECT(nearly_nothing_survived > 100 * MiB);
+    EXPECT(nearly_nothing_survived < 101 * MiB);
+}
+
+TEST_CASE(threshold_grows_with_collection_frequency)
+{
+    GC::Heap::PacingConfiguration configuration;
+    configuration.target_collection_interval = AK::Duration::from_milliseconds(100);
+
+    // At or past the target interval, only the survival ratio counts.
+    EXPECT_EQ(threshold(100 * MiB, 100 * MiB, AK::Duration::from_milliseconds(100), configuration), 150 * MiB);
+
+    // Collections that come faster than the target stretch the threshold towards it.
+    EXPECT_EQ(threshold(100 * MiB, 100 * MiB, AK::Duration::from_milliseconds(80), configuration), 192'000 * KiB);
+    EXPECT_EQ(threshold(100 * MiB, 100 * MiB, AK::Duration::from_milliseconds(50), configuration), 300 * MiB);
+
+    // ...but by no more than a factor of two.
+    EXPECT_EQ(threshold(100 * MiB, 100 * MiB, AK::Duration::from_milliseconds(1), configuration), 300 * MiB);
+
+    // An interval too short to measure doesn't count.
+    EXPECT_EQ(threshold(100 * MiB, 100 * MiB, AK::Duration::zero(), configuration), 150 * MiB);
+}
+
+TEST_CASE(threshold_is_clamped)
+{
+    GC::Heap::PacingConfiguration configuration;
+    configuration.min_bytes_threshold = 8 * MiB;
+    configuration.max_bytes_threshold = 64 * MiB;
+
+    EXPECT_EQ(threshold(0, 0, slow, configuration), 8 * MiB);
+    EXPECT_EQ(threshold(1 * MiB, 1 * MiB, slow, configuration), 8 * MiB);
+    EXPECT_EQ(threshold(40 * MiB, 0, slow, configuration), 64 * MiB);
+    EXPECT_EQ(threshold(1024 * MiB, 0, slow, configuration), 64 * MiB);
+
+    // The defaults.
+    EXPECT_EQ(threshold(0, 0, slow), 4 * MiB);
+    EXPECT_EQ(threshold(800 * MiB, 0, slow), 1024 * MiB);
+}
+
+TEST_CASE(threshold_follows_configuration)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    EXPECT_EQ(heap.statistics().bytes_threshold, 4 * MiB);
+
+    GC::Heap::PacingConfiguration configuration;
+    configuration.min_bytes_threshold = 16 * MiB;
+    heap.set_pacing_configuration(configuration);
+    EXPECT_EQ(heap.statistics().bytes_threshold, 16 * MiB);
+
+    configuration.min_bytes_threshold = 64 * KiB;
+    configuration.max_bytes_threshold = 1 * MiB;
+    heap.set_pacing_configuration(configuration);
+    EXPECT_EQ(heap.statistics().bytes_threshold, 1 * MiB);
+}
+
+TEST_CASE(allocation_past_threshold_collects)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    GC::Heap::PacingConfiguration configuration;
+    configuration.min_bytes_threshold = 64 * KiB;
+    configuration.max_bytes_threshold = 64 * KiB;
+    heap.set_pacing_configuration(configuration);
+
+    while (heap.statistics().allocated_bytes_since_last_collection + sizeof(PacingTestCell) <= 64 * KiB)
+        heap.allocate<PacingTestCell>();
+    EXPECT_EQ(heap.statistics().full_collections, 0u);
+
+    heap.allocate<PacingTestCell>();
+    EXPECT_EQ(heap.statistics().full_collections, 1u);
+}
+
+TEST_CASE(idle_collection_needs_enough_allocation)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    GC::Heap::PacingConfiguration configuration;
+    configuration.min_bytes_threshold = 64 * KiB;
+    configuration.max_bytes_threshold = 64 * KiB;
+    configuration.idle_collection_threshold_ratio = 0.5;
+    heap.set_pacing_configuration(configuration);
+
+    auto const idle_time = AK::Duration::from_seconds(1);
+    EXPECT(!heap.collect_garbage_if_idle(idle_time));
+
+    while (heap.statistics().allocated_bytes_since_last_collection < 32 * KiB - sizeof(PacingTestCell))
+        heap.allocate<PacingTestCell>();
+    EXPECT(!heap.collect_garbage_if_idle(idle_time));
+
+    heap.allocate<PacingTestCell>();
+    EXPECT(heap.collect_garbage_if_idle(idle_time));
+
+    auto statistics = heap.statistics();
+    EXPECT_EQ(statistics.idle_collections, 1u);
+    EXPECT_EQ(statistics.full_collections, 1u);
+    EXPECT_EQ(statistics.allocated_bytes_since_last_collection, 0u);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/MemoryStream.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+class SnapshotCell final : public GC::Cell {
+    GC_CELL(SnapshotCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(SnapshotCell);
+
+public:
+    GC::Ptr<SnapshotCell> next;
+
+private:
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(next);
+    }
+};
+
+GC_DEFINE_ALLOCATOR(SnapshotCell);
+
+static constexpr size_t node_field_count = 7;
+static constexpr size_t node_name_field = 1;
+static constexpr size_t node_id_field = 2;
+static constexpr size_t node_edge_count_field = 4;
+static constexpr size_t edge_field_count = 3;
+static constexpr size_t edge_name_or_index_field = 1;
+static constexpr size_t edge_to_node_field = 2;
+
+static JsonObject write_snapshot(GC::Heap& heap)
+{
+    AllocatingMemoryStream stream;
+    MUST(heap.write_heap_snapshot(stream));
+    auto bytes = MUST(stream.read_until_eof());
+    auto snapshot = MUST(JsonValue::from_string(bytes));
+    VERIFY(snapshot.is_object());
+    return snapshot.as_object();
+}
+
+static Vector<String> string_array(JsonArray const& array)
+{
+    Vector<String> strings;
+    array.for_each([&](auto const& value) {
+        VERIFY(value.is_string());
+        strings.append(value.as_string());
+    });
+    return strings;
+}
+
+static u64 integer_at(JsonArray const& array, size_t index)
+{
+    return array[index].get_u64().value();
+}
+
+TEST_CASE(snapshot_of_small_graph)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+
+    // A cycle of three cells that's reachable from a root, and one cell that isn't reachable but hasn't been
+    // collected yet.
+    GC::Root<SnapshotCell> a = heap.allocate<SnapshotCell>();
+    auto b = heap.allocate<SnapshotCell>();
+    auto c = heap.allocate<SnapshotCell>();
+    auto d = heap.allocate<SnapshotCell>();
+    a->next = b;
+    b->next = c;
+    c->next = a.cell();
+
+    auto snapshot = write_snapshot(heap);
+
+    auto const& meta = snapshot.get_object("snapshot"sv)->get_object("meta"sv).value();
+    EXPECT_EQ(string_array(meta.get_array("node_fields"sv).value()),
+        (Vector<String> { "type"_string, "name"_string, "id"_string, "self_size"_string, "edge_count"_string, "trace_node_id"_string, "detachedness"_string }));
+    EXPECT_EQ(string_array(meta.get_array("edge_fields"sv).value()),
+        (Vector<String> { "type"_string, "name_or_index"_string, "to_node"_string }));
+
+    auto const& nodes = snapshot.get_array("nodes"sv).value();
+    auto const& edges = snapshot.get_array("edges"sv).value();
+    auto strings = string_array(snapshot.get_array("strings"sv).value());
+
+    // The synthetic root node, and one node per live cell.
+    auto node_count = snapshot.get_object("snapshot"sv)->get_integer<u64>("node_count"sv).value();
+    auto edge_count = snapshot.get_object("snapshot"sv)->get_integer<u64>("edge_count"sv).value();
+    EXPECT_EQ(node_count, 5u);
+    EXPECT_EQ(nodes.size(), node_count * node_field_count);
+    EXPECT_EQ(edges.size(), edge_count * edge_field_count);
+    EXPECT_EQ(strings[integer_at(nodes, node_name_field)], "(GC roots)"_string);
+
+    // Each node's edges follow those of the node before it.
+    HashMap<u64, size_t> first_edge_by_id;
+    size_t total_edge_count = 0;
+    for (size_t node = 0; node < node_count; ++node) {
+        auto field = [&](size_t index) { return integer_at(nodes, node * node_field_count + index); };
+        if (node != 0)
+            EXPECT_EQ(strings[field(node_name_field)], "SnapshotCell"_string);
+        first_edge_by_id.set(field(node_id_field), total_edge_count);
+        total_edge_count += field(node_edge_count_field);
+    }
+    EXPECT_EQ(total_edge_count, edge_count);
+
+    for (size_t edge = 0; edge < edge_count; ++edge) {
+        auto to_node = integer_at(edges, edge * edge_field_count + edge_to_node_field);
+        EXPECT_EQ(to_node % node_field_count, 0u);
+        EXPECT(to_node < nodes.size());
+    }
+
+    auto node_id_at_edge = [&](size_t edge) {
+        return integer_at(nodes, integer_at(edges, edge * edge_field_count + edge_to_node_field) + node_id_field);
+    };
+    auto id_of = [](SnapshotCell const* cell) { return static_cast<u64>(reinterpret_cast<FlatPtr>(cell)); };
+
+    EXPECT_EQ(node_id_at_edge(first_edge_by_id.get(id_of(a.cell())).value()), id_of(b));
+    EXPECT_EQ(node_id_at_edge(first_edge_by_id.get(id_of(b)).value()), id_of(c));
+    EXPECT_EQ(node_id_at_edge(first_edge_by_id.get(id_of(c)).value()), id_of(a.cell()));
+
+    // The root node has an edge to every root, which is named after the kind of root.
+    auto root_edge_count = integer_at(nodes, node_edge_count_field);
+    bool found_root = false;
+    for (size_t edge = 0; edge < root_edge_count; ++edge) {
+        if (node_id_at_edge(edge) != id_of(a.cell()))
+            continue;
+        EXPECT_EQ(strings[integer_at(edges, edge * edge_field_count + edge_name_or_index_field)], "Root"_string);
+        found_root = true;
+    }
+    EXPECT(found_root);
+
+    // Writing a snapshot doesn't collect anything.
+    EXPECT(d->state() == GC::Cell::State::Live);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Vector.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/DeferGC.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+class GraphNode final : public GC::Cell {
+    GC_CELL(GraphNode, GC::Cell);
+    GC_DECLARE_ALLOCATOR(GraphNode);
+
+public:
+    static constexpr size_t max_edges = 4;
+
+    void add_edge(GraphNode& node)
+    {
+        VERIFY(m_edge_count < max_edges);
+        m_edges[m_edge_count++] = &node;
+    }
+
+private:
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        for (size_t i = 0; i < m_edge_count; ++i)
+            visitor.visit(m_edges[i]);
+    }
+
+    Array<GC::Ptr<GraphNode>, max_edges> m_edges;
+    size_t m_edge_count { 0 };
+};
+
+GC_DEFINE_ALLOCATOR(GraphNode);
+
+// Overwrites the stack below us, so that no stale pointer to a cell is found by the conservative root scan.
+static NEVER_INLINE void clobber_stack()
+{
+    volatile u8 garbage[16 * KiB];
+    for (size_t i = 0; i < sizeof(garbage); ++i)
+        garbage[i] = 0;
+}
+
+struct Graph {
+    GC::Root<GraphNode> root;
+    Vector<GraphNode*> reachable_nodes;
+    Vector<GraphNode*> unreachable_nodes;
+};
+
+// Builds a tree with cross edges and cycles, which is wide enough to be split between threads, plus a second one
+// that nothing points to. Only raw pointers are kept outside the heap, and the stack isn't left holding any.
+static NEVER_INLINE Graph build_graph(GC::Heap& heap, size_t node_count)
+{
+    Graph graph;
+    GC::DeferGC defer_gc(heap);
+
+    auto build = [&](Vector<GraphNode*>& nodes) {
+        nodes.ensure_capacity(node_count);
+        for (size_t i = 0; i < node_count; ++i) {
+            auto node = heap.allocate<GraphNode>();
+            if (i > 0)
+                nodes[(i - 1) / 3]->add_edge(*node);
+            nodes.unchecked_append(node);
+        }
+        // Every node has room for one more edge. Point it back into the graph.
+        for (size_t i = 0; i < node_count; ++i)
+            nodes[i]->add_edge(*nodes[(i * 7919) % node_count]);
+    };
+    build(graph.reachable_nodes);
+    build(graph.unreachable_nodes);
+
+    graph.root = *graph.reachable_nodes.first();
+    return graph;
+}
+
+static void expect_only_reachable_nodes_survive(GC::Heap& heap, size_t marking_thread_count)
+{
+    static constexpr size_t node_count = 100'000;
+
+    heap.set_marking_thread_count(marking_thread_count);
+    auto graph = build_graph(heap, node_count);
+    clobber_stack();
+
+    heap.collect_garbage();
+
+    size_t live_reachable_nodes = 0;
+    for (auto* node : graph.reachable_nodes) {
+        if (node->state() == GC::Cell::State::Live)
+            ++live_reachable_nodes;
+    }
+    EXPECT_EQ(live_reachable_nodes, node_count);
+
+    size_t live_unreachable_nodes = 0;
+    for (auto* node : graph.unreachable_nodes) {
+        if (node->state() == GC::Cell::State::Live)
+            ++live_unreachable_nodes;
+    }
+    EXPECT_EQ(live_unreachable_nodes, 0u);
+}
+
+TEST_CASE(serial_marking)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    expect_only_reachable_nodes_survive(heap, 1);
+}
+
+TEST_CASE(parallel_marking)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    expect_only_reachable_nodes_survive(heap, 4);
+}
+
+TEST_CASE(parallel_marking_with_more_threads_than_work)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_marking_thread_count(16);
+
+    GC::Root<GraphNode> node = heap.allocate<GraphNode>();
+    heap.collect_garbage();
+    EXPECT(node->state() == GC::Cell::State::Live);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGC/Heap.h>
+#include <LibGC/HeapBlock.h>
+#include <LibTest/TestCase.h>
+
+static constexpr Array expected_size_classes {
+    32uz, 48uz, 64uz, 80uz, 96uz, 112uz, 128uz, 160uz, 192uz, 224uz, 256uz, 320uz,
+    384uz, 448uz, 512uz, 640uz, 768uz, 896uz, 1024uz, 1280uz, 1536uz, 2048uz, 3072uz
+};
+
+static_assert(GC::Heap::size_class_for_cell_size(1) == 32);
+static_assert(GC::Heap::size_class_for_cell_size(33) == 48);
+static_assert(GC::Heap::size_class_for_cell_size(3072) == 3072);
+
+template<size_t size>
+class SizedCell final : public GC::Cell {
+    GC_CELL(SizedCell, GC::Cell);
+
+    [[maybe_unused]] Array<u8, size - sizeof(GC::Cell)> m_payload {};
+};
+
+TEST_CASE(boundary_sizes)
+{
+    EXPECT_EQ(GC::Heap::largest_size_class(), expected_size_classes.last());
+
+    for (size_t i = 0; i < expected_size_classes.size(); ++i) {
+        auto size_class = expected_size_classes[i];
+        EXPECT_EQ(GC::Heap::size_class_for_cell_size(size_class), size_class);
+        EXPECT_EQ(GC::Heap::size_class_for_cell_size(size_class - 1), size_class);
+        if (i + 1 < expected_size_classes.size())
+            EXPECT_EQ(GC::Heap::size_class_for_cell_size(size_class + 1), expected_size_classes[i + 1]);
+    }
+}
+
+TEST_CASE(every_size_gets_the_smallest_class_that_fits)
+{
+    size_t smallest_fitting_class = 0;
+    for (size_t size = 1; size <= GC::Heap::largest_size_class(); ++size) {
+        while (expected_size_classes[smallest_fitting_class] < size)
+            ++smallest_fitting_class;
+        EXPECT_EQ(GC::Heap::size_class_for_cell_size(size), expected_size_classes[smallest_fitting_class]);
+    }
+}
+
+template<typename T>
+static void expect_allocated_in_size_class(GC::Heap& heap)
+{
+    auto* block = GC::HeapBlock::from_cell(heap.allocate<T>().ptr());
+    EXPECT(block->cell_size() >= sizeof(T));
+    EXPECT_EQ(block->cell_size(), GC::Heap::size_class_for_cell_size(sizeof(T)));
+}
+
+TEST_CASE(cells_are_allocated_in_their_size_class)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    expect_allocated_in_size_class<SizedCell<32>>(heap);
+    expect_allocated_in_size_class<SizedCell<64>>(heap);
+    expect_allocated_in_size_class<SizedCell<72>>(heap);
+    expect_allocated_in_size_class<SizedCell<1544>>(heap);
+    expect_allocated_in_size_class<SizedCell<3072>>(heap);
+}
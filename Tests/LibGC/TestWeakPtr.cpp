@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/WeakPtr.h>
+#include <AK/Weakable.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibTest/TestCase.h>
+
+static bool s_weakable_cell_was_destroyed = false;
+
+class WeakableCell final : public GC::Cell
+    , public Weakable<WeakableCell> {
+    GC_CELL(WeakableCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(WeakableCell);
+
+public:
+    virtual ~WeakableCell() override { s_weakable_cell_was_destroyed = true; }
+
+private:
+    virtual void revoke_weak_ptrs_before_sweep() override { revoke_weak_ptrs(); }
+};
+
+GC_DEFINE_ALLOCATOR(WeakableCell);
+
+static NEVER_INLINE WeakPtr<WeakableCell> allocate_unreachable_cell(GC::Heap& heap)
+{
+    return heap.allocate<WeakableCell>()->make_weak_ptr();
+}
+
+// Overwrites the stack below us, so that no stale pointer to the cell is found by the conservative root scan.
+static NEVER_INLINE void clobber_stack()
+{
+    volatile u8 garbage[16 * KiB];
+    for (size_t i = 0; i < sizeof(garbage); ++i)
+        garbage[i] = 0;
+}
+
+TEST_CASE(weak_ptr_to_collected_cell_is_null_before_sweep)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+
+    auto weak_cell = allocate_unreachable_cell(heap);
+    EXPECT(weak_cell);
+    clobber_stack();
+
+    heap.collect_garbage();
+
+    // The cell hasn't been destroyed yet, as its block is only swept once the allocator needs the space.
+    EXPECT(!s_weakable_cell_was_destroyed);
+    EXPECT(!weak_cell);
+
+    heap.collect_garbage(GC::Heap::CollectionType::CollectEverything);
+    EXPECT(s_weakable_cell_was_destroyed);
+}
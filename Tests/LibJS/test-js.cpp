@@ -6,6 +6,7 @@
  */
 
 #include <AK/Enumerate.h>
+#include <AK/TemporaryChange.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/Date.h>
 #include <LibJS/Runtime/TypedArray.h>
@@ -43,6 +44,23 @@ TESTJS_GLOBAL_FUNCTION(evaluate_source, evaluateSource)
     return vm.bytecode_interpreter().run(script.value());
 }
 
+// Like evaluateSource, but skips function bodies until their first call, as with `--lazy-parse`.
+TESTJS_GLOBAL_FUNCTION(evaluate_source_with_lazy_parsing, evaluateSourceWithLazyParsing)
+{
+    auto& realm = *vm.current_realm();
+
+    auto source = TRY(vm.argument(0).to_string(vm));
+
+    auto script = [&] {
+        TemporaryChange enable_lazy_parsing(JS::g_lazy_function_parsing, true);
+        return JS::Script::parse(source, realm);
+    }();
+    if (script.is_error())
+        return vm.throw_completion<JS::SyntaxError>(script.error().first().to_string());
+
+    return vm.bytecode_interpreter().run(script.value());
+}
+
 TESTJS_GLOBAL_FUNCTION(run_queued_promise_jobs, runQueuedPromiseJobs)
 {
     vm.run_queued_promise_jobs();
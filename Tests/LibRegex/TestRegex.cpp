@@ -9,6 +9,7 @@
 #include <AK/Debug.h>
 #include <AK/StringBuilder.h>
 #include <AK/Tuple.h>
+#include <AK/Utf16View.h>
 #include <LibRegex/Regex.h>
 #include <LibRegex/RegexDebug.h>
 #include <LibRegex/RegexMatcher.h>
@@ -1312,3 +1313,97 @@ TEST_CASE(zero_width_backreference)
         EXPECT_EQ(result.capture_group_matches.first()[0].view.to_byte_string(), ""sv);
     }
 }
+
+TEST_CASE(parse_result_cache)
+{
+    auto pattern = "cache-(test)+[0-9]{2}"sv;
+
+    auto before = Regex<ECMA262>::cache_statistics();
+    {
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Global);
+        EXPECT(re.match("cache-testtest42"sv).success);
+    }
+    auto after_first = Regex<ECMA262>::cache_statistics();
+    EXPECT_EQ(after_first.misses, before.misses + 1);
+    EXPECT_EQ(after_first.hits, before.hits);
+
+    {
+        // A pre-parsed pattern with the same options shares the cache entry.
+        Regex<ECMA262> re(Regex<ECMA262>::parse_pattern(pattern, ECMAScriptFlags::Global), pattern, ECMAScriptFlags::Global);
+        EXPECT(re.match("cache-test42"sv).success);
+        EXPECT(!re.match("cache-42"sv).success);
+    }
+    auto after_second = Regex<ECMA262>::cache_statistics();
+    EXPECT_EQ(after_second.hits, after_first.hits + 1);
+
+    {
+        // Different options are a different entry.
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Insensitive);
+        EXPECT(re.match("CACHE-TEST42"sv).success);
+    }
+    EXPECT_EQ(Regex<ECMA262>::cache_statistics().misses, after_second.misses + 1);
+}
+
+static void expect_prefiltered_matches(StringView pattern, ECMAScriptFlags flags, StringView subject, Vector<size_t> const& expected_offsets, Vector<StringView> const& expected_matches)
+{
+    Regex<ECMA262> re(pattern, flags);
+    EXPECT(re.parser_result.optimization_data.prefilter.has_value());
+
+    auto check = [&](RegexResult const& result) {
+        EXPECT_EQ(result.count, expected_offsets.size());
+        if (result.count != expected_offsets.size())
+            return;
+        for (size_t i = 0; i < result.count; ++i) {
+            EXPECT_EQ(result.matches[i].global_offset, expected_offsets[i]);
+            EXPECT_EQ(result.matches[i].view.to_byte_string(), expected_matches[i]);
+        }
+    };
+
+    check(re.match(subject));
+
+    auto utf16_subject = MUST(AK::utf8_to_utf16(subject));
+    check(re.match(Utf16View { utf16_subject }));
+}
+
+TEST_CASE(prefilter)
+{
+    // NOTE: ECMAScriptFlags::Global would make the regex stateful, and only return one match per call.
+    auto global = (ECMAScriptFlags)regex::AllFlags::Global;
+    auto insensitive = (global | ECMAScriptFlags::Insensitive).value();
+
+    auto haystack = ByteString::formatted("{}needle{}needl{}needle", ByteString::repeated('x', 37), ByteString::repeated('x', 15), ByteString::repeated('y', 20));
+    expect_prefiltered_matches("needle"sv, global, haystack, { 37, 83 }, { "needle"sv, "needle"sv });
+    expect_prefiltered_matches("needle"sv, insensitive, haystack.to_uppercase(), { 37, 83 }, { "NEEDLE"sv, "NEEDLE"sv });
+    expect_prefiltered_matches("ne(edle|edl)"sv, global, haystack, { 37, 58, 83 }, { "needle"sv, "needl"sv, "needle"sv });
+
+    // Candidates that straddle 16-byte chunks, and ones at the very end of the input.
+    auto straddling = ByteString::formatted("{}ab{}ab", ByteString::repeated('-', 15), ByteString::repeated('-', 14));
+    expect_prefiltered_matches("ab"sv, global, straddling, { 15, 31 }, { "ab"sv, "ab"sv });
+    expect_prefiltered_matches("b"sv, global, straddling, { 16, 32 }, { "b"sv, "b"sv });
+
+    auto text = "The cat and the dog saw 42 other cats, 7 dogs and 1234567890123456789 birds."sv;
+    expect_prefiltered_matches("[0-9]+"sv, global, text, { 24, 39, 50 }, { "42"sv, "7"sv, "1234567890123456789"sv });
+    expect_prefiltered_matches("cat|dog"sv, global, text, { 4, 16, 33, 41 }, { "cat"sv, "dog"sv, "cat"sv, "dog"sv });
+    expect_prefiltered_matches("(?:c|d)[a-z]*s"sv, global, text, { 33, 41, 73 }, { "cats"sv, "dogs"sv, "ds"sv });
+    expect_prefiltered_matches("[T-Z][a-z]+"sv, insensitive, text, { 0, 12, 28, 35 }, { "The"sv, "the"sv, "ther"sv, "ts"sv });
+
+    // Patterns that can match the empty string, or that start with lookaround, get no prefilter.
+    Array unfiltered_patterns { "a*"sv, "(?:a|)"sv, "(?=a)a"sv, "[^a]b"sv, "^ab"sv };
+    for (auto pattern : unfiltered_patterns) {
+        Regex<ECMA262> re(pattern, global);
+        EXPECT(!re.parser_result.optimization_data.prefilter.has_value());
+    }
+}
+
+BENCHMARK_CASE(prefilter_performance)
+{
+    auto haystack = ByteString::formatted("{}needle{}", ByteString::repeated('x', 1'000'000), ByteString::repeated('y', 1'000'000));
+    Array patterns { "needle"sv, "ne+dle"sv, "[m-o]eedle"sv, "needle|haystack"sv };
+    for (auto pattern : patterns) {
+        Regex<ECMA262> re(pattern, (ECMAScriptFlags)regex::AllFlags::Global);
+        for (size_t i = 0; i < 10; ++i) {
+            auto result = re.match(haystack.view());
+            EXPECT_EQ(result.count, 1u);
+        }
+    }
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h> // import first, to prevent warning of VERIFY* redefinition
+
+#include <AK/ByteString.h>
+#include <AK/StringBuilder.h>
+#include <AK/Tuple.h>
+#include <AK/Utf16View.h>
+#include <LibRegex/Regex.h>
+
+// ECMAScriptFlags::Global also makes the regex stateful, so that every match() only finds the next match.
+static constexpr auto global = (ECMAScriptFlags)regex::AllFlags::Global;
+
+static ECMAScriptOptions with_flags(ECMAScriptFlags a, ECMAScriptFlags b)
+{
+    return static_cast<ECMAScriptFlags>(static_cast<regex::FlagsUnderlyingType>(a) | static_cast<regex::FlagsUnderlyingType>(b));
+}
+
+static ByteString repeated(StringView string, size_t count)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < count; ++i)
+        builder.append(string);
+    return builder.to_byte_string();
+}
+
+static void expect_same_matches(RegexResult const& nfa, RegexResult const& backtracking)
+{
+    EXPECT_EQ(nfa.success, backtracking.success);
+    EXPECT_EQ(nfa.count, backtracking.count);
+    if (nfa.count != backtracking.count)
+        return;
+
+    for (size_t i = 0; i < nfa.count; ++i) {
+        EXPECT_EQ(nfa.matches[i].view.to_byte_string(), backtracking.matches[i].view.to_byte_string());
+        EXPECT_EQ(nfa.matches[i].global_offset, backtracking.matches[i].global_offset);
+
+        auto const& nfa_groups = nfa.capture_group_matches[i];
+        auto const& backtracking_groups = backtracking.capture_group_matches[i];
+        EXPECT_EQ(nfa_groups.size(), backtracking_groups.size());
+        for (size_t j = 0; j < min(nfa_groups.size(), backtracking_groups.size()); ++j) {
+            EXPECT_EQ(nfa_groups[j].view.is_null(), backtracking_groups[j].view.is_null());
+            EXPECT_EQ(nfa_groups[j].view.to_byte_string(), backtracking_groups[j].view.to_byte_string());
+            EXPECT_EQ(nfa_groups[j].global_offset, backtracking_groups[j].global_offset);
+            EXPECT_EQ(nfa_groups[j].capture_group_name, backtracking_groups[j].capture_group_name);
+        }
+    }
+}
+
+static void expect_engines_agree(StringView pattern, StringView subject, ECMAScriptFlags flags = global)
+{
+    Regex<ECMA262> re(pattern, flags);
+    EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+
+    auto nfa = re.match(subject);
+    auto backtracking = re.match(subject, with_flags(flags, ECMAScriptFlags::BacktrackingOnly));
+    expect_same_matches(nfa, backtracking);
+
+    // Match again with the same matcher, so that the cached DFA states get used too.
+    auto nfa_again = re.match(subject);
+    expect_same_matches(nfa_again, backtracking);
+}
+
+TEST_CASE(engine_selection)
+{
+    Array nfa_patterns {
+        "(a|aa)*b"sv,
+        "(x+x+)+y"sv,
+        "[a-z]+@[a-z]+\\.com"sv,
+        ".*foo.*bar"sv,
+        "^(\\w+)\\s(\\w+)$"sv,
+    };
+    for (auto pattern : nfa_patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT(re.parser_result.optimization_data.nfa_program);
+    }
+
+    Array backtracking_patterns {
+        "(a)\\1"sv,   // Backreference
+        "a(?=b)"sv,  // Lookahead
+        "(?<=a)b"sv, // Lookbehind
+        "abc"sv,     // No forks, so nothing to gain
+    };
+    for (auto pattern : backtracking_patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT(!re.parser_result.optimization_data.nfa_program);
+    }
+}
+
+TEST_CASE(engines_agree_on_matches)
+{
+    Array tests {
+        Tuple { "(a|aa)*b"sv, "aaaaaab aab b ab"sv },
+        Tuple { "(a|ab)(c|bcd)(d*)"sv, "abcd"sv },
+        Tuple { "a*?b"sv, "aaab ab b"sv },
+        Tuple { "(a+?)(a*)"sv, "aaaa"sv },
+        Tuple { "x*"sv, "xxyxx"sv },
+        Tuple { "(?:)|a"sv, "aaa"sv },
+        Tuple { "foo|foobar"sv, "foobar foo"sv },
+        Tuple { "foobar|foo"sv, "foobar foo"sv },
+        Tuple { "[0-9]+(\\.[0-9]+)?"sv, "1 2.5 3. .4"sv },
+        Tuple { "(\\w+)@(\\w+)\\.(com|org)"sv, "mail alice@example.com or bob@example.org"sv },
+        Tuple { "\\bfoo\\b"sv, "foo food afoo foo"sv },
+        Tuple { "^a|b$"sv, "ab"sv },
+        Tuple { "(a*)*b"sv, "aaab"sv },
+        Tuple { "(a*)+$"sv, "aab"sv },
+        Tuple { "(?<first>[a-z]+) (?<second>[a-z]+)"sv, "hello world again"sv },
+        Tuple { "((a)|(b))+"sv, "abab"sv },
+        Tuple { "(a|b|c)*c"sv, "abcabc"sv },
+        Tuple { ".*"sv, ""sv },
+        Tuple { "[^,]*,"sv, "a,,b,"sv },
+    };
+
+    for (auto& test : tests)
+        expect_engines_agree(test.get<0>(), test.get<1>());
+}
+
+TEST_CASE(engines_agree_with_flags)
+{
+    expect_engines_agree("(FOO|bar)+baz"sv, "fooBARbaz"sv, with_flags(global, ECMAScriptFlags::Insensitive).value());
+    expect_engines_agree("^(a|b)+$"sv, "ab\nba\nc"sv, with_flags(global, ECMAScriptFlags::Multiline).value());
+    expect_engines_agree("a.+b"sv, "a\nb a-b"sv, with_flags(global, ECMAScriptFlags::SingleLine).value());
+    expect_engines_agree("(a|b)+"sv, "xxabab"sv, with_flags(global, ECMAScriptFlags::Sticky).value());
+    expect_engines_agree("(a|b)+c"sv, "aabc"sv, ECMAScriptFlags::Default);
+}
+
+TEST_CASE(engines_agree_on_unicode)
+{
+    auto flags = with_flags(global, ECMAScriptFlags::Unicode).value();
+    Regex<ECMA262> re("(.|\\u{1f600})+?z"sv, flags);
+    EXPECT(re.parser_result.optimization_data.nfa_program);
+
+    auto subject = MUST(AK::utf8_to_utf16("x\U0001f600\U0001f600y \u00e9\U0001f600z"sv));
+    Utf16View view { subject };
+
+    auto nfa = re.match(view);
+    auto backtracking = re.match(view, with_flags(flags, ECMAScriptFlags::BacktrackingOnly));
+    EXPECT(nfa.success);
+    expect_same_matches(nfa, backtracking);
+}
+
+TEST_CASE(dfa_state_limit)
+{
+    // (a|b)*a(a|b){n} needs exponentially many DFA states, so this has to fall back to the Pike VM part way through.
+    auto pattern = ByteString::formatted("(?:a|b)*a{}", repeated("(?:a|b)"sv, 12));
+    auto subject = ByteString::formatted("{}{}", repeated("ab"sv, 300), repeated("a"sv, 13));
+    expect_engines_agree(pattern, subject);
+}
+
+TEST_CASE(engines_agree_on_searches)
+{
+    // The leftmost start wins, even if a later one would give a longer match.
+    expect_engines_agree("b+|ab"sv, "aab"sv);
+    expect_engines_agree("a*"sv, "baab"sv);
+    expect_engines_agree("\\b(\\w)(\\w*)\\b"sv, "  first second, third"sv);
+
+    // Matches far from where the search started, and failing searches.
+    expect_engines_agree("(a|b)*c"sv, ByteString::formatted("{}c{}", repeated("ab"sv, 50), repeated("ab"sv, 50)));
+    expect_engines_agree("x([0-9]+)y"sv, ByteString::formatted("{}x12y{}x3", repeated("1"sv, 300), repeated("x1"sv, 100)));
+    expect_engines_agree("(a|b)*c"sv, repeated("ab"sv, 200));
+
+    expect_engines_agree("x|y$"sv, "y\nxy\nay"sv, with_flags(global, ECMAScriptFlags::Multiline).value());
+}
+
+TEST_CASE(unanchored_search_is_linear)
+{
+    // Restarting at every position would take quadratic time to find that there is no match.
+    auto operations_for_failing_search = [](size_t length) {
+        Regex<ECMA262> re("(a|b)*c"sv, global);
+        auto subject = repeated("ab"sv, length);
+        auto result = re.match(subject.view());
+        EXPECT(!result.success);
+        return result.n_operations;
+    };
+    EXPECT(operations_for_failing_search(2000) <= 3 * operations_for_failing_search(1000));
+}
+
+static void run_benchmark(StringView pattern, StringView subject, ECMAScriptOptions options, size_t iterations)
+{
+    Regex<ECMA262> re(pattern, options);
+    for (size_t i = 0; i < iterations; ++i)
+        (void)re.match(subject);
+}
+
+// Every benchmark runs once on the engine the pattern picks, and once on the backtracking matcher.
+#define ENGINE_BENCHMARK_CASE(name, pattern, subject, iterations)             \
+    BENCHMARK_CASE(name##_nfa)                                                \
+    {                                                                         \
+        run_benchmark(pattern, subject, global, iterations);                  \
+    }                                                                         \
+    BENCHMARK_CASE(name##_backtracking)                                       \
+    {                                                                         \
+        auto options = with_flags(global, ECMAScriptFlags::BacktrackingOnly); \
+        run_benchmark(pattern, subject, options, iterations);                 \
+    }
+
+// Pathological patterns, which make the backtracking matcher try many ways to split up the same input.
+ENGINE_BENCHMARK_CASE(overlapping_alternatives, "(a|aa)*b"sv, repeated("a"sv, 30), 1)
+ENGINE_BENCHMARK_CASE(nested_quantifiers, "(x+x+)+y"sv, repeated("x"sv, 30), 1)
+ENGINE_BENCHMARK_CASE(nested_plus, "(a+)+b"sv, repeated("a"sv, 100), 1)
+ENGINE_BENCHMARK_CASE(optional_prefixes, ByteString::formatted("{}{}", repeated("a?"sv, 25), repeated("a"sv, 25)), repeated("a"sv, 25), 1)
+
+// Realistic patterns, on larger inputs.
+ENGINE_BENCHMARK_CASE(email_addresses, "[\\w.+-]+@[\\w-]+\\.[\\w.-]+"sv, repeated("write to someone.else+tag@example.co.uk or to noreply@example.com, "sv, 500), 10)
+ENGINE_BENCHMARK_CASE(log_lines, "(\\d+)-(\\d+)-(\\d+) (ERROR|WARN): (.*)"sv, repeated("2025-01-01 INFO: all good\n2025-01-02 ERROR: disk full\n"sv, 500), 10)
+ENGINE_BENCHMARK_CASE(dot_star_sequence, ".*foo.*bar"sv, ByteString::formatted("{}foo{}bar", repeated("x"sv, 2000), repeated("y"sv, 2000)), 10)
+ENGINE_BENCHMARK_CASE(failing_search, "(a|b)*c"sv, repeated("ab"sv, 2000), 1)
+ENGINE_BENCHMARK_CASE(distant_match, "x[0-9]+y"sv, ByteString::formatted("{}x123y", repeated("x123"sv, 5000)), 1)
+ENGINE_BENCHMARK_CASE(identifiers, "[a-zA-Z_][a-zA-Z0-9_]*"sv, repeated("foo bar_1 baz2 _qux, "sv, 1000), 10)
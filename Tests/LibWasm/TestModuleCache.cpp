@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCore/File.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibFileSystem/TempFile.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+// A module with one function of type [] -> [i32], that returns i32.const 1.
+static constexpr Array<u8, 27> valid_module_bytes {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    0x01, 0x05, 0x01, 0x60, 0x00, 0x01, 0x7f,
+    0x03, 0x02, 0x01, 0x00,
+    0x0a, 0x06, 0x01, 0x04, 0x00, 0x41, 0x01, 0x0b
+};
+
+static NonnullRefPtr<Wasm::Module> parse_module(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    return MUST(Wasm::Module::parse(stream));
+}
+
+static ByteString entry_path(StringView directory, Wasm::ModuleCache::Key const& key)
+{
+    StringBuilder builder;
+    builder.appendff("{}/", directory);
+    for (auto byte : key)
+        builder.appendff("{:02x}", byte);
+    builder.append(".wasmvc"sv);
+    return builder.to_byte_string();
+}
+
+// Validates a freshly parsed module, stores it in a cache in the directory, and returns its key.
+static Wasm::ModuleCache::Key store_valid_module(StringView directory, Optional<ByteString> build_identifier = {})
+{
+    auto cache = build_identifier.has_value()
+        ? MUST(Wasm::ModuleCache::create(directory, build_identifier.release_value()))
+        : MUST(Wasm::ModuleCache::create(directory));
+    auto module = parse_module(valid_module_bytes);
+    Wasm::Validator validator;
+    MUST(validator.validate(*module));
+    auto key = Wasm::ModuleCache::key_for(valid_module_bytes);
+    cache->store(*module, key);
+    return key;
+}
+
+// Looks the module up in a new cache, as a later run would, and checks that it still validates either way.
+static bool load_in_later_run(StringView directory)
+{
+    auto cache = MUST(Wasm::ModuleCache::create(directory));
+    auto module = parse_module(valid_module_bytes);
+    auto found = cache->load(*module, Wasm::ModuleCache::key_for(valid_module_bytes));
+    EXPECT_EQ(module->function_bodies_validated_by_earlier_run(), found);
+    Wasm::Validator validator;
+    EXPECT(!validator.validate(*module).is_error());
+    return found;
+}
+
+TEST_CASE(hit)
+{
+    auto directory = TRY_OR_FAIL(FileSystem::TempFile::create_temp_directory());
+    EXPECT(!load_in_later_run(directory->path()));
+
+    auto key = store_valid_module(directory->path());
+    EXPECT(FileSystem::exists(entry_path(directory->path(), key)));
+    EXPECT(load_in_later_run(directory->path()));
+}
+
+TEST_CASE(invalid_modules_are_not_stored)
+{
+    auto directory = TRY_OR_FAIL(FileSystem::TempFile::create_temp_directory());
+    auto cache = TRY_OR_FAIL(Wasm::ModuleCache::create(directory->path().to_byte_string()));
+
+    // The same module, but the function returns i64.const 1.
+    auto bytes = valid_module_bytes;
+    bytes[bytes.size() - 3] = 0x42;
+    auto module = parse_module(bytes);
+    Wasm::Validator validator;
+    EXPECT(validator.validate(*module).is_error());
+
+    auto key = Wasm::ModuleCache::key_for(bytes);
+    cache->store(*module, key);
+    EXPECT(!FileSystem::exists(entry_path(directory->path(), key)));
+}
+
+TEST_CASE(corrupted_entry)
+{
+    auto directory = TRY_OR_FAIL(FileSystem::TempFile::create_temp_directory());
+    auto path = entry_path(directory->path(), store_valid_module(directory->path()));
+    auto entry = TRY_OR_FAIL(TRY_OR_FAIL(Core::File::open(path, Core::File::OpenMode::Read))->read_until_eof());
+
+    auto write_entry = [&](ReadonlyBytes bytes) {
+        auto file = TRY_OR_FAIL(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY_OR_FAIL(file->write_until_depleted(bytes));
+    };
+
+    // Every single flipped bit, in the header, the build identifier, the key and the signature, is noticed.
+    for (size_t i = 0; i < entry.size(); ++i) {
+        auto corrupted = TRY_OR_FAIL(ByteBuffer::copy(entry));
+        corrupted[i] ^= 1;
+        write_entry(corrupted);
+        EXPECT(!load_in_later_run(directory->path()));
+    }
+
+    write_entry(entry.bytes().trim(entry.size() - 1));
+    EXPECT(!load_in_later_run(directory->path()));
+
+    write_entry(entry);
+    EXPECT(load_in_later_run(directory->path()));
+}
+
+TEST_CASE(version_mismatch)
+{
+    auto directory = TRY_OR_FAIL(FileSystem::TempFile::create_temp_directory());
+    store_valid_module(directory->path(), ByteString { "some other build"sv });
+    EXPECT(!load_in_later_run(directory->path()));
+
+    // Storing it again from this build replaces the entry.
+    store_valid_module(directory->path());
+    EXPECT(load_in_later_run(directory->path()));
+}
+
+TEST_CASE(entry_from_another_cache)
+{
+    // An entry that's well-formed, but was signed with another cache's secret, isn't trusted.
+    auto directory = TRY_OR_FAIL(FileSystem::TempFile::create_temp_directory());
+    auto other_directory = TRY_OR_FAIL(FileSystem::TempFile::create_temp_directory());
+    auto key = store_valid_module(other_directory->path());
+    (void)MUST(Wasm::ModuleCache::create(directory->path().to_byte_string()));
+
+    auto entry = TRY_OR_FAIL(TRY_OR_FAIL(Core::File::open(entry_path(other_directory->path(), key), Core::File::OpenMode::Read))->read_until_eof());
+    auto file = TRY_OR_FAIL(Core::File::open(entry_path(directory->path(), key), Core::File::OpenMode::Write));
+    TRY_OR_FAIL(file->write_until_depleted(entry));
+    file->close();
+    EXPECT(!load_in_later_run(directory->path()));
+}
@@ -8,11 +8,16 @@
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/Parser/StreamingParser.h>
+#include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
 #include <string.h>
 
 TEST_ROOT("Libraries/LibWasm/Tests");
 
+TESTJS_PROGRAM_FLAG(stack_interpreter_only, "Run every function on the stack interpreter", "stack-interpreter", 0);
+
 TESTJS_GLOBAL_FUNCTION(read_binary_wasm_file, readBinaryWasmFile)
 {
     auto& realm = *vm.current_realm();
@@ -48,6 +53,7 @@ public:
         : JS::Object(ConstructWithPrototypeTag::Tag, prototype)
     {
         m_machine.enable_instruction_count_limit();
+        m_machine.store().enable_guard_pages_for_memories();
     }
 
     static Wasm::AbstractMachine& machine() { return m_machine; }
@@ -156,6 +162,19 @@ private:
 Wasm::AbstractMachine WebAssemblyModule::m_machine;
 HashMap<Wasm::Linker::Name, Wasm::ExternValue> WebAssemblyModule::s_spec_test_namespace;
 
+TESTJS_MAIN_HOOK()
+{
+    WebAssemblyModule::machine().set_register_programs_enabled(!stack_interpreter_only);
+}
+
+TESTJS_GLOBAL_FUNCTION(set_register_programs_enabled, setRegisterProgramsEnabled)
+{
+    auto& machine = WebAssemblyModule::machine();
+    auto was_enabled = machine.register_programs_enabled();
+    machine.set_register_programs_enabled(vm.argument(0).to_boolean());
+    return JS::Value(was_enabled);
+}
+
 TESTJS_GLOBAL_FUNCTION(parse_webassembly_module, parseWebAssemblyModule)
 {
     auto& realm = *vm.current_realm();
@@ -187,6 +206,72 @@ TESTJS_GLOBAL_FUNCTION(parse_webassembly_module, parseWebAssemblyModule)
     return JS::Value(TRY(WebAssemblyModule::create(realm, result.release_value(), imports)));
 }
 
+static JS::ThrowCompletionOr<ReadonlyBytes> module_bytes_argument(JS::VM& vm)
+{
+    auto object = TRY(vm.argument(0).to_object(vm));
+    if (!is<JS::Uint8Array>(*object))
+        return vm.throw_completion<JS::TypeError>("Expected a Uint8Array argument"sv);
+    return static_cast<JS::Uint8Array&>(*object).data();
+}
+
+// Parses a module and returns it as printed by Wasm::Printer. If an array of offsets is passed, the module is fed to a
+// StreamingParser in chunks that end at those offsets, instead of being parsed by Module::parse().
+TESTJS_GLOBAL_FUNCTION(print_webassembly_module, printWebAssemblyModule)
+{
+    auto bytes = TRY(module_bytes_argument(vm));
+
+    auto parse = [&]() -> JS::ThrowCompletionOr<Wasm::ParseResult<NonnullRefPtr<Wasm::Module>>> {
+        if (vm.argument(1).is_undefined()) {
+            FixedMemoryStream stream { bytes };
+            return Wasm::Module::parse(stream);
+        }
+
+        auto chunk_ends = TRY(vm.argument(1).to_object(vm));
+        auto chunk_count = TRY(JS::length_of_array_like(vm, chunk_ends));
+        Wasm::StreamingParser parser;
+        size_t offset = 0;
+        for (size_t i = 0; i <= chunk_count; ++i) {
+            auto end = bytes.size();
+            if (i < chunk_count)
+                end = TRY(TRY(chunk_ends->get(i)).to_index(vm));
+            if (end < offset || end > bytes.size())
+                return vm.throw_completion<JS::RangeError>("Chunk offsets must be in order and inside the module"sv);
+            if (auto result = parser.append(bytes.slice(offset, end - offset)); result.is_error())
+                return result.release_error();
+            offset = end;
+        }
+        return parser.finish();
+    };
+
+    auto result = TRY(parse());
+    if (result.is_error())
+        return vm.throw_completion<JS::SyntaxError>(Wasm::parse_error_to_byte_string(result.error()));
+
+    AllocatingMemoryStream stream;
+    Wasm::Printer printer(stream);
+    printer.print(*result.value());
+    auto printed = TRY_OR_THROW_OOM(vm, stream.read_until_eof());
+    return JS::PrimitiveString::create(vm, ByteString { printed.bytes() });
+}
+
+// Validates a module on the given number of threads, and returns the validation error, or null if it's valid.
+TESTJS_GLOBAL_FUNCTION(validate_webassembly_module, validateWebAssemblyModule)
+{
+    auto bytes = TRY(module_bytes_argument(vm));
+    auto thread_count = TRY(vm.argument(1).to_index(vm));
+
+    FixedMemoryStream stream { bytes };
+    auto module = Wasm::Module::parse(stream);
+    if (module.is_error())
+        return vm.throw_completion<JS::SyntaxError>(Wasm::parse_error_to_byte_string(module.error()));
+
+    Wasm::Validator validator;
+    validator.set_thread_count(thread_count);
+    if (auto result = validator.validate(*module.value()); result.is_error())
+        return JS::PrimitiveString::create(vm, result.error().error_string);
+    return JS::js_null();
+}
+
 TESTJS_GLOBAL_FUNCTION(compare_typed_arrays, compareTypedArrays)
 {
     auto lhs = TRY(vm.argument(0).to_object(vm));
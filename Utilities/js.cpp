@@ -7,9 +7,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/JsonValue.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/Platform.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
@@ -29,6 +31,7 @@
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibJS/SourceTextModule.h>
 #include <LibMain/Main.h>
+#include <LibRegex/Regex.h>
 #include <LibTextCodec/Decoder.h>
 #include <signal.h>
 
@@ -788,9 +791,15 @@ static ErrorOr<int> run_repl(bool gc_on_every_allocation, bool syntax_highlight)
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     bool gc_on_every_allocation = false;
+    size_t gc_marking_threads = 1;
+    bool gc_generational = false;
+    bool gc_allocation_statistics = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
+    bool disable_bytecode_optimizations = false;
+    bool lazy_parse_statistics = false;
+    bool regex_cache_statistics = false;
     StringView evaluate_script;
     Vector<StringView> script_paths;
 
@@ -798,11 +807,20 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_dump_bytecode_passes, "Dump the bytecode before and after optimization", "dump-bytecode-passes", {});
+    args_parser.add_option(disable_bytecode_optimizations, "Disable bytecode optimizations", "no-bytecode-optimizations", {});
+    args_parser.add_option(JS::g_lazy_function_parsing, "Skip function bodies until the function is first called (syntax errors in a body are only reported when it's called)", "lazy-parse", {});
+    args_parser.add_option(lazy_parse_statistics, "Dump lazy function parsing statistics on exit", "lazy-parse-statistics", {});
+    args_parser.add_option(JS::Bytecode::g_collect_megamorphic_cache_statistics, "Dump megamorphic property cache statistics on exit", "megamorphic-cache-statistics", {});
+    args_parser.add_option(regex_cache_statistics, "Dump compiled regex cache statistics on exit", "regex-cache-statistics", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(gc_generational, "Use generational garbage collection", "gc-generational", {});
+    args_parser.add_option(gc_allocation_statistics, "Dump GC allocation statistics on exit (needs HEAP_DEBUG)", "gc-allocation-statistics", {});
+    args_parser.add_option(gc_marking_threads, "Number of threads used for GC marking (0 = one per CPU core)", "gc-marking-threads", {}, "count");
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(s_disable_string_quotes, "Disable quotes around strings", "disable-string-quotes", {});
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
@@ -814,11 +832,41 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     [[maybe_unused]] bool syntax_highlight = !disable_syntax_highlight;
 
     AK::set_debug_enabled(!disable_debug_printing);
+    JS::Bytecode::g_optimize_bytecode = !disable_bytecode_optimizations;
+    if (JS::Bytecode::g_dump_bytecode_passes)
+        JS::Bytecode::g_dump_bytecode = true;
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
     g_vm_storage.get() = JS::VM::create();
     g_vm = g_vm_storage->ptr();
     g_vm->set_dynamic_imports_allowed(true);
+    g_vm->heap().set_marking_thread_count(gc_marking_threads);
+    g_vm->heap().set_generational_collection_enabled(gc_generational);
+
+    ScopeGuard dump_allocation_statistics = [&] {
+        if (gc_allocation_statistics)
+            g_vm->heap().dump_allocation_statistics();
+    };
+
+    ScopeGuard dump_lazy_parse_statistics = [&] {
+        if (lazy_parse_statistics)
+            JS::g_lazy_parsing_statistics.dump();
+    };
+
+    ScopeGuard dump_megamorphic_cache_statistics = [&] {
+        if (JS::Bytecode::g_collect_megamorphic_cache_statistics)
+            JS::Bytecode::g_megamorphic_cache_statistics.dump();
+    };
+
+    ScopeGuard dump_regex_cache_statistics = [&] {
+        if (regex_cache_statistics)
+            Regex<ECMA262>::cache_statistics().dump();
+    };
+
+    ScopeGuard dump_executed_instruction_count = [&] {
+        if constexpr (JS_BYTECODE_INSTRUCTION_COUNT_DEBUG)
+            warnln("Executed {} bytecode instructions", g_vm->bytecode_interpreter().executed_instruction_count());
+    };
 
     if (!disable_debug_printing) {
         // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
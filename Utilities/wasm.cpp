@@ -10,6 +10,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/StackInfo.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibFileSystem/FileSystem.h>
@@ -17,6 +18,7 @@
 #include <LibMain/Main.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
 #include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
 #include <LibWasm/Wasi.h>
@@ -31,6 +33,9 @@ static bool g_continue { false };
 static void (*old_signal)(int);
 static StackInfo g_stack_info;
 static Wasm::DebuggerBytecodeInterpreter g_interpreter(g_stack_info);
+static OwnPtr<Wasm::ModuleCache> g_module_cache;
+static HashMap<Wasm::Module const*, Wasm::ModuleCache::Key> g_module_cache_keys;
+static bool g_print_timings { false };
 
 struct ParsedValue {
     Wasm::Value value;
@@ -353,7 +358,7 @@ static bool pre_interpret_hook(Wasm::Configuration& config, Wasm::InstructionPoi
                     warnln("invalid memory index {} (not found)", args[2]);
                     continue;
                 }
-                warnln("{:>32hex-dump}", mem->data().bytes());
+                warnln("{:>32hex-dump}", mem->bytes());
                 continue;
             }
             if (what.is_one_of("i", "instr", "instruction")) {
@@ -500,13 +505,40 @@ static RefPtr<Wasm::Module> parse(StringView filename)
         return {};
     }
 
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
     auto parse_result = Wasm::Module::parse(*result.value());
     if (parse_result.is_error()) {
         warnln("Something went wrong, either the file is invalid, or there's a bug with LibWasm!");
         warnln("The parse error was {}", Wasm::parse_error_to_byte_string(parse_result.error()));
         return {};
     }
-    return parse_result.release_value();
+    auto module = parse_result.release_value();
+    if (g_print_timings)
+        warnln("Parsed {} in {}us", filename, timer.elapsed_time().to_microseconds());
+
+    // The function bodies of a module that was validated before don't need to be validated again when it's instantiated.
+    if (g_module_cache) {
+        auto key = Wasm::ModuleCache::key_for(result.value()->bytes());
+        if (g_module_cache->load(*module, key)) {
+            if (g_print_timings)
+                warnln("Found {} in the module cache", filename);
+        } else {
+            g_module_cache_keys.set(module.ptr(), key);
+        }
+    }
+    return module;
+}
+
+static Wasm::InstantiationResult instantiate(Wasm::AbstractMachine& machine, Wasm::Module const& module, Vector<Wasm::ExternValue> externs)
+{
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    auto result = machine.instantiate(module, move(externs));
+    if (g_print_timings)
+        warnln("Instantiated the module in {}us", timer.elapsed_time().to_microseconds());
+
+    if (auto key = g_module_cache_keys.take(&module); key.has_value())
+        g_module_cache->store(module, *key);
+    return result;
 }
 
 static void print_link_error(Wasm::LinkError const& error)
@@ -524,6 +556,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool export_all_imports = false;
     bool shell_mode = false;
     bool wasi = false;
+    bool stack_interpreter_only = false;
+    StringView module_cache_directory;
     ByteString exported_function_to_execute;
     Vector<ParsedValue> values_to_push;
     Vector<ByteString> modules_to_link_in;
@@ -539,6 +573,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop");
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
+    parser.add_option(module_cache_directory, "Skip validating modules that are found in, and store validated modules to, this directory", "module-cache", {}, "path");
+    parser.add_option(g_print_timings, "Print how long parsing and instantiating took", "print-timings", {});
+    parser.add_option(stack_interpreter_only, "Don't lower functions to register programs", "stack-interpreter", {});
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Directory mappings to expose via WASI",
@@ -603,6 +640,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (!exported_function_to_execute.is_empty())
         attempt_instantiate = true;
 
+    if (!module_cache_directory.is_empty())
+        g_module_cache = TRY(Wasm::ModuleCache::create(module_cache_directory));
+
     auto parse_result = parse(filename);
     if (parse_result.is_null())
         return 1;
@@ -617,6 +657,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (attempt_instantiate) {
         Wasm::AbstractMachine machine;
+        machine.store().enable_guard_pages_for_memories();
+        machine.set_register_programs_enabled(!stack_interpreter_only);
+        g_interpreter.set_register_programs_enabled(!stack_interpreter_only);
         Optional<Wasm::Wasi::Implementation> wasi_impl;
 
         if (wasi) {
@@ -671,7 +714,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 print_link_error(link_result.error());
                 return 1;
             }
-            auto instantiation_result = machine.instantiate(linked_modules.last(), link_result.release_value());
+            auto instantiation_result = instantiate(machine, linked_modules.last(), link_result.release_value());
             if (instantiation_result.is_error()) {
                 warnln("Instantiation of imported module '{}' failed: {}", name, instantiation_result.error().error);
                 return 1;
@@ -745,7 +788,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             print_link_error(link_result.error());
             return 1;
         }
-        auto result = machine.instantiate(*parse_result, link_result.release_value());
+        auto result = instantiate(machine, *parse_result, link_result.release_value());
         if (result.is_error()) {
             warnln("Module instantiation failed: {}", result.error().error);
             return 1;